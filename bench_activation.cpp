@@ -0,0 +1,160 @@
+/**
+ * @file bench_activation.cpp
+ * @brief Reader latency on ActivationField while ticks are running
+ *
+ * One thread ticks a random graph back to back while reader threads call
+ * get_activation() / for_each_active(). Compares:
+ *   - locked: every tick and read behind one mutex (how ActivationField
+ *     used to work)
+ *   - published: ActivationField as is (readers never wait for a tick)
+ *
+ * Usage:
+ *   bench_activation [--nodes 20000] [--readers 4] [--seconds 2]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/reasoning/spreading_activation.h"
+
+using namespace melvin::reasoning;
+
+namespace {
+
+using Graph = std::unordered_map<int, std::vector<std::pair<int, float>>>;
+
+Graph make_graph(int nodes, int degree) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(0, nodes - 1);
+    std::uniform_real_distribution<float> weight(0.1f, 1.0f);
+
+    Graph graph;
+    for (int i = 0; i < nodes; ++i) {
+        auto& edges = graph[i];
+        for (int k = 0; k < degree; ++k) {
+            edges.emplace_back(pick(rng), weight(rng));
+        }
+    }
+    return graph;
+}
+
+void print_histogram(const char* name, const LatencyHistogram& histogram) {
+    std::cout << "  " << std::left << std::setw(22) << name << std::right
+              << std::setw(10) << histogram.count() << " samples"
+              << "  p50 <" << std::setw(9) << histogram.percentile(0.50f) / 1000.0 << " us"
+              << "  p99 <" << std::setw(9) << histogram.percentile(0.99f) / 1000.0 << " us"
+              << "  max <" << std::setw(9) << histogram.percentile(1.0f) / 1000.0 << " us\n";
+}
+
+void run(bool locked, const Graph& graph, int nodes, int readers, double seconds) {
+    ActivationField field(0.9f, 0.3f, 0.01f);
+    std::mutex big_lock;
+    LatencyHistogram tick_times;
+    LatencyHistogram read_times;
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> pick(0, nodes - 1);
+    for (int i = 0; i < 200; ++i) {
+        field.activate(pick(rng), 1.0f);
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> ticks{0};
+    std::atomic<uint64_t> reads{0};
+
+    std::thread ticker([&] {
+        std::mt19937 seed_rng(5);
+        while (running.load()) {
+            auto start = std::chrono::steady_clock::now();
+            if (locked) {
+                std::lock_guard<std::mutex> lock(big_lock);
+                field.tick(graph);
+            } else {
+                field.tick(graph);
+            }
+            tick_times.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+            field.activate(pick(seed_rng), 1.0f);  // Keep the field from dying out
+            ticks++;
+        }
+    });
+
+    std::vector<std::thread> reader_threads;
+    for (int r = 0; r < readers; ++r) {
+        reader_threads.emplace_back([&, r] {
+            std::mt19937 reader_rng(100 + r);
+            uint64_t count = 0;
+            float sink = 0.0f;
+            while (running.load()) {
+                auto start = std::chrono::steady_clock::now();
+                if (count % 16 == 0) {
+                    auto read_all = [&] {
+                        field.for_each_active(0.05f, [&](int, float a) { sink += a; });
+                    };
+                    if (locked) {
+                        std::lock_guard<std::mutex> lock(big_lock);
+                        read_all();
+                    } else {
+                        read_all();
+                    }
+                } else if (locked) {
+                    std::lock_guard<std::mutex> lock(big_lock);
+                    sink += field.get_activation(pick(reader_rng));
+                } else {
+                    sink += field.get_activation(pick(reader_rng));
+                }
+                read_times.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count()));
+                count++;
+            }
+            reads += count;
+            if (sink < 0.0f) std::cout << "";  // Keep the reads alive
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    running = false;
+    ticker.join();
+    for (auto& thread : reader_threads) {
+        thread.join();
+    }
+
+    std::cout << (locked ? "locked" : "published") << ": "
+              << ticks.load() << " ticks, " << reads.load() << " reads\n";
+    print_histogram("tick", tick_times);
+    print_histogram("read", read_times);
+    if (!locked) {
+        print_histogram("publish wait", field.publish_wait_histogram());
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int nodes = 20000;
+    int readers = 4;
+    double seconds = 2.0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--nodes") nodes = std::atoi(argv[i + 1]);
+        else if (arg == "--readers") readers = std::atoi(argv[i + 1]);
+        else if (arg == "--seconds") seconds = std::atof(argv[i + 1]);
+    }
+
+    Graph graph = make_graph(nodes, 8);
+    std::cout << "ActivationField reader latency: " << nodes << " nodes, "
+              << readers << " readers, " << seconds << " s per run\n\n";
+    run(true, graph, nodes, readers, seconds);
+    std::cout << "\n";
+    run(false, graph, nodes, readers, seconds);
+    return 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file bench_intent.cpp
+ * @brief Intent classification throughput (queries/second)
+ *
+ * Classifies a batch of generated queries two ways:
+ *   - per query: tokenize() → compute_simple_embedding() → infer_intent(),
+ *     with fresh strings and vectors for every query
+ *   - batched: IntentClassifier::classify_many() over string_views, with
+ *     interned tokens and reused buffers
+ * and checks that both give the same intents.
+ *
+ * Usage:
+ *   bench_intent [--queries 20000] [--rounds 10]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "core/language/intent_classifier.h"
+
+using namespace melvin::language;
+
+namespace {
+
+std::vector<std::string> make_queries(size_t count) {
+    static const char* openers[] = {
+        "what is", "where is", "why does", "when did", "how to", "how do you know",
+        "difference between", "compare", "tell me about", ""
+    };
+    static const char* words[] = {
+        "fire", "water", "the", "a", "Paris", "dog", "cat", "heat", "smoke", "river",
+        "of", "and", "time", "history", "steps", "like", "similar", "cause", "vs", "sun"
+    };
+
+    std::mt19937 rng(42);
+    std::vector<std::string> queries;
+    queries.reserve(count);
+    for (size_t q = 0; q < count; ++q) {
+        std::string query = openers[rng() % (sizeof(openers) / sizeof(openers[0]))];
+        size_t length = 1 + rng() % 6;
+        for (size_t w = 0; w < length; ++w) {
+            if (!query.empty()) query += ' ';
+            query += words[rng() % (sizeof(words) / sizeof(words[0]))];
+        }
+        if (rng() % 2) query += '?';
+        queries.push_back(query);
+    }
+    return queries;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t count = 20000;
+    size_t rounds = 10;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--queries") count = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (arg == "--rounds") rounds = std::strtoul(argv[i + 1], nullptr, 10);
+    }
+
+    std::vector<std::string> queries = make_queries(count);
+    std::vector<std::string_view> views(queries.begin(), queries.end());
+    IntentClassifier classifier;
+
+    std::vector<ReasoningIntent> expected(count);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t q = 0; q < count; ++q) {
+            std::vector<std::string> tokens = tokenize(queries[q]);
+            expected[q] = classifier.infer_intent(compute_simple_embedding(tokens), tokens);
+        }
+    }
+    double per_query_s = seconds_since(start);
+
+    std::vector<ReasoningIntent> intents;
+    start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r) {
+        classifier.classify_many(views, intents);
+    }
+    double batched_s = seconds_since(start);
+
+    size_t mismatches = 0;
+    for (size_t q = 0; q < count; ++q) {
+        if (intents[q] != expected[q]) mismatches++;
+    }
+
+    double total = static_cast<double>(count * rounds);
+    std::cout << "Intent classification: " << count << " queries x " << rounds << " rounds\n"
+              << std::fixed << std::setprecision(0)
+              << "  per query    " << std::setw(10) << total / per_query_s << " queries/s\n"
+              << "  classify_many" << std::setw(10) << total / batched_s << " queries/s"
+              << std::setprecision(1) << "  (" << per_query_s / batched_s << "x)\n"
+              << "  " << mismatches << " mismatches\n";
+    return mismatches == 0 ? 0 : 1;
+}
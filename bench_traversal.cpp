@@ -0,0 +1,227 @@
+/**
+ * @file bench_traversal.cpp
+ * @brief Path queries on a synthetic power-law graph
+ *
+ * Builds a preferential-attachment graph (a few hubs, many low-degree
+ * nodes, edges in both directions about half the time) and times:
+ *   - legacy: best-first search over the adjacency map with hash-set
+ *     visited state and a 1000-step cap (how find_reasoning_chain used to
+ *     work), against find_reasoning_chain on a TraversalGraph. Legacy
+ *     stops at the first meeting and walks out-edges from the target, so
+ *     its chains are reported with how many follow real edges and their
+ *     mean weight product (geometric mean over queries)
+ *   - find_reasoning_chains with k = 5
+ *   - hop_distances for a batch of queries, against one BFS per query
+ *
+ * Usage:
+ *   bench_traversal [--nodes 200000] [--degree 4] [--queries 200] [--batch 20000]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/fields/parallel_graph_traversal.h"
+
+using namespace melvin::fields;
+
+namespace {
+
+using Adjacency = std::unordered_map<int, std::vector<std::pair<int, float>>>;
+
+Adjacency make_power_law_graph(size_t nodes, size_t degree, std::mt19937& rng) {
+    Adjacency graph;
+    std::vector<int> endpoints;  // One entry per edge end: picking one is degree-proportional
+    std::uniform_real_distribution<float> weight(0.05f, 1.0f);
+
+    for (size_t u = 1; u < nodes; ++u) {
+        for (size_t e = 0; e < degree; ++e) {
+            int v = endpoints.empty() || rng() % 4 == 0 ? rng() % u : endpoints[rng() % endpoints.size()];
+            graph[u].push_back({v, weight(rng)});
+            if (rng() % 2) graph[v].push_back({static_cast<int>(u), weight(rng)});
+            endpoints.push_back(static_cast<int>(u));
+            endpoints.push_back(v);
+        }
+    }
+    return graph;
+}
+
+// Former find_reasoning_chain: paths copied per node, hash-set visited state
+std::vector<int> legacy_chain(int start, int target, const Adjacency& graph, size_t max_steps = 1000) {
+    struct Frontier {
+        std::unordered_map<int, std::vector<int>> node_to_path;
+        std::priority_queue<std::pair<float, int>> queue;
+    };
+    Frontier sides[2];
+    sides[0].node_to_path[start] = {start};
+    sides[0].queue.push({1.0f, start});
+    sides[1].node_to_path[target] = {target};
+    sides[1].queue.push({1.0f, target});
+
+    for (size_t step = 0; step < max_steps; ++step) {
+        for (int s = 0; s < 2; ++s) {
+            Frontier& self = sides[s];
+            Frontier& other = sides[1 - s];
+            if (self.queue.empty()) continue;
+            auto [priority, node] = self.queue.top();
+            self.queue.pop();
+            auto met = other.node_to_path.find(node);
+            if (met != other.node_to_path.end()) {
+                std::vector<int> path = self.node_to_path[node];
+                path.insert(path.end(), met->second.rbegin() + 1, met->second.rend());
+                return path;
+            }
+            auto it = graph.find(node);
+            if (it == graph.end()) continue;
+            for (const auto& [neighbor, weight] : it->second) {
+                if (self.node_to_path.count(neighbor)) continue;
+                auto path = self.node_to_path[node];
+                path.push_back(neighbor);
+                self.node_to_path[neighbor] = path;
+                self.queue.push({priority * weight, neighbor});
+            }
+        }
+    }
+    return {};
+}
+
+int single_bfs(const TraversalGraph& graph, uint32_t source, uint32_t target, std::vector<int>& depth) {
+    if (source == target) return 0;
+    std::fill(depth.begin(), depth.end(), -1);
+    std::vector<uint32_t> queue{source};
+    depth[source] = 0;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        uint32_t u = queue[head];
+        for (uint32_t e = graph.out_offsets[u]; e < graph.out_offsets[u + 1]; ++e) {
+            uint32_t v = graph.out_targets[e];
+            if (depth[v] >= 0) continue;
+            depth[v] = depth[u] + 1;
+            if (v == target) return depth[v];
+            queue.push_back(v);
+        }
+    }
+    return -1;
+}
+
+// Product of edge weights along a chain, 0 if an edge doesn't exist
+double chain_strength(const std::vector<int>& chain, const Adjacency& graph) {
+    double strength = 1.0;
+    for (size_t i = 0; i + 1 < chain.size(); ++i) {
+        double best = 0.0;
+        auto it = graph.find(chain[i]);
+        if (it != graph.end()) {
+            for (const auto& [neighbor, weight] : it->second) {
+                if (neighbor == chain[i + 1]) best = std::max(best, static_cast<double>(weight));
+            }
+        }
+        strength *= best;
+    }
+    return strength;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t nodes = 200000;
+    size_t degree = 4;
+    size_t queries = 200;
+    size_t batch = 20000;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        if (arg == "--nodes") nodes = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (arg == "--degree") degree = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (arg == "--queries") queries = std::strtoul(argv[i + 1], nullptr, 10);
+        else if (arg == "--batch") batch = std::strtoul(argv[i + 1], nullptr, 10);
+    }
+
+    std::mt19937 rng(42);
+    Adjacency graph = make_power_law_graph(nodes, degree, rng);
+    auto start = std::chrono::steady_clock::now();
+    TraversalGraph csr = TraversalGraph::build(graph);
+    double build_s = seconds_since(start);
+    std::cout << "Power-law graph: " << csr.size() << " nodes, " << csr.num_edges() << " edges"
+              << std::fixed << std::setprecision(1) << " (CSR build " << build_s * 1e3 << " ms)\n";
+
+    std::vector<std::pair<int, int>> pairs;
+    for (size_t q = 0; q < std::max(queries, batch); ++q) {
+        pairs.push_back({static_cast<int>(rng() % nodes), static_cast<int>(rng() % nodes)});
+    }
+
+    ParallelGraphTraversal traversal;
+    std::vector<std::vector<int>> legacy_chains(queries), chains(queries);
+    start = std::chrono::steady_clock::now();
+    for (size_t q = 0; q < queries; ++q) {
+        legacy_chains[q] = legacy_chain(pairs[q].first, pairs[q].second, graph);
+    }
+    double legacy_s = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+    for (size_t q = 0; q < queries; ++q) {
+        chains[q] = traversal.find_reasoning_chain(pairs[q].first, pairs[q].second, csr);
+    }
+    double chain_s = seconds_since(start);
+
+    // Quality on the queries both answered with real edges
+    size_t legacy_found = 0, legacy_valid = 0, found = 0, compared = 0;
+    double legacy_log = 0.0, chain_log = 0.0;
+    for (size_t q = 0; q < queries; ++q) {
+        double legacy_strength = chain_strength(legacy_chains[q], graph);
+        if (!legacy_chains[q].empty()) legacy_found++;
+        if (!legacy_chains[q].empty() && legacy_strength > 0.0) legacy_valid++;
+        if (!chains[q].empty()) found++;
+        if (legacy_strength > 0.0 && !chains[q].empty()) {
+            legacy_log += std::log(legacy_strength);
+            chain_log += std::log(chain_strength(chains[q], graph));
+            compared++;
+        }
+    }
+    start = std::chrono::steady_clock::now();
+    size_t k_paths = 0;
+    for (size_t q = 0; q < queries; ++q) {
+        k_paths += traversal.find_reasoning_chains(pairs[q].first, pairs[q].second, csr, 5).size();
+    }
+    double k_s = seconds_since(start);
+
+    std::cout << std::setprecision(3)
+              << "  legacy chain        " << std::setw(10) << legacy_s / queries * 1e3 << " ms/query  "
+              << legacy_found << "/" << queries << " found, " << legacy_valid << " along edges, strength "
+              << std::exp(legacy_log / std::max<size_t>(1, compared)) << "\n"
+              << "  find_reasoning_chain" << std::setw(10) << chain_s / queries * 1e3 << " ms/query  "
+              << found << "/" << queries << " found, strength "
+              << std::exp(chain_log / std::max<size_t>(1, compared)) << "\n"
+              << "  k = 5 chains        " << std::setw(10) << k_s / queries * 1e3 << " ms/query  "
+              << k_paths << " paths\n";
+
+    std::vector<std::pair<int, int>> hop_queries(pairs.begin(), pairs.begin() + batch);
+    std::vector<int> depth(csr.size());
+    size_t bfs_count = std::min(batch, size_t(1000));
+    start = std::chrono::steady_clock::now();
+    size_t mismatches = 0;
+    std::vector<int> single(bfs_count);
+    for (size_t q = 0; q < bfs_count; ++q) {
+        single[q] = single_bfs(csr, csr.find(hop_queries[q].first), csr.find(hop_queries[q].second), depth);
+    }
+    double bfs_s = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+    std::vector<int> hops = traversal.hop_distances(hop_queries, csr);
+    double hops_s = seconds_since(start);
+    for (size_t q = 0; q < bfs_count; ++q) {
+        if (hops[q] != single[q]) mismatches++;
+    }
+
+    std::cout << std::setprecision(0)
+              << "  BFS per query       " << std::setw(10) << bfs_count / bfs_s << " queries/s\n"
+              << "  hop_distances       " << std::setw(10) << batch / hops_s << " queries/s  ("
+              << traversal.get_num_threads() << " threads, " << mismatches << " mismatches)\n";
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file bench_vision.cpp
+ * @brief Per-frame cost of the vision pipeline stages
+ *
+ * Runs on synthetic 640x480 BGR frames (coloured blocks drifting over a
+ * gradient, plus noise), with a fixed focus point so fine patches are on:
+ *   - Stage 1: per-ROI cv::mean / cv::meanStdDev / cv::countNonZero
+ *     vs Stage1_VisionInput (one pass, patch integrals)
+ *   - Stage 2: ostringstream patch keys and per-element sin embeddings
+ *     vs Stage2_Tokenize (packed 64-bit keys)
+ *   - Stages 1 → 5: sequential on one thread vs PipelinedVision, with
+ *     frames submitted back to back (stale frames are dropped)
+ *
+ * Usage:
+ *   bench_vision [--frames 200]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/vision/vision_pipeline.h"
+#include "core/vision/pipelined_vision.h"
+
+using namespace melvin::vision;
+
+namespace {
+
+constexpr int WIDTH = 640;
+constexpr int HEIGHT = 480;
+constexpr int PATCH = 64;
+constexpr int FINE_PATCH = 8;
+constexpr int FOCUS_RADIUS = 150;
+
+std::vector<cv::Mat> make_frames(int count) {
+    cv::Mat background(HEIGHT, WIDTH, CV_8UC3);
+    for (int y = 0; y < HEIGHT; ++y) {
+        for (int x = 0; x < WIDTH; ++x) {
+            background.at<cv::Vec3b>(y, x) = cv::Vec3b(x * 255 / WIDTH, y * 255 / HEIGHT, 128);
+        }
+    }
+
+    std::vector<cv::Mat> frames;
+    cv::RNG rng(7);
+    for (int i = 0; i < count; ++i) {
+        cv::Mat frame = background.clone();
+        cv::rectangle(frame, cv::Rect(40 + (3 * i) % 500, 100, 80, 80), cv::Scalar(0, 0, 220), cv::FILLED);
+        cv::rectangle(frame, cv::Rect(300, 60 + (2 * i) % 300, 60, 120), cv::Scalar(200, 40, 40), cv::FILLED);
+        cv::Mat noise(frame.size(), CV_8UC3);
+        rng.fill(noise, cv::RNG::UNIFORM, 0, 12);
+        frame += noise;
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+// Baseline: statistics from OpenCV calls on each patch ROI
+Patch roi_patch(const cv::Mat& frame, const cv::Mat& motion_map, const cv::Rect& roi) {
+    cv::Mat patch_img = frame(roi);
+
+    Patch patch;
+    patch.x = roi.x;
+    patch.y = roi.y;
+    patch.width = roi.width;
+    patch.height = roi.height;
+    patch.avg_color = cv::mean(patch_img);
+    patch.motion = motion_map.empty()
+        ? 0.0f
+        : cv::countNonZero(motion_map(roi)) / float(roi.width * roi.height);
+
+    cv::Scalar mean, stddev;
+    cv::meanStdDev(patch_img, mean, stddev);
+    patch.saliency = (stddev[0] + stddev[1] + stddev[2]) / 3.0f;
+    return patch;
+}
+
+std::vector<Patch> stage1_roi(const cv::Mat& frame, cv::Mat& prev_gray, const cv::Point2f& focus) {
+    cv::Mat gray, motion_map;
+    cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
+    if (!prev_gray.empty()) {
+        cv::Mat diff;
+        cv::absdiff(gray, prev_gray, diff);
+        cv::threshold(diff, motion_map, 25, 255, cv::THRESH_BINARY);
+    }
+    prev_gray = gray;
+
+    std::vector<Patch> patches;
+    for (int py = 0; py + PATCH <= frame.rows; py += PATCH) {
+        for (int px = 0; px + PATCH <= frame.cols; px += PATCH) {
+            patches.push_back(roi_patch(frame, motion_map, cv::Rect(px, py, PATCH, PATCH)));
+        }
+    }
+    int fx = static_cast<int>(focus.x);
+    int fy = static_cast<int>(focus.y);
+    for (int py = fy - FOCUS_RADIUS; py < fy + FOCUS_RADIUS; py += FINE_PATCH) {
+        for (int px = fx - FOCUS_RADIUS; px < fx + FOCUS_RADIUS; px += FINE_PATCH) {
+            if (px < 0 || py < 0 || px + FINE_PATCH > frame.cols || py + FINE_PATCH > frame.rows) {
+                continue;
+            }
+            patches.push_back(roi_patch(frame, motion_map, cv::Rect(px, py, FINE_PATCH, FINE_PATCH)));
+        }
+    }
+    return patches;
+}
+
+// Baseline: string-keyed deduplication, embedding via 119 sin calls
+struct StringTokenizer {
+    std::unordered_map<std::string, int> patch_to_node;
+    int next_node_id = 100000;
+
+    int process(const std::vector<Patch>& patches, std::vector<Token>& tokens) {
+        int created = 0;
+        tokens.clear();
+        for (const auto& patch : patches) {
+            std::ostringstream oss;
+            oss << std::fixed << std::setprecision(0);
+            oss << patch.x / 10 << "_" << patch.y / 10 << "_"
+                << patch.avg_color[0] / 20 << "_"
+                << patch.avg_color[1] / 20 << "_"
+                << patch.avg_color[2] / 20;
+
+            Token token;
+            token.patch = patch;
+            token.embedding.assign(128, 0.0f);
+            float* emb = token.embedding.data();
+            emb[0] = patch.avg_color[0] / 255.0f;
+            emb[1] = patch.avg_color[1] / 255.0f;
+            emb[2] = patch.avg_color[2] / 255.0f;
+            emb[3] = patch.x / 1000.0f;
+            emb[4] = patch.y / 1000.0f;
+            emb[5] = patch.width / 100.0f;
+            emb[6] = patch.height / 100.0f;
+            emb[7] = patch.motion;
+            emb[8] = patch.saliency / 100.0f;
+            for (size_t i = 9; i < 128; ++i) {
+                emb[i] = std::sin(i * 0.1f + emb[i % 9]) * 0.1f;
+            }
+
+            auto it = patch_to_node.find(oss.str());
+            if (it != patch_to_node.end()) {
+                token.node_id = it->second;
+            } else {
+                token.node_id = next_node_id++;
+                patch_to_node[oss.str()] = token.node_id;
+                created++;
+            }
+            tokens.push_back(token);
+        }
+        return created;
+    }
+};
+
+double elapsed(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(const std::string& name, double seconds, int frames) {
+    std::cout << "  " << std::left << std::setw(40) << name
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << seconds * 1e6 / frames << " us/frame\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int num_frames = 200;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--frames" && i + 1 < argc) {
+            num_frames = std::max(2, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--frames N]\n";
+            return 1;
+        }
+    }
+
+    std::vector<cv::Mat> frames = make_frames(num_frames);
+    cv::Point2f focus(WIDTH / 2.0f, HEIGHT / 2.0f);
+
+    std::cout << "Vision tokenization benchmark: " << num_frames << " frames of "
+              << WIDTH << "x" << HEIGHT << ", focus radius " << FOCUS_RADIUS << "\n\n";
+
+    // Stage 1
+    std::vector<std::vector<Patch>> roi_patches(num_frames);
+    cv::Mat prev_gray;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_frames; ++i) {
+        roi_patches[i] = stage1_roi(frames[i], prev_gray, focus);
+    }
+    double t_roi = elapsed(start);
+
+    std::vector<Stage1_VisionInput::Output> stage1_out(num_frames);
+    Stage1_VisionInput stage1;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_frames; ++i) {
+        stage1_out[i] = stage1.process(frames[i], focus);
+    }
+    double t_stage1 = elapsed(start);
+
+    double max_color_err = 0.0, max_saliency_err = 0.0, max_motion_err = 0.0;
+    for (int i = 0; i < num_frames; ++i) {
+        const auto& a = roi_patches[i];
+        const auto& b = stage1_out[i].patches;
+        if (a.size() != b.size()) {
+            std::cerr << "Patch count mismatch on frame " << i << "\n";
+            return 1;
+        }
+        for (size_t p = 0; p < a.size(); ++p) {
+            for (int c = 0; c < 3; ++c) {
+                max_color_err = std::max(max_color_err, std::fabs(a[p].avg_color[c] - b[p].avg_color[c]));
+            }
+            max_saliency_err = std::max(max_saliency_err, double(std::fabs(a[p].saliency - b[p].saliency)));
+            max_motion_err = std::max(max_motion_err, double(std::fabs(a[p].motion - b[p].motion)));
+        }
+    }
+
+    std::cout << "Stage 1 patch statistics (" << stage1_out[0].patches.size() << " patches/frame)\n";
+    report("per-ROI mean/meanStdDev/countNonZero", t_roi, num_frames);
+    report("Stage1_VisionInput (patch integrals)", t_stage1, num_frames);
+    std::cout << "  max |diff|: colour " << std::scientific << std::setprecision(2) << max_color_err
+              << ", saliency " << max_saliency_err << ", motion " << max_motion_err << std::fixed << "\n";
+
+    // Stage 2
+    StringTokenizer string_tokenizer;
+    std::vector<Token> tokens;
+    int created_string = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_frames; ++i) {
+        created_string += string_tokenizer.process(stage1_out[i].patches, tokens);
+    }
+    double t_string = elapsed(start);
+
+    Stage2_Tokenize stage2;
+    int created_packed = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_frames; ++i) {
+        created_packed += stage2.process(stage1_out[i]).nodes_created;
+    }
+    double t_packed = elapsed(start);
+
+    std::cout << "\nStage 2 tokenization\n";
+    report("string keys + sin embedding", t_string, num_frames);
+    report("Stage2_Tokenize (packed keys)", t_packed, num_frames);
+    std::cout << "  nodes created: string " << created_string << ", packed " << created_packed << "\n";
+
+    // Whole pipeline
+    Stage1_VisionInput seq_stage1;
+    Stage2_Tokenize seq_stage2;
+    Stage3_Connect seq_stage3;
+    Stage5_Generalize seq_stage5;
+    cv::Point2f seq_focus(-1, -1);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_frames; ++i) {
+        auto tokenized = seq_stage2.process(seq_stage1.process(frames[i], seq_focus));
+        seq_focus = tokenized.focus_point;
+        seq_stage5.process(seq_stage3.process(tokenized));
+    }
+    double t_sequential = elapsed(start);
+
+    PipelinedVision pipeline;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < num_frames; ++i) {
+        pipeline.submit(frames[i]);
+    }
+    pipeline.stop();
+    double t_pipelined = elapsed(start);
+    PipelinedVision::Stats stats = pipeline.get_stats();
+
+    std::cout << "\nStages 1-5 (" << pipeline.config().tile_threads << " tile threads, "
+              << pipeline.config().tiles_per_frame << " tiles/frame)\n";
+    std::cout << "  sequential:  " << std::setprecision(1) << num_frames / t_sequential << " fps\n";
+    std::cout << "  pipelined:   " << stats.completed / t_pipelined << " fps completed, "
+              << stats.dropped << " of " << stats.submitted << " frames dropped, latency "
+              << std::setprecision(2) << stats.mean_latency_ms << " ms mean / "
+              << stats.max_latency_ms << " ms max\n";
+    const char* stage_names[4] = {"Stage 1", "Stage 2", "Stage 3", "Stage 5"};
+    for (int i = 0; i < 4; ++i) {
+        const auto& stage = stats.stages[i];
+        std::cout << "    " << stage_names[i] << ": " << stage.processed << " frames, "
+                  << std::setprecision(3) << stage.mean_ms << " ms mean, "
+                  << stage.max_ms << " ms max, " << std::setprecision(1)
+                  << stage.throughput_fps << " fps\n";
+    }
+
+    return 0;
+}
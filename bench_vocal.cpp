@@ -0,0 +1,214 @@
+/**
+ * @file bench_vocal.cpp
+ * @brief Real-time factor of the vocal synthesis / spectral analysis path
+ *
+ * Measures, on 16 kHz audio:
+ *   - formant filtering: per-formant scalar IIR vs BiquadCascade
+ *   - pitch autocorrelation: direct O(N·L) vs FFT (Wiener–Khinchin)
+ *   - 80-bin log-mel extraction
+ *   - end-to-end VocalSynthesizer::synthesize_text
+ *   - streaming: block render cost and time to first audio via SpeechStream
+ *
+ * Real-time factor = processing time / audio duration (lower is better;
+ * 0.01 means 100x faster than real time).
+ *
+ * Usage:
+ *   bench_vocal [--seconds 10] [--repeats 5]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/audio/spectral.h"
+#include "core/audio/speech_stream.h"
+#include "core/audio/vocal_synthesis.h"
+
+using namespace melvin::audio;
+
+namespace {
+
+constexpr int SAMPLE_RATE = 16000;
+constexpr float PI = 3.14159265358979323846f;
+
+template <typename F>
+double best_seconds(int repeats, F&& fn) {
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+    return best;
+}
+
+void report(const std::string& name, double seconds, double audio_seconds) {
+    std::cout << "  " << std::left << std::setw(34) << name
+              << std::right << std::fixed << std::setprecision(3)
+              << std::setw(10) << seconds * 1000.0 << " ms"
+              << "   RTF " << std::setprecision(5) << seconds / audio_seconds << "\n";
+}
+
+// Baseline: the per-formant scalar filter the synthesizer used before
+std::vector<float> formants_scalar(const std::vector<float>& source, const std::vector<Formant>& formants) {
+    std::vector<float> result = source;
+    for (const auto& formant : formants) {
+        Biquad q = Biquad::resonator(formant.frequency, formant.bandwidth, formant.amplitude, SAMPLE_RATE);
+        std::vector<float> filtered(result.size(), 0.0f);
+        for (size_t i = 2; i < result.size(); ++i) {
+            filtered[i] = q.b0 * result[i] - q.a1 * filtered[i - 1] - q.a2 * filtered[i - 2];
+        }
+        result.swap(filtered);
+    }
+    return result;
+}
+
+// Baseline: direct autocorrelation over the pitch lag range
+void autocorrelation_direct(const std::vector<float>& x, size_t max_lag, std::vector<float>& out) {
+    out.assign(max_lag + 1, 0.0f);
+    for (size_t lag = 0; lag <= max_lag && lag < x.size(); ++lag) {
+        float sum = 0.0f;
+        for (size_t i = 0; i + lag < x.size(); ++i) {
+            sum += x[i] * x[i + lag];
+        }
+        out[lag] = sum;
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    double seconds = 10.0;
+    int repeats = 5;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::max(0.1, std::atof(argv[++i]));
+        } else if (arg == "--repeats" && i + 1 < argc) {
+            repeats = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--seconds S] [--repeats N]\n";
+            return 1;
+        }
+    }
+
+    // Voiced test signal: 140 Hz pulse train with vibrato plus a little noise
+    size_t n = static_cast<size_t>(seconds * SAMPLE_RATE);
+    std::vector<float> audio(n);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(-0.05f, 0.05f);
+    float phase = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        float f0 = 140.0f + 5.0f * std::sin(2.0f * PI * 4.0f * i / SAMPLE_RATE);
+        phase += f0 / SAMPLE_RATE;
+        phase -= std::floor(phase);
+        audio[i] = 0.5f * (1.0f - std::cos(2.0f * PI * std::min(phase / 0.6f, 1.0f))) + noise(rng);
+    }
+
+    std::cout << "Vocal DSP benchmark: " << seconds << " s of " << SAMPLE_RATE
+              << " Hz audio, best of " << repeats << "\n\n";
+
+    // Formant filtering
+    std::vector<Formant> formants = VocalConfiguration::for_phoneme("AA").formants;
+    std::vector<Biquad> sections;
+    for (const auto& f : formants) {
+        sections.push_back(Biquad::resonator(f.frequency, f.bandwidth, f.amplitude, SAMPLE_RATE));
+    }
+    std::vector<float> filtered(n);
+    std::vector<float> baseline;
+    double t_scalar = best_seconds(repeats, [&] { baseline = formants_scalar(audio, formants); });
+    double t_cascade = best_seconds(repeats, [&] {
+        BiquadCascade cascade(sections);
+        cascade.process(audio.data(), filtered.data(), n);
+    });
+    double t_blocks = best_seconds(repeats, [&] {
+        BiquadCascade cascade(sections);
+        for (size_t off = 0; off < n; off += 256) {
+            cascade.process(audio.data() + off, filtered.data() + off, std::min<size_t>(256, n - off));
+        }
+    });
+    std::cout << "Formants (" << formants.size() << " resonators)\n";
+    report("scalar per-formant IIR", t_scalar, seconds);
+    report("BiquadCascade", t_cascade, seconds);
+    report("BiquadCascade, 256-sample blocks", t_blocks, seconds);
+
+    // Pitch autocorrelation (1 s analysis windows, 80-400 Hz lag range)
+    size_t window = std::min<size_t>(n, SAMPLE_RATE);
+    size_t max_lag = SAMPLE_RATE / 80;
+    std::vector<float> win(audio.begin(), audio.begin() + window);
+    std::vector<float> r_direct, r_fft;
+    size_t windows = n / window;
+    double t_direct = best_seconds(repeats, [&] {
+        for (size_t w = 0; w < windows; ++w) autocorrelation_direct(win, max_lag, r_direct);
+    });
+    double t_fft = best_seconds(repeats, [&] {
+        for (size_t w = 0; w < windows; ++w) autocorrelation(win.data(), win.size(), max_lag, r_fft);
+    });
+    float max_err = 0.0f;
+    for (size_t lag = 0; lag <= max_lag; ++lag) {
+        max_err = std::max(max_err, std::fabs(r_direct[lag] - r_fft[lag]) / std::max(1e-6f, r_direct[0]));
+    }
+    auto peak = [&](const std::vector<float>& r) {
+        size_t best = SAMPLE_RATE / 400;
+        for (size_t lag = best; lag < max_lag; ++lag) if (r[lag] > r[best]) best = lag;
+        return static_cast<float>(SAMPLE_RATE) / best;
+    };
+    std::cout << "\nPitch autocorrelation (" << window << "-sample windows, lags <= " << max_lag << ")\n";
+    report("direct O(N*L)", t_direct, seconds);
+    report("FFT (Wiener-Khinchin)", t_fft, seconds);
+    std::cout << "  F0 direct " << std::setprecision(1) << peak(r_direct) << " Hz, FFT " << peak(r_fft)
+              << " Hz, max rel. error " << std::scientific << std::setprecision(2) << max_err
+              << std::fixed << "\n";
+
+    // Mel features
+    MelSpectrogram mel;
+    std::vector<float> frames;
+    size_t num_frames = 0;
+    double t_mel = best_seconds(repeats, [&] { num_frames = mel.compute(audio.data(), n, frames); });
+    std::cout << "\nLog-mel (" << mel.config().num_mels << " bins, " << num_frames << " frames)\n";
+    report("MelSpectrogram::compute", t_mel, seconds);
+
+    // End-to-end synthesis
+    VocalSynthesizer synth(SAMPLE_RATE);
+    std::string text = "hello melvin this is a longer sentence for the vocal synthesis benchmark";
+    std::vector<float> speech;
+    double t_synth = best_seconds(repeats, [&] { speech = synth.synthesize_text(text); });
+    double speech_seconds = static_cast<double>(speech.size()) / SAMPLE_RATE;
+    std::cout << "\nSynthesis (" << std::setprecision(2) << speech_seconds << " s of speech)\n";
+    report("VocalSynthesizer::synthesize_text", t_synth, speech_seconds);
+
+    // Streaming: the same utterance rendered in 256-sample blocks
+    SpeechPlan plan = synth.plan_text(text);
+    std::vector<float> block(256);
+    size_t streamed = 0;
+    double t_stream = best_seconds(repeats, [&] {
+        StreamingSynthesizer streaming(SAMPLE_RATE);
+        streaming.start(plan);
+        streamed = 0;
+        while (size_t got = streaming.render(block.data(), block.size())) streamed += got;
+    });
+    report("StreamingSynthesizer, 256 blocks", t_stream, static_cast<double>(streamed) / SAMPLE_RATE);
+
+    // Time to first audio: whole-utterance synthesis vs first streamed block
+    SpeechStream stream(SAMPLE_RATE, 256);
+    double t_first = best_seconds(repeats, [&] {
+        stream.speak(plan);
+        while (stream.read(block.data(), block.size()) == 0) std::this_thread::yield();
+    });
+    std::cout << "\nTime to first audio\n";
+    std::cout << "  " << std::left << std::setw(34) << "synthesize_text (whole utterance)"
+              << std::right << std::setprecision(3) << std::setw(10) << t_synth * 1000.0 << " ms\n";
+    std::cout << "  " << std::left << std::setw(34) << "SpeechStream first block"
+              << std::right << std::setw(10) << t_first * 1000.0 << " ms\n";
+
+    return 0;
+}
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <iostream>
 #include <random>
+#include <sstream>
 
 namespace melvin {
 namespace cognitive_os {
@@ -38,6 +39,7 @@ void CognitiveOS::start() {
     }
     
     running_.store(true, std::memory_order_relaxed);
+    last_consolidation_time_ = get_timestamp();
     
     // Start scheduler thread
     scheduler_thread_ = std::thread([this]() {
@@ -182,6 +184,7 @@ void CognitiveOS::run_tick() {
     kpis.dropped_msgs = bus_.dropped_messages();
     kpis.services_active = 6;
     kpis.avg_service_load = cpu_load;
+    kpis.consolidation_progress = consolidation_progress_;
     
     metrics_.log(kpis);
 }
@@ -496,6 +499,8 @@ void CognitiveOS::tick_working_memory(float budget_ms) {
 void CognitiveOS::tick_learning(float budget_ms) {
     if (!intelligence_) return;
     
+    double tick_start = get_timestamp();
+    
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
     // ONLINE LEARNING: Process feedback events and update system
     // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -517,6 +522,33 @@ void CognitiveOS::tick_learning(float budget_ms) {
     
     // Hebbian learning is automatically applied after each reasoning step
     // (see UnifiedIntelligence::reason() → apply_hebbian_learning())
+    
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    // CONSOLIDATION: Resumable pass, in slices, within budget
+    // ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+    
+    if (!intelligence_->consolidation_active() &&
+        tick_start - last_consolidation_time_ >= CONSOLIDATION_PERIOD_S) {
+        intelligence_->begin_consolidation();  // Replay, prune, abstract; no node merging
+        last_consolidation_time_ = tick_start;
+    }
+    
+    // Slices run until what's left of the learning budget and the
+    // consolidation budget is spent; the pass resumes next tick
+    double deadline = tick_start + (budget_ms + budgets_.consolidation) / 1000.0;
+    while (intelligence_->consolidation_active() && get_timestamp() < deadline) {
+        auto progress = intelligence_->consolidate_step(CONSOLIDATION_SLICE);
+        if (progress.complete) {
+            consolidation_progress_ = 0.0f;
+            break;
+        }
+        
+        // Three phases of equal weight (the live pass skips MERGE)
+        float phase = static_cast<float>(progress.phase) - 1.0f;
+        float within = progress.phase_total > 0
+            ? static_cast<float>(progress.phase_done) / progress.phase_total : 0.0f;
+        consolidation_progress_ = (phase + within) / 3.0f;
+    }
 }
 
 void CognitiveOS::tick_reflection(float budget_ms) {
@@ -163,6 +163,13 @@ private:
     std::vector<WMSlot> working_memory_;
     static constexpr int MAX_WM_SLOTS = 7;
     
+    // Consolidation: a pass starts every CONSOLIDATION_PERIOD_S and is
+    // spread over learning ticks in slices of CONSOLIDATION_SLICE units
+    static constexpr double CONSOLIDATION_PERIOD_S = 300.0;
+    static constexpr size_t CONSOLIDATION_SLICE = 256;
+    double last_consolidation_time_{0.0};
+    float consolidation_progress_{0.0f};       // Of the running pass, 0 when idle
+    
     // Stats
     uint64_t total_ticks_{0};
     double last_tick_time_{0.0};
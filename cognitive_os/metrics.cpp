@@ -46,7 +46,8 @@ void MetricsLogger::log(const SystemKPIs& kpis) {
     oss << "\"cpu\":" << kpis.cpu_usage << ",";
     oss << "\"gpu\":" << kpis.gpu_usage << ",";
     oss << "\"dropped\":" << kpis.dropped_msgs << ",";
-    oss << "\"services\":" << kpis.services_active;
+    oss << "\"services\":" << kpis.services_active << ",";
+    oss << "\"consolidation\":" << kpis.consolidation_progress;
     oss << "}\n";
     
     file_ << oss.str();
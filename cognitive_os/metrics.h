@@ -38,6 +38,7 @@ struct SystemKPIs {
     // Services
     int services_active;
     float avg_service_load;
+    float consolidation_progress;  // Of the running pass, 0 when idle
 };
 
 /**
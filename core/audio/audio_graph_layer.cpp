@@ -9,7 +9,9 @@
 #include <cmath>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <chrono>
+#include <filesystem>
 
 namespace melvin {
 namespace audio {
@@ -28,6 +30,16 @@ AudioGraphLayer::AudioGraphLayer()
     );
 }
 
+// ============================================================
+// FEATURE EXTRACTION
+// ============================================================
+
+std::vector<float> AudioGraphLayer::extract_mel_features(const std::vector<float>& audio) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    return mel_extractor_.average(audio);
+}
+
 // ============================================================
 // LEARNING FROM INPUT (Whisper)
 // ============================================================
@@ -75,6 +87,7 @@ void AudioGraphLayer::learn_from_speech_input(
     audio_node.timestamp_us = std::chrono::duration_cast<std::chrono::microseconds>(
         std::chrono::system_clock::now().time_since_epoch()
     ).count();
+    dirty_nodes_.insert(audio_node_id);
     
     // 4. Strengthen links to activated concepts
     for (uint64_t concept_id : activated_concept_ids) {
@@ -121,6 +134,7 @@ void AudioGraphLayer::learn_from_speech_output(
     }
     
     audio_node.co_activation_count++;
+    dirty_nodes_.insert(audio_node_id);
     
     // 4. Strengthen links (output associations are stronger)
     for (uint64_t concept_id : concept_ids_that_triggered_speech) {
@@ -146,6 +160,7 @@ void AudioGraphLayer::learn_phoneme_pattern(
     // Update phoneme pattern
     auto& pattern = phoneme_patterns_[phonemes];
     pattern.phoneme_sequence = phonemes;
+    dirty_patterns_.insert(phonemes);
     
     if (pattern.mel_template.empty()) {
         pattern.mel_template = mel_features;
@@ -323,6 +338,7 @@ uint64_t AudioGraphLayer::create_audio_node(
     node.co_activation_count = 0;
     
     audio_nodes_[node_id] = node;
+    dirty_nodes_.insert(node_id);
     
     return node_id;
 }
@@ -362,6 +378,9 @@ void AudioGraphLayer::strengthen_link(
     // Increase confidence with more co-activations
     audio_nodes_[audio_node_id].confidence = 
         std::min(1.0f, audio_nodes_[audio_node_id].confidence + 0.01f);
+    
+    dirty_nodes_.insert(audio_node_id);
+    dirty_concepts_.insert(concept_id);
 }
 
 void AudioGraphLayer::decay_weak_links() {
@@ -372,6 +391,7 @@ void AudioGraphLayer::decay_weak_links() {
         for (auto it = concept_map.begin(); it != concept_map.end(); ) {
             if (it->second < min_strength) {
                 it = concept_map.erase(it);
+                dirty_nodes_.insert(audio_id);
             } else {
                 ++it;
             }
@@ -522,6 +542,32 @@ AudioGraphLayer::DualOutput AudioGraphLayer::generate_dual_output(
     return output;
 }
 
+void AudioGraphLayer::speak_streaming(
+    const std::string& text,
+    const std::vector<float>& tts_audio,
+    const std::vector<uint64_t>& concept_ids,
+    HybridVocalGenerator::Mode mode
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    speech_stream_.speak(hybrid_generator_->plan_speech(text, tts_audio, concept_ids, mode));
+}
+
+size_t AudioGraphLayer::read_speech(float* out, size_t max_samples) {
+    // No graph lock: the stream's ring buffer is safe for its single reader
+    return speech_stream_.read(out, max_samples);
+}
+
+bool AudioGraphLayer::speech_done() {
+    return speech_stream_.done();
+}
+
+VocalConfiguration AudioGraphLayer::get_vocal_config(const std::vector<uint64_t>& concept_ids) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    return vocal_learner_.get_config_for_concepts(concept_ids);
+}
+
 bool AudioGraphLayer::can_speak_independently(
     const std::vector<uint64_t>& concept_ids,
     float confidence_threshold
@@ -619,33 +665,627 @@ void AudioGraphLayer::save_dual_output_for_analysis(
 }
 
 // ============================================================
-// PERSISTENCE (Placeholder)
+// PERSISTENCE
 // ============================================================
+//
+// Snapshot layout (version 1, native little-endian):
+//   header     SnapshotHeader (counts, counters, block offsets)
+//   nodes      node_count node records (mel rows live in the block below)
+//   concepts   concept_count concept → audio node lists
+//   patterns   pattern_count pattern records (templates in the block below)
+//   mel        64-byte aligned float[node_count][mel_dim], row i = node i
+//   templates  64-byte aligned float[pattern_count][mel_dim]
+// Rows are zero padded to mel_dim; each record keeps its true length, so
+// the float blocks can be mmap'd and indexed without parsing the records.
+//
+// Delta journal (<file>.delta), appended by save_incremental:
+//   repeated { magic, version, generation, payload_bytes, payload }
+// Each payload holds the counters plus full copies of changed nodes,
+// concept lists and patterns (mel inline). Records whose generation
+// doesn't match the snapshot are stale and skipped.
+
+namespace {
+
+constexpr uint32_t AUDIO_FILE_MAGIC = 0x4D415544;   // "MAUD"
+constexpr uint32_t AUDIO_DELTA_MAGIC = 0x4D414444;  // "MADD"
+constexpr uint32_t AUDIO_FILE_VERSION = 1;
+constexpr size_t BLOCK_ALIGNMENT = 64;
+constexpr uint32_t MAX_ARRAY_LENGTH = 1u << 26;   // Sanity bound for corrupt files
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t mel_dim;
+    uint32_t reserved;
+    uint64_t generation;
+    uint64_t next_audio_node_id;
+    uint64_t inputs_processed;
+    uint64_t outputs_processed;
+    uint64_t node_count;
+    uint64_t concept_count;
+    uint64_t pattern_count;
+    uint64_t mel_offset;
+    uint64_t template_offset;
+};
+static_assert(sizeof(SnapshotHeader) == 88, "SnapshotHeader must have no padding");
+
+struct DeltaHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t generation;
+    uint64_t payload_bytes;
+};
+
+template <typename T>
+void write_pod(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_pod(std::istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+void write_floats(std::ostream& out, const std::vector<float>& values) {
+    write_pod(out, static_cast<uint32_t>(values.size()));
+    out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+}
+
+bool read_floats(std::istream& in, std::vector<float>& values) {
+    uint32_t n = 0;
+    if (!read_pod(in, n) || n > MAX_ARRAY_LENGTH) return false;
+    values.resize(n);
+    in.read(reinterpret_cast<char*>(values.data()), n * sizeof(float));
+    return static_cast<bool>(in);
+}
+
+void write_ids(std::ostream& out, const std::vector<uint64_t>& ids) {
+    write_pod(out, static_cast<uint32_t>(ids.size()));
+    out.write(reinterpret_cast<const char*>(ids.data()), ids.size() * sizeof(uint64_t));
+}
+
+bool read_ids(std::istream& in, std::vector<uint64_t>& ids) {
+    uint32_t n = 0;
+    if (!read_pod(in, n) || n > MAX_ARRAY_LENGTH) return false;
+    ids.resize(n);
+    in.read(reinterpret_cast<char*>(ids.data()), n * sizeof(uint64_t));
+    return static_cast<bool>(in);
+}
+
+void write_string(std::ostream& out, const std::string& s) {
+    write_pod(out, static_cast<uint32_t>(s.size()));
+    out.write(s.data(), s.size());
+}
+
+bool read_string(std::istream& in, std::string& s) {
+    uint32_t n = 0;
+    if (!read_pod(in, n) || n > MAX_ARRAY_LENGTH) return false;
+    s.resize(n);
+    in.read(&s[0], n);
+    return static_cast<bool>(in);
+}
+
+void write_weights(std::ostream& out, const std::unordered_map<uint64_t, float>& weights) {
+    write_pod(out, static_cast<uint32_t>(weights.size()));
+    for (const auto& [id, w] : weights) {
+        write_pod(out, id);
+        write_pod(out, w);
+    }
+}
+
+bool read_weights(std::istream& in, std::unordered_map<uint64_t, float>& weights) {
+    uint32_t n = 0;
+    if (!read_pod(in, n) || n > MAX_ARRAY_LENGTH) return false;
+    weights.clear();
+    weights.reserve(n);
+    for (uint32_t i = 0; i < n; ++i) {
+        uint64_t id = 0;
+        float w = 0.0f;
+        if (!read_pod(in, id) || !read_pod(in, w)) return false;
+        weights[id] = w;
+    }
+    return true;
+}
+
+void pad_to_alignment(std::ostream& out) {
+    static const char zeros[BLOCK_ALIGNMENT] = {};
+    size_t pos = static_cast<size_t>(out.tellp());
+    size_t pad = (BLOCK_ALIGNMENT - pos % BLOCK_ALIGNMENT) % BLOCK_ALIGNMENT;
+    out.write(zeros, pad);
+}
+
+// A node with the association row and concept list that belong to it
+struct NodeRecord {
+    AudioNode node;
+    std::unordered_map<uint64_t, float> associations;
+    std::vector<uint64_t> concepts;
+    uint32_t mel_length = 0;
+};
+
+struct PatternRecord {
+    std::string key;
+    PhonemePattern pattern;
+    uint32_t template_length = 0;
+};
+
+void write_node_record(std::ostream& out, const NodeRecord& rec, bool inline_mel) {
+    const AudioNode& node = rec.node;
+    write_pod(out, node.node_id);
+    write_pod(out, static_cast<uint32_t>(node.type));
+    write_pod(out, node.duration_ms);
+    write_pod(out, node.pitch_mean);
+    write_pod(out, node.energy_mean);
+    write_pod(out, node.co_activation_count);
+    write_pod(out, node.confidence);
+    write_pod(out, node.timestamp_us);
+    if (inline_mel) {
+        write_floats(out, node.mel_features);
+    } else {
+        write_pod(out, static_cast<uint32_t>(node.mel_features.size()));
+    }
+    write_floats(out, node.audio_embedding);
+    write_string(out, node.phoneme_sequence);
+    write_weights(out, node.linked_concepts);
+    write_weights(out, rec.associations);
+    write_ids(out, rec.concepts);
+}
+
+bool read_node_record(std::istream& in, NodeRecord& rec, bool inline_mel) {
+    AudioNode& node = rec.node;
+    uint32_t type = 0;
+    if (!read_pod(in, node.node_id) || !read_pod(in, type) ||
+        !read_pod(in, node.duration_ms) || !read_pod(in, node.pitch_mean) ||
+        !read_pod(in, node.energy_mean) || !read_pod(in, node.co_activation_count) ||
+        !read_pod(in, node.confidence) || !read_pod(in, node.timestamp_us)) {
+        return false;
+    }
+    if (type > static_cast<uint32_t>(AudioNodeType::WHISPER_EMBEDDING)) {
+        return false;
+    }
+    node.type = static_cast<AudioNodeType>(type);
+
+    if (inline_mel) {
+        if (!read_floats(in, node.mel_features)) return false;
+        rec.mel_length = static_cast<uint32_t>(node.mel_features.size());
+    } else if (!read_pod(in, rec.mel_length)) {
+        return false;
+    }
+
+    return read_floats(in, node.audio_embedding) &&
+           read_string(in, node.phoneme_sequence) &&
+           read_weights(in, node.linked_concepts) &&
+           read_weights(in, rec.associations) &&
+           read_ids(in, rec.concepts);
+}
+
+void write_pattern_record(std::ostream& out, const std::string& key,
+                          const PhonemePattern& pattern, bool inline_template) {
+    write_string(out, key);
+    write_string(out, pattern.phoneme_sequence);
+    if (inline_template) {
+        write_floats(out, pattern.mel_template);
+    } else {
+        write_pod(out, static_cast<uint32_t>(pattern.mel_template.size()));
+    }
+    write_ids(out, pattern.word_concepts);
+    write_pod(out, pattern.confidence);
+}
+
+bool read_pattern_record(std::istream& in, PatternRecord& rec, bool inline_template) {
+    if (!read_string(in, rec.key) || !read_string(in, rec.pattern.phoneme_sequence)) {
+        return false;
+    }
+    if (inline_template) {
+        if (!read_floats(in, rec.pattern.mel_template)) return false;
+        rec.template_length = static_cast<uint32_t>(rec.pattern.mel_template.size());
+    } else if (!read_pod(in, rec.template_length)) {
+        return false;
+    }
+    return read_ids(in, rec.pattern.word_concepts) && read_pod(in, rec.pattern.confidence);
+}
+
+// Reads a float[rows][dim] block and hands each row's true-length prefix out
+template <typename Assign>
+bool read_float_block(std::istream& in, uint64_t offset, size_t rows, size_t dim, Assign&& assign) {
+    std::vector<float> block(rows * dim);
+    in.seekg(static_cast<std::streamoff>(offset));
+    in.read(reinterpret_cast<char*>(block.data()), block.size() * sizeof(float));
+    if (!in) return false;
+    for (size_t r = 0; r < rows; ++r) {
+        assign(r, block.data() + r * dim);
+    }
+    return true;
+}
+
+} // namespace
+
+void AudioGraphLayer::clear_dirty() {
+    dirty_nodes_.clear();
+    dirty_concepts_.clear();
+    dirty_patterns_.clear();
+}
+
+bool AudioGraphLayer::write_snapshot(const std::string& filepath) {
+    std::string temp_path = filepath + ".tmp";
+    uint64_t generation = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+    ).count();
+    generation = std::max(generation, snapshot_generation_ + 1);
+
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Failed to save audio graph to " << filepath << std::endl;
+            return false;
+        }
+
+        SnapshotHeader header = {};
+        header.magic = AUDIO_FILE_MAGIC;
+        header.version = AUDIO_FILE_VERSION;
+        header.generation = generation;
+        header.next_audio_node_id = next_audio_node_id_;
+        header.inputs_processed = inputs_processed_;
+        header.outputs_processed = outputs_processed_;
+        header.node_count = audio_nodes_.size();
+        header.concept_count = concept_to_audio_.size();
+        header.pattern_count = phoneme_patterns_.size();
+
+        for (const auto& [id, node] : audio_nodes_) {
+            header.mel_dim = std::max<uint32_t>(header.mel_dim, node.mel_features.size());
+        }
+        for (const auto& [key, pattern] : phoneme_patterns_) {
+            header.mel_dim = std::max<uint32_t>(header.mel_dim, pattern.mel_template.size());
+        }
+
+        write_pod(out, header);  // Rewritten once the block offsets are known
+
+        // Records (map iteration order is stable while the lock is held,
+        // so row i of the mel block matches the i-th node record)
+        NodeRecord rec;
+        for (const auto& [id, node] : audio_nodes_) {
+            rec.node = node;
+            auto assoc = association_matrix_.find(id);
+            rec.associations = (assoc != association_matrix_.end())
+                ? assoc->second : std::unordered_map<uint64_t, float>();
+            auto concepts = audio_to_concepts_.find(id);
+            rec.concepts = (concepts != audio_to_concepts_.end())
+                ? concepts->second : std::vector<uint64_t>();
+            write_node_record(out, rec, false);
+        }
+        for (const auto& [concept_id, audio_ids] : concept_to_audio_) {
+            write_pod(out, concept_id);
+            write_ids(out, audio_ids);
+        }
+        for (const auto& [key, pattern] : phoneme_patterns_) {
+            write_pattern_record(out, key, pattern, false);
+        }
+
+        // Fixed-stride float blocks
+        std::vector<float> row(header.mel_dim);
+        auto write_row = [&](const std::vector<float>& values) {
+            std::fill(row.begin(), row.end(), 0.0f);
+            std::copy(values.begin(), values.end(), row.begin());
+            out.write(reinterpret_cast<const char*>(row.data()), row.size() * sizeof(float));
+        };
+
+        pad_to_alignment(out);
+        header.mel_offset = static_cast<uint64_t>(out.tellp());
+        for (const auto& [id, node] : audio_nodes_) {
+            write_row(node.mel_features);
+        }
+
+        pad_to_alignment(out);
+        header.template_offset = static_cast<uint64_t>(out.tellp());
+        for (const auto& [key, pattern] : phoneme_patterns_) {
+            write_row(pattern.mel_template);
+        }
+
+        out.seekp(0);
+        write_pod(out, header);
+        if (!out) {
+            std::cerr << "Failed to save audio graph to " << filepath << std::endl;
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, filepath, ec);
+    if (ec) {
+        std::cerr << "Failed to save audio graph to " << filepath << ": " << ec.message() << std::endl;
+        return false;
+    }
+
+    // The snapshot now covers everything the journal held
+    std::filesystem::remove(filepath + ".delta", ec);
+
+    snapshot_generation_ = generation;
+    clear_dirty();
+    return true;
+}
 
-void AudioGraphLayer::save_to_file(const std::string& filepath) {
+bool AudioGraphLayer::save_to_file(const std::string& filepath) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    std::ofstream out(filepath, std::ios::binary);
+    if (!write_snapshot(filepath)) {
+        return false;
+    }
+    
+    std::cout << "Audio graph saved to " << filepath << " (" << audio_nodes_.size()
+              << " nodes, " << phoneme_patterns_.size() << " patterns)" << std::endl;
+    return true;
+}
+
+bool AudioGraphLayer::save_incremental(const std::string& filepath) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    std::error_code ec;
+    std::string delta_path = filepath + ".delta";
+    
+    // Start a new snapshot if this layer didn't write/load the one on disk,
+    // or compact once replaying the journal would cost more than a reload
+    if (snapshot_generation_ == 0 || !std::filesystem::exists(filepath, ec)) {
+        return write_snapshot(filepath);
+    }
+    if (std::filesystem::exists(delta_path, ec) &&
+        std::filesystem::file_size(delta_path, ec) > std::filesystem::file_size(filepath, ec)) {
+        return write_snapshot(filepath);
+    }
+    
+    std::ostringstream payload;
+    write_pod(payload, next_audio_node_id_);
+    write_pod(payload, static_cast<uint64_t>(inputs_processed_));
+    write_pod(payload, static_cast<uint64_t>(outputs_processed_));
+    
+    std::vector<uint64_t> node_ids;
+    for (uint64_t id : dirty_nodes_) {
+        if (audio_nodes_.count(id)) node_ids.push_back(id);
+    }
+    write_pod(payload, static_cast<uint64_t>(node_ids.size()));
+    NodeRecord rec;
+    for (uint64_t id : node_ids) {
+        rec.node = audio_nodes_[id];
+        auto assoc = association_matrix_.find(id);
+        rec.associations = (assoc != association_matrix_.end())
+            ? assoc->second : std::unordered_map<uint64_t, float>();
+        auto concepts = audio_to_concepts_.find(id);
+        rec.concepts = (concepts != audio_to_concepts_.end())
+            ? concepts->second : std::vector<uint64_t>();
+        write_node_record(payload, rec, true);
+    }
+    
+    write_pod(payload, static_cast<uint64_t>(dirty_concepts_.size()));
+    for (uint64_t concept_id : dirty_concepts_) {
+        auto it = concept_to_audio_.find(concept_id);
+        write_pod(payload, concept_id);
+        write_ids(payload, it != concept_to_audio_.end() ? it->second : std::vector<uint64_t>());
+    }
+    
+    std::vector<std::string> pattern_keys;
+    for (const auto& key : dirty_patterns_) {
+        if (phoneme_patterns_.count(key)) pattern_keys.push_back(key);
+    }
+    write_pod(payload, static_cast<uint64_t>(pattern_keys.size()));
+    for (const auto& key : pattern_keys) {
+        write_pattern_record(payload, key, phoneme_patterns_[key], true);
+    }
+    
+    std::string bytes = payload.str();
+    std::ofstream out(delta_path, std::ios::binary | std::ios::app);
     if (!out) {
-        std::cerr << "Failed to save audio graph to " << filepath << std::endl;
-        return;
+        std::cerr << "Failed to append audio graph delta to " << delta_path << std::endl;
+        return false;
+    }
+    DeltaHeader header = {AUDIO_DELTA_MAGIC, AUDIO_FILE_VERSION, snapshot_generation_, bytes.size()};
+    write_pod(out, header);
+    out.write(bytes.data(), bytes.size());
+    out.flush();
+    if (!out) {
+        std::cerr << "Failed to append audio graph delta to " << delta_path << std::endl;
+        return false;
     }
     
-    // TODO: Implement binary serialization
-    std::cout << "Audio graph saved to " << filepath << std::endl;
+    clear_dirty();
+    return true;
 }
 
-void AudioGraphLayer::load_from_file(const std::string& filepath) {
+bool AudioGraphLayer::load_from_file(const std::string& filepath) {
     std::lock_guard<std::mutex> lock(mutex_);
     
     std::ifstream in(filepath, std::ios::binary);
     if (!in) {
         std::cerr << "Failed to load audio graph from " << filepath << std::endl;
-        return;
+        return false;
     }
     
-    // TODO: Implement binary deserialization
-    std::cout << "Audio graph loaded from " << filepath << std::endl;
+    in.seekg(0, std::ios::end);
+    uint64_t file_size = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+    
+    auto fail = [&](const char* what) {
+        std::cerr << "Failed to load audio graph from " << filepath << ": " << what << std::endl;
+        return false;
+    };
+    
+    SnapshotHeader header;
+    if (!read_pod(in, header) || header.magic != AUDIO_FILE_MAGIC) {
+        return fail("not an audio graph file");
+    }
+    if (header.version != AUDIO_FILE_VERSION) {
+        return fail("unsupported version");
+    }
+    if (header.mel_dim > MAX_ARRAY_LENGTH || header.node_count > MAX_ARRAY_LENGTH ||
+        header.pattern_count > MAX_ARRAY_LENGTH || header.concept_count > MAX_ARRAY_LENGTH) {
+        return fail("corrupt header");
+    }
+    uint64_t row_bytes = static_cast<uint64_t>(header.mel_dim) * sizeof(float);
+    if (header.mel_offset > file_size || header.template_offset > file_size ||
+        header.mel_offset + header.node_count * row_bytes > file_size ||
+        header.template_offset + header.pattern_count * row_bytes > file_size) {
+        return fail("truncated");
+    }
+    
+    // Build into locals so a bad file leaves the live graph untouched
+    std::unordered_map<uint64_t, AudioNode> nodes;
+    std::unordered_map<uint64_t, std::unordered_map<uint64_t, float>> associations;
+    std::unordered_map<uint64_t, std::vector<uint64_t>> audio_to_concepts;
+    std::unordered_map<uint64_t, std::vector<uint64_t>> concept_to_audio;
+    std::unordered_map<std::string, PhonemePattern> patterns;
+    
+    std::vector<uint64_t> node_order;
+    std::vector<uint32_t> mel_lengths;
+    node_order.reserve(header.node_count);
+    mel_lengths.reserve(header.node_count);
+    nodes.reserve(header.node_count);
+    
+    NodeRecord rec;
+    for (uint64_t i = 0; i < header.node_count; ++i) {
+        if (!read_node_record(in, rec, false) || rec.mel_length > header.mel_dim) {
+            return fail("bad node record");
+        }
+        uint64_t id = rec.node.node_id;
+        node_order.push_back(id);
+        mel_lengths.push_back(rec.mel_length);
+        if (!rec.associations.empty()) associations[id] = std::move(rec.associations);
+        if (!rec.concepts.empty()) audio_to_concepts[id] = std::move(rec.concepts);
+        nodes[id] = std::move(rec.node);
+        rec = NodeRecord();
+    }
+    
+    for (uint64_t i = 0; i < header.concept_count; ++i) {
+        uint64_t concept_id = 0;
+        std::vector<uint64_t> ids;
+        if (!read_pod(in, concept_id) || !read_ids(in, ids)) {
+            return fail("bad concept list");
+        }
+        concept_to_audio[concept_id] = std::move(ids);
+    }
+    
+    std::vector<std::string> pattern_order;
+    std::vector<uint32_t> template_lengths;
+    for (uint64_t i = 0; i < header.pattern_count; ++i) {
+        PatternRecord prec;
+        if (!read_pattern_record(in, prec, false) || prec.template_length > header.mel_dim) {
+            return fail("bad pattern record");
+        }
+        pattern_order.push_back(prec.key);
+        template_lengths.push_back(prec.template_length);
+        patterns[prec.key] = std::move(prec.pattern);
+    }
+    
+    // Mel rows: one bulk read per block
+    bool blocks_ok =
+        read_float_block(in, header.mel_offset, node_order.size(), header.mel_dim,
+            [&](size_t r, const float* row) {
+                nodes[node_order[r]].mel_features.assign(row, row + mel_lengths[r]);
+            }) &&
+        read_float_block(in, header.template_offset, pattern_order.size(), header.mel_dim,
+            [&](size_t r, const float* row) {
+                patterns[pattern_order[r]].mel_template.assign(row, row + template_lengths[r]);
+            });
+    if (!blocks_ok) {
+        return fail("truncated mel block");
+    }
+    
+    uint64_t next_id = header.next_audio_node_id;
+    uint64_t inputs = header.inputs_processed;
+    uint64_t outputs = header.outputs_processed;
+    
+    // Replay the journal; stop at the first torn or corrupt record
+    size_t deltas_applied = 0;
+    std::string delta_path = filepath + ".delta";
+    std::ifstream journal(delta_path, std::ios::binary);
+    uint64_t journal_good = 0;  // Bytes up to the end of the last good record
+    DeltaHeader delta;
+    while (journal && read_pod(journal, delta)) {
+        if (delta.magic != AUDIO_DELTA_MAGIC || delta.version != AUDIO_FILE_VERSION ||
+            delta.payload_bytes > MAX_ARRAY_LENGTH * sizeof(float)) {
+            break;
+        }
+        std::string bytes(delta.payload_bytes, '\0');
+        if (!journal.read(&bytes[0], bytes.size())) {
+            break;
+        }
+        if (delta.generation != header.generation) {
+            journal_good += sizeof(DeltaHeader) + delta.payload_bytes;
+            continue;  // Left over from an older snapshot
+        }
+        
+        std::istringstream payload(bytes);
+        uint64_t d_next = 0, d_inputs = 0, d_outputs = 0, count = 0;
+        if (!read_pod(payload, d_next) || !read_pod(payload, d_inputs) ||
+            !read_pod(payload, d_outputs) || !read_pod(payload, count)) {
+            break;
+        }
+        
+        bool ok = true;
+        for (uint64_t i = 0; ok && i < count; ++i) {
+            NodeRecord drec;
+            ok = read_node_record(payload, drec, true);
+            if (!ok) break;
+            uint64_t id = drec.node.node_id;
+            if (drec.associations.empty()) associations.erase(id);
+            else associations[id] = std::move(drec.associations);
+            if (drec.concepts.empty()) audio_to_concepts.erase(id);
+            else audio_to_concepts[id] = std::move(drec.concepts);
+            nodes[id] = std::move(drec.node);
+        }
+        ok = ok && read_pod(payload, count);
+        for (uint64_t i = 0; ok && i < count; ++i) {
+            uint64_t concept_id = 0;
+            std::vector<uint64_t> ids;
+            ok = read_pod(payload, concept_id) && read_ids(payload, ids);
+            if (ok) concept_to_audio[concept_id] = std::move(ids);
+        }
+        ok = ok && read_pod(payload, count);
+        for (uint64_t i = 0; ok && i < count; ++i) {
+            PatternRecord prec;
+            ok = read_pattern_record(payload, prec, true);
+            if (ok) patterns[prec.key] = std::move(prec.pattern);
+        }
+        if (!ok) {
+            break;
+        }
+        
+        next_id = d_next;
+        inputs = d_inputs;
+        outputs = d_outputs;
+        deltas_applied++;
+        journal_good += sizeof(DeltaHeader) + delta.payload_bytes;
+    }
+    journal.close();
+    
+    audio_nodes_ = std::move(nodes);
+    association_matrix_ = std::move(associations);
+    audio_to_concepts_ = std::move(audio_to_concepts);
+    concept_to_audio_ = std::move(concept_to_audio);
+    phoneme_patterns_ = std::move(patterns);
+    next_audio_node_id_ = next_id;
+    inputs_processed_ = inputs;
+    outputs_processed_ = outputs;
+    snapshot_generation_ = header.generation;
+    clear_dirty();
+    
+    // Cut a torn or corrupt tail off the journal, so the next
+    // save_incremental() appends right after the last good record. If that
+    // fails, the next save writes a fresh snapshot instead.
+    std::error_code ec;
+    if (std::filesystem::exists(delta_path, ec) &&
+        std::filesystem::file_size(delta_path, ec) > journal_good) {
+        std::filesystem::resize_file(delta_path, journal_good, ec);
+        if (ec) {
+            std::cerr << "Failed to truncate " << delta_path << ": " << ec.message() << std::endl;
+            snapshot_generation_ = 0;
+        }
+    }
+    
+    std::cout << "Audio graph loaded from " << filepath << " (" << audio_nodes_.size()
+              << " nodes, " << phoneme_patterns_.size() << " patterns";
+    if (deltas_applied > 0) {
+        std::cout << ", " << deltas_applied << " deltas";
+    }
+    std::cout << ")" << std::endl;
+    return true;
 }
 
 } // namespace audio
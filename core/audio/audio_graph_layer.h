@@ -12,9 +12,12 @@
 
 #include "audio_node.h"
 #include "vocal_synthesis.h"
+#include "spectral.h"
+#include "speech_stream.h"
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <mutex>
 
@@ -26,6 +29,16 @@ public:
     AudioGraphLayer();
     ~AudioGraphLayer() = default;
     
+    // ============================================================
+    // FEATURE EXTRACTION
+    // ============================================================
+    
+    /**
+     * Time-averaged 80-bin log-mel features from 16 kHz audio
+     * (the mel_features expected by the learning calls below)
+     */
+    std::vector<float> extract_mel_features(const std::vector<float>& audio);
+    
     // ============================================================
     // LEARNING FROM INPUT (Whisper)
     // ============================================================
@@ -128,6 +141,34 @@ public:
         HybridVocalGenerator::Mode mode = HybridVocalGenerator::BALANCED
     );
     
+    /**
+     * Start speaking through the streaming pipeline, interrupting any
+     * utterance in progress. Audio is rendered block by block; pull it
+     * with read_speech().
+     */
+    void speak_streaming(
+        const std::string& text,
+        const std::vector<float>& tts_audio,
+        const std::vector<uint64_t>& concept_ids,
+        HybridVocalGenerator::Mode mode = HybridVocalGenerator::BALANCED
+    );
+    
+    /**
+     * Audio output thread: next rendered speech samples
+     * Never blocks; returns 0 when nothing is buffered yet.
+     */
+    size_t read_speech(float* out, size_t max_samples);
+    
+    /**
+     * true when the current utterance has been rendered and fully read
+     */
+    bool speech_done();
+    
+    /**
+     * Learned vocal configuration for a set of concepts
+     */
+    VocalConfiguration get_vocal_config(const std::vector<uint64_t>& concept_ids);
+    
     /**
      * DUAL OUTPUT: Generate both TTS and self-generated in parallel
      * Perfect for monitoring learning progress!
@@ -224,8 +265,26 @@ public:
     // PERSISTENCE
     // ============================================================
     
-    void save_to_file(const std::string& filepath);
-    void load_from_file(const std::string& filepath);
+    /**
+     * Write a full binary snapshot (versioned; layout documented in the .cpp)
+     * Goes through a temp file + rename and folds in the delta journal.
+     */
+    bool save_to_file(const std::string& filepath);
+    
+    /**
+     * Append only what changed since the last save to <filepath>.delta
+     * Falls back to a full snapshot when none exists yet or the journal
+     * has outgrown the snapshot.
+     */
+    bool save_incremental(const std::string& filepath);
+    
+    /**
+     * Load a snapshot and replay its delta journal
+     * A torn or corrupt journal tail is ignored and cut off the file, so
+     * later deltas are appended after the last good record; on failure the
+     * current state is left untouched.
+     */
+    bool load_from_file(const std::string& filepath);
     
 private:
     // ============================================================
@@ -258,10 +317,25 @@ private:
     VocalParameterLearner vocal_learner_;
     std::unique_ptr<HybridVocalGenerator> hybrid_generator_;
     
+    // Mel feature extraction (owns FFT scratch, guarded by mutex_)
+    MelSpectrogram mel_extractor_;
+    
+    // Streaming speech output (has its own producer thread and ring buffer)
+    SpeechStream speech_stream_;
+    
     // Dual output tracking
     std::vector<float> similarity_history_;  // Track similarity over time
     size_t conversation_count_;
     
+    // Changed since the last save (drives save_incremental)
+    std::unordered_set<uint64_t> dirty_nodes_;
+    std::unordered_set<uint64_t> dirty_concepts_;
+    std::unordered_set<std::string> dirty_patterns_;
+    uint64_t snapshot_generation_ = 0;  // Generation of the snapshot the journal extends
+    
+    void clear_dirty();
+    bool write_snapshot(const std::string& filepath);
+    
     // ============================================================
     // INTERNAL HELPER METHODS
     // ============================================================
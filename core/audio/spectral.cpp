@@ -0,0 +1,553 @@
+/**
+ * Spectral Analysis Implementation
+ */
+
+#include "spectral.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+
+// SSE is baseline on x86-64 and NEON on aarch64, so no extra flags are needed
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MELVIN_SPECTRAL_SSE 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MELVIN_SPECTRAL_NEON 1
+#endif
+
+namespace melvin {
+namespace audio {
+
+static constexpr double PI_D = 3.14159265358979323846;
+
+// ============================================================
+// REAL FFT
+// ============================================================
+
+size_t RealFFT::next_power_of_two(size_t n) {
+    size_t p = 1;
+    while (p < n) {
+        p <<= 1;
+    }
+    return p;
+}
+
+RealFFT::RealFFT(size_t size)
+    : n_(next_power_of_two(std::max<size_t>(size, 4))),
+      half_(n_ / 2) {
+
+    int bits = 0;
+    while ((size_t(1) << bits) < half_) {
+        bits++;
+    }
+    bit_reverse_.resize(half_);
+    for (size_t i = 0; i < half_; ++i) {
+        uint32_t r = 0;
+        for (int b = 0; b < bits; ++b) {
+            r |= ((i >> b) & 1u) << (bits - 1 - b);
+        }
+        bit_reverse_[i] = r;
+    }
+
+    // Stage with half-span m uses m twiddles starting at offset m-1
+    stage_twiddles_.resize(half_ > 1 ? half_ - 1 : 0);
+    for (size_t m = 1; m < half_; m <<= 1) {
+        for (size_t j = 0; j < m; ++j) {
+            double angle = -PI_D * static_cast<double>(j) / static_cast<double>(m);
+            stage_twiddles_[m - 1 + j] = {static_cast<float>(std::cos(angle)),
+                                          static_cast<float>(std::sin(angle))};
+        }
+    }
+
+    split_twiddles_.resize(half_);
+    for (size_t k = 0; k < half_; ++k) {
+        double angle = -2.0 * PI_D * static_cast<double>(k) / static_cast<double>(n_);
+        split_twiddles_[k] = {static_cast<float>(std::cos(angle)),
+                              static_cast<float>(std::sin(angle))};
+    }
+
+    work_.resize(half_);
+    bins_.resize(half_ + 1);
+}
+
+void RealFFT::transform(std::complex<float>* data) {
+    for (size_t i = 0; i < half_; ++i) {
+        size_t j = bit_reverse_[i];
+        if (i < j) {
+            std::swap(data[i], data[j]);
+        }
+    }
+
+    // std::complex layout is float[2]; spelling the butterflies out avoids
+    // the NaN-recovery path of operator* in non-fast-math builds
+    float* d = reinterpret_cast<float*>(data);
+    for (size_t m = 1; m < half_; m <<= 1) {
+        const float* w = reinterpret_cast<const float*>(&stage_twiddles_[m - 1]);
+        for (size_t k = 0; k < half_; k += 2 * m) {
+            float* a = d + 2 * k;
+            float* b = d + 2 * (k + m);
+            for (size_t j = 0; j < m; ++j) {
+                float wr = w[2 * j], wi = w[2 * j + 1];
+                float br = b[2 * j], bi = b[2 * j + 1];
+                float tr = wr * br - wi * bi;
+                float ti = wr * bi + wi * br;
+                float ar = a[2 * j], ai = a[2 * j + 1];
+                a[2 * j] = ar + tr;
+                a[2 * j + 1] = ai + ti;
+                b[2 * j] = ar - tr;
+                b[2 * j + 1] = ai - ti;
+            }
+        }
+    }
+}
+
+void RealFFT::forward(const float* input, std::complex<float>* spectrum) {
+    // Pack even/odd samples as real/imag of a half-size complex signal
+    for (size_t k = 0; k < half_; ++k) {
+        work_[k] = {input[2 * k], input[2 * k + 1]};
+    }
+    transform(work_.data());
+
+    float z0r = work_[0].real(), z0i = work_[0].imag();
+    spectrum[0] = {z0r + z0i, 0.0f};
+    spectrum[half_] = {z0r - z0i, 0.0f};
+
+    for (size_t k = 1; k < half_; ++k) {
+        float zr = work_[k].real(), zi = work_[k].imag();
+        float cr = work_[half_ - k].real(), ci = -work_[half_ - k].imag();
+
+        // Even part (Z[k] + conj Z[N/2-k]) / 2, odd part -i (Z[k] - conj Z[N/2-k]) / 2
+        float er = 0.5f * (zr + cr), ei = 0.5f * (zi + ci);
+        float orr = 0.5f * (zi - ci), oi = -0.5f * (zr - cr);
+
+        float wr = split_twiddles_[k].real(), wi = split_twiddles_[k].imag();
+        spectrum[k] = {er + wr * orr - wi * oi, ei + wr * oi + wi * orr};
+    }
+}
+
+void RealFFT::inverse(const std::complex<float>* spectrum, float* output) {
+    for (size_t k = 0; k < half_; ++k) {
+        float xr = spectrum[k].real(), xi = spectrum[k].imag();
+        float cr = spectrum[half_ - k].real(), ci = -spectrum[half_ - k].imag();
+
+        float er = 0.5f * (xr + cr), ei = 0.5f * (xi + ci);
+        float dr = 0.5f * (xr - cr), di = 0.5f * (xi - ci);
+
+        // Odd part = difference · conj(W^k)
+        float wr = split_twiddles_[k].real(), wi = -split_twiddles_[k].imag();
+        float orr = dr * wr - di * wi, oi = dr * wi + di * wr;
+
+        // Z = even + i·odd, conjugated so the forward transform inverts it
+        work_[k] = {er - oi, -(ei + orr)};
+    }
+    transform(work_.data());
+
+    float scale = 1.0f / static_cast<float>(half_);
+    for (size_t k = 0; k < half_; ++k) {
+        output[2 * k] = work_[k].real() * scale;
+        output[2 * k + 1] = -work_[k].imag() * scale;
+    }
+}
+
+void RealFFT::power_spectrum(const float* input, float* power) {
+    forward(input, bins_.data());
+    for (size_t k = 0; k <= half_; ++k) {
+        power[k] = std::norm(bins_[k]);
+    }
+}
+
+// ============================================================
+// AUTOCORRELATION
+// ============================================================
+
+void autocorrelation(const float* signal, size_t n, size_t max_lag, std::vector<float>& out) {
+    out.assign(max_lag + 1, 0.0f);
+    if (n == 0) {
+        return;
+    }
+
+    // Lags >= n are zero; padding to n + lag keeps the circular result linear
+    size_t lags = std::min(max_lag, n - 1);
+    RealFFT fft(n + lags + 1);
+
+    std::vector<float> padded(fft.size(), 0.0f);
+    std::memcpy(padded.data(), signal, n * sizeof(float));
+
+    std::vector<std::complex<float>> spectrum(fft.num_bins());
+    fft.forward(padded.data(), spectrum.data());
+    for (auto& bin : spectrum) {
+        bin = {std::norm(bin), 0.0f};
+    }
+    fft.inverse(spectrum.data(), padded.data());
+
+    std::copy(padded.begin(), padded.begin() + lags + 1, out.begin());
+}
+
+// ============================================================
+// MEL FILTERBANK
+// ============================================================
+
+float MelFilterbank::hz_to_mel(float hz) {
+    return 2595.0f * std::log10(1.0f + hz / 700.0f);
+}
+
+float MelFilterbank::mel_to_hz(float mel) {
+    return 700.0f * (std::pow(10.0f, mel / 2595.0f) - 1.0f);
+}
+
+MelFilterbank::MelFilterbank(int sample_rate, size_t fft_size, size_t num_mels,
+                             float min_hz, float max_hz)
+    : fft_size_(fft_size) {
+
+    float nyquist = 0.5f * static_cast<float>(sample_rate);
+    if (max_hz <= 0.0f || max_hz > nyquist) {
+        max_hz = nyquist;
+    }
+    min_hz = std::max(0.0f, std::min(min_hz, max_hz));
+
+    size_t num_bins = fft_size / 2 + 1;
+    float bin_hz = static_cast<float>(sample_rate) / static_cast<float>(fft_size);
+
+    // num_mels + 2 edges evenly spaced on the mel scale
+    float mel_lo = hz_to_mel(min_hz);
+    float mel_hi = hz_to_mel(max_hz);
+    std::vector<float> edges(num_mels + 2);
+    for (size_t i = 0; i < edges.size(); ++i) {
+        float mel = mel_lo + (mel_hi - mel_lo) * static_cast<float>(i) / static_cast<float>(num_mels + 1);
+        edges[i] = mel_to_hz(mel);
+    }
+
+    first_bin_.resize(num_mels);
+    offsets_.assign(1, 0);
+    for (size_t m = 0; m < num_mels; ++m) {
+        float left = edges[m], center = edges[m + 1], right = edges[m + 2];
+
+        size_t first = num_bins;
+        size_t start = weights_.size();
+        for (size_t k = 0; k < num_bins; ++k) {
+            float f = static_cast<float>(k) * bin_hz;
+            float rising = (f - left) / std::max(center - left, 1e-6f);
+            float falling = (right - f) / std::max(right - center, 1e-6f);
+            float w = std::min(rising, falling);
+            if (w <= 0.0f) {
+                if (first != num_bins) break;  // Past the triangle
+                continue;
+            }
+            if (first == num_bins) first = k;
+            weights_.push_back(w);
+        }
+
+        // Low filters can be narrower than one bin; give them the nearest bin
+        if (first == num_bins) {
+            first = std::min(num_bins - 1, static_cast<size_t>(std::lround(center / bin_hz)));
+            weights_.resize(start);
+            weights_.push_back(1.0f);
+        }
+
+        first_bin_[m] = first;
+        offsets_.push_back(weights_.size());
+    }
+}
+
+void MelFilterbank::apply(const float* power, float* mel) const {
+    for (size_t m = 0; m < first_bin_.size(); ++m) {
+        const float* p = power + first_bin_[m];
+        const float* w = weights_.data() + offsets_[m];
+        size_t count = offsets_[m + 1] - offsets_[m];
+
+        float sum = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            sum += w[i] * p[i];
+        }
+        mel[m] = sum;
+    }
+}
+
+// ============================================================
+// MEL SPECTROGRAM
+// ============================================================
+
+MelSpectrogram::MelSpectrogram() : MelSpectrogram(Config()) {
+}
+
+MelSpectrogram::MelSpectrogram(const Config& config)
+    : config_(config),
+      fft_(config.frame_size),
+      filterbank_(config.sample_rate, fft_.size(), config.num_mels) {
+
+    config_.hop_size = std::max<size_t>(1, config_.hop_size);
+
+    // Periodic Hann window over the frame; the FFT tail stays zero
+    window_.resize(config_.frame_size);
+    for (size_t i = 0; i < window_.size(); ++i) {
+        window_[i] = static_cast<float>(
+            0.5 - 0.5 * std::cos(2.0 * PI_D * static_cast<double>(i) / static_cast<double>(window_.size())));
+    }
+    frame_.assign(fft_.size(), 0.0f);
+    power_.resize(fft_.num_bins());
+}
+
+size_t MelSpectrogram::compute(const float* audio, size_t n, std::vector<float>& frames) {
+    size_t frame_size = config_.frame_size;
+    size_t num_frames = (n <= frame_size) ? 1 : 1 + (n - frame_size) / config_.hop_size;
+    size_t num_mels = filterbank_.num_mels();
+
+    frames.resize(num_frames * num_mels);
+    for (size_t f = 0; f < num_frames; ++f) {
+        size_t offset = f * config_.hop_size;
+        size_t available = std::min(frame_size, n - std::min(n, offset));
+
+        for (size_t i = 0; i < available; ++i) {
+            frame_[i] = audio[offset + i] * window_[i];
+        }
+        std::fill(frame_.begin() + available, frame_.end(), 0.0f);
+
+        fft_.power_spectrum(frame_.data(), power_.data());
+
+        float* mel = frames.data() + f * num_mels;
+        filterbank_.apply(power_.data(), mel);
+        for (size_t m = 0; m < num_mels; ++m) {
+            mel[m] = std::log10(std::max(mel[m], 1e-10f));
+        }
+    }
+
+    return num_frames;
+}
+
+std::vector<float> MelSpectrogram::average(const std::vector<float>& audio) {
+    if (audio.empty()) {
+        return {};
+    }
+
+    std::vector<float> frames;
+    size_t num_frames = compute(audio.data(), audio.size(), frames);
+    size_t num_mels = filterbank_.num_mels();
+
+    std::vector<float> mean(num_mels, 0.0f);
+    for (size_t f = 0; f < num_frames; ++f) {
+        const float* mel = frames.data() + f * num_mels;
+        for (size_t m = 0; m < num_mels; ++m) {
+            mean[m] += mel[m];
+        }
+    }
+    for (float& v : mean) {
+        v /= static_cast<float>(num_frames);
+    }
+    return mean;
+}
+
+// ============================================================
+// BIQUAD CASCADE
+// ============================================================
+
+Biquad Biquad::resonator(float frequency, float bandwidth, float gain, int sample_rate) {
+    const float pi = static_cast<float>(PI_D);
+    float r = std::exp(-pi * bandwidth / sample_rate);
+    float omega = 2.0f * pi * frequency / sample_rate;
+
+    Biquad q;
+    q.b0 = gain * (1.0f - r * r);
+    q.a1 = -2.0f * r * std::cos(omega);
+    q.a2 = r * r;
+    return q;
+}
+
+namespace {
+
+#if defined(MELVIN_SPECTRAL_SSE)
+using Lane4 = __m128;
+inline Lane4 load4(const float* p) { return _mm_load_ps(p); }
+inline void store4(float* p, Lane4 v) { _mm_store_ps(p, v); }
+inline Lane4 add4(Lane4 a, Lane4 b) { return _mm_add_ps(a, b); }
+inline Lane4 sub4(Lane4 a, Lane4 b) { return _mm_sub_ps(a, b); }
+inline Lane4 mul4(Lane4 a, Lane4 b) { return _mm_mul_ps(a, b); }
+inline Lane4 splat4(float x) { return _mm_set1_ps(x); }
+inline Lane4 select4(Lane4 mask, Lane4 a, Lane4 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+inline Lane4 mask4(const uint32_t* bits) {
+    return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(bits)));
+}
+// [carry.3, v.0, v.1, v.2]: each section takes the previous section's output
+inline Lane4 shift_in4(Lane4 v, Lane4 carry) {
+    return _mm_move_ss(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 1, 0, 0)),
+                       _mm_shuffle_ps(carry, carry, _MM_SHUFFLE(3, 3, 3, 3)));
+}
+inline float last4(Lane4 v) { return _mm_cvtss_f32(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3))); }
+#define MELVIN_SPECTRAL_SIMD 1
+#elif defined(MELVIN_SPECTRAL_NEON)
+using Lane4 = float32x4_t;
+inline Lane4 load4(const float* p) { return vld1q_f32(p); }
+inline void store4(float* p, Lane4 v) { vst1q_f32(p, v); }
+inline Lane4 add4(Lane4 a, Lane4 b) { return vaddq_f32(a, b); }
+inline Lane4 sub4(Lane4 a, Lane4 b) { return vsubq_f32(a, b); }
+inline Lane4 mul4(Lane4 a, Lane4 b) { return vmulq_f32(a, b); }
+inline Lane4 splat4(float x) { return vdupq_n_f32(x); }
+inline Lane4 select4(Lane4 mask, Lane4 a, Lane4 b) {
+    return vbslq_f32(vreinterpretq_u32_f32(mask), a, b);
+}
+inline Lane4 mask4(const uint32_t* bits) { return vreinterpretq_f32_u32(vld1q_u32(bits)); }
+inline Lane4 shift_in4(Lane4 v, Lane4 carry) { return vextq_f32(carry, v, 3); }
+inline float last4(Lane4 v) { return vgetq_lane_f32(v, 3); }
+#define MELVIN_SPECTRAL_SIMD 1
+#endif
+
+#if defined(MELVIN_SPECTRAL_SIMD)
+
+struct CascadeLanes {
+    float* b0; float* b1; float* b2; float* a1; float* a2;
+    float* x1; float* x2; float* y1; float* y2;
+};
+
+/**
+ * V vectors = 4V sections. At step t lane k filters sample t-k; lanes
+ * outside [0, n) during fill/drain are masked so their state holds.
+ */
+template <int V>
+void run_pipeline(const CascadeLanes& s, const float* in, float* out, size_t n) {
+    constexpr size_t L = 4 * V;
+
+    Lane4 b0[V], b1[V], b2[V], a1[V], a2[V], x1[V], x2[V], y1[V], y2[V], prev[V];
+    for (int v = 0; v < V; ++v) {
+        b0[v] = load4(s.b0 + 4 * v); b1[v] = load4(s.b1 + 4 * v); b2[v] = load4(s.b2 + 4 * v);
+        a1[v] = load4(s.a1 + 4 * v); a2[v] = load4(s.a2 + 4 * v);
+        x1[v] = load4(s.x1 + 4 * v); x2[v] = load4(s.x2 + 4 * v);
+        y1[v] = load4(s.y1 + 4 * v); y2[v] = load4(s.y2 + 4 * v);
+        prev[v] = splat4(0.0f);
+    }
+
+    auto step = [&](size_t t, auto masked) {
+        constexpr bool MASKED = decltype(masked)::value;
+        Lane4 x[V];
+        x[0] = shift_in4(prev[0], splat4(t < n ? in[t] : 0.0f));
+        for (int v = 1; v < V; ++v) {
+            x[v] = shift_in4(prev[v], prev[v - 1]);
+        }
+
+        alignas(16) uint32_t bits[L];
+        if (MASKED) {
+            for (size_t k = 0; k < L; ++k) {
+                bits[k] = (t >= k && t - k < n) ? 0xFFFFFFFFu : 0u;
+            }
+        }
+
+        for (int v = 0; v < V; ++v) {
+            Lane4 y = add4(add4(mul4(b0[v], x[v]), mul4(b1[v], x1[v])), mul4(b2[v], x2[v]));
+            y = sub4(sub4(y, mul4(a1[v], y1[v])), mul4(a2[v], y2[v]));
+
+            if (MASKED) {
+                Lane4 m = mask4(bits + 4 * v);
+                x2[v] = select4(m, x1[v], x2[v]);
+                x1[v] = select4(m, x[v], x1[v]);
+                y2[v] = select4(m, y1[v], y2[v]);
+                y1[v] = select4(m, y, y1[v]);
+                prev[v] = select4(m, y, prev[v]);
+            } else {
+                x2[v] = x1[v]; x1[v] = x[v];
+                y2[v] = y1[v]; y1[v] = y;
+                prev[v] = y;
+            }
+        }
+
+        if (t + 1 >= L) {
+            out[t + 1 - L] = last4(prev[V - 1]);
+        }
+    };
+
+    // Fill, steady state, drain; writes trail reads so in == out is safe
+    size_t steps = n + L - 1;
+    size_t steady_begin = L - 1;
+    size_t steady_end = std::max(steady_begin, n);
+    size_t t = 0;
+    for (; t < std::min(steady_begin, steps); ++t) step(t, std::true_type{});
+    for (; t < steady_end; ++t) step(t, std::false_type{});
+    for (; t < steps; ++t) step(t, std::true_type{});
+
+    for (int v = 0; v < V; ++v) {
+        store4(s.x1 + 4 * v, x1[v]); store4(s.x2 + 4 * v, x2[v]);
+        store4(s.y1 + 4 * v, y1[v]); store4(s.y2 + 4 * v, y2[v]);
+    }
+}
+
+#endif
+
+} // namespace
+
+BiquadCascade::BiquadCascade(const std::vector<Biquad>& sections) {
+    set_sections(sections);
+}
+
+void BiquadCascade::set_sections(const std::vector<Biquad>& sections) {
+    bool keep_state = sections.size() == sections_.size();
+    sections_ = sections;
+
+    // Unused lanes are pass-through sections
+    for (size_t k = 0; k < MAX_SIMD_SECTIONS; ++k) {
+        Biquad q = (k < sections_.size()) ? sections_[k] : Biquad();
+        b0_[k] = q.b0; b1_[k] = q.b1; b2_[k] = q.b2;
+        a1_[k] = q.a1; a2_[k] = q.a2;
+    }
+
+    if (!keep_state) {
+        reset();
+    }
+}
+
+void BiquadCascade::reset() {
+    std::fill(std::begin(x1_), std::end(x1_), 0.0f);
+    std::fill(std::begin(x2_), std::end(x2_), 0.0f);
+    std::fill(std::begin(y1_), std::end(y1_), 0.0f);
+    std::fill(std::begin(y2_), std::end(y2_), 0.0f);
+    scalar_state_.assign(4 * sections_.size(), 0.0f);
+}
+
+void BiquadCascade::process(const float* in, float* out, size_t n) {
+    if (n == 0) {
+        return;
+    }
+    if (sections_.empty()) {
+        if (out != in) std::memcpy(out, in, n * sizeof(float));
+        return;
+    }
+
+#if defined(MELVIN_SPECTRAL_SIMD)
+    CascadeLanes lanes{b0_, b1_, b2_, a1_, a2_, x1_, x2_, y1_, y2_};
+    if (sections_.size() <= 4) {
+        run_pipeline<1>(lanes, in, out, n);
+        return;
+    }
+    if (sections_.size() <= MAX_SIMD_SECTIONS) {
+        run_pipeline<2>(lanes, in, out, n);
+        return;
+    }
+#endif
+
+    process_scalar(in, out, n);
+}
+
+void BiquadCascade::process_scalar(const float* in, float* out, size_t n) {
+    if (out != in) {
+        std::memcpy(out, in, n * sizeof(float));
+    }
+
+    for (size_t s = 0; s < sections_.size(); ++s) {
+        const Biquad& q = sections_[s];
+        float* state = scalar_state_.data() + 4 * s;
+        float x1 = state[0], x2 = state[1], y1 = state[2], y2 = state[3];
+
+        for (size_t i = 0; i < n; ++i) {
+            float x = out[i];
+            float y = q.b0 * x + q.b1 * x1 + q.b2 * x2 - q.a1 * y1 - q.a2 * y2;
+            x2 = x1; x1 = x;
+            y2 = y1; y1 = y;
+            out[i] = y;
+        }
+
+        state[0] = x1; state[1] = x2; state[2] = y1; state[3] = y2;
+    }
+}
+
+} // namespace audio
+} // namespace melvin
@@ -0,0 +1,229 @@
+/**
+ * Spectral Analysis - FFT, autocorrelation, mel features, biquad filtering
+ *
+ * Small in-tree DSP kernels used by vocal synthesis and the audio graph:
+ * - RealFFT: radix-2 real transform (half-size complex FFT + split)
+ * - autocorrelation(): Wiener–Khinchin, O(N log N) instead of O(N·L)
+ * - MelFilterbank / MelSpectrogram: 80-bin log-mel features
+ * - BiquadCascade: serial biquads evaluated as a SIMD pipeline
+ */
+
+#pragma once
+
+#include <vector>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+namespace melvin {
+namespace audio {
+
+// ============================================================
+// REAL FFT
+// ============================================================
+
+/**
+ * Radix-2 FFT of a real signal of power-of-two length N
+ *
+ * Runs an N/2-point complex FFT on the interleaved even/odd samples and
+ * splits the result. Twiddles are precomputed once per size and stored
+ * stage by stage, so every butterfly pass reads its table sequentially.
+ *
+ * Sizes are rounded up to a power of two (minimum 4).
+ * Owns scratch space: use one instance per thread.
+ */
+class RealFFT {
+public:
+    explicit RealFFT(size_t size);
+
+    size_t size() const { return n_; }
+    size_t num_bins() const { return n_ / 2 + 1; }
+
+    /**
+     * N real samples → N/2+1 complex bins (unnormalized)
+     */
+    void forward(const float* input, std::complex<float>* spectrum);
+
+    /**
+     * N/2+1 complex bins → N real samples (scaled by 1/N, so inverse(forward(x)) == x)
+     */
+    void inverse(const std::complex<float>* spectrum, float* output);
+
+    /**
+     * |X[k]|^2 for k in [0, N/2]
+     */
+    void power_spectrum(const float* input, float* power);
+
+    static size_t next_power_of_two(size_t n);
+
+private:
+    size_t n_;
+    size_t half_;
+    std::vector<uint32_t> bit_reverse_;
+    std::vector<std::complex<float>> stage_twiddles_;  // e^{-iπj/m} for each stage m
+    std::vector<std::complex<float>> split_twiddles_;  // e^{-2πik/N}, k < N/2
+    std::vector<std::complex<float>> work_;
+    std::vector<std::complex<float>> bins_;
+
+    void transform(std::complex<float>* data);
+};
+
+// ============================================================
+// AUTOCORRELATION
+// ============================================================
+
+/**
+ * r[lag] = Σ x[i]·x[i+lag] for lag in [0, max_lag]
+ *
+ * Computed as IFFT(|FFT(x)|²) with enough zero padding that the circular
+ * correlation never wraps. out is resized to max_lag + 1.
+ */
+void autocorrelation(const float* signal, size_t n, size_t max_lag, std::vector<float>& out);
+
+// ============================================================
+// MEL FEATURES
+// ============================================================
+
+/**
+ * Triangular mel filters over a power spectrum (HTK mel scale)
+ * Filters are stored sparsely: only the non-zero span of each triangle.
+ */
+class MelFilterbank {
+public:
+    MelFilterbank(int sample_rate, size_t fft_size, size_t num_mels = 80,
+                  float min_hz = 0.0f, float max_hz = 0.0f);  // max_hz 0 = Nyquist
+
+    /**
+     * power: fft_size/2+1 bins → mel: num_mels energies
+     */
+    void apply(const float* power, float* mel) const;
+
+    size_t num_mels() const { return first_bin_.size(); }
+    size_t fft_size() const { return fft_size_; }
+
+    static float hz_to_mel(float hz);
+    static float mel_to_hz(float mel);
+
+private:
+    size_t fft_size_;
+    std::vector<size_t> first_bin_;    // Per filter: first non-zero bin
+    std::vector<size_t> offsets_;      // Per filter: start in weights_ (size num_mels+1)
+    std::vector<float> weights_;
+};
+
+/**
+ * Framed log-mel spectrogram (Hann window, 25 ms / 10 ms at 16 kHz)
+ * Owns FFT scratch: use one instance per thread.
+ */
+class MelSpectrogram {
+public:
+    struct Config {
+        int sample_rate = 16000;
+        size_t frame_size = 400;
+        size_t hop_size = 160;
+        size_t num_mels = 80;
+    };
+
+    MelSpectrogram();
+    explicit MelSpectrogram(const Config& config);
+
+    /**
+     * Row-major [num_frames × num_mels] log10 mel energies; returns num_frames
+     * Audio shorter than one frame is zero padded to a single frame.
+     */
+    size_t compute(const float* audio, size_t n, std::vector<float>& frames);
+
+    /**
+     * Time-averaged log-mel vector (the AudioNode::mel_features layout)
+     * Empty audio gives an empty vector.
+     */
+    std::vector<float> average(const std::vector<float>& audio);
+
+    const Config& config() const { return config_; }
+
+private:
+    Config config_;
+    RealFFT fft_;
+    MelFilterbank filterbank_;
+    std::vector<float> window_;
+    std::vector<float> frame_;
+    std::vector<float> power_;
+};
+
+// ============================================================
+// BIQUAD CASCADE
+// ============================================================
+
+/**
+ * Direct form I biquad:
+ *   y[n] = b0·x[n] + b1·x[n-1] + b2·x[n-2] - a1·y[n-1] - a2·y[n-2]
+ */
+struct Biquad {
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f;
+    float a1 = 0.0f, a2 = 0.0f;
+
+    /**
+     * Two-pole formant resonator (the classic r = e^{-π·bw/sr} design)
+     */
+    static Biquad resonator(float frequency, float bandwidth, float gain, int sample_rate);
+};
+
+/**
+ * Biquads applied in series, with state kept across process() calls
+ *
+ * Serial IIR sections can't be vectorized over time, so the cascade is
+ * vectorized over sections instead: SIMD lane k runs section k one sample
+ * behind lane k-1, and every step advances all sections at once. The
+ * pipeline is filled and drained inside each call, so output is sample
+ * exact with no added latency and blocks can be any size.
+ *
+ * Up to 8 sections use the SIMD path; longer cascades (or builds without
+ * SSE2/NEON) run section by section.
+ */
+class BiquadCascade {
+public:
+    static constexpr size_t MAX_SIMD_SECTIONS = 8;
+
+    BiquadCascade() = default;
+    explicit BiquadCascade(const std::vector<Biquad>& sections);
+
+    /**
+     * Replace coefficients; filter state is kept when the section count
+     * is unchanged (smooth parameter changes while streaming)
+     */
+    void set_sections(const std::vector<Biquad>& sections);
+
+    /**
+     * Clear filter memory
+     */
+    void reset();
+
+    /**
+     * Filter n samples; in and out may alias
+     */
+    void process(const float* in, float* out, size_t n);
+
+    size_t num_sections() const { return sections_.size(); }
+
+private:
+    std::vector<Biquad> sections_;
+
+    // Per-lane state in structure-of-arrays form (padded to MAX_SIMD_SECTIONS)
+    alignas(16) float b0_[MAX_SIMD_SECTIONS] = {};
+    alignas(16) float b1_[MAX_SIMD_SECTIONS] = {};
+    alignas(16) float b2_[MAX_SIMD_SECTIONS] = {};
+    alignas(16) float a1_[MAX_SIMD_SECTIONS] = {};
+    alignas(16) float a2_[MAX_SIMD_SECTIONS] = {};
+    alignas(16) float x1_[MAX_SIMD_SECTIONS] = {};
+    alignas(16) float x2_[MAX_SIMD_SECTIONS] = {};
+    alignas(16) float y1_[MAX_SIMD_SECTIONS] = {};
+    alignas(16) float y2_[MAX_SIMD_SECTIONS] = {};
+
+    // State for cascades too long for the SIMD path
+    std::vector<float> scalar_state_;  // 4 per section: x1, x2, y1, y2
+
+    void process_scalar(const float* in, float* out, size_t n);
+};
+
+} // namespace audio
+} // namespace melvin
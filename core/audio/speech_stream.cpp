@@ -0,0 +1,323 @@
+/**
+ * Speech Stream Implementation
+ */
+
+#include "speech_stream.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+namespace melvin {
+namespace audio {
+
+// ============================================================
+// RING BUFFER
+// ============================================================
+
+AudioRingBuffer::AudioRingBuffer(size_t capacity) {
+    size_t size = 1;
+    while (size < std::max<size_t>(capacity, 2)) {
+        size <<= 1;
+    }
+    buffer_.assign(size, 0.0f);
+    mask_ = size - 1;
+}
+
+size_t AudioRingBuffer::write(const float* samples, size_t n) {
+    uint64_t write = write_pos_.load(std::memory_order_relaxed);
+    uint64_t read = read_pos_.load(std::memory_order_acquire);
+    n = std::min<size_t>(n, buffer_.size() - static_cast<size_t>(write - read));
+    if (n == 0) {
+        return 0;
+    }
+
+    // At most two copies: up to the end of storage, then from the start
+    size_t start = static_cast<size_t>(write & mask_);
+    size_t first = std::min(n, buffer_.size() - start);
+    std::memcpy(buffer_.data() + start, samples, first * sizeof(float));
+    std::memcpy(buffer_.data(), samples + first, (n - first) * sizeof(float));
+
+    write_pos_.store(write + n, std::memory_order_release);
+    return n;
+}
+
+size_t AudioRingBuffer::read(float* out, size_t n) {
+    uint64_t read = read_pos_.load(std::memory_order_relaxed);
+    uint64_t write = write_pos_.load(std::memory_order_acquire);
+    n = std::min<size_t>(n, static_cast<size_t>(write - read));
+    if (n == 0) {
+        return 0;
+    }
+
+    size_t start = static_cast<size_t>(read & mask_);
+    size_t first = std::min(n, buffer_.size() - start);
+    std::memcpy(out, buffer_.data() + start, first * sizeof(float));
+    std::memcpy(out + first, buffer_.data(), (n - first) * sizeof(float));
+
+    read_pos_.store(read + n, std::memory_order_release);
+    return n;
+}
+
+void AudioRingBuffer::discard_until(uint64_t position) {
+    uint64_t read = read_pos_.load(std::memory_order_relaxed);
+    if (read < position) {
+        read_pos_.store(position, std::memory_order_release);
+    }
+}
+
+size_t AudioRingBuffer::available() const {
+    return static_cast<size_t>(write_pos_.load(std::memory_order_acquire) -
+                               read_pos_.load(std::memory_order_acquire));
+}
+
+size_t AudioRingBuffer::free_space() const {
+    return buffer_.size() - available();
+}
+
+// ============================================================
+// STREAMING SYNTHESIZER
+// ============================================================
+
+StreamingSynthesizer::StreamingSynthesizer(int sample_rate)
+    : sample_rate_(sample_rate), noise_rng_(NOISE_SEED) {
+    segment_starts_.assign(1, 0);
+}
+
+void StreamingSynthesizer::start(SpeechPlan plan) {
+    plan_ = std::move(plan);
+
+    segment_starts_.assign(1, 0);
+    for (const auto& config : plan_.segments) {
+        size_t samples = static_cast<size_t>(std::max(0.0f, config.duration_ms) * sample_rate_ / 1000.0f);
+        segment_starts_.push_back(segment_starts_.back() + samples);
+    }
+
+    // Same length rules as HybridVocalGenerator::blend_audio
+    size_t synth_samples = segment_starts_.back();
+    if (plan_.blend_weight >= 1.0f) {
+        total_samples_ = plan_.blend_audio.size();
+    } else if (plan_.blend_weight > 0.0f) {
+        total_samples_ = std::min(synth_samples, plan_.blend_audio.size());
+    } else {
+        total_samples_ = synth_samples;
+    }
+
+    transition_samples_ = static_cast<size_t>(std::max(0.0f, plan_.transition_ms) * sample_rate_ / 1000.0f);
+    position_ = 0;
+    segment_ = 0;
+
+    glottal_phase_ = 0.0f;
+    lip_prev_in_ = 0.0f;
+    lip_prev_out_ = 0.0f;
+    noise_rng_.seed(NOISE_SEED);  // Same utterance, same samples
+    sections_.clear();
+    formant_filter_.set_sections(sections_);
+    formant_filter_.reset();
+}
+
+size_t StreamingSynthesizer::render(float* out, size_t n) {
+    size_t produced = 0;
+
+    while (produced < n && position_ < total_samples_) {
+        // Control updates sit on a fixed grid, so output doesn't depend on block size
+        size_t to_grid = CONTROL_INTERVAL - position_ % CONTROL_INTERVAL;
+        size_t chunk = std::min({to_grid, n - produced, total_samples_ - position_});
+
+        // TTS-only output can run past the segments; nothing to clamp to then
+        if (plan_.blend_weight < 1.0f && position_ < segment_starts_.back()) {
+            while (segment_ + 1 < plan_.segments.size() && position_ >= segment_starts_[segment_ + 1]) {
+                segment_++;
+            }
+            // Parameters change at segment boundaries, so chunks never straddle one
+            chunk = std::min(chunk, segment_starts_[segment_ + 1] - position_);
+        }
+
+        render_chunk(out + produced, chunk);
+        produced += chunk;
+        position_ += chunk;
+    }
+
+    return produced;
+}
+
+void StreamingSynthesizer::render_chunk(float* out, size_t n) {
+    float tts_weight = plan_.blend_weight;
+    const float* tts = plan_.blend_audio.data() + position_;
+    if (tts_weight >= 1.0f) {
+        std::memcpy(out, tts, n * sizeof(float));
+        return;
+    }
+
+    // Parameters for this chunk, gliding into the next segment near the end
+    const VocalConfiguration& current = plan_.segments[segment_];
+    const VocalConfiguration* next =
+        (segment_ + 1 < plan_.segments.size()) ? &plan_.segments[segment_ + 1] : nullptr;
+
+    // Evaluated at the control point this chunk belongs to
+    size_t control = std::max<size_t>(position_ - position_ % CONTROL_INTERVAL, segment_starts_[segment_]);
+    size_t segment_end = segment_starts_[segment_ + 1];
+    float t = 0.0f;
+    if (next && transition_samples_ > 0 && control + transition_samples_ > segment_end) {
+        t = 1.0f - static_cast<float>(segment_end - control) / static_cast<float>(transition_samples_);
+    }
+    auto lerp = [t](float a, float b) { return a * (1.0f - t) + b * t; };
+
+    float f0 = next ? lerp(current.f0, next->f0) : current.f0;
+    float open_quotient = next ? lerp(current.open_quotient, next->open_quotient) : current.open_quotient;
+    float voicing = next ? lerp(current.voicing_strength, next->voicing_strength) : current.voicing_strength;
+    float aspiration = next ? lerp(current.aspiration_level, next->aspiration_level) : current.aspiration_level;
+    float amplitude = next ? lerp(current.amplitude, next->amplitude) : current.amplitude;
+
+    size_t num_formants = (t > 0.0f) ? std::min(current.formants.size(), next->formants.size())
+                                     : current.formants.size();
+    sections_.resize(num_formants);
+    for (size_t i = 0; i < num_formants; ++i) {
+        const Formant& a = current.formants[i];
+        const Formant& b = (t > 0.0f) ? next->formants[i] : a;
+        sections_[i] = Biquad::resonator(lerp(a.frequency, b.frequency), lerp(a.bandwidth, b.bandwidth),
+                                         lerp(a.amplitude, b.amplitude), sample_rate_);
+    }
+    formant_filter_.set_sections(sections_);  // Keeps filter memory
+
+    // Glottal source with a phase accumulator, so pitch periods run on
+    // across chunk and phoneme boundaries
+    std::uniform_real_distribution<float> noise(-1.0f, 1.0f);
+    if (f0 <= 0.0f) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = noise(noise_rng_);
+        }
+    } else {
+        float phase_step = f0 / static_cast<float>(sample_rate_);
+        for (size_t i = 0; i < n; ++i) {
+            float glottal = VocalSynthesizer::glottal_shape(glottal_phase_, open_quotient);
+            out[i] = voicing * glottal + aspiration * noise(noise_rng_) * 0.3f;
+            glottal_phase_ += phase_step;
+            glottal_phase_ -= std::floor(glottal_phase_);
+        }
+    }
+
+    formant_filter_.process(out, out, n);
+
+    // Lip radiation (first-order high-pass) and amplitude
+    const float alpha = 0.95f;
+    for (size_t i = 0; i < n; ++i) {
+        float x = out[i];
+        lip_prev_out_ = alpha * (lip_prev_out_ + x - lip_prev_in_);
+        lip_prev_in_ = x;
+        out[i] = lip_prev_out_ * amplitude;
+    }
+
+    if (tts_weight > 0.0f) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = tts_weight * tts[i] + (1.0f - tts_weight) * out[i];
+        }
+    }
+}
+
+// ============================================================
+// SPEECH STREAM
+// ============================================================
+
+SpeechStream::SpeechStream(int sample_rate, size_t block_size, size_t ring_capacity)
+    : block_size_(std::max<size_t>(1, block_size)),
+      ring_(std::max(ring_capacity, 2 * block_size)),
+      synth_(sample_rate) {
+}
+
+SpeechStream::~SpeechStream() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (producer_.joinable()) {
+        producer_.join();
+    }
+}
+
+void SpeechStream::speak(SpeechPlan plan) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = std::move(plan);
+        has_pending_ = true;
+        requested_generation_.fetch_add(1, std::memory_order_release);
+        rendering_.store(true, std::memory_order_release);
+        if (!producer_.joinable()) {
+            producer_ = std::thread(&SpeechStream::producer_loop, this);
+        }
+    }
+    wake_.notify_all();
+}
+
+size_t SpeechStream::read(float* out, size_t n) {
+    // Until the producer has picked up the latest speak(), whatever is in
+    // the ring belongs to the interrupted utterance
+    if (!flush_stale()) {
+        return 0;
+    }
+    return ring_.read(out, n);
+}
+
+bool SpeechStream::done() {
+    return flush_stale() && !rendering_.load(std::memory_order_acquire) && ring_.available() == 0;
+}
+
+bool SpeechStream::flush_stale() {
+    uint64_t requested = requested_generation_.load(std::memory_order_acquire);
+    if (started_generation_.load(std::memory_order_acquire) != requested) {
+        return false;
+    }
+    ring_.discard_until(flush_position_.load(std::memory_order_acquire));
+    return true;
+}
+
+void SpeechStream::producer_loop() {
+    std::vector<float> block(block_size_);
+    size_t block_fill = 0;     // Rendered samples in block
+    size_t block_written = 0;  // ...of which already in the ring
+
+    // When the ring is full, wait about a quarter block for the consumer
+    auto backoff = std::chrono::microseconds(
+        std::max<int64_t>(100, static_cast<int64_t>(250000.0 * block_size_ / synth_.sample_rate())));
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (!has_pending_ && synth_.finished() && block_written == block_fill) {
+                rendering_.store(false, std::memory_order_release);
+                wake_.wait(lock, [&] { return stop_ || has_pending_; });
+            }
+            if (stop_) {
+                return;
+            }
+            if (has_pending_) {
+                synth_.start(std::move(pending_));
+                has_pending_ = false;
+                block_fill = block_written = 0;
+                // Everything already in the ring belongs to the interrupted utterance
+                flush_position_.store(ring_.write_position(), std::memory_order_release);
+                started_generation_.store(requested_generation_.load(std::memory_order_relaxed),
+                                          std::memory_order_release);
+            }
+        }
+
+        if (block_written == block_fill) {
+            block_fill = synth_.render(block.data(), block_size_);
+            block_written = 0;
+            if (block_fill == 0) {
+                continue;
+            }
+        }
+
+        block_written += ring_.write(block.data() + block_written, block_fill - block_written);
+
+        if (block_written < block_fill) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait_for(lock, backoff, [&] { return stop_ || has_pending_; });
+        }
+    }
+}
+
+} // namespace audio
+} // namespace melvin
@@ -0,0 +1,194 @@
+/**
+ * Speech Stream - Block-based streaming vocal synthesis
+ *
+ * Instead of rendering a whole utterance before playback, speech is
+ * rendered in fixed-size blocks by a producer thread into a lock-free
+ * ring buffer that the audio output thread drains:
+ *
+ *   speak() → StreamingSynthesizer (256-sample blocks) → AudioRingBuffer → read()
+ *
+ * All synthesis state (glottal phase, formant filter memory, lip radiation,
+ * position within the phoneme and its transition) carries across blocks,
+ * so block boundaries are inaudible and the first block is ready after
+ * ~one block of work rather than one utterance.
+ */
+
+#pragma once
+
+#include "vocal_synthesis.h"
+#include "spectral.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace melvin {
+namespace audio {
+
+// ============================================================
+// RING BUFFER
+// ============================================================
+
+/**
+ * Single-producer / single-consumer float ring buffer
+ *
+ * Wait-free on both sides: the producer only stores the write index and
+ * the consumer only stores the read index (monotonic 64-bit counters, so
+ * there is no wrap ambiguity). Capacity is rounded up to a power of two.
+ */
+class AudioRingBuffer {
+public:
+    explicit AudioRingBuffer(size_t capacity = 8192);
+
+    /**
+     * Producer: copy up to n samples in; returns how many fit
+     */
+    size_t write(const float* samples, size_t n);
+
+    /**
+     * Consumer: copy up to n samples out; returns how many were available
+     */
+    size_t read(float* out, size_t n);
+
+    /**
+     * Consumer: drop everything written before write position `position`
+     */
+    void discard_until(uint64_t position);
+
+    size_t available() const;      // Readable samples
+    size_t free_space() const;     // Writable samples
+    size_t capacity() const { return buffer_.size(); }
+    uint64_t write_position() const { return write_pos_.load(std::memory_order_acquire); }
+
+private:
+    std::vector<float> buffer_;
+    size_t mask_;
+    alignas(64) std::atomic<uint64_t> write_pos_{0};
+    alignas(64) std::atomic<uint64_t> read_pos_{0};
+};
+
+// ============================================================
+// STREAMING SYNTHESIZER
+// ============================================================
+
+/**
+ * Renders an utterance incrementally, any number of samples at a time
+ *
+ * Segments (one VocalConfiguration per phoneme) play back to back; the last
+ * transition_ms of each segment glides toward the next one. Parameters are
+ * updated every CONTROL_INTERVAL samples on a fixed grid, so the output is
+ * identical whatever block sizes render() is called with. A plan's TTS
+ * audio is mixed in the way HybridVocalGenerator::blend_audio does.
+ *
+ * Not thread-safe: owned by one rendering thread.
+ */
+class StreamingSynthesizer {
+public:
+    static constexpr size_t CONTROL_INTERVAL = 64;
+    static constexpr uint32_t NOISE_SEED = 0x5eed;  // Reseeded per utterance
+
+    explicit StreamingSynthesizer(int sample_rate = 16000);
+
+    /**
+     * Start a new utterance (resets all synthesis state)
+     */
+    void start(SpeechPlan plan);
+
+    /**
+     * Render up to n samples; returns fewer only at the end of the utterance
+     */
+    size_t render(float* out, size_t n);
+
+    bool finished() const { return position_ >= total_samples_; }
+    size_t total_samples() const { return total_samples_; }
+    size_t position() const { return position_; }
+    int sample_rate() const { return sample_rate_; }
+
+private:
+    int sample_rate_;
+    SpeechPlan plan_;
+    std::vector<size_t> segment_starts_;   // Sample offset of each segment (+ end)
+    size_t total_samples_ = 0;
+    size_t position_ = 0;
+    size_t segment_ = 0;
+    size_t transition_samples_ = 0;
+
+    // State carried across blocks
+    float glottal_phase_ = 0.0f;
+    float lip_prev_in_ = 0.0f;
+    float lip_prev_out_ = 0.0f;
+    BiquadCascade formant_filter_;
+    std::vector<Biquad> sections_;
+    std::mt19937 noise_rng_;
+
+    void render_chunk(float* out, size_t n);
+};
+
+// ============================================================
+// SPEECH STREAM
+// ============================================================
+
+/**
+ * Producer thread + ring buffer around a StreamingSynthesizer
+ *
+ * speak() may be called from any thread and interrupts the current
+ * utterance; read() and done() belong to the audio output thread, and
+ * read() never blocks or allocates. The producer thread starts on the
+ * first speak().
+ */
+class SpeechStream {
+public:
+    explicit SpeechStream(int sample_rate = 16000, size_t block_size = 256,
+                          size_t ring_capacity = 8192);
+    ~SpeechStream();
+
+    SpeechStream(const SpeechStream&) = delete;
+    SpeechStream& operator=(const SpeechStream&) = delete;
+
+    /**
+     * Replace whatever is playing with a new utterance
+     */
+    void speak(SpeechPlan plan);
+
+    /**
+     * Output thread: pull up to n samples (0 when nothing is ready)
+     */
+    size_t read(float* out, size_t n);
+
+    /**
+     * Output thread: true when the utterance is fully rendered and drained
+     */
+    bool done();
+
+    /**
+     * Samples rendered and not yet read
+     */
+    size_t buffered() const { return ring_.available(); }
+
+    size_t block_size() const { return block_size_; }
+
+private:
+    size_t block_size_;
+    AudioRingBuffer ring_;
+    StreamingSynthesizer synth_;           // Owned by the producer thread
+
+    std::thread producer_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    bool has_pending_ = false;
+    SpeechPlan pending_;
+    std::atomic<bool> rendering_{false};
+    std::atomic<uint64_t> flush_position_{0};
+    std::atomic<uint64_t> requested_generation_{0};  // Bumped by speak()
+    std::atomic<uint64_t> started_generation_{0};    // Set once flush_position_ covers it
+
+    void producer_loop();
+    bool flush_stale();  // Drop interrupted audio; false while a speak() is not yet picked up
+};
+
+} // namespace audio
+} // namespace melvin
@@ -5,6 +5,7 @@
  */
 
 #include "vocal_synthesis.h"
+#include "spectral.h"
 #include <cmath>
 #include <algorithm>
 #include <random>
@@ -191,6 +192,22 @@ std::vector<float> VocalSynthesizer::synthesize_phonemes(
 ) {
     std::vector<float> result;
     
+    for (const auto& config : plan_phonemes(phonemes, pitch_contour, durations_ms).segments) {
+        auto audio = synthesize(config);
+        result.insert(result.end(), audio.begin(), audio.end());
+    }
+    
+    return result;
+}
+
+SpeechPlan VocalSynthesizer::plan_phonemes(
+    const std::vector<std::string>& phonemes,
+    const std::vector<float>& pitch_contour,
+    const std::vector<float>& durations_ms
+) {
+    SpeechPlan plan;
+    plan.segments.reserve(phonemes.size());
+    
     for (size_t i = 0; i < phonemes.size(); ++i) {
         VocalConfiguration config = VocalConfiguration::for_phoneme(phonemes[i]);
         
@@ -201,11 +218,19 @@ std::vector<float> VocalSynthesizer::synthesize_phonemes(
             config.duration_ms = durations_ms[i];
         }
         
-        auto audio = synthesize(config);
-        result.insert(result.end(), audio.begin(), audio.end());
+        plan.segments.push_back(config);
     }
     
-    return result;
+    return plan;
+}
+
+SpeechPlan VocalSynthesizer::plan_text(const std::string& text, float base_pitch) {
+    auto phonemes = text_to_phonemes(text);
+    
+    std::vector<float> pitch_contour(phonemes.size(), base_pitch);
+    std::vector<float> durations(phonemes.size(), 80.0f);
+    
+    return plan_phonemes(phonemes, pitch_contour, durations);
 }
 
 std::vector<float> VocalSynthesizer::synthesize_with_transitions(
@@ -255,6 +280,17 @@ std::vector<float> VocalSynthesizer::synthesize_text(
     return synthesize_phonemes(phonemes, pitch_contour, durations);
 }
 
+float VocalSynthesizer::glottal_shape(float phase, float open_quotient) {
+    // Simplified glottal pulse (Rosenberg model)
+    if (phase < open_quotient) {
+        // Opening phase
+        return 0.5f * (1.0f - std::cos(PI * phase / open_quotient));
+    }
+    // Closing phase (sharp closure)
+    float t = (phase - open_quotient) / (1.0f - open_quotient);
+    return 0.5f * (1.0f + std::cos(PI * t));
+}
+
 // ============================================================
 // PRIVATE METHODS
 // ============================================================
@@ -277,17 +313,7 @@ std::vector<float> VocalSynthesizer::generate_glottal_pulse(
     
     for (int i = 0; i < num_samples; ++i) {
         float phase = std::fmod(i, period_samples) / period_samples;
-        
-        // Simplified glottal pulse (Rosenberg model)
-        float glottal_value = 0.0f;
-        if (phase < open_quotient) {
-            // Opening phase
-            glottal_value = 0.5f * (1.0f - std::cos(PI * phase / open_quotient));
-        } else {
-            // Closing phase (sharp closure)
-            float t = (phase - open_quotient) / (1.0f - open_quotient);
-            glottal_value = 0.5f * (1.0f + std::cos(PI * t));
-        }
+        float glottal_value = glottal_shape(phase, open_quotient);
         
         // Mix voiced and noise components
         float noise = (static_cast<float>(rand()) / RAND_MAX) * 2.0f - 1.0f;
@@ -301,27 +327,19 @@ std::vector<float> VocalSynthesizer::apply_formants(
     const std::vector<float>& source,
     const std::vector<Formant>& formants
 ) {
-    std::vector<float> result = source;
-    
-    // Apply each formant as a resonant filter (2nd order IIR)
+    // Formant resonators in series, evaluated as one SIMD biquad cascade
+    std::vector<Biquad> sections;
+    sections.reserve(formants.size());
     for (const auto& formant : formants) {
-        float r = std::exp(-PI * formant.bandwidth / sample_rate_);
-        float omega = 2.0f * PI * formant.frequency / sample_rate_;
-        
-        // Filter coefficients
-        float a1 = -2.0f * r * std::cos(omega);
-        float a2 = r * r;
-        float b0 = formant.amplitude * (1.0f - r * r);
-        
-        // Apply filter
-        std::vector<float> filtered(result.size(), 0.0f);
-        for (size_t i = 2; i < result.size(); ++i) {
-            filtered[i] = b0 * result[i] - a1 * filtered[i-1] - a2 * filtered[i-2];
-        }
-        
-        result = filtered;
+        sections.push_back(Biquad::resonator(
+            formant.frequency, formant.bandwidth, formant.amplitude, sample_rate_
+        ));
     }
     
+    std::vector<float> result(source.size());
+    BiquadCascade cascade(sections);
+    cascade.process(source.data(), result.data(), source.size());
+    
     return result;
 }
 
@@ -523,7 +541,7 @@ float VocalParameterLearner::estimate_pitch(
     const std::vector<float>& audio,
     int sample_rate
 ) {
-    // Simplified autocorrelation pitch detection
+    // Autocorrelation pitch detection
     float min_pitch = 80.0f;  // Hz
     float max_pitch = 400.0f;  // Hz
     
@@ -533,14 +551,19 @@ float VocalParameterLearner::estimate_pitch(
     float best_correlation = 0.0f;
     int best_lag = min_lag;
     
-    for (int lag = min_lag; lag < max_lag && lag < static_cast<int>(audio.size() / 2); ++lag) {
-        float correlation = 0.0f;
-        for (size_t i = 0; i < audio.size() - lag; ++i) {
-            correlation += audio[i] * audio[i + lag];
-        }
-        
-        if (correlation > best_correlation) {
-            best_correlation = correlation;
+    // Lags stay below half the signal length
+    int last_lag = std::min(max_lag, static_cast<int>(audio.size() / 2));
+    if (last_lag <= min_lag) {
+        return static_cast<float>(sample_rate) / best_lag;
+    }
+    
+    // All lags at once via FFT (Wiener–Khinchin) instead of O(N·L)
+    std::vector<float> correlation;
+    autocorrelation(audio.data(), audio.size(), static_cast<size_t>(last_lag), correlation);
+    
+    for (int lag = min_lag; lag < last_lag; ++lag) {
+        if (correlation[lag] > best_correlation) {
+            best_correlation = correlation[lag];
             best_lag = lag;
         }
     }
@@ -611,6 +634,26 @@ HybridVocalGenerator::Mode HybridVocalGenerator::auto_select_mode(
     return PURE_SELF;
 }
 
+SpeechPlan HybridVocalGenerator::plan_speech(
+    const std::string& text,
+    const std::vector<float>& tts_audio,
+    const std::vector<uint64_t>& active_concepts,
+    Mode mode
+) {
+    SpeechPlan plan;
+    plan.blend_weight = get_tts_weight(mode);
+    
+    if (plan.blend_weight > 0.0f) {
+        plan.blend_audio = tts_audio;
+    }
+    if (plan.blend_weight < 1.0f) {
+        auto config = learner_.get_config_for_concepts(active_concepts);
+        plan.segments = synthesizer_.plan_text(text, config.f0).segments;
+    }
+    
+    return plan;
+}
+
 float HybridVocalGenerator::get_proficiency(const std::vector<uint64_t>& concept_ids) {
     auto stats = learner_.get_stats();
     return stats.average_confidence;
@@ -78,6 +78,16 @@ struct VocalConfiguration {
     );
 };
 
+/**
+ * One utterance ready to render (batch or streaming)
+ */
+struct SpeechPlan {
+    std::vector<VocalConfiguration> segments;  // One per phoneme, played in order
+    float transition_ms = 20.0f;               // Glide from each segment into the next
+    std::vector<float> blend_audio;            // Optional TTS audio mixed in
+    float blend_weight = 0.0f;                 // Weight of blend_audio (1 = TTS only)
+};
+
 // ============================================================
 // VOCAL SYNTHESIZER
 // ============================================================
@@ -120,6 +130,23 @@ public:
         float base_pitch = 150.0f
     );
     
+    /**
+     * Per-phoneme plan for text, for rendering block by block
+     * (see StreamingSynthesizer)
+     */
+    SpeechPlan plan_text(const std::string& text, float base_pitch = 150.0f);
+    
+    SpeechPlan plan_phonemes(
+        const std::vector<std::string>& phonemes,
+        const std::vector<float>& pitch_contour,
+        const std::vector<float>& durations_ms
+    );
+    
+    /**
+     * Rosenberg glottal pulse shape at phase in [0, 1)
+     */
+    static float glottal_shape(float phase, float open_quotient);
+    
     int get_sample_rate() const { return sample_rate_; }
     
 private:
@@ -296,6 +323,17 @@ public:
         Mode mode
     );
     
+    /**
+     * Same mode handling as generate_speech, as a plan that a SpeechStream
+     * renders incrementally instead of one finished buffer
+     */
+    SpeechPlan plan_speech(
+        const std::string& text,
+        const std::vector<float>& tts_audio,
+        const std::vector<uint64_t>& active_concepts,
+        Mode mode
+    );
+    
     /**
      * Automatically determine mode based on confidence
      */
@@ -171,9 +171,9 @@ std::vector<int> CognitiveEngine::think() {
     int length_variance = 30;
     
     if (genome_) {
-        length_min = (int)genome_->get("output_length_min");
-        length_max = (int)genome_->get("output_length_max");
-        length_variance = (int)genome_->get("output_length_variance");
+        length_min = (int)genome_->get(evolution::genes::OUTPUT_LENGTH_MIN);
+        length_max = (int)genome_->get(evolution::genes::OUTPUT_LENGTH_MAX);
+        length_variance = (int)genome_->get(evolution::genes::OUTPUT_LENGTH_VARIANCE);
     }
     
     // Generate variable length within range
@@ -458,9 +458,9 @@ void CognitiveEngine::print_statistics() const {
     // Show genome phase if connected
     if (genome_) {
         std::cout << "\n🧬 Genome Phase: " << genome_->get_phase_name() << std::endl;
-        std::cout << "   Base learning rate: " << genome_->get("base_learning_rate") << std::endl;
-        std::cout << "   Temperature range: [" << genome_->get("temperature_min") 
-                  << ", " << genome_->get("temperature_max") << "]" << std::endl;
+        std::cout << "   Base learning rate: " << genome_->get(evolution::genes::BASE_LEARNING_RATE) << std::endl;
+        std::cout << "   Temperature range: [" << genome_->get(evolution::genes::TEMPERATURE_MIN) 
+                  << ", " << genome_->get(evolution::genes::TEMPERATURE_MAX) << "]" << std::endl;
     }
     
     // Show reasoning engine metrics
@@ -575,9 +575,9 @@ void CognitiveEngine::sync_from_genome() {
     if (!genome_) return;
     
     // Load all cognitive parameters from genome
-    state.quality_threshold = genome_->get("quality_threshold");
-    state.boredom_threshold = (int)genome_->get("boredom_threshold");
-    state.exploration_rate = genome_->get("exploration_rate");
+    state.quality_threshold = genome_->get(evolution::genes::QUALITY_THRESHOLD);
+    state.boredom_threshold = (int)genome_->get(evolution::genes::BOREDOM_THRESHOLD);
+    state.exploration_rate = genome_->get(evolution::genes::EXPLORATION_RATE);
     
     // Note: Other parameters like output_length are read directly in think()
     // This allows for dynamic adjustment during runtime
@@ -588,9 +588,9 @@ void CognitiveEngine::sync_to_genome() {
     
     // Save learned cognitive parameters back to genome
     // This allows the system to evolve better thinking strategies!
-    genome_->set("quality_threshold", state.quality_threshold);
-    genome_->set("boredom_threshold", (float)state.boredom_threshold);
-    genome_->set("exploration_rate", state.exploration_rate);
+    genome_->set(evolution::genes::QUALITY_THRESHOLD, state.quality_threshold);
+    genome_->set(evolution::genes::BOREDOM_THRESHOLD, (float)state.boredom_threshold);
+    genome_->set(evolution::genes::EXPLORATION_RATE, state.exploration_rate);
     
     // The genome can then mutate and evolve these values
 }
@@ -658,11 +658,11 @@ void CognitiveEngine::evaluate_adaptation() {
         
         // Stabilize: reduce temperature, lower learning rate
         if (genome_) {
-            float current_temp_max = genome_->get("temperature_max");
-            genome_->set("temperature_max", current_temp_max * 0.9f);
+            float current_temp_max = genome_->get(evolution::genes::TEMPERATURE_MAX);
+            genome_->set(evolution::genes::TEMPERATURE_MAX, current_temp_max * 0.9f);
             
-            float current_learning = genome_->get("base_learning_rate");
-            genome_->set("base_learning_rate", current_learning * 0.8f);
+            float current_learning = genome_->get(evolution::genes::BASE_LEARNING_RATE);
+            genome_->set(evolution::genes::BASE_LEARNING_RATE, current_learning * 0.8f);
         }
         
         // Increase quality threshold (be more selective)
@@ -674,8 +674,8 @@ void CognitiveEngine::evaluate_adaptation() {
         
         // Encourage: slightly increase learning rate
         if (genome_) {
-            float current_learning = genome_->get("base_learning_rate");
-            genome_->set("base_learning_rate", std::min(0.5f, current_learning * 1.05f));
+            float current_learning = genome_->get(evolution::genes::BASE_LEARNING_RATE);
+            genome_->set(evolution::genes::BASE_LEARNING_RATE, std::min(0.5f, current_learning * 1.05f));
         }
         
         // Can afford to be more exploratory
@@ -0,0 +1,150 @@
+#include "population_evaluator.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+namespace melvin {
+namespace cognitive_field {
+
+namespace {
+
+inline uint64_t mix64(uint64_t x) {
+    // splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+size_t resolve_threads(size_t threads) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+        if (threads == 0) threads = 4;  // Fallback
+    }
+    return threads;
+}
+
+} // namespace
+
+// ============================================================================
+// Setup
+// ============================================================================
+
+PopulationEvaluator::PopulationEvaluator() : PopulationEvaluator(Config()) {
+}
+
+PopulationEvaluator::PopulationEvaluator(const Config& config)
+    : config_(config)
+    , pool_(resolve_threads(config.num_threads))
+{
+    config_.trials_per_genome = std::max<size_t>(1, config_.trials_per_genome);
+    config_.num_threads = pool_.threads();
+}
+
+PopulationEvaluator::~PopulationEvaluator() = default;
+
+// ============================================================================
+// Evaluation
+// ============================================================================
+
+uint64_t PopulationEvaluator::genome_hash(const evolution::Genome& genome) {
+    uint64_t h = mix64(genome.gene_count());
+    const float* values = genome.values();
+    for (size_t i = 0; i < genome.gene_count(); ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        h = mix64(h ^ (static_cast<uint64_t>(i) << 32 | bits));
+    }
+    return h;
+}
+
+std::vector<float> PopulationEvaluator::evaluate(
+    const std::vector<evolution::Genome>& population,
+    const TrialFunction& trial) {
+
+    std::vector<float> fitness(population.size(), 0.0f);
+    std::vector<uint64_t> keys(population.size());
+    std::vector<size_t> pending;
+
+    // Cache lookups; the cutoff reference is fixed before any trial runs so
+    // early termination doesn't depend on thread timing
+    float reference = 0.0f;
+    bool have_reference = false;
+    for (size_t i = 0; i < population.size(); ++i) {
+        keys[i] = genome_hash(population[i]);
+        auto it = cache_.find(keys[i]);
+        if (it != cache_.end()) {
+            fitness[i] = it->second;
+            reference = have_reference ? std::max(reference, it->second) : it->second;
+            have_reference = true;
+            stats_.cache_hits++;
+        } else {
+            pending.push_back(i);
+        }
+    }
+
+    size_t trials = config_.trials_per_genome;
+    size_t min_trials = std::min(trials, std::max<size_t>(1, config_.min_trials_before_cutoff));
+    float cutoff = reference - config_.cutoff_margin;
+
+    pool_.run(pending.size(), [&](size_t job_index) {
+        size_t index = pending[job_index];
+        const evolution::Genome& genome = population[index];
+        uint64_t genome_seed = mix64(config_.base_seed ^ keys[index]);
+
+        float sum = 0.0f;
+        size_t run = 0;
+        while (run < trials) {
+            std::mt19937 rng(static_cast<uint32_t>(mix64(genome_seed + run)));
+            sum += trial(genome, run, rng);
+            run++;
+
+            if (have_reference && run >= min_trials && run < trials && sum / run < cutoff) {
+                early_terminations_.fetch_add(1, std::memory_order_relaxed);
+                break;
+            }
+        }
+
+        trials_run_.fetch_add(run, std::memory_order_relaxed);
+        fitness[index] = sum / run;
+    });
+
+    for (size_t index : pending) {
+        cache_insert(keys[index], fitness[index]);
+    }
+
+    stats_.rounds++;
+    stats_.genomes_evaluated += pending.size();
+    return fitness;
+}
+
+void PopulationEvaluator::cache_insert(uint64_t key, float fitness) {
+    if (config_.cache_capacity == 0) {
+        return;
+    }
+
+    if (cache_.emplace(key, fitness).second) {
+        cache_order_.push_back(key);
+    }
+    while (cache_order_.size() > config_.cache_capacity) {
+        cache_.erase(cache_order_.front());
+        cache_order_.pop_front();
+    }
+}
+
+void PopulationEvaluator::clear_cache() {
+    cache_.clear();
+    cache_order_.clear();
+}
+
+PopulationEvaluator::Stats PopulationEvaluator::get_stats() const {
+    Stats s = stats_;
+    s.trials_run = trials_run_.load(std::memory_order_relaxed);
+    s.early_terminations = early_terminations_.load(std::memory_order_relaxed);
+    return s;
+}
+
+} // namespace cognitive_field
+} // namespace melvin
@@ -0,0 +1,101 @@
+#ifndef POPULATION_EVALUATOR_H
+#define POPULATION_EVALUATOR_H
+
+#include "../evolution/genome.h"
+#include "../worker_pool.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace melvin {
+namespace cognitive_field {
+
+/**
+ * Parallel Population Evaluation
+ *
+ * Runs fitness trials for every genome of a population concurrently:
+ * 1. Worker pool shared across evaluation rounds (no per-round thread spawn)
+ * 2. Deterministic seeding: trial RNG derives from (base seed, genome hash,
+ *    trial index), so a genome scores the same regardless of scheduling
+ * 3. Early termination: a genome whose running mean is clearly below the
+ *    best score known at the start of the round stops after a few trials
+ * 4. Results cache keyed by genome hash: unchanged genomes cost nothing
+ *
+ * Trials must only read shared state (e.g. a graph snapshot captured by the
+ * trial function), since several run at once.
+ */
+
+class PopulationEvaluator {
+public:
+    /**
+     * Runs one trial of a genome and returns its fitness in [0, 1]
+     * Called concurrently from worker threads.
+     */
+    using TrialFunction = std::function<float(const evolution::Genome& genome,
+                                              size_t trial_index,
+                                              std::mt19937& rng)>;
+
+    struct Config {
+        size_t num_threads = 0;                 // 0 = hardware concurrency
+        size_t trials_per_genome = 8;
+        uint64_t base_seed = 0x6d656c76696eULL;
+        size_t min_trials_before_cutoff = 3;
+        float cutoff_margin = 0.2f;             // Stop when mean < best - margin
+        size_t cache_capacity = 256;
+    };
+
+    struct Stats {
+        size_t rounds = 0;
+        size_t genomes_evaluated = 0;
+        size_t cache_hits = 0;
+        size_t early_terminations = 0;
+        size_t trials_run = 0;
+    };
+
+    PopulationEvaluator();
+    explicit PopulationEvaluator(const Config& config);
+    ~PopulationEvaluator();
+
+    PopulationEvaluator(const PopulationEvaluator&) = delete;
+    PopulationEvaluator& operator=(const PopulationEvaluator&) = delete;
+
+    /**
+     * Score every genome; returns fitness per population index
+     */
+    std::vector<float> evaluate(const std::vector<evolution::Genome>& population,
+                                const TrialFunction& trial);
+
+    /**
+     * Hash of a genome's gene values (cache key)
+     */
+    static uint64_t genome_hash(const evolution::Genome& genome);
+
+    void clear_cache();
+    Stats get_stats() const;
+    const Config& config() const { return config_; }
+
+private:
+    Config config_;
+
+    // Shared across evaluation rounds
+    WorkerPool pool_;
+
+    // Results cache (FIFO eviction)
+    std::unordered_map<uint64_t, float> cache_;
+    std::deque<uint64_t> cache_order_;
+
+    Stats stats_;
+    std::atomic<size_t> trials_run_{0};
+    std::atomic<size_t> early_terminations_{0};
+
+    void cache_insert(uint64_t key, float fitness);
+};
+
+} // namespace cognitive_field
+} // namespace melvin
+
+#endif // POPULATION_EVALUATOR_H
@@ -0,0 +1,388 @@
+#include "population_evolution.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <numeric>
+
+namespace melvin {
+namespace cognitive_field {
+
+PopulationEvolution::PopulationEvolution(size_t population_size, size_t fitness_window)
+    : population_size_(std::max<size_t>(2, population_size))
+    , fitness_window_(std::max<size_t>(2, fitness_window))
+    , min_samples_for_evolution_(fitness_window)
+    , rng_(std::random_device{}()) {
+}
+
+// ============================================================================
+// Population Management
+// ============================================================================
+
+void PopulationEvolution::initialize_population() {
+    population_.clear();
+    population_.reserve(population_size_);
+
+    // First genome keeps the defaults, the rest start as variations
+    population_.emplace_back();
+    for (size_t i = 1; i < population_size_; ++i) {
+        evolution::Genome genome;
+        genome.mutate();
+        population_.push_back(std::move(genome));
+    }
+
+    genome_fitness_scores_.assign(population_.size(), 0.0f);
+    active_genome_index_ = 0;
+}
+
+evolution::Genome& PopulationEvolution::get_active_genome() {
+    if (population_.empty()) {
+        initialize_population();
+    }
+    return population_[active_genome_index_];
+}
+
+const evolution::Genome& PopulationEvolution::get_active_genome() const {
+    return population_[active_genome_index_];
+}
+
+std::vector<evolution::Genome>& PopulationEvolution::get_population() {
+    return population_;
+}
+
+// ============================================================================
+// Fitness Tracking (Rolling Window)
+// ============================================================================
+
+void PopulationEvolution::record_fitness(float prediction_accuracy,
+                                         float energy_efficiency,
+                                         float learning_speed) {
+    FitnessSnapshot snapshot;
+    snapshot.timestamp = std::chrono::high_resolution_clock::now();
+    snapshot.prediction_accuracy = prediction_accuracy;
+    snapshot.energy_efficiency = energy_efficiency;
+    snapshot.learning_speed = learning_speed;
+    snapshot.combined_fitness = prediction_accuracy * 0.5f +
+                                energy_efficiency * 0.3f +
+                                learning_speed * 0.2f;
+
+    fitness_history_.push_back(snapshot);
+    if (fitness_history_.size() > fitness_window_) {
+        fitness_history_.pop_front();
+    }
+
+    samples_since_evolution_++;
+    update_parameter_histories();
+}
+
+float PopulationEvolution::get_rolling_fitness() const {
+    if (fitness_history_.empty()) return 0.0f;
+
+    float sum = 0.0f;
+    for (const auto& snapshot : fitness_history_) {
+        sum += snapshot.combined_fitness;
+    }
+    return sum / fitness_history_.size();
+}
+
+float PopulationEvolution::get_fitness_trend() const {
+    if (fitness_history_.size() < 4) return 0.0f;
+
+    // Second half of the window vs first half
+    size_t half = fitness_history_.size() / 2;
+    float first = 0.0f, second = 0.0f;
+    for (size_t i = 0; i < half; ++i) {
+        first += fitness_history_[i].combined_fitness;
+    }
+    for (size_t i = half; i < fitness_history_.size(); ++i) {
+        second += fitness_history_[i].combined_fitness;
+    }
+    return second / (fitness_history_.size() - half) - first / half;
+}
+
+// ============================================================================
+// Evolution Triggers
+// ============================================================================
+
+bool PopulationEvolution::should_evolve() const {
+    return samples_since_evolution_ >= min_samples_for_evolution_ &&
+           compute_fitness_variance() >= min_fitness_variance_for_evolution_;
+}
+
+void PopulationEvolution::evolve() {
+    if (population_.empty()) {
+        initialize_population();
+    }
+
+    // 1. Evaluate all genomes
+    evaluate_all_genomes();
+
+    // 2-5. Replace the weakest third with mutated children of good parents
+    size_t replace_count = std::max<size_t>(1, population_.size() / 3);
+    std::vector<size_t> weakest = select_bottom_genomes(replace_count);
+    std::vector<std::string> targets = identify_mutation_targets();
+
+    for (size_t index : weakest) {
+        size_t parent_a = tournament_select();
+        size_t parent_b = tournament_select();
+
+        evolution::Genome child = crossover(population_[parent_a], population_[parent_b]);
+        selective_mutate(child, targets);
+
+        population_[index] = std::move(child);
+        genome_fitness_scores_[index] = 0.5f * (genome_fitness_scores_[parent_a] +
+                                                genome_fitness_scores_[parent_b]);
+    }
+
+    // Best genome becomes active
+    active_genome_index_ = select_top_genomes(1).front();
+
+    generation_++;
+    total_evolutions_++;
+    samples_since_evolution_ = 0;
+
+    std::cout << "🧬 Population evolved (generation " << generation_ << ", "
+              << weakest.size() << " genomes replaced, best fitness "
+              << genome_fitness_scores_[active_genome_index_] << ")" << std::endl;
+}
+
+// ============================================================================
+// Selective Mutation
+// ============================================================================
+
+std::vector<std::string> PopulationEvolution::identify_mutation_targets() const {
+    std::vector<std::pair<float, std::string>> correlations;
+    for (const auto& pair : parameter_fitness_history_) {
+        correlations.emplace_back(std::abs(compute_parameter_correlation(pair.first)), pair.first);
+    }
+
+    // Not enough history yet: every gene is a target
+    if (correlations.empty()) {
+        std::vector<std::string> all;
+        if (!population_.empty()) {
+            for (const auto& gene : population_[active_genome_index_].get_all_genes()) {
+                all.push_back(gene.name);
+            }
+        }
+        return all;
+    }
+
+    // Top quarter by |correlation with fitness|
+    std::sort(correlations.begin(), correlations.end(),
+              [](const auto& a, const auto& b) { return a.first > b.first; });
+    size_t count = std::max<size_t>(1, correlations.size() / 4);
+
+    std::vector<std::string> targets;
+    for (size_t i = 0; i < count; ++i) {
+        targets.push_back(correlations[i].second);
+    }
+    return targets;
+}
+
+void PopulationEvolution::selective_mutate(evolution::Genome& genome,
+                                           const std::vector<std::string>& target_params) {
+    std::vector<evolution::Gene> genes = genome.get_all_genes();
+
+    for (const auto& name : target_params) {
+        evolution::GeneHandle h = genome.handle(name);
+        if (h == evolution::INVALID_GENE) continue;
+
+        const evolution::Gene& gene = genes[h];
+        float magnitude = gene.is_critical ? gene.mutation_magnitude * 0.2f : gene.mutation_magnitude;
+        std::normal_distribution<float> dist(0.0f, magnitude);
+        genome.set(h, genome.get(h) + dist(rng_));
+    }
+}
+
+// ============================================================================
+// Crossover (Genetic Recombination)
+// ============================================================================
+
+evolution::Genome PopulationEvolution::crossover(const evolution::Genome& parent_a,
+                                                 const evolution::Genome& parent_b) {
+    evolution::Genome child = parent_a;
+    std::bernoulli_distribution take_b(0.5);
+
+    size_t genes = std::min(parent_a.gene_count(), parent_b.gene_count());
+    for (evolution::GeneHandle h = 0; h < static_cast<evolution::GeneHandle>(genes); ++h) {
+        if (take_b(rng_)) {
+            child.set(h, parent_b.get(h));
+        }
+    }
+    return child;
+}
+
+// ============================================================================
+// Selection
+// ============================================================================
+
+std::vector<size_t> PopulationEvolution::select_top_genomes(size_t k) const {
+    std::vector<size_t> order(genome_fitness_scores_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return genome_fitness_scores_[a] > genome_fitness_scores_[b];
+    });
+    order.resize(std::min(k, order.size()));
+    return order;
+}
+
+std::vector<size_t> PopulationEvolution::select_bottom_genomes(size_t k) const {
+    std::vector<size_t> order(genome_fitness_scores_.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t a, size_t b) {
+        return genome_fitness_scores_[a] < genome_fitness_scores_[b];
+    });
+    order.resize(std::min(k, order.size()));
+    return order;
+}
+
+size_t PopulationEvolution::tournament_select(size_t tournament_size) const {
+    if (genome_fitness_scores_.empty()) return 0;
+
+    std::uniform_int_distribution<size_t> pick(0, genome_fitness_scores_.size() - 1);
+    size_t best = pick(rng_);
+    for (size_t i = 1; i < tournament_size; ++i) {
+        size_t candidate = pick(rng_);
+        if (genome_fitness_scores_[candidate] > genome_fitness_scores_[best]) {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+// ============================================================================
+// Genome Evaluation
+// ============================================================================
+
+void PopulationEvolution::set_trial_function(PopulationEvaluator::TrialFunction trial) {
+    trial_ = std::move(trial);
+    evaluator_.clear_cache();  // Scores from a different trial aren't comparable
+}
+
+void PopulationEvolution::evaluate_all_genomes() {
+    if (population_.empty()) {
+        initialize_population();
+    }
+    genome_fitness_scores_.resize(population_.size(), 0.0f);
+
+    if (trial_) {
+        genome_fitness_scores_ = evaluator_.evaluate(population_, trial_);
+    } else if (!fitness_history_.empty()) {
+        // Only the active genome has live measurements
+        genome_fitness_scores_[active_genome_index_] = get_rolling_fitness();
+    }
+}
+
+std::vector<float> PopulationEvolution::get_all_fitness_scores() const {
+    return genome_fitness_scores_;
+}
+
+// ============================================================================
+// Persistence
+// ============================================================================
+
+void PopulationEvolution::save_population(const std::string& directory) const {
+    for (size_t i = 0; i < population_.size(); ++i) {
+        population_[i].save(directory + "/genome_" + std::to_string(i) + ".bin");
+    }
+}
+
+void PopulationEvolution::load_population(const std::string& directory) {
+    if (population_.empty()) {
+        initialize_population();
+    }
+    for (size_t i = 0; i < population_.size(); ++i) {
+        population_[i].load(directory + "/genome_" + std::to_string(i) + ".bin");
+    }
+    evaluator_.clear_cache();
+}
+
+// ============================================================================
+// Statistics
+// ============================================================================
+
+PopulationEvolution::Stats PopulationEvolution::get_stats() const {
+    Stats stats;
+    stats.generation = generation_;
+    stats.population_size = population_.size();
+    stats.best_fitness = 0.0f;
+    stats.avg_fitness = 0.0f;
+    stats.worst_fitness = 0.0f;
+    stats.fitness_variance = compute_fitness_variance();
+    stats.total_evolutions = total_evolutions_;
+    stats.samples_since_last_evolution = samples_since_evolution_;
+
+    if (!genome_fitness_scores_.empty()) {
+        auto minmax = std::minmax_element(genome_fitness_scores_.begin(), genome_fitness_scores_.end());
+        stats.worst_fitness = *minmax.first;
+        stats.best_fitness = *minmax.second;
+        stats.avg_fitness = std::accumulate(genome_fitness_scores_.begin(),
+                                            genome_fitness_scores_.end(), 0.0f) /
+                            genome_fitness_scores_.size();
+    }
+    return stats;
+}
+
+// ============================================================================
+// Helpers
+// ============================================================================
+
+float PopulationEvolution::compute_fitness_variance() const {
+    if (fitness_history_.size() < 2) return 0.0f;
+
+    float mean = get_rolling_fitness();
+    float sum_sq = 0.0f;
+    for (const auto& snapshot : fitness_history_) {
+        float d = snapshot.combined_fitness - mean;
+        sum_sq += d * d;
+    }
+    return sum_sq / fitness_history_.size();
+}
+
+float PopulationEvolution::compute_parameter_correlation(const std::string& param_name) const {
+    auto it = parameter_fitness_history_.find(param_name);
+    if (it == parameter_fitness_history_.end()) return 0.0f;
+
+    // Parameter values and fitness samples are appended together, so the
+    // most recent n of each line up
+    const auto& values = it->second;
+    size_t n = std::min(values.size(), fitness_history_.size());
+    if (n < 3) return 0.0f;
+
+    size_t value_offset = values.size() - n;
+    size_t fitness_offset = fitness_history_.size() - n;
+
+    float mean_v = 0.0f, mean_f = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        mean_v += values[value_offset + i];
+        mean_f += fitness_history_[fitness_offset + i].combined_fitness;
+    }
+    mean_v /= n;
+    mean_f /= n;
+
+    float cov = 0.0f, var_v = 0.0f, var_f = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        float dv = values[value_offset + i] - mean_v;
+        float df = fitness_history_[fitness_offset + i].combined_fitness - mean_f;
+        cov += dv * df;
+        var_v += dv * dv;
+        var_f += df * df;
+    }
+
+    float denom = std::sqrt(var_v * var_f);
+    return (denom > 1e-9f) ? cov / denom : 0.0f;
+}
+
+void PopulationEvolution::update_parameter_histories() {
+    if (population_.empty()) return;
+
+    for (const auto& gene : population_[active_genome_index_].get_all_genes()) {
+        auto& history = parameter_fitness_history_[gene.name];
+        history.push_back(gene.value);
+        if (history.size() > fitness_window_) {
+            history.pop_front();
+        }
+    }
+}
+
+} // namespace cognitive_field
+} // namespace melvin
@@ -2,10 +2,13 @@
 #define POPULATION_EVOLUTION_H
 
 #include "../evolution/genome.h"
+#include "population_evaluator.h"
+#include <chrono>
 #include <vector>
 #include <deque>
 #include <string>
 #include <random>
+#include <unordered_map>
 
 namespace melvin {
 namespace cognitive_field {
@@ -147,9 +150,19 @@ public:
     
     /**
      * Evaluate all genomes (assign fitness scores)
+     * With a trial function set, genomes run in parallel on the evaluator's
+     * worker pool; otherwise the active genome takes its rolling fitness.
      */
     void evaluate_all_genomes();
     
+    /**
+     * Set the per-genome trial used by evaluate_all_genomes()
+     * The trial must only read shared state (e.g. a captured graph snapshot).
+     */
+    void set_trial_function(PopulationEvaluator::TrialFunction trial);
+    
+    PopulationEvaluator& get_evaluator() { return evaluator_; }
+    
     /**
      * Get fitness scores for all genomes
      */
@@ -204,8 +217,12 @@ private:
     size_t min_samples_for_evolution_ = 100;
     float min_fitness_variance_for_evolution_ = 0.05f;
     
-    // Random number generator
-    std::mt19937 rng_;
+    // Parallel genome trials + results cache
+    PopulationEvaluator evaluator_;
+    PopulationEvaluator::TrialFunction trial_;
+    
+    // Random number generator (mutable: tournament selection is const)
+    mutable std::mt19937 rng_;
     
     // Helper functions
     float compute_fitness_variance() const;
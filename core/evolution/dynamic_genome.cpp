@@ -360,6 +360,16 @@ void DynamicGenome::set_gene(const std::string& name, float value) {
     }
 }
 
+bool DynamicGenome::has_gene(const std::string& name) const {
+    auto self = const_cast<DynamicGenome*>(this);
+    for (const auto& gene : self->get_all_gene_ptrs()) {
+        if (gene.first == name) {
+            return true;
+        }
+    }
+    return false;
+}
+
 float DynamicGenome::get_gene(const std::string& name) const {
     // Copy to avoid const issues
     auto self = const_cast<DynamicGenome*>(this);
@@ -298,9 +298,12 @@ public:
     // Get all gene pointers for generic access
     std::vector<std::pair<std::string, float*>> get_all_gene_ptrs();
     
-    // Set any gene by name
+    // Set any gene by name (unknown names are ignored; see has_gene)
     void set_gene(const std::string& name, float value);
     
+    // Whether a gene of this name exists
+    bool has_gene(const std::string& name) const;
+    
     // Get any gene by name
     float get_gene(const std::string& name) const;
     
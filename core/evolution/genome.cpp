@@ -5,128 +5,181 @@
 namespace melvin {
 namespace evolution {
 
-Genome::Genome() : current_generation_(0), rng_(std::random_device{}()) {
-    initialize_default_genome();
-}
+namespace {
 
-void Genome::initialize_default_genome() {
+// Default values for the built-in genes, in genes:: handle order
+struct BuiltinGene {
+    const char* name;
+    float value;
+    float min_value;
+    float max_value;
+    float mutation_rate;
+    float mutation_magnitude;
+    bool is_critical;
+};
+
+constexpr BuiltinGene BUILTIN_GENES[] = {
     // Energy system genes
-    genes_["base_input_energy"] = {"base_input_energy", 10.0f, 1.0f, 100.0f, 0.05f, 2.0f, false, 0.0f, 0};
-    genes_["energy_decay_rate"] = {"energy_decay_rate", 0.9f, 0.5f, 0.999f, 0.05f, 0.05f, true, 0.0f, 0};
-    genes_["energy_spread_rate"] = {"energy_spread_rate", 0.3f, 0.01f, 0.9f, 0.05f, 0.1f, false, 0.0f, 0};
-    genes_["min_activation_threshold"] = {"min_activation_threshold", 0.01f, 0.001f, 0.5f, 0.03f, 0.01f, true, 0.0f, 0};
-    genes_["novelty_bonus_multiplier"] = {"novelty_bonus_multiplier", 2.0f, 1.0f, 10.0f, 0.08f, 0.5f, false, 0.0f, 0};
+    {"base_input_energy", 10.0f, 1.0f, 100.0f, 0.05f, 2.0f, false},
+    {"energy_decay_rate", 0.9f, 0.5f, 0.999f, 0.05f, 0.05f, true},
+    {"energy_spread_rate", 0.3f, 0.01f, 0.9f, 0.05f, 0.1f, false},
+    {"min_activation_threshold", 0.01f, 0.001f, 0.5f, 0.03f, 0.01f, true},
+    {"novelty_bonus_multiplier", 2.0f, 1.0f, 10.0f, 0.08f, 0.5f, false},
     
     // Learning system genes
-    genes_["base_learning_rate"] = {"base_learning_rate", 0.1f, 0.001f, 0.5f, 0.05f, 0.02f, true, 0.0f, 0};
-    genes_["exploration_learning_rate"] = {"exploration_learning_rate", 0.3f, 0.05f, 0.8f, 0.05f, 0.05f, false, 0.0f, 0};
-    genes_["exploitation_learning_rate"] = {"exploitation_learning_rate", 0.03f, 0.001f, 0.2f, 0.05f, 0.01f, false, 0.0f, 0};
-    genes_["eligibility_trace_decay"] = {"eligibility_trace_decay", 0.95f, 0.5f, 0.999f, 0.05f, 0.02f, true, 0.0f, 0};
+    {"base_learning_rate", 0.1f, 0.001f, 0.5f, 0.05f, 0.02f, true},
+    {"exploration_learning_rate", 0.3f, 0.05f, 0.8f, 0.05f, 0.05f, false},
+    {"exploitation_learning_rate", 0.03f, 0.001f, 0.2f, 0.05f, 0.01f, false},
+    {"eligibility_trace_decay", 0.95f, 0.5f, 0.999f, 0.05f, 0.02f, true},
     
     // Attention system genes
-    genes_["base_attention_weight"] = {"base_attention_weight", 1.0f, 0.1f, 5.0f, 0.05f, 0.2f, false, 0.0f, 0};
-    genes_["goal_relevance_weight"] = {"goal_relevance_weight", 1.0f, 0.0f, 5.0f, 0.05f, 0.3f, false, 0.0f, 0};
-    genes_["surprise_bonus_weight"] = {"surprise_bonus_weight", 1.0f, 0.0f, 3.0f, 0.05f, 0.2f, false, 0.0f, 0};
+    {"base_attention_weight", 1.0f, 0.1f, 5.0f, 0.05f, 0.2f, false},
+    {"goal_relevance_weight", 1.0f, 0.0f, 5.0f, 0.05f, 0.3f, false},
+    {"surprise_bonus_weight", 1.0f, 0.0f, 3.0f, 0.05f, 0.2f, false},
     
     // Prediction system genes
-    genes_["prediction_confidence_threshold"] = {"prediction_confidence_threshold", 0.5f, 0.1f, 0.95f, 0.05f, 0.1f, false, 0.0f, 0};
-    genes_["prediction_temperature"] = {"prediction_temperature", 1.0f, 0.1f, 5.0f, 0.05f, 0.3f, false, 0.0f, 0};
+    {"prediction_confidence_threshold", 0.5f, 0.1f, 0.95f, 0.05f, 0.1f, false},
+    {"prediction_temperature", 1.0f, 0.1f, 5.0f, 0.05f, 0.3f, false},
     
     // Consolidation system genes
-    genes_["consolidation_replay_strength"] = {"consolidation_replay_strength", 0.05f, 0.001f, 0.5f, 0.05f, 0.02f, false, 0.0f, 0};
-    genes_["consolidation_pruning_threshold"] = {"consolidation_pruning_threshold", 0.1f, 0.01f, 0.5f, 0.05f, 0.05f, true, 0.0f, 0};
-    genes_["consolidation_merge_threshold"] = {"consolidation_merge_threshold", 0.85f, 0.5f, 0.99f, 0.05f, 0.05f, false, 0.0f, 0};
+    {"consolidation_replay_strength", 0.05f, 0.001f, 0.5f, 0.05f, 0.02f, false},
+    {"consolidation_pruning_threshold", 0.1f, 0.01f, 0.5f, 0.05f, 0.05f, true},
+    {"consolidation_merge_threshold", 0.85f, 0.5f, 0.99f, 0.05f, 0.05f, false},
     
     // Meta-learning system genes
-    genes_["meta_success_threshold_explore"] = {"meta_success_threshold_explore", 0.3f, 0.1f, 0.5f, 0.05f, 0.05f, false, 0.0f, 0};
-    genes_["meta_success_threshold_exploit"] = {"meta_success_threshold_exploit", 0.7f, 0.5f, 0.95f, 0.05f, 0.05f, false, 0.0f, 0};
+    {"meta_success_threshold_explore", 0.3f, 0.1f, 0.5f, 0.05f, 0.05f, false},
+    {"meta_success_threshold_exploit", 0.7f, 0.5f, 0.95f, 0.05f, 0.05f, false},
     
     // Temporal reasoning genes
-    genes_["temporal_window_ms"] = {"temporal_window_ms", 200.0f, 50.0f, 1000.0f, 0.05f, 50.0f, false, 0.0f, 0};
+    {"temporal_window_ms", 200.0f, 50.0f, 1000.0f, 0.05f, 50.0f, false},
     
     // Edge dynamics genes
-    genes_["edge_strengthening_rate"] = {"edge_strengthening_rate", 0.05f, 0.001f, 0.5f, 0.05f, 0.02f, false, 0.0f, 0};
-    genes_["edge_weakening_rate"] = {"edge_weakening_rate", 0.1f, 0.001f, 0.5f, 0.05f, 0.05f, false, 0.0f, 0};
+    {"edge_strengthening_rate", 0.05f, 0.001f, 0.5f, 0.05f, 0.02f, false},
+    {"edge_weakening_rate", 0.1f, 0.001f, 0.5f, 0.05f, 0.05f, false},
     
     // Output generation genes (COGNITIVE SYSTEM)
-    genes_["output_length_min"] = {"output_length_min", 20.0f, 5.0f, 50.0f, 0.1f, 5.0f, false, 0.0f, 0};
-    genes_["output_length_max"] = {"output_length_max", 100.0f, 20.0f, 500.0f, 0.1f, 20.0f, false, 0.0f, 0};
-    genes_["output_length_variance"] = {"output_length_variance", 30.0f, 0.0f, 100.0f, 0.1f, 10.0f, false, 0.0f, 0};
-    genes_["quality_threshold"] = {"quality_threshold", 0.3f, 0.1f, 0.7f, 0.1f, 0.05f, false, 0.0f, 0};
-    genes_["boredom_threshold"] = {"boredom_threshold", 3.0f, 1.0f, 10.0f, 0.1f, 1.0f, false, 0.0f, 0};
-    genes_["exploration_rate"] = {"exploration_rate", 0.3f, 0.05f, 0.8f, 0.1f, 0.05f, false, 0.0f, 0};
-    genes_["goal_duration_min"] = {"goal_duration_min", 5.0f, 1.0f, 20.0f, 0.1f, 2.0f, false, 0.0f, 0};
-    genes_["goal_duration_max"] = {"goal_duration_max", 15.0f, 5.0f, 50.0f, 0.1f, 5.0f, false, 0.0f, 0};
-    genes_["consolidation_interval"] = {"consolidation_interval", 5.0f, 1.0f, 20.0f, 0.1f, 2.0f, false, 0.0f, 0};
-    genes_["temperature_min"] = {"temperature_min", 0.6f, 0.1f, 1.5f, 0.1f, 0.1f, false, 0.0f, 0};
-    genes_["temperature_max"] = {"temperature_max", 1.4f, 0.5f, 3.0f, 0.1f, 0.2f, false, 0.0f, 0};
+    {"output_length_min", 20.0f, 5.0f, 50.0f, 0.1f, 5.0f, false},
+    {"output_length_max", 100.0f, 20.0f, 500.0f, 0.1f, 20.0f, false},
+    {"output_length_variance", 30.0f, 0.0f, 100.0f, 0.1f, 10.0f, false},
+    {"quality_threshold", 0.3f, 0.1f, 0.7f, 0.1f, 0.05f, false},
+    {"boredom_threshold", 3.0f, 1.0f, 10.0f, 0.1f, 1.0f, false},
+    {"exploration_rate", 0.3f, 0.05f, 0.8f, 0.1f, 0.05f, false},
+    {"goal_duration_min", 5.0f, 1.0f, 20.0f, 0.1f, 2.0f, false},
+    {"goal_duration_max", 15.0f, 5.0f, 50.0f, 0.1f, 5.0f, false},
+    {"consolidation_interval", 5.0f, 1.0f, 20.0f, 0.1f, 2.0f, false},
+    {"temperature_min", 0.6f, 0.1f, 1.5f, 0.1f, 0.1f, false},
+    {"temperature_max", 1.4f, 0.5f, 3.0f, 0.1f, 0.2f, false},
     
     // Mode Control System genes (Autonomous Mode Selection)
-    genes_["mode_confidence_threshold"] = {"mode_confidence_threshold", 0.7f, 0.5f, 0.95f, 0.1f, 0.05f, false, 0.0f, 0};
-    genes_["mode_min_knowledge_for_action"] = {"mode_min_knowledge_for_action", 0.3f, 0.1f, 0.7f, 0.1f, 0.05f, false, 0.0f, 0};
-    genes_["mode_energy_low_threshold"] = {"mode_energy_low_threshold", 5.0f, 1.0f, 10.0f, 0.1f, 0.5f, false, 0.0f, 0};
-    genes_["mode_energy_high_threshold"] = {"mode_energy_high_threshold", 50.0f, 20.0f, 100.0f, 0.1f, 5.0f, false, 0.0f, 0};
-    genes_["mode_consolidation_interval"] = {"mode_consolidation_interval", 300.0f, 60.0f, 600.0f, 0.1f, 30.0f, false, 0.0f, 0};
-    genes_["mode_evolution_interval"] = {"mode_evolution_interval", 600.0f, 120.0f, 1200.0f, 0.1f, 60.0f, false, 0.0f, 0};
-    genes_["mode_idle_timeout"] = {"mode_idle_timeout", 60.0f, 10.0f, 300.0f, 0.1f, 10.0f, false, 0.0f, 0};
-    genes_["mode_min_nodes_for_action"] = {"mode_min_nodes_for_action", 1000.0f, 100.0f, 10000.0f, 0.1f, 500.0f, false, 0.0f, 0};
-    genes_["mode_min_safe_distance"] = {"mode_min_safe_distance", 0.3f, 0.1f, 1.0f, 0.1f, 0.05f, false, 0.0f, 0};
-    genes_["mode_max_error_rate"] = {"mode_max_error_rate", 0.7f, 0.3f, 0.9f, 0.1f, 0.05f, false, 0.0f, 0};
-    genes_["mode_exploration_threshold"] = {"mode_exploration_threshold", 0.4f, 0.2f, 0.8f, 0.1f, 0.05f, false, 0.0f, 0};
-    genes_["mode_exploration_confidence"] = {"mode_exploration_confidence", 0.5f, 0.3f, 0.8f, 0.1f, 0.05f, false, 0.0f, 0};
-    genes_["mode_min_success_rate"] = {"mode_min_success_rate", 0.3f, 0.1f, 0.7f, 0.1f, 0.05f, false, 0.0f, 0};
-    
-    std::cout << "🧬 Genome initialized with " << genes_.size() << " genes" << std::endl;
+    {"mode_confidence_threshold", 0.7f, 0.5f, 0.95f, 0.1f, 0.05f, false},
+    {"mode_min_knowledge_for_action", 0.3f, 0.1f, 0.7f, 0.1f, 0.05f, false},
+    {"mode_energy_low_threshold", 5.0f, 1.0f, 10.0f, 0.1f, 0.5f, false},
+    {"mode_energy_high_threshold", 50.0f, 20.0f, 100.0f, 0.1f, 5.0f, false},
+    {"mode_consolidation_interval", 300.0f, 60.0f, 600.0f, 0.1f, 30.0f, false},
+    {"mode_evolution_interval", 600.0f, 120.0f, 1200.0f, 0.1f, 60.0f, false},
+    {"mode_idle_timeout", 60.0f, 10.0f, 300.0f, 0.1f, 10.0f, false},
+    {"mode_min_nodes_for_action", 1000.0f, 100.0f, 10000.0f, 0.1f, 500.0f, false},
+    {"mode_min_safe_distance", 0.3f, 0.1f, 1.0f, 0.1f, 0.05f, false},
+    {"mode_max_error_rate", 0.7f, 0.3f, 0.9f, 0.1f, 0.05f, false},
+    {"mode_exploration_threshold", 0.4f, 0.2f, 0.8f, 0.1f, 0.05f, false},
+    {"mode_exploration_confidence", 0.5f, 0.3f, 0.8f, 0.1f, 0.05f, false},
+    {"mode_min_success_rate", 0.3f, 0.1f, 0.7f, 0.1f, 0.05f, false},
+};
+
+static_assert(sizeof(BUILTIN_GENES) / sizeof(BUILTIN_GENES[0]) == genes::BUILTIN_COUNT,
+              "BUILTIN_GENES must list every genes:: handle in order");
+
+} // namespace
+
+Genome::Genome() : current_generation_(0), rng_(std::random_device{}()) {
+    initialize_default_genome();
+}
+
+void Genome::initialize_default_genome() {
+    for (const BuiltinGene& builtin : BUILTIN_GENES) {
+        add_gene({builtin.name, builtin.value, builtin.min_value, builtin.max_value,
+                  builtin.mutation_rate, builtin.mutation_magnitude, builtin.is_critical, 0.0f, 0});
+    }
+    
+    std::cout << "🧬 Genome initialized with " << values_.size() << " genes" << std::endl;
+}
+
+GeneHandle Genome::add_gene(const Gene& gene) {
+    GeneHandle h = static_cast<GeneHandle>(values_.size());
+    names_.push_back(gene.name);
+    values_.push_back(gene.value);
+    min_values_.push_back(gene.min_value);
+    max_values_.push_back(gene.max_value);
+    mutation_rates_.push_back(gene.mutation_rate);
+    mutation_magnitudes_.push_back(gene.mutation_magnitude);
+    is_critical_.push_back(gene.is_critical ? 1 : 0);
+    fitness_contributions_.push_back(gene.fitness_contribution);
+    generations_created_.push_back(gene.generation_created);
+    handles_[gene.name] = h;
+    return h;
+}
+
+Gene Genome::gene_at(GeneHandle gene) const {
+    return {names_[gene], values_[gene], min_values_[gene], max_values_[gene],
+            mutation_rates_[gene], mutation_magnitudes_[gene], is_critical_[gene] != 0,
+            fitness_contributions_[gene], generations_created_[gene]};
+}
+
+GeneHandle Genome::handle(const std::string& name) const {
+    auto it = handles_.find(name);
+    return (it != handles_.end()) ? it->second : INVALID_GENE;
 }
 
 float Genome::get(const std::string& name) const {
-    auto it = genes_.find(name);
-    if (it != genes_.end()) {
-        return it->second.value;
+    GeneHandle h = handle(name);
+    if (h != INVALID_GENE) {
+        return get(h);
     }
     std::cerr << "⚠️  Gene '" << name << "' not found! Using default 0.0" << std::endl;
     return 0.0f;
 }
 
 void Genome::set(const std::string& name, float value) {
-    auto it = genes_.find(name);
-    if (it != genes_.end()) {
-        value = std::max(it->second.min_value, std::min(it->second.max_value, value));
-        it->second.value = value;
+    GeneHandle h = handle(name);
+    if (h != INVALID_GENE) {
+        set(h, value);
     } else {
         std::cerr << "⚠️  Gene '" << name << "' not found! Cannot set." << std::endl;
     }
 }
 
 bool Genome::has(const std::string& name) const {
-    return genes_.find(name) != genes_.end();
+    return handle(name) != INVALID_GENE;
 }
 
 void Genome::mutate() {
     std::uniform_real_distribution<float> prob_dist(0.0f, 1.0f);
-    int mutations = 0;
-    
-    for (auto& pair : genes_) {
-        Gene& gene = pair.second;
-        
-        if (prob_dist(rng_) < gene.mutation_rate) {
-            float magnitude = gene.mutation_magnitude;
-            if (gene.is_critical) {
+    std::normal_distribution<float> unit_dist(0.0f, 1.0f);
+    size_t n = values_.size();
+    
+    // Draw all deltas first (the RNG is inherently sequential), then apply
+    // them in one branch-free pass over the flat arrays
+    std::vector<float> deltas(n, 0.0f);
+    for (size_t i = 0; i < n; ++i) {
+        if (prob_dist(rng_) < mutation_rates_[i]) {
+            float magnitude = mutation_magnitudes_[i];
+            if (is_critical_[i]) {
                 magnitude *= 0.2f;
             }
-            
-            std::normal_distribution<float> mut_dist(0.0f, magnitude);
-            float delta = mut_dist(rng_);
-            float old_value = gene.value;
-            gene.value += delta;
-            gene.value = std::max(gene.min_value, std::min(gene.max_value, gene.value));
-            
-            if (std::abs(gene.value - old_value) > 0.001f) {
-                mutations++;
-            }
+            deltas[i] = unit_dist(rng_) * magnitude;
         }
     }
     
+    int mutations = 0;
+    float* values = values_.data();
+    const float* lo = min_values_.data();
+    const float* hi = max_values_.data();
+    for (size_t i = 0; i < n; ++i) {
+        float old_value = values[i];
+        values[i] = std::max(lo[i], std::min(hi[i], old_value + deltas[i]));
+        mutations += (std::abs(values[i] - old_value) > 0.001f) ? 1 : 0;
+    }
+    
     if (mutations > 0) {
         std::cout << "🧬 Mutation: " << mutations << " genes mutated (generation " 
                   << current_generation_ << ")" << std::endl;
@@ -141,27 +194,20 @@ void Genome::evaluate_fitness(const std::unordered_map<std::string, float>& metr
     
     float overall_fitness = prediction_acc * 0.5f + energy_eff * 0.3f + learning_speed * 0.2f;
     
-    for (auto& pair : genes_) {
-        Gene& gene = pair.second;
-        float mid_value = 0.5f * (gene.min_value + gene.max_value);
-        float divergence = std::abs(gene.value - mid_value);
-        float normalized_div = divergence / (gene.max_value - gene.min_value);
-        gene.fitness_contribution = overall_fitness * normalized_div;
+    for (size_t i = 0; i < values_.size(); ++i) {
+        float mid_value = 0.5f * (min_values_[i] + max_values_[i]);
+        float divergence = std::abs(values_[i] - mid_value);
+        float normalized_div = divergence / (max_values_[i] - min_values_[i]);
+        fitness_contributions_[i] = overall_fitness * normalized_div;
     }
 }
 
 void Genome::natural_selection() {
-    std::vector<std::pair<std::string, Gene>> all_genes(genes_.begin(), genes_.end());
-    std::sort(all_genes.begin(), all_genes.end(),
-              [](const auto& a, const auto& b) {
-                  return a.second.fitness_contribution > b.second.fitness_contribution;
-              });
-    
-    int top_count = std::max(3, static_cast<int>(all_genes.size() * 0.1));
-    if (all_genes.size() >= static_cast<size_t>(top_count)) {
+    int top_count = std::max(3, static_cast<int>(values_.size() * 0.1));
+    if (values_.size() >= static_cast<size_t>(top_count)) {
         std::cout << "\n📊 Top " << top_count << " genes:\n";
-        for (int i = 0; i < top_count; ++i) {
-            std::cout << "  ✅ " << all_genes[i].first << " = " << all_genes[i].second.value << "\n";
+        for (const Gene& gene : get_top_genes(top_count)) {
+            std::cout << "  ✅ " << gene.name << " = " << gene.value << "\n";
         }
     }
 }
@@ -174,11 +220,11 @@ void Genome::save(const std::string& filename) const {
     }
     
     file.write(reinterpret_cast<const char*>(&current_generation_), sizeof(int));
-    int gene_count = genes_.size();
+    int gene_count = values_.size();
     file.write(reinterpret_cast<const char*>(&gene_count), sizeof(int));
     
-    for (const auto& pair : genes_) {
-        const Gene& gene = pair.second;
+    for (GeneHandle h = 0; h < gene_count; ++h) {
+        const Gene gene = gene_at(h);
         int name_len = gene.name.size();
         file.write(reinterpret_cast<const char*>(&name_len), sizeof(int));
         file.write(gene.name.c_str(), name_len);
@@ -221,7 +267,19 @@ void Genome::load(const std::string& filename) {
         file.read(reinterpret_cast<char*>(&gene.is_critical), sizeof(bool));
         file.read(reinterpret_cast<char*>(&gene.fitness_contribution), sizeof(float));
         file.read(reinterpret_cast<char*>(&gene.generation_created), sizeof(int));
-        genes_[gene.name] = gene;
+        GeneHandle h = handle(gene.name);
+        if (h == INVALID_GENE) {
+            add_gene(gene);
+        } else {
+            values_[h] = gene.value;
+            min_values_[h] = gene.min_value;
+            max_values_[h] = gene.max_value;
+            mutation_rates_[h] = gene.mutation_rate;
+            mutation_magnitudes_[h] = gene.mutation_magnitude;
+            is_critical_[h] = gene.is_critical ? 1 : 0;
+            fitness_contributions_[h] = gene.fitness_contribution;
+            generations_created_[h] = gene.generation_created;
+        }
     }
     
     file.close();
@@ -230,38 +288,33 @@ void Genome::load(const std::string& filename) {
 
 std::vector<Gene> Genome::get_all_genes() const {
     std::vector<Gene> result;
-    for (const auto& pair : genes_) {
-        result.push_back(pair.second);
+    result.reserve(values_.size());
+    for (GeneHandle h = 0; h < static_cast<GeneHandle>(values_.size()); ++h) {
+        result.push_back(gene_at(h));
     }
     return result;
 }
 
 std::vector<Gene> Genome::get_top_genes(int n) const {
-    std::vector<std::pair<std::string, Gene>> all_genes(genes_.begin(), genes_.end());
+    std::vector<Gene> all_genes = get_all_genes();
     std::sort(all_genes.begin(), all_genes.end(),
-              [](const auto& a, const auto& b) {
-                  return a.second.fitness_contribution > b.second.fitness_contribution;
+              [](const Gene& a, const Gene& b) {
+                  return a.fitness_contribution > b.fitness_contribution;
               });
     
-    std::vector<Gene> result;
-    for (int i = 0; i < n && i < static_cast<int>(all_genes.size()); ++i) {
-        result.push_back(all_genes[i].second);
-    }
-    return result;
+    all_genes.resize(std::min(all_genes.size(), static_cast<size_t>(std::max(n, 0))));
+    return all_genes;
 }
 
 std::vector<Gene> Genome::get_worst_genes(int n) const {
-    std::vector<std::pair<std::string, Gene>> all_genes(genes_.begin(), genes_.end());
+    std::vector<Gene> all_genes = get_all_genes();
     std::sort(all_genes.begin(), all_genes.end(),
-              [](const auto& a, const auto& b) {
-                  return a.second.fitness_contribution < b.second.fitness_contribution;
+              [](const Gene& a, const Gene& b) {
+                  return a.fitness_contribution < b.fitness_contribution;
               });
     
-    std::vector<Gene> result;
-    for (int i = 0; i < n && i < static_cast<int>(all_genes.size()); ++i) {
-        result.push_back(all_genes[i].second);
-    }
-    return result;
+    all_genes.resize(std::min(all_genes.size(), static_cast<size_t>(std::max(n, 0))));
+    return all_genes;
 }
 
 // ==============================================================================
@@ -315,32 +368,32 @@ void Genome::apply_phase_parameters() {
     switch (current_phase_) {
         case AdaptationPhase::EXPLORE:
             // High plasticity, high exploration
-            set("base_learning_rate", 0.3f);
-            set("exploration_rate", 0.5f);
-            set("quality_threshold", 0.2f);  // Accept lower quality to learn more
-            set("temperature_min", 0.8f);
-            set("temperature_max", 1.6f);
-            set("energy_spread_rate", 0.4f);  // Spread energy more
+            set(genes::BASE_LEARNING_RATE, 0.3f);
+            set(genes::EXPLORATION_RATE, 0.5f);
+            set(genes::QUALITY_THRESHOLD, 0.2f);  // Accept lower quality to learn more
+            set(genes::TEMPERATURE_MIN, 0.8f);
+            set(genes::TEMPERATURE_MAX, 1.6f);
+            set(genes::ENERGY_SPREAD_RATE, 0.4f);  // Spread energy more
             break;
             
         case AdaptationPhase::REFINE:
             // Medium plasticity, balanced
-            set("base_learning_rate", 0.1f);
-            set("exploration_rate", 0.2f);
-            set("quality_threshold", 0.3f);
-            set("temperature_min", 0.6f);
-            set("temperature_max", 1.4f);
-            set("energy_spread_rate", 0.3f);
+            set(genes::BASE_LEARNING_RATE, 0.1f);
+            set(genes::EXPLORATION_RATE, 0.2f);
+            set(genes::QUALITY_THRESHOLD, 0.3f);
+            set(genes::TEMPERATURE_MIN, 0.6f);
+            set(genes::TEMPERATURE_MAX, 1.4f);
+            set(genes::ENERGY_SPREAD_RATE, 0.3f);
             break;
             
         case AdaptationPhase::EXPLOIT:
             // Low plasticity, consolidate knowledge
-            set("base_learning_rate", 0.03f);
-            set("exploration_rate", 0.05f);
-            set("quality_threshold", 0.4f);  // More selective
-            set("temperature_min", 0.4f);
-            set("temperature_max", 1.0f);
-            set("energy_spread_rate", 0.2f);  // More focused
+            set(genes::BASE_LEARNING_RATE, 0.03f);
+            set(genes::EXPLORATION_RATE, 0.05f);
+            set(genes::QUALITY_THRESHOLD, 0.4f);  // More selective
+            set(genes::TEMPERATURE_MIN, 0.4f);
+            set(genes::TEMPERATURE_MAX, 1.0f);
+            set(genes::ENERGY_SPREAD_RATE, 0.2f);  // More focused
             break;
     }
 }
@@ -371,24 +424,24 @@ void Genome::apply_affective_modulation(float success_rate, float stability, flo
     
     // Apply neuromodulation to learning parameters
     // Dopamine boosts learning rate when successful
-    float current_lr = get("base_learning_rate");
+    float current_lr = get(genes::BASE_LEARNING_RATE);
     float modulated_lr = current_lr * (1.0f + 0.5f * neuromodulators_.dopamine);
-    set("base_learning_rate", std::max(0.001f, std::min(0.5f, modulated_lr)));
+    set(genes::BASE_LEARNING_RATE, std::max(0.001f, std::min(0.5f, modulated_lr)));
     
     // Noradrenaline boosts exploration
-    float current_explore = get("exploration_rate");
+    float current_explore = get(genes::EXPLORATION_RATE);
     float modulated_explore = current_explore * (1.0f + 0.3f * neuromodulators_.noradrenaline);
-    set("exploration_rate", std::max(0.05f, std::min(0.8f, modulated_explore)));
+    set(genes::EXPLORATION_RATE, std::max(0.05f, std::min(0.8f, modulated_explore)));
     
     // Serotonin affects quality threshold (more selective when confident)
-    float current_threshold = get("quality_threshold");
+    float current_threshold = get(genes::QUALITY_THRESHOLD);
     float modulated_threshold = current_threshold + 0.05f * (1.0f - neuromodulators_.serotonin);
-    set("quality_threshold", std::max(0.1f, std::min(0.7f, modulated_threshold)));
+    set(genes::QUALITY_THRESHOLD, std::max(0.1f, std::min(0.7f, modulated_threshold)));
     
     // Acetylcholine focuses attention (reduces temperature variance)
-    float current_temp_max = get("temperature_max");
+    float current_temp_max = get(genes::TEMPERATURE_MAX);
     float modulated_temp = current_temp_max * (1.0f - 0.2f * neuromodulators_.acetylcholine);
-    set("temperature_max", std::max(0.5f, std::min(3.0f, modulated_temp)));
+    set(genes::TEMPERATURE_MAX, std::max(0.5f, std::min(3.0f, modulated_temp)));
 }
 
 } // namespace evolution
@@ -1,6 +1,8 @@
 #ifndef GENOME_H
 #define GENOME_H
 
+#include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
 #include <vector>
@@ -24,6 +26,86 @@ struct Gene {
     int generation_created;
 };
 
+// Integer handle for a gene: an index into the genome's flat value array.
+// Resolve a name once with Genome::handle() and reuse the handle in hot paths.
+using GeneHandle = int;
+constexpr GeneHandle INVALID_GENE = -1;
+
+// Handles of the built-in genes, fixed at compile time (same order as the
+// default genome table). Genes loaded from a file that aren't built in get
+// handles from BUILTIN_COUNT upward.
+namespace genes {
+    enum : GeneHandle {
+        // Energy system genes
+        BASE_INPUT_ENERGY,
+        ENERGY_DECAY_RATE,
+        ENERGY_SPREAD_RATE,
+        MIN_ACTIVATION_THRESHOLD,
+        NOVELTY_BONUS_MULTIPLIER,
+        
+        // Learning system genes
+        BASE_LEARNING_RATE,
+        EXPLORATION_LEARNING_RATE,
+        EXPLOITATION_LEARNING_RATE,
+        ELIGIBILITY_TRACE_DECAY,
+        
+        // Attention system genes
+        BASE_ATTENTION_WEIGHT,
+        GOAL_RELEVANCE_WEIGHT,
+        SURPRISE_BONUS_WEIGHT,
+        
+        // Prediction system genes
+        PREDICTION_CONFIDENCE_THRESHOLD,
+        PREDICTION_TEMPERATURE,
+        
+        // Consolidation system genes
+        CONSOLIDATION_REPLAY_STRENGTH,
+        CONSOLIDATION_PRUNING_THRESHOLD,
+        CONSOLIDATION_MERGE_THRESHOLD,
+        
+        // Meta-learning system genes
+        META_SUCCESS_THRESHOLD_EXPLORE,
+        META_SUCCESS_THRESHOLD_EXPLOIT,
+        
+        // Temporal reasoning genes
+        TEMPORAL_WINDOW_MS,
+        
+        // Edge dynamics genes
+        EDGE_STRENGTHENING_RATE,
+        EDGE_WEAKENING_RATE,
+        
+        // Output generation genes (COGNITIVE SYSTEM)
+        OUTPUT_LENGTH_MIN,
+        OUTPUT_LENGTH_MAX,
+        OUTPUT_LENGTH_VARIANCE,
+        QUALITY_THRESHOLD,
+        BOREDOM_THRESHOLD,
+        EXPLORATION_RATE,
+        GOAL_DURATION_MIN,
+        GOAL_DURATION_MAX,
+        CONSOLIDATION_INTERVAL,
+        TEMPERATURE_MIN,
+        TEMPERATURE_MAX,
+        
+        // Mode Control System genes (Autonomous Mode Selection)
+        MODE_CONFIDENCE_THRESHOLD,
+        MODE_MIN_KNOWLEDGE_FOR_ACTION,
+        MODE_ENERGY_LOW_THRESHOLD,
+        MODE_ENERGY_HIGH_THRESHOLD,
+        MODE_CONSOLIDATION_INTERVAL,
+        MODE_EVOLUTION_INTERVAL,
+        MODE_IDLE_TIMEOUT,
+        MODE_MIN_NODES_FOR_ACTION,
+        MODE_MIN_SAFE_DISTANCE,
+        MODE_MAX_ERROR_RATE,
+        MODE_EXPLORATION_THRESHOLD,
+        MODE_EXPLORATION_CONFIDENCE,
+        MODE_MIN_SUCCESS_RATE,
+        
+        BUILTIN_COUNT
+    };
+}
+
 // ADAPTIVE INTELLIGENCE: Meta-learning phases
 enum class AdaptationPhase {
     EXPLORE,     // High plasticity, high exploration, low confidence
@@ -36,7 +118,18 @@ class Genome {
 public:
     Genome();
     
-    // Variable access (used by ALL systems)
+    // Variable access by handle (hot paths): no hashing, one array read
+    float get(GeneHandle gene) const { return values_[gene]; }
+    void set(GeneHandle gene, float value) {
+        values_[gene] = std::max(min_values_[gene], std::min(max_values_[gene], value));
+    }
+    
+    // Resolve a gene name to its handle (INVALID_GENE if unknown)
+    GeneHandle handle(const std::string& name) const;
+    size_t gene_count() const { return values_.size(); }
+    const float* values() const { return values_.data(); }
+    
+    // Variable access by name (compatibility layer over the handles)
     float get(const std::string& name) const;
     void set(const std::string& name, float value);
     bool has(const std::string& name) const;
@@ -77,7 +170,18 @@ public:
     void apply_affective_modulation(float success_rate, float stability, float novelty);
     
 private:
-    std::unordered_map<std::string, Gene> genes_;
+    // Gene table in structure-of-arrays form, indexed by GeneHandle
+    std::vector<std::string> names_;
+    std::vector<float> values_;
+    std::vector<float> min_values_;
+    std::vector<float> max_values_;
+    std::vector<float> mutation_rates_;
+    std::vector<float> mutation_magnitudes_;
+    std::vector<uint8_t> is_critical_;
+    std::vector<float> fitness_contributions_;
+    std::vector<int> generations_created_;
+    std::unordered_map<std::string, GeneHandle> handles_;
+    
     int current_generation_;
     std::mt19937 rng_;
     
@@ -91,6 +195,8 @@ private:
     NeuromodulatorLevels neuromodulators_;
     
     void initialize_default_genome();
+    GeneHandle add_gene(const Gene& gene);
+    Gene gene_at(GeneHandle gene) const;
 };
 
 } // namespace evolution
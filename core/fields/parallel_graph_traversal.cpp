@@ -1,7 +1,9 @@
 #include "parallel_graph_traversal.h"
 #include <algorithm>
 #include <cmath>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <sstream>
 
 namespace melvin {
@@ -196,92 +198,6 @@ void ParallelGraphTraversal::spread_worker(
     }
 }
 
-std::vector<int> ParallelGraphTraversal::find_reasoning_chain(
-    int start_node,
-    int target_node,
-    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
-    size_t max_chain_length) {
-    
-    if (start_node == target_node) {
-        return {start_node};
-    }
-    
-    // Bidirectional search
-    SearchFrontier forward, backward;
-    
-    forward.node_to_path[start_node] = {start_node};
-    forward.queue.push({1.0f, start_node});
-    
-    backward.node_to_path[target_node] = {target_node};
-    backward.queue.push({1.0f, target_node});
-    
-    std::vector<int> result;
-    
-    // Alternate between forward and backward search
-    for (size_t iter = 0; iter < max_chain_length; ++iter) {
-        if (forward.queue.empty() && backward.queue.empty()) break;
-        
-        // Forward step
-        if (!forward.queue.empty()) {
-            if (bidirectional_step(forward, backward, graph, result)) {
-                return result;
-            }
-        }
-        
-        // Backward step
-        if (!backward.queue.empty()) {
-            if (bidirectional_step(backward, forward, graph, result)) {
-                // Reverse the backward part
-                std::reverse(result.begin(), result.end());
-                return result;
-            }
-        }
-    }
-    
-    return {};  // No path found within limit
-}
-
-bool ParallelGraphTraversal::bidirectional_step(
-    SearchFrontier& forward,
-    SearchFrontier& backward,
-    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
-    std::vector<int>& meeting_path) {
-    
-    if (forward.queue.empty()) return false;
-    
-    auto [priority, current_node] = forward.queue.top();
-    forward.queue.pop();
-    
-    // Check if we've met the other search
-    auto it = backward.node_to_path.find(current_node);
-    if (it != backward.node_to_path.end()) {
-        // Found meeting point!
-        meeting_path = forward.node_to_path[current_node];
-        auto& backward_path = it->second;
-        // Append backward path (reversed)
-        meeting_path.insert(meeting_path.end(), 
-                           backward_path.rbegin() + 1, backward_path.rend());
-        return true;
-    }
-    
-    // Expand neighbors
-    auto graph_it = graph.find(current_node);
-    if (graph_it != graph.end()) {
-        for (const auto& [neighbor_id, edge_weight] : graph_it->second) {
-            if (forward.node_to_path.count(neighbor_id)) continue;
-            
-            auto new_path = forward.node_to_path[current_node];
-            new_path.push_back(neighbor_id);
-            forward.node_to_path[neighbor_id] = new_path;
-            
-            float new_priority = priority * edge_weight;
-            forward.queue.push({new_priority, neighbor_id});
-        }
-    }
-    
-    return false;
-}
-
 std::unordered_set<int> ParallelGraphTraversal::get_energy_neighborhood(
     int origin_node,
     const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
@@ -370,6 +286,454 @@ std::unordered_map<int, float> ParallelGraphTraversal::compute_activation_field(
     return activations;
 }
 
+// ============================================================================
+// Path Queries over TraversalGraph
+// ============================================================================
+
+namespace {
+
+inline bool test_bit(const std::vector<uint64_t>& bits, uint32_t v) {
+    return (bits[v >> 6] >> (v & 63)) & 1;
+}
+
+inline void set_bit(std::vector<uint64_t>& bits, uint32_t v) {
+    bits[v >> 6] |= uint64_t(1) << (v & 63);
+}
+
+inline void clear_bit(std::vector<uint64_t>& bits, uint32_t v) {
+    bits[v >> 6] &= ~(uint64_t(1) << (v & 63));
+}
+
+using HeapEntry = std::pair<double, uint32_t>;
+
+// Cost of the cheapest edge u -> v
+double edge_cost(const TraversalGraph& graph, uint32_t u, uint32_t v) {
+    double cost = std::numeric_limits<double>::infinity();
+    for (uint32_t e = graph.out_offsets[u]; e < graph.out_offsets[u + 1]; ++e) {
+        if (graph.out_targets[e] == v) {
+            cost = std::min(cost, static_cast<double>(graph.out_costs[e]));
+        }
+    }
+    return cost;
+}
+
+} // namespace
+
+TraversalGraph TraversalGraph::build(
+    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph) {
+    
+    TraversalGraph csr;
+    auto intern = [&](int node_id) {
+        auto [it, inserted] = csr.index.try_emplace(node_id, static_cast<uint32_t>(csr.node_ids.size()));
+        if (inserted) csr.node_ids.push_back(node_id);
+        return it->second;
+    };
+    
+    // Neighbors need not have adjacency entries of their own
+    csr.index.reserve(graph.size());
+    size_t num_edges = 0;
+    for (const auto& [node_id, neighbors] : graph) {
+        intern(node_id);
+        num_edges += neighbors.size();
+    }
+    for (const auto& [node_id, neighbors] : graph) {
+        for (const auto& edge : neighbors) intern(edge.first);
+    }
+    
+    size_t n = csr.node_ids.size();
+    csr.out_offsets.assign(n + 1, 0);
+    csr.in_offsets.assign(n + 1, 0);
+    for (const auto& [node_id, neighbors] : graph) {
+        csr.out_offsets[csr.index[node_id] + 1] += static_cast<uint32_t>(neighbors.size());
+        for (const auto& edge : neighbors) csr.in_offsets[csr.index[edge.first] + 1]++;
+    }
+    for (size_t v = 0; v < n; ++v) {
+        csr.out_offsets[v + 1] += csr.out_offsets[v];
+        csr.in_offsets[v + 1] += csr.in_offsets[v];
+    }
+    
+    csr.out_targets.resize(num_edges);
+    csr.out_costs.resize(num_edges);
+    csr.in_sources.resize(num_edges);
+    csr.in_costs.resize(num_edges);
+    std::vector<uint32_t> in_fill(csr.in_offsets.begin(), csr.in_offsets.end() - 1);
+    for (const auto& [node_id, neighbors] : graph) {
+        uint32_t u = csr.index[node_id];
+        uint32_t e = csr.out_offsets[u];
+        for (const auto& [neighbor_id, weight] : neighbors) {
+            uint32_t v = csr.index[neighbor_id];
+            float cost = -std::log(std::clamp(weight, MIN_EDGE_WEIGHT, 1.0f));
+            csr.out_targets[e] = v;
+            csr.out_costs[e++] = cost;
+            csr.in_sources[in_fill[v]] = u;
+            csr.in_costs[in_fill[v]++] = cost;
+        }
+    }
+    
+    return csr;
+}
+
+void ParallelGraphTraversal::PathSearch::prepare(size_t num_nodes) {
+    if (dist[0].size() == num_nodes) return;
+    size_t words = (num_nodes + 63) / 64;
+    for (int side = 0; side < 2; ++side) {
+        dist[side].assign(num_nodes, 0.0);
+        parent[side].assign(num_nodes, TraversalGraph::NO_NODE);
+        reached[side].assign(words, 0);
+        settled[side].assign(words, 0);
+    }
+    banned.assign(words, 0);
+}
+
+void ParallelGraphTraversal::PathSearch::reset() {
+    // Every bit set belongs to a touched node, so whole words can go
+    for (uint32_t v : touched) {
+        for (int side = 0; side < 2; ++side) {
+            reached[side][v >> 6] = 0;
+            settled[side][v >> 6] = 0;
+        }
+    }
+    touched.clear();
+    heap[0].clear();
+    heap[1].clear();
+}
+
+std::vector<uint32_t> ParallelGraphTraversal::shortest_path(
+    const TraversalGraph& graph,
+    uint32_t source,
+    uint32_t target,
+    uint32_t spur_node,
+    const std::vector<uint32_t>& banned_targets,
+    double* cost) {
+    
+    PathSearch& ps = search_;
+    if (test_bit(ps.banned, source) || test_bit(ps.banned, target)) return {};
+    if (source == target) {
+        *cost = 0.0;
+        return {source};
+    }
+    
+    auto reach = [&](int side, uint32_t v, double d, uint32_t from) {
+        if (!test_bit(ps.reached[side], v)) {
+            set_bit(ps.reached[side], v);
+            ps.touched.push_back(v);
+        }
+        ps.dist[side][v] = d;
+        ps.parent[side][v] = from;
+        ps.heap[side].push_back({d, v});
+        std::push_heap(ps.heap[side].begin(), ps.heap[side].end(), std::greater<HeapEntry>());
+    };
+    auto edge_banned = [&](uint32_t from, uint32_t to) {
+        return from == spur_node &&
+               std::find(banned_targets.begin(), banned_targets.end(), to) != banned_targets.end();
+    };
+    // Drop entries for settled nodes or superseded distances
+    auto skip_stale = [&](int side) {
+        auto& heap = ps.heap[side];
+        while (!heap.empty() &&
+               (test_bit(ps.settled[side], heap.front().second) ||
+                heap.front().first > ps.dist[side][heap.front().second])) {
+            std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+            heap.pop_back();
+        }
+    };
+    
+    reach(0, source, 0.0, TraversalGraph::NO_NODE);
+    reach(1, target, 0.0, TraversalGraph::NO_NODE);
+    double best = std::numeric_limits<double>::infinity();
+    uint32_t meet = TraversalGraph::NO_NODE;
+    
+    while (true) {
+        skip_stale(0);
+        skip_stale(1);
+        if (ps.heap[0].empty() || ps.heap[1].empty()) break;
+        // No unsettled pair can beat the best meeting found
+        if (ps.heap[0].front().first + ps.heap[1].front().first >= best) break;
+        
+        // Grow the smaller frontier: forward along out-edges, backward along in-edges
+        int side = ps.heap[0].size() <= ps.heap[1].size() ? 0 : 1;
+        auto& heap = ps.heap[side];
+        auto [d, u] = heap.front();
+        std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+        heap.pop_back();
+        set_bit(ps.settled[side], u);
+        
+        const auto& offsets = side == 0 ? graph.out_offsets : graph.in_offsets;
+        const auto& nodes = side == 0 ? graph.out_targets : graph.in_sources;
+        const auto& costs = side == 0 ? graph.out_costs : graph.in_costs;
+        for (uint32_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+            uint32_t v = nodes[e];
+            if (test_bit(ps.banned, v) || test_bit(ps.settled[side], v)) continue;
+            if (side == 0 ? edge_banned(u, v) : edge_banned(v, u)) continue;
+            
+            double nd = d + costs[e];
+            if (!test_bit(ps.reached[side], v) || nd < ps.dist[side][v]) {
+                reach(side, v, nd, u);
+                if (test_bit(ps.reached[1 - side], v) && nd + ps.dist[1 - side][v] < best) {
+                    best = nd + ps.dist[1 - side][v];
+                    meet = v;
+                }
+            }
+        }
+    }
+    
+    std::vector<uint32_t> path;
+    if (meet != TraversalGraph::NO_NODE) {
+        for (uint32_t v = meet; v != TraversalGraph::NO_NODE; v = ps.parent[0][v]) path.push_back(v);
+        std::reverse(path.begin(), path.end());
+        for (uint32_t v = ps.parent[1][meet]; v != TraversalGraph::NO_NODE; v = ps.parent[1][v]) path.push_back(v);
+        *cost = best;
+    }
+    ps.reset();
+    return path;
+}
+
+const TraversalGraph& ParallelGraphTraversal::traversal_graph(
+    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    uint64_t graph_version) {
+    
+    if (cached_source_ != &graph || cached_version_ != graph_version) {
+        cached_graph_ = TraversalGraph::build(graph);
+        cached_source_ = &graph;
+        cached_version_ = graph_version;
+    }
+    return cached_graph_;
+}
+
+std::vector<int> ParallelGraphTraversal::find_reasoning_chain(
+    int start_node,
+    int target_node,
+    const TraversalGraph& graph,
+    size_t max_chain_length) {
+    
+    if (start_node == target_node) {
+        return {start_node};
+    }
+    uint32_t source = graph.find(start_node);
+    uint32_t target = graph.find(target_node);
+    if (source == TraversalGraph::NO_NODE || target == TraversalGraph::NO_NODE) {
+        return {};
+    }
+    
+    search_.prepare(graph.size());
+    double cost = 0.0;
+    std::vector<uint32_t> path = shortest_path(graph, source, target, TraversalGraph::NO_NODE, {}, &cost);
+    if (path.empty() || path.size() > max_chain_length) {
+        return {};  // No path found within limit
+    }
+    
+    std::vector<int> chain;
+    chain.reserve(path.size());
+    for (uint32_t v : path) chain.push_back(graph.node_ids[v]);
+    return chain;
+}
+
+std::vector<WeightedChain> ParallelGraphTraversal::find_reasoning_chains(
+    int start_node,
+    int target_node,
+    const TraversalGraph& graph,
+    size_t k) {
+    
+    std::vector<WeightedChain> chains;
+    uint32_t source = graph.find(start_node);
+    uint32_t target = graph.find(target_node);
+    if (k == 0 || source == TraversalGraph::NO_NODE || target == TraversalGraph::NO_NODE) {
+        return chains;
+    }
+    
+    struct Candidate {
+        std::vector<uint32_t> path;
+        double cost;
+    };
+    std::vector<Candidate> accepted;
+    std::vector<Candidate> candidates;
+    
+    search_.prepare(graph.size());
+    double cost = 0.0;
+    std::vector<uint32_t> first = shortest_path(graph, source, target, TraversalGraph::NO_NODE, {}, &cost);
+    if (first.empty()) {
+        return chains;
+    }
+    accepted.push_back({std::move(first), cost});
+    
+    // Yen: each next path leaves an accepted one at some spur node, without
+    // reusing its root or any edge an accepted path takes from that root
+    std::vector<uint32_t> banned_targets;
+    while (accepted.size() < k) {
+        const std::vector<uint32_t> previous = accepted.back().path;
+        double root_cost = 0.0;
+        
+        for (size_t i = 0; i + 1 < previous.size(); ++i) {
+            uint32_t spur = previous[i];
+            
+            banned_targets.clear();
+            for (const auto& chain : accepted) {
+                if (chain.path.size() > i + 1 &&
+                    std::equal(previous.begin(), previous.begin() + i + 1, chain.path.begin())) {
+                    banned_targets.push_back(chain.path[i + 1]);
+                }
+            }
+            for (size_t j = 0; j < i; ++j) set_bit(search_.banned, previous[j]);
+            
+            double spur_cost = 0.0;
+            std::vector<uint32_t> spur_path = shortest_path(graph, spur, target, spur, banned_targets, &spur_cost);
+            
+            for (size_t j = 0; j < i; ++j) clear_bit(search_.banned, previous[j]);
+            
+            if (!spur_path.empty()) {
+                Candidate candidate;
+                candidate.path.assign(previous.begin(), previous.begin() + i);
+                candidate.path.insert(candidate.path.end(), spur_path.begin(), spur_path.end());
+                candidate.cost = root_cost + spur_cost;
+                
+                auto same = [&](const Candidate& other) { return other.path == candidate.path; };
+                if (std::none_of(candidates.begin(), candidates.end(), same) &&
+                    std::none_of(accepted.begin(), accepted.end(), same)) {
+                    candidates.push_back(std::move(candidate));
+                }
+            }
+            root_cost += edge_cost(graph, spur, previous[i + 1]);
+        }
+        
+        if (candidates.empty()) break;
+        auto cheapest = std::min_element(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.cost < b.cost; });
+        accepted.push_back(std::move(*cheapest));
+        candidates.erase(cheapest);
+    }
+    
+    chains.reserve(accepted.size());
+    for (const auto& candidate : accepted) {
+        WeightedChain chain;
+        chain.nodes.reserve(candidate.path.size());
+        for (uint32_t v : candidate.path) chain.nodes.push_back(graph.node_ids[v]);
+        chain.strength = static_cast<float>(std::exp(-candidate.cost));
+        chains.push_back(std::move(chain));
+    }
+    return chains;
+}
+
+std::vector<int> ParallelGraphTraversal::hop_distances(
+    const std::vector<std::pair<int, int>>& queries,
+    const TraversalGraph& graph,
+    size_t max_hops) {
+    
+    std::vector<int> hops(queries.size(), -1);
+    size_t n = graph.size();
+    size_t num_batches = (queries.size() + 63) / 64;
+    if (n == 0 || num_batches == 0) {
+        return hops;
+    }
+    
+    // Pull instead of push once the frontier holds 1/BOTTOM_UP_FRACTION of the nodes
+    constexpr size_t BOTTOM_UP_FRACTION = 20;
+    
+    // Each worker owns its bitmasks and takes every num_workers-th batch
+    auto worker = [&](size_t first_batch, size_t batch_stride) {
+        std::vector<uint64_t> visited(n, 0), frontier(n, 0), next(n, 0);
+        std::vector<uint32_t> active, next_active, touched;
+        uint32_t sources[64], targets[64];
+        
+        for (size_t batch = first_batch; batch < num_batches; batch += batch_stride) {
+            size_t base = batch * 64;
+            size_t lanes = std::min(size_t(64), queries.size() - base);
+            uint64_t pending = 0;
+            
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                sources[lane] = graph.find(queries[base + lane].first);
+                targets[lane] = graph.find(queries[base + lane].second);
+                if (sources[lane] == TraversalGraph::NO_NODE || targets[lane] == TraversalGraph::NO_NODE) {
+                    continue;
+                }
+                if (sources[lane] == targets[lane]) {
+                    hops[base + lane] = 0;
+                    continue;
+                }
+                uint64_t bit = uint64_t(1) << lane;
+                uint32_t s = sources[lane];
+                if (visited[s] == 0) touched.push_back(s);
+                if (frontier[s] == 0) active.push_back(s);
+                visited[s] |= bit;
+                frontier[s] |= bit;
+                pending |= bit;
+            }
+            
+            for (size_t hop = 1; pending != 0 && !active.empty() && (max_hops == 0 || hop <= max_hops); ++hop) {
+                // One sweep advances every still-pending query by a hop:
+                // pushed along out-edges of the frontier while it's small,
+                // pulled along in-edges of unvisited nodes once it's large
+                if (active.size() * BOTTOM_UP_FRACTION < n) {
+                    for (uint32_t u : active) {
+                        uint64_t bits = frontier[u] & pending;
+                        frontier[u] = 0;
+                        if (bits == 0) continue;
+                        for (uint32_t e = graph.out_offsets[u]; e < graph.out_offsets[u + 1]; ++e) {
+                            uint32_t v = graph.out_targets[e];
+                            uint64_t fresh = bits & ~visited[v];
+                            if (fresh == 0) continue;
+                            if (next[v] == 0) next_active.push_back(v);
+                            next[v] |= fresh;
+                        }
+                    }
+                } else {
+                    for (uint32_t v = 0; v < n; ++v) {
+                        uint64_t missing = pending & ~visited[v];
+                        if (missing == 0) continue;
+                        uint64_t bits = 0;
+                        for (uint32_t e = graph.in_offsets[v]; e < graph.in_offsets[v + 1]; ++e) {
+                            bits |= frontier[graph.in_sources[e]];
+                            if ((bits & missing) == missing) break;
+                        }
+                        if (bits & missing) {
+                            next_active.push_back(v);
+                            next[v] = bits & missing;
+                        }
+                    }
+                    for (uint32_t u : active) frontier[u] = 0;
+                }
+                
+                for (uint32_t v : next_active) {
+                    if (visited[v] == 0) touched.push_back(v);
+                    visited[v] |= next[v];
+                    frontier[v] = next[v];
+                    next[v] = 0;
+                }
+                active.swap(next_active);
+                next_active.clear();
+                
+                for (uint64_t open = pending; open != 0; open &= open - 1) {
+                    size_t lane = __builtin_ctzll(open);
+                    if (visited[targets[lane]] & (uint64_t(1) << lane)) {
+                        hops[base + lane] = static_cast<int>(hop);
+                        pending &= ~(uint64_t(1) << lane);
+                    }
+                }
+            }
+            
+            for (uint32_t v : touched) {
+                visited[v] = 0;
+                frontier[v] = 0;
+            }
+            touched.clear();
+            active.clear();
+        }
+    };
+    
+    size_t num_workers = std::min(num_threads_, num_batches);
+    if (num_workers <= 1) {
+        worker(0, 1);
+        return hops;
+    }
+    std::vector<std::future<void>> futures;
+    for (size_t w = 0; w < num_workers; ++w) {
+        futures.push_back(std::async(std::launch::async, worker, w, num_workers));
+    }
+    for (auto& f : futures) {
+        f.get();
+    }
+    return hops;
+}
+
 // ============================================================================
 // ReasoningPathAnalyzer Implementation
 // ============================================================================
@@ -1,6 +1,7 @@
 #ifndef PARALLEL_GRAPH_TRAVERSAL_H
 #define PARALLEL_GRAPH_TRAVERSAL_H
 
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -49,6 +50,48 @@ struct TraversalStats {
     std::chrono::milliseconds duration;
 };
 
+/**
+ * @brief Compressed (CSR) copy of an adjacency map for path queries
+ * 
+ * Node ids are mapped to dense indices 0..size()-1, and out- and in-edges
+ * are stored contiguously, so searches run over flat arrays and bitmaps
+ * instead of hash maps. Edge costs are -log(weight), with weights clamped
+ * to [MIN_EDGE_WEIGHT, 1]: the cheapest path is the one with the strongest
+ * product of weights. Build once per graph version and reuse.
+ */
+struct TraversalGraph {
+    static constexpr uint32_t NO_NODE = UINT32_MAX;
+    static constexpr float MIN_EDGE_WEIGHT = 1e-6f;
+    
+    std::vector<int> node_ids;                  // Dense index -> node id
+    std::unordered_map<int, uint32_t> index;    // Node id -> dense index
+    
+    // Edges of v: [out_offsets[v], out_offsets[v + 1])
+    std::vector<uint32_t> out_offsets;
+    std::vector<uint32_t> out_targets;
+    std::vector<float> out_costs;
+    std::vector<uint32_t> in_offsets;
+    std::vector<uint32_t> in_sources;
+    std::vector<float> in_costs;
+    
+    static TraversalGraph build(
+        const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph
+    );
+    
+    size_t size() const { return node_ids.size(); }
+    size_t num_edges() const { return out_targets.size(); }
+    uint32_t find(int node_id) const {
+        auto it = index.find(node_id);
+        return it != index.end() ? it->second : NO_NODE;
+    }
+};
+
+// A path and the product of its edge weights
+struct WeightedChain {
+    std::vector<int> nodes;
+    float strength;
+};
+
 /**
  * @brief Parallel Graph Traversal Engine
  * 
@@ -110,19 +153,65 @@ public:
         size_t max_nodes_to_activate = 10000
     );
     
+    /**
+     * @brief TraversalGraph of an adjacency map, cached by graph version
+     * 
+     * Rebuilt only when called with a different map or graph_version, so
+     * callers that query a map repeatedly build its CSR once. Bump the
+     * version on every change to the map's edges or weights. The reference
+     * stays valid until the next call with another map or version.
+     */
+    const TraversalGraph& traversal_graph(
+        const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        uint64_t graph_version
+    );
+    
     /**
      * @brief Find reasoning chain between two concepts
      * 
-     * Uses bidirectional search from both ends.
-     * Returns the actual chain of reasoning.
+     * Bidirectional best-first (Dijkstra) search over edge directions: the
+     * chain with the strongest product of edge weights, following edges
+     * from start to target. Takes a TraversalGraph; for an adjacency map,
+     * use traversal_graph() so the CSR is built once, not per query.
      * 
-     * @return Vector of node IDs forming the reasoning chain
+     * @param max_chain_length Longest chain returned, in nodes (safety only)
+     * @return Vector of node IDs forming the reasoning chain. Empty if there
+     *         is none, or if the strongest chain has more than
+     *         max_chain_length nodes (no weaker, shorter chain is tried)
      */
     std::vector<int> find_reasoning_chain(
         int start_node,
         int target_node,
-        const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
-        size_t max_chain_length = 1000  // Safety only, not a traversal limit
+        const TraversalGraph& graph,
+        size_t max_chain_length = 1000
+    );
+    
+    /**
+     * @brief The k strongest loopless chains from start to target
+     * 
+     * Yen's algorithm on top of the bidirectional search, strongest first.
+     */
+    std::vector<WeightedChain> find_reasoning_chains(
+        int start_node,
+        int target_node,
+        const TraversalGraph& graph,
+        size_t k
+    );
+    
+    /**
+     * @brief Hop distances for many (start, target) queries at once
+     * 
+     * Multi-source BFS with one bit per query: each node holds a 64-bit
+     * visited mask, so one sweep over the edges advances 64 queries by a
+     * hop. Batches of 64 queries run on up to get_num_threads() threads.
+     * 
+     * @param max_hops Stop after this many hops (0 = no limit)
+     * @return Hops per query, -1 if unreachable (or unknown node)
+     */
+    std::vector<int> hop_distances(
+        const std::vector<std::pair<int, int>>& queries,
+        const TraversalGraph& graph,
+        size_t max_hops = 0
     );
     
     /**
@@ -209,17 +298,36 @@ private:
         float decay_rate
     );
     
-    // Bidirectional search helper
-    struct SearchFrontier {
-        std::unordered_map<int, std::vector<int>> node_to_path;
-        std::priority_queue<std::pair<float, int>> queue;  // (priority, node_id)
+    // Bidirectional search state, sized to the graph and reset by touched
+    // nodes only, so a query costs what it explores
+    struct PathSearch {
+        std::vector<double> dist[2];            // Forward, backward
+        std::vector<uint32_t> parent[2];
+        std::vector<uint64_t> reached[2];       // Bitmaps: dist/parent valid
+        std::vector<uint64_t> settled[2];
+        std::vector<uint64_t> banned;           // Nodes excluded (k-shortest)
+        std::vector<uint32_t> touched;
+        std::vector<std::pair<double, uint32_t>> heap[2];  // Min-heaps (cost, node)
+        
+        void prepare(size_t num_nodes);
+        void reset();
     };
+    PathSearch search_;
     
-    bool bidirectional_step(
-        SearchFrontier& forward,
-        SearchFrontier& backward,
-        const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
-        std::vector<int>& meeting_path
+    // traversal_graph() cache: the map it was built from and its version
+    const std::unordered_map<int, std::vector<std::pair<int, float>>>* cached_source_ = nullptr;
+    uint64_t cached_version_ = 0;
+    TraversalGraph cached_graph_;
+    
+    // Strongest path (dense indices) avoiding banned nodes and the edges
+    // from spur_node to banned_targets; empty if none
+    std::vector<uint32_t> shortest_path(
+        const TraversalGraph& graph,
+        uint32_t source,
+        uint32_t target,
+        uint32_t spur_node,
+        const std::vector<uint32_t>& banned_targets,
+        double* cost
     );
 };
 
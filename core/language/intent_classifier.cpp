@@ -5,41 +5,182 @@
 
 #include "intent_classifier.h"
 #include <algorithm>
-#include <sstream>
 #include <cctype>
 #include <cmath>
 
 namespace melvin {
 namespace language {
 
-std::vector<std::string> tokenize(const std::string& text) {
-    std::vector<std::string> tokens;
-    std::stringstream ss(text);
-    std::string word;
+namespace {
+
+// ============================================================================
+// Function words: stop words, question-word hints and comparison keywords in
+// one perfect-hash table built at compile time
+// ============================================================================
+
+enum WordFlags : uint8_t {
+    STOP_WORD = 1,
+    QUESTION_WORD = 2,
+    COMPARE_WORD = 4
+};
+
+struct FunctionWord {
+    std::string_view word;
+    uint8_t flags;
+    ReasoningIntent hint;  // For question words
+};
+
+constexpr FunctionWord FUNCTION_WORDS[] = {
+    {"a", STOP_WORD, ReasoningIntent::UNKNOWN}, {"an", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"the", STOP_WORD, ReasoningIntent::UNKNOWN}, {"is", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"are", STOP_WORD, ReasoningIntent::UNKNOWN}, {"was", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"were", STOP_WORD, ReasoningIntent::UNKNOWN}, {"be", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"been", STOP_WORD, ReasoningIntent::UNKNOWN}, {"being", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"have", STOP_WORD, ReasoningIntent::UNKNOWN}, {"has", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"had", STOP_WORD, ReasoningIntent::UNKNOWN}, {"do", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"does", STOP_WORD, ReasoningIntent::UNKNOWN}, {"did", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"will", STOP_WORD, ReasoningIntent::UNKNOWN}, {"would", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"should", STOP_WORD, ReasoningIntent::UNKNOWN}, {"could", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"may", STOP_WORD, ReasoningIntent::UNKNOWN}, {"might", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"must", STOP_WORD, ReasoningIntent::UNKNOWN}, {"can", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"of", STOP_WORD, ReasoningIntent::UNKNOWN}, {"in", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"on", STOP_WORD, ReasoningIntent::UNKNOWN}, {"at", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"to", STOP_WORD, ReasoningIntent::UNKNOWN}, {"for", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"with", STOP_WORD, ReasoningIntent::UNKNOWN}, {"by", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"from", STOP_WORD, ReasoningIntent::UNKNOWN}, {"about", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"as", STOP_WORD, ReasoningIntent::UNKNOWN}, {"into", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"through", STOP_WORD, ReasoningIntent::UNKNOWN}, {"during", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"before", STOP_WORD, ReasoningIntent::UNKNOWN}, {"after", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"above", STOP_WORD, ReasoningIntent::UNKNOWN}, {"below", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"between", STOP_WORD, ReasoningIntent::UNKNOWN}, {"under", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"again", STOP_WORD, ReasoningIntent::UNKNOWN}, {"further", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"then", STOP_WORD, ReasoningIntent::UNKNOWN}, {"once", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"here", STOP_WORD, ReasoningIntent::UNKNOWN}, {"there", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"all", STOP_WORD, ReasoningIntent::UNKNOWN}, {"both", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"each", STOP_WORD, ReasoningIntent::UNKNOWN}, {"few", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"more", STOP_WORD, ReasoningIntent::UNKNOWN}, {"most", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"other", STOP_WORD, ReasoningIntent::UNKNOWN}, {"some", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"such", STOP_WORD, ReasoningIntent::UNKNOWN}, {"no", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"nor", STOP_WORD, ReasoningIntent::UNKNOWN}, {"not", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"only", STOP_WORD, ReasoningIntent::UNKNOWN}, {"own", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"same", STOP_WORD, ReasoningIntent::UNKNOWN}, {"so", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"than", STOP_WORD, ReasoningIntent::UNKNOWN}, {"too", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"very", STOP_WORD, ReasoningIntent::UNKNOWN}, {"s", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"t", STOP_WORD, ReasoningIntent::UNKNOWN}, {"just", STOP_WORD, ReasoningIntent::UNKNOWN},
+    {"don", STOP_WORD, ReasoningIntent::UNKNOWN}, {"now", STOP_WORD, ReasoningIntent::UNKNOWN},
+    
+    // Question words for heuristic hints
+    {"what", QUESTION_WORD, ReasoningIntent::DEFINE},
+    {"where", QUESTION_WORD, ReasoningIntent::LOCATE},
+    {"why", QUESTION_WORD, ReasoningIntent::CAUSE},
+    {"when", QUESTION_WORD, ReasoningIntent::TEMPORAL},
+    {"how", QUESTION_WORD, ReasoningIntent::PROCESS},
+    
+    // Comparison keywords
+    {"difference", COMPARE_WORD, ReasoningIntent::COMPARE},
+    {"compare", COMPARE_WORD, ReasoningIntent::COMPARE},
+    {"vs", COMPARE_WORD, ReasoningIntent::COMPARE},
+    {"versus", COMPARE_WORD, ReasoningIntent::COMPARE}
+};
+
+constexpr size_t FUNCTION_WORD_COUNT = sizeof(FUNCTION_WORDS) / sizeof(FUNCTION_WORDS[0]);
+constexpr size_t FUNCTION_WORD_SLOTS = 1024;  // Power of two, sparse enough for a quick seed search
+
+constexpr uint32_t seeded_fnv1a(std::string_view word, uint32_t seed) {
+    uint32_t h = 2166136261u ^ seed;
+    for (char c : word) {
+        h = (h ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return h ^ (h >> 15);
+}
+
+struct FunctionWordTable {
+    uint32_t seed = 0;
+    uint8_t slots[FUNCTION_WORD_SLOTS] = {};  // FUNCTION_WORDS index + 1, 0 = empty
+};
+
+// First seed that puts every word in its own slot
+constexpr FunctionWordTable build_function_word_table() {
+    for (uint32_t seed = 1;; seed++) {
+        FunctionWordTable table;
+        table.seed = seed;
+        bool collision = false;
+        for (size_t i = 0; i < FUNCTION_WORD_COUNT && !collision; i++) {
+            uint32_t slot = seeded_fnv1a(FUNCTION_WORDS[i].word, seed) & (FUNCTION_WORD_SLOTS - 1);
+            collision = table.slots[slot] != 0;
+            table.slots[slot] = static_cast<uint8_t>(i + 1);
+        }
+        if (!collision) {
+            return table;
+        }
+    }
+}
+
+static_assert(FUNCTION_WORD_COUNT < 256, "slot entries are uint8_t");
+constexpr FunctionWordTable FUNCTION_WORD_TABLE = build_function_word_table();
+
+// One hash, one comparison
+const FunctionWord* find_function_word(std::string_view word) {
+    uint32_t slot = seeded_fnv1a(word, FUNCTION_WORD_TABLE.seed) & (FUNCTION_WORD_SLOTS - 1);
+    uint8_t entry = FUNCTION_WORD_TABLE.slots[slot];
+    if (entry == 0 || FUNCTION_WORDS[entry - 1].word != word) {
+        return nullptr;
+    }
+    return &FUNCTION_WORDS[entry - 1];
+}
+
+// sin terms of one token's hash embedding
+void add_token_terms(size_t hash, float* embedding) {
+    for (size_t i = 0; i < INTENT_EMBEDDING_DIM; i++) {
+        embedding[i] += std::sin(static_cast<float>(hash + i) * 0.01f);
+    }
+}
+
+} // namespace
+
+void tokenize_into(
+    std::string_view text,
+    std::string& scratch,
+    std::vector<std::string_view>& tokens
+) {
+    // Reserve up front: views must not move while tokens are appended
+    scratch.clear();
+    scratch.reserve(text.size());
+    tokens.clear();
     
-    while (ss >> word) {
+    size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() && std::isspace(static_cast<unsigned char>(text[i]))) i++;
+        
         // Remove punctuation and convert to lowercase
-        word.erase(std::remove_if(word.begin(), word.end(), ::ispunct), word.end());
-        std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+        size_t start = scratch.size();
+        for (; i < text.size() && !std::isspace(static_cast<unsigned char>(text[i])); i++) {
+            unsigned char c = static_cast<unsigned char>(text[i]);
+            if (!std::ispunct(c)) {
+                scratch.push_back(static_cast<char>(std::tolower(c)));
+            }
+        }
         
-        if (!word.empty()) {
-            tokens.push_back(word);
+        if (scratch.size() > start) {
+            tokens.emplace_back(scratch.data() + start, scratch.size() - start);
         }
     }
-    
-    return tokens;
+}
+
+std::vector<std::string> tokenize(const std::string& text) {
+    std::string scratch;
+    std::vector<std::string_view> views;
+    tokenize_into(text, scratch, views);
+    return std::vector<std::string>(views.begin(), views.end());
 }
 
 std::vector<float> compute_simple_embedding(const std::vector<std::string>& tokens) {
     // Simple hash-based embedding for now
     // TODO: Replace with real embedding model
-    std::vector<float> embedding(128, 0.0f);
+    std::vector<float> embedding(INTENT_EMBEDDING_DIM, 0.0f);
     
     for (const auto& token : tokens) {
-        size_t hash = std::hash<std::string>{}(token);
-        for (size_t i = 0; i < 128; i++) {
-            embedding[i] += std::sin(static_cast<float>(hash + i) * 0.01f);
-        }
+        add_token_terms(std::hash<std::string>{}(token), embedding.data());
     }
     
     // Normalize
@@ -58,10 +199,77 @@ std::vector<float> compute_simple_embedding(const std::vector<std::string>& toke
     return embedding;
 }
 
+// ============================================================================
+// TokenTable
+// ============================================================================
+
+uint32_t TokenTable::find(std::string_view token) const {
+    auto it = ids_.find(token);
+    return it != ids_.end() ? it->second : NOT_FOUND;
+}
+
+uint32_t TokenTable::intern(std::string_view token) {
+    auto it = ids_.find(token);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    if (strings_.size() >= MAX_TOKENS) {
+        return NOT_FOUND;
+    }
+    
+    uint32_t id = static_cast<uint32_t>(strings_.size());
+    strings_.emplace_back(token);
+    ids_.emplace(strings_.back(), id);
+    
+    // std::hash of a string_view equals that of the same std::string
+    terms_.resize(terms_.size() + INTENT_EMBEDDING_DIM, 0.0f);
+    add_token_terms(std::hash<std::string_view>{}(token), &terms_[id * INTENT_EMBEDDING_DIM]);
+    return id;
+}
+
+void TokenTable::embed(const std::vector<std::string_view>& tokens, std::vector<float>& embedding) {
+    embedding.assign(INTENT_EMBEDDING_DIM, 0.0f);
+    
+    // Same summation order as compute_simple_embedding, so same floats
+    for (std::string_view token : tokens) {
+        uint32_t id = intern(token);
+        if (id == NOT_FOUND) {
+            add_token_terms(std::hash<std::string_view>{}(token), embedding.data());
+            continue;
+        }
+        const float* row = terms(id);
+        for (size_t i = 0; i < INTENT_EMBEDDING_DIM; i++) {
+            embedding[i] += row[i];
+        }
+    }
+    
+    float norm = 0.0f;
+    for (float val : embedding) {
+        norm += val * val;
+    }
+    norm = std::sqrt(norm);
+    
+    if (norm > 1e-6f) {
+        for (float& val : embedding) {
+            val /= norm;
+        }
+    }
+}
+
+// ============================================================================
+// IntentClassifier
+// ============================================================================
+
+// Equal similarities go to the earlier entry
+const std::array<ReasoningIntent, IntentClassifier::PROTOTYPE_COUNT> IntentClassifier::PROTOTYPE_INTENTS = {
+    ReasoningIntent::TEMPORAL, ReasoningIntent::PROCESS, ReasoningIntent::REFLECT,
+    ReasoningIntent::ANALOGY, ReasoningIntent::COMPARE, ReasoningIntent::CAUSE,
+    ReasoningIntent::LOCATE, ReasoningIntent::DEFINE
+};
+
 IntentClassifier::IntentClassifier() {
     initialize_prototypes();
     initialize_strategies();
-    initialize_stop_words();
 }
 
 ReasoningIntent IntentClassifier::infer_intent(
@@ -69,20 +277,74 @@ ReasoningIntent IntentClassifier::infer_intent(
     const std::vector<std::string>& tokens
 ) {
     // First try keyword-based heuristic for speed
-    ReasoningIntent keyword_intent = classify_by_keywords(tokens);
+    views_.assign(tokens.begin(), tokens.end());
+    ReasoningIntent keyword_intent = classify_by_keywords(views_);
     if (keyword_intent != ReasoningIntent::UNKNOWN) {
         return keyword_intent;
     }
     
     // Fall back to embedding similarity
+    return closest_prototype(query_embedding);
+}
+
+ReasoningIntent IntentClassifier::classify(std::string_view query) {
+    tokenize_into(query, scratch_, views_);
+    
+    // Keyword hits never need the embedding
+    ReasoningIntent keyword_intent = classify_by_keywords(views_);
+    if (keyword_intent != ReasoningIntent::UNKNOWN) {
+        return keyword_intent;
+    }
+    
+    token_table_.embed(views_, embedding_);
+    return closest_prototype(embedding_);
+}
+
+void IntentClassifier::classify_many(
+    const std::vector<std::string_view>& queries,
+    std::vector<ReasoningIntent>& intents
+) {
+    intents.resize(queries.size());
+    for (size_t q = 0; q < queries.size(); q++) {
+        intents[q] = classify(queries[q]);
+    }
+}
+
+std::vector<float> IntentClassifier::embed(const std::vector<std::string>& tokens) {
+    views_.assign(tokens.begin(), tokens.end());
+    std::vector<float> embedding;
+    token_table_.embed(views_, embedding);
+    return embedding;
+}
+
+ReasoningIntent IntentClassifier::closest_prototype(const std::vector<float>& query_embedding) const {
+    if (query_embedding.size() != INTENT_EMBEDDING_DIM) {
+        return ReasoningIntent::UNKNOWN;
+    }
+    
+    // The query's norm is recomputed rather than assumed to be 1, as callers
+    // may pass their own embeddings
+    const float* a = query_embedding.data();
+    float norm_a = 0.0f;
+    for (size_t i = 0; i < INTENT_EMBEDDING_DIM; i++) {
+        norm_a += a[i] * a[i];
+    }
+    norm_a = std::sqrt(norm_a);
+    
     float best_similarity = -1.0f;
     ReasoningIntent best_intent = ReasoningIntent::UNKNOWN;
     
-    for (const auto& [intent, prototype] : intent_prototypes_) {
-        float sim = cosine_similarity(query_embedding, prototype);
+    for (size_t p = 0; p < PROTOTYPE_COUNT; p++) {
+        const float* b = &prototypes_[p * INTENT_EMBEDDING_DIM];
+        float dot = 0.0f;
+        for (size_t i = 0; i < INTENT_EMBEDDING_DIM; i++) {
+            dot += a[i] * b[i];
+        }
+        float denom = norm_a * prototype_norms_[p];
+        float sim = (denom > 1e-6f) ? (dot / denom) : 0.0f;
         if (sim > best_similarity) {
             best_similarity = sim;
-            best_intent = intent;
+            best_intent = PROTOTYPE_INTENTS[p];
         }
     }
     
@@ -138,8 +400,9 @@ IntentClassifier::QueryEntities IntentClassifier::extract_entities(
     return entities;
 }
 
-bool IntentClassifier::is_stop_word(const std::string& token) const {
-    return stop_words_.count(token) > 0;
+bool IntentClassifier::is_stop_word(std::string_view token) const {
+    const FunctionWord* word = find_function_word(token);
+    return word && (word->flags & STOP_WORD);
 }
 
 std::vector<std::string> IntentClassifier::get_content_words(
@@ -154,6 +417,18 @@ std::vector<std::string> IntentClassifier::get_content_words(
     return content;
 }
 
+void IntentClassifier::get_content_words(
+    const std::vector<std::string_view>& tokens,
+    std::vector<std::string_view>& content
+) const {
+    content.clear();
+    for (std::string_view token : tokens) {
+        if (!is_stop_word(token)) {
+            content.push_back(token);
+        }
+    }
+}
+
 void IntentClassifier::initialize_prototypes() {
     // Create learned prototypes from typical queries
     // In real implementation, these would be learned from data
@@ -167,14 +442,22 @@ void IntentClassifier::initialize_prototypes() {
     std::vector<std::string> process_examples = {"how", "steps", "procedure", "method", "way"};
     std::vector<std::string> temporal_examples = {"when", "time", "date", "history", "ago"};
     
-    intent_prototypes_[ReasoningIntent::DEFINE] = compute_simple_embedding(define_examples);
-    intent_prototypes_[ReasoningIntent::LOCATE] = compute_simple_embedding(locate_examples);
-    intent_prototypes_[ReasoningIntent::CAUSE] = compute_simple_embedding(cause_examples);
-    intent_prototypes_[ReasoningIntent::COMPARE] = compute_simple_embedding(compare_examples);
-    intent_prototypes_[ReasoningIntent::ANALOGY] = compute_simple_embedding(analogy_examples);
-    intent_prototypes_[ReasoningIntent::REFLECT] = compute_simple_embedding(reflect_examples);
-    intent_prototypes_[ReasoningIntent::PROCESS] = compute_simple_embedding(process_examples);
-    intent_prototypes_[ReasoningIntent::TEMPORAL] = compute_simple_embedding(temporal_examples);
+    // In PROTOTYPE_INTENTS order
+    const std::vector<std::string>* examples[PROTOTYPE_COUNT] = {
+        &temporal_examples, &process_examples, &reflect_examples, &analogy_examples,
+        &compare_examples, &cause_examples, &locate_examples, &define_examples
+    };
+    
+    for (size_t p = 0; p < PROTOTYPE_COUNT; p++) {
+        std::vector<float> prototype = compute_simple_embedding(*examples[p]);
+        std::copy(prototype.begin(), prototype.end(), &prototypes_[p * INTENT_EMBEDDING_DIM]);
+        
+        float norm = 0.0f;
+        for (float val : prototype) {
+            norm += val * val;
+        }
+        prototype_norms_[p] = std::sqrt(norm);
+    }
 }
 
 void IntentClassifier::initialize_strategies() {
@@ -244,55 +527,15 @@ void IntentClassifier::initialize_strategies() {
     strategies_[ReasoningIntent::UNKNOWN] = default_s;
 }
 
-void IntentClassifier::initialize_stop_words() {
-    stop_words_ = {
-        "a", "an", "the", "is", "are", "was", "were", "be", "been", "being",
-        "have", "has", "had", "do", "does", "did", "will", "would", "should",
-        "could", "may", "might", "must", "can", "of", "in", "on", "at", "to",
-        "for", "with", "by", "from", "about", "as", "into", "through", "during",
-        "before", "after", "above", "below", "between", "under", "again", "further",
-        "then", "once", "here", "there", "all", "both", "each", "few", "more",
-        "most", "other", "some", "such", "no", "nor", "not", "only", "own",
-        "same", "so", "than", "too", "very", "s", "t", "just", "don", "now"
-    };
-    
-    // Question words for heuristic hints
-    question_word_hints_["what"] = ReasoningIntent::DEFINE;
-    question_word_hints_["where"] = ReasoningIntent::LOCATE;
-    question_word_hints_["why"] = ReasoningIntent::CAUSE;
-    question_word_hints_["when"] = ReasoningIntent::TEMPORAL;
-    question_word_hints_["how"] = ReasoningIntent::PROCESS;
-}
-
-float IntentClassifier::cosine_similarity(
-    const std::vector<float>& a,
-    const std::vector<float>& b
-) const {
-    if (a.size() != b.size() || a.empty()) return 0.0f;
-    
-    float dot = 0.0f;
-    float norm_a = 0.0f;
-    float norm_b = 0.0f;
-    
-    for (size_t i = 0; i < a.size(); i++) {
-        dot += a[i] * b[i];
-        norm_a += a[i] * a[i];
-        norm_b += b[i] * b[i];
-    }
-    
-    float denom = std::sqrt(norm_a) * std::sqrt(norm_b);
-    return (denom > 1e-6f) ? (dot / denom) : 0.0f;
-}
-
 ReasoningIntent IntentClassifier::classify_by_keywords(
-    const std::vector<std::string>& tokens
+    const std::vector<std::string_view>& tokens
 ) const {
     if (tokens.empty()) return ReasoningIntent::UNKNOWN;
     
     // Check first few tokens for question words
     for (size_t i = 0; i < std::min(size_t(3), tokens.size()); i++) {
-        auto it = question_word_hints_.find(tokens[i]);
-        if (it != question_word_hints_.end()) {
+        const FunctionWord* word = find_function_word(tokens[i]);
+        if (word && (word->flags & QUESTION_WORD)) {
             // Special case: "how to" suggests PROCESS
             if (tokens[i] == "how" && i + 1 < tokens.size() && tokens[i + 1] == "to") {
                 return ReasoningIntent::PROCESS;
@@ -305,13 +548,14 @@ ReasoningIntent IntentClassifier::classify_by_keywords(
                     }
                 }
             }
-            return it->second;
+            return word->hint;
         }
     }
     
     // Check for comparison keywords
-    for (const auto& token : tokens) {
-        if (token == "difference" || token == "compare" || token == "vs" || token == "versus") {
+    for (std::string_view token : tokens) {
+        const FunctionWord* word = find_function_word(token);
+        if (word && (word->flags & COMPARE_WORD)) {
             return ReasoningIntent::COMPARE;
         }
     }
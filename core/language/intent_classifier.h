@@ -16,10 +16,13 @@
 #ifndef MELVIN_INTENT_CLASSIFIER_H
 #define MELVIN_INTENT_CLASSIFIER_H
 
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace melvin {
 namespace language {
@@ -75,6 +78,33 @@ struct ReasoningStrategy {
     {}
 };
 
+constexpr size_t INTENT_EMBEDDING_DIM = 128;
+
+/**
+ * @brief Interned tokens with precomputed embedding terms
+ * 
+ * Each distinct token is hashed and its sin terms computed once; an
+ * embedding is then a sum of table rows. Matches compute_simple_embedding.
+ */
+class TokenTable {
+public:
+    static constexpr uint32_t NOT_FOUND = UINT32_MAX;
+    static constexpr size_t MAX_TOKENS = 1 << 16;  // Past this, terms are computed per use
+    
+    uint32_t intern(std::string_view token);  // NOT_FOUND once full
+    uint32_t find(std::string_view token) const;
+    const float* terms(uint32_t id) const { return &terms_[id * INTENT_EMBEDDING_DIM]; }
+    size_t size() const { return strings_.size(); }
+    
+    // Normalized embedding of a token sequence
+    void embed(const std::vector<std::string_view>& tokens, std::vector<float>& embedding);
+    
+private:
+    std::deque<std::string> strings_;                      // Stable storage for the keys
+    std::unordered_map<std::string_view, uint32_t> ids_;
+    std::vector<float> terms_;                             // size() x INTENT_EMBEDDING_DIM
+};
+
 /**
  * @brief Embedding-based intent classifier
  */
@@ -94,6 +124,24 @@ public:
         const std::vector<std::string>& tokens
     );
     
+    /**
+     * @brief Tokenize, embed and classify raw queries
+     * 
+     * Same result as tokenize() → compute_simple_embedding() →
+     * infer_intent(), but over reused buffers and interned tokens, so a
+     * warm classifier doesn't allocate per query.
+     */
+    ReasoningIntent classify(std::string_view query);
+    void classify_many(
+        const std::vector<std::string_view>& queries,
+        std::vector<ReasoningIntent>& intents
+    );
+    
+    /**
+     * @brief Query embedding through the interned token table
+     */
+    std::vector<float> embed(const std::vector<std::string>& tokens);
+    
     /**
      * @brief Get reasoning strategy for intent
      * 
@@ -121,7 +169,7 @@ public:
     /**
      * @brief Check if token is a stop word
      */
-    bool is_stop_word(const std::string& token) const;
+    bool is_stop_word(std::string_view token) const;
     
     /**
      * @brief Get content words (filter stop words)
@@ -129,31 +177,38 @@ public:
     std::vector<std::string> get_content_words(
         const std::vector<std::string>& tokens
     ) const;
+    void get_content_words(
+        const std::vector<std::string_view>& tokens,
+        std::vector<std::string_view>& content
+    ) const;
     
 private:
-    // Intent prototypes (learned embeddings)
-    std::unordered_map<ReasoningIntent, std::vector<float>> intent_prototypes_;
+    // Intent prototypes (learned embeddings), one row per intent in
+    // PROTOTYPE_INTENTS order, with their norms
+    static constexpr size_t PROTOTYPE_COUNT = 8;
+    static const std::array<ReasoningIntent, PROTOTYPE_COUNT> PROTOTYPE_INTENTS;
+    std::array<float, PROTOTYPE_COUNT * INTENT_EMBEDDING_DIM> prototypes_;
+    std::array<float, PROTOTYPE_COUNT> prototype_norms_;
     
     // Reasoning strategies
     std::unordered_map<ReasoningIntent, ReasoningStrategy> strategies_;
     
-    // Stop words
-    std::unordered_set<std::string> stop_words_;
+    // Stop words and question-word hints live in a compile-time
+    // perfect-hash table (see intent_classifier.cpp)
     
-    // Question words for heuristic boost
-    std::unordered_map<std::string, ReasoningIntent> question_word_hints_;
+    // Reused per query
+    TokenTable token_table_;
+    std::string scratch_;
+    std::vector<std::string_view> views_;
+    std::vector<float> embedding_;
     
     void initialize_prototypes();
     void initialize_strategies();
-    void initialize_stop_words();
     
-    float cosine_similarity(
-        const std::vector<float>& a,
-        const std::vector<float>& b
-    ) const;
+    ReasoningIntent closest_prototype(const std::vector<float>& query_embedding) const;
     
     ReasoningIntent classify_by_keywords(
-        const std::vector<std::string>& tokens
+        const std::vector<std::string_view>& tokens
     ) const;
 };
 
@@ -162,6 +217,19 @@ private:
  */
 std::vector<std::string> tokenize(const std::string& text);
 
+/**
+ * @brief Tokenizer without per-token strings
+ * 
+ * Same rules as tokenize() (split on whitespace, drop punctuation,
+ * lowercase). The normalized text goes to scratch, which is reused
+ * across calls, and tokens are views into it.
+ */
+void tokenize_into(
+    std::string_view text,
+    std::string& scratch,
+    std::vector<std::string_view>& tokens
+);
+
 /**
  * @brief Compute simple embedding from tokens
  * (For now - later will use real embedding model)
@@ -495,8 +495,29 @@ std::string ContinuousMind::generate_text_output(int max_tokens) {
 }
 
 std::vector<float> ContinuousMind::generate_audio_output(float duration_sec) {
-    // TODO: Implement audio generation from active concepts
-    return std::vector<float>();
+    // Voice the learned vocal configuration of the active concepts
+    auto active = get_active_concepts();
+    std::vector<uint64_t> concept_ids(active.begin(), active.end());
+    
+    audio::SpeechPlan plan;
+    plan.segments.push_back(audio_layer_.get_vocal_config(concept_ids));
+    plan.segments.back().duration_ms = duration_sec * 1000.0f;
+    
+    audio::StreamingSynthesizer synth(16000);
+    synth.start(std::move(plan));
+    std::vector<float> output(synth.total_samples());
+    synth.render(output.data(), output.size());
+    return output;
+}
+
+void ContinuousMind::speak(const std::string& text) {
+    auto active = get_active_concepts();
+    std::vector<uint64_t> concept_ids(active.begin(), active.end());
+    audio_layer_.speak_streaming(text, {}, concept_ids, audio::HybridVocalGenerator::PURE_SELF);
+}
+
+size_t ContinuousMind::read_audio_output(float* out, size_t max_samples) {
+    return audio_layer_.read_speech(out, max_samples);
 }
 
 std::vector<float> ContinuousMind::generate_motor_command(int motor_id) {
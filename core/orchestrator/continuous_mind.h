@@ -76,6 +76,11 @@ public:
     std::vector<float> generate_audio_output(float duration_sec = 1.0f);
     std::vector<float> generate_motor_command(int motor_id);
     
+    // Streaming speech: speak() returns at once; the audio thread drains
+    // rendered blocks with read_audio_output()
+    void speak(const std::string& text);
+    size_t read_audio_output(float* out, size_t max_samples);
+    
     // Conversational methods
     std::string generate_conversational_response(
         const std::vector<int>& context_nodes,
@@ -6,12 +6,177 @@
 #include "answer_synthesizer.h"
 #include <sstream>
 #include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <deque>
+#include <unordered_set>
 
 namespace melvin {
 namespace reasoning {
 
-AnswerSynthesizer::AnswerSynthesizer() {}
+void TokenWindow::push(const std::string& token, std::string* evicted) {
+    tokens_.push_back(token);
+    counts_[token]++;
+    if (tokens_.size() <= capacity_) {
+        return;
+    }
+    
+    auto it = counts_.find(tokens_.front());
+    if (--it->second == 0) {
+        counts_.erase(it);
+    }
+    if (evicted) {
+        *evicted = std::move(tokens_.front());
+    }
+    tokens_.pop_front();
+}
+
+int TokenWindow::count(const std::string& token) const {
+    auto it = counts_.find(token);
+    return it != counts_.end() ? it->second : 0;
+}
+
+void TokenSampler::reset(
+    const std::vector<std::pair<std::string, float>>& pool,
+    float temperature,
+    float top_p
+) {
+    exponent_ = 1.0 / std::max(1e-3f, temperature);
+    top_p_ = top_p;
+    
+    size_t n = pool.size();
+    first_.clear();  // Views into tokens_, which is about to change
+    tokens_.resize(n);
+    base_.resize(n);
+    weight_.resize(n);
+    next_same_.assign(n, NONE);
+    for (size_t i = 0; i < n; ++i) {
+        tokens_[i].assign(pool[i].first);
+        base_[i] = std::max(1e-6, (double)pool[i].second);
+        weight_[i] = std::pow(base_[i], exponent_);
+    }
+    
+    // Repeated tokens are chained so a penalty reaches all of them
+    for (size_t i = n; i-- > 0;) {
+        auto [it, inserted] = first_.try_emplace(tokens_[i], i);
+        if (!inserted) {
+            next_same_[i] = it->second;
+            it->second = i;
+        }
+    }
+    
+    candidate_pos_.assign(n, NONE);
+    dirty_ = true;
+}
+
+void TokenSampler::set_penalty(const std::string& token, double factor) {
+    auto it = first_.find(token);
+    if (it == first_.end()) {
+        return;
+    }
+    
+    for (size_t i = it->second; i != NONE; i = next_same_[i]) {
+        double w = std::pow(base_[i] * factor, exponent_);
+        size_t c = candidate_pos_[i];
+        if (c != NONE) {
+            mass_ += w - weight_[i];
+            if (w > built_[c]) dirty_ = true;  // Rejection can't raise a weight
+        } else if (w > weight_[i]) {
+            dirty_ = true;  // May belong in the nucleus now
+        }
+        weight_[i] = w;
+    }
+}
+
+void TokenSampler::build() {
+    size_t n = tokens_.size();
+    double total = 0.0;
+    for (double w : weight_) total += w;
+    
+    // Nucleus top-p: sort only as far as needed, doubling the sorted prefix
+    order_.resize(n);
+    for (size_t i = 0; i < n; ++i) order_[i] = i;
+    candidates_.clear();
+    if (top_p_ >= 1.0) {
+        candidates_ = order_;
+    } else {
+        double target = top_p_ * std::max(1e-12, total);
+        double cum = 0.0;
+        size_t sorted = 0;
+        size_t k = std::min(n, size_t(16));
+        auto heavier = [&](size_t a, size_t b) { return weight_[a] > weight_[b]; };
+        while (sorted < n && cum < target) {
+            std::partial_sort(order_.begin() + sorted, order_.begin() + k, order_.end(), heavier);
+            for (; sorted < k && cum < target; ++sorted) {
+                candidates_.push_back(order_[sorted]);
+                cum += weight_[order_[sorted]];
+            }
+            k = std::min(n, k * 2);
+        }
+    }
+    
+    // Walker alias table (Vose's construction)
+    size_t m = candidates_.size();
+    std::fill(candidate_pos_.begin(), candidate_pos_.end(), NONE);
+    built_.resize(m);
+    alias_prob_.resize(m);
+    alias_.resize(m);
+    built_mass_ = 0.0;
+    for (size_t c = 0; c < m; ++c) {
+        candidate_pos_[candidates_[c]] = c;
+        built_[c] = weight_[candidates_[c]];
+        built_mass_ += built_[c];
+    }
+    mass_ = built_mass_;
+    
+    small_.clear();
+    large_.clear();
+    for (size_t c = 0; c < m; ++c) {
+        alias_prob_[c] = built_[c] * m / built_mass_;
+        alias_[c] = static_cast<uint32_t>(c);
+        (alias_prob_[c] < 1.0 ? small_ : large_).push_back(static_cast<uint32_t>(c));
+    }
+    while (!small_.empty() && !large_.empty()) {
+        uint32_t s = small_.back(); small_.pop_back();
+        uint32_t l = large_.back();
+        alias_[s] = l;
+        alias_prob_[l] -= 1.0 - alias_prob_[s];
+        if (alias_prob_[l] < 1.0) {
+            large_.pop_back();
+            small_.push_back(l);
+        }
+    }
+    for (uint32_t c : small_) alias_prob_[c] = 1.0;  // Rounding leftovers
+    for (uint32_t c : large_) alias_prob_[c] = 1.0;
+    
+    dirty_ = false;
+}
+
+size_t TokenSampler::sample(std::mt19937& rng) {
+    if (tokens_.empty()) {
+        return NONE;
+    }
+    if (dirty_ || mass_ < REBUILD_MASS * built_mass_) {
+        build();
+    }
+    
+    // Alias draw, then accept with current / built weight (>= 3/4 on average)
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    size_t m = candidates_.size();
+    while (true) {
+        double x = uniform(rng) * m;
+        size_t c = std::min(m - 1, static_cast<size_t>(x));
+        if (x - c >= alias_prob_[c]) {
+            c = alias_[c];
+        }
+        size_t i = candidates_[c];
+        if (weight_[i] >= built_[c] || uniform(rng) * built_[c] < weight_[i]) {
+            return i;
+        }
+    }
+}
+
+AnswerSynthesizer::AnswerSynthesizer() : rng_(static_cast<uint32_t>(rand())) {}
 
 std::string AnswerSynthesizer::generate_lm_style(
     const std::vector<std::pair<std::string, float>>& top_concepts,
@@ -47,40 +212,25 @@ std::string AnswerSynthesizer::generate_lm_style(
     float mean_conf = 0.0f; for (float c : recent_conf) mean_conf += c; mean_conf /= std::max<size_t>(1, recent_conf.size());
     if (mean_conf > 0.95f) temperature = 1.2f; // confidence damping -> raise temperature
     
-    // Helper to sample from weighted tokens (with global repetition penalty + nucleus top-p)
+    // Sampler over the pool (nucleus top-p 0.9) with global repetition penalty
     std::unordered_map<std::string, int> used;
-    static std::deque<std::string> recent_tokens;
+    static TokenWindow recent_tokens(50);
     static std::string last_sentence;
-    auto recent_penalty = [&](const std::string& t){
-        int cnt = 0; for (const auto& s : recent_tokens) if (s == t) cnt++;
-        return std::pow(0.8f, (float)cnt); // more repeats => stronger downweight
+    auto penalize = [&](const std::string& t){
+        auto it = used.find(t);
+        int uses = it != used.end() ? it->second : 0;
+        // more repeats => stronger downweight
+        sampler_.set_penalty(t, std::pow(0.8, recent_tokens.count(t)) / std::pow(repetition_penalty, uses));
     };
+    sampler_.reset(token_pool, temperature, 0.9f);
+    for (const auto& entry : token_pool) {
+        if (recent_tokens.count(entry.first) > 0) penalize(entry.first);
+    }
     auto sample_token = [&]()->std::string{
-        // Build softmax over weights/temperature with repetition penalty
-        double sum = 0.0;
-        std::vector<double> probs(token_pool.size());
-        for (size_t i = 0; i < token_pool.size(); ++i) {
-            double w = std::max(1e-6, (double)token_pool[i].second);
-            w *= (double)recent_penalty(token_pool[i].first);
-            if (used.count(token_pool[i].first)) {
-                w *= std::pow(repetition_penalty, used[token_pool[i].first]);
-            }
-            double p = std::pow(w, 1.0 / temperature);
-            probs[i] = p;
-            sum += p;
-        }
-        // sort indices by prob desc
-        std::vector<size_t> idx(probs.size()); for (size_t i = 0; i < idx.size(); ++i) idx[i] = i;
-        std::sort(idx.begin(), idx.end(), [&](size_t a, size_t b){ return probs[a] > probs[b]; });
-        // nucleus top-p (0.9)
-        double norm_sum = std::max(1e-12, sum);
-        double cum = 0.0; std::vector<size_t> nucleus; nucleus.reserve(idx.size());
-        for (size_t j = 0; j < idx.size(); ++j) {
-            double pj = probs[idx[j]] / norm_sum; cum += pj; nucleus.push_back(idx[j]); if (cum >= 0.9) break;
-        }
-        size_t pick = nucleus.empty() ? idx.front() : nucleus[(size_t)rand() % nucleus.size()];
-        used[token_pool[pick].first]++;
-        return token_pool[pick].first;
+        const std::string& tok = sampler_.token(sampler_.sample(rng_));
+        used[tok]++;
+        penalize(tok);
+        return tok;
     };
     
     // Generate 6-12 tokens (organic sentence length), limit function words to 30%
@@ -92,7 +242,7 @@ std::string AnswerSynthesizer::generate_lm_style(
     for (int i = 0; i < target_tokens; ++i) {
         std::string tok = sample_token();
         if (tok == prev_token) repeat_count++; else repeat_count = 0;
-        if (repeat_count >= 2) { used[tok] += 2; tok = sample_token(); repeat_count = (tok == prev_token) ? 1 : 0; }
+        if (repeat_count >= 2) { used[tok] += 2; penalize(tok); tok = sample_token(); repeat_count = (tok == prev_token) ? 1 : 0; }
         bool is_function = (tok == "and" || tok == "also" || tok == "because" || tok == "however" || tok == "maybe");
         if (is_function && fn_used >= max_function) { --i; continue; }
         if (i > 0) out << " ";
@@ -104,8 +254,10 @@ std::string AnswerSynthesizer::generate_lm_style(
         prev_token = tok;
         if (is_function) fn_used++;
         // track global recent tokens
-        recent_tokens.push_back(tok);
-        if (recent_tokens.size() > 50) recent_tokens.pop_front();
+        std::string evicted;
+        recent_tokens.push(tok, &evicted);
+        penalize(tok);
+        if (!evicted.empty()) penalize(evicted);
     }
     std::string sentence = out.str() + ".";
     // If sentence overlaps heavily with last, increase temperature next call via static effect
@@ -152,40 +304,25 @@ std::string AnswerSynthesizer::generate(
     float temperature = std::clamp(0.8f + (0.5f - std::min(spread, 0.5f)), 0.7f, 1.3f);
     float repetition_penalty = 0.85f; // discourage immediate repeats
     
-    // Helper to sample from weighted tokens
-    auto sample_token = [&](std::unordered_map<std::string,int>& used)->std::string{
-        // Build softmax over weights/temperature with repetition penalty
-        double sum = 0.0;
-        std::vector<double> probs(token_pool.size());
-        for (size_t i = 0; i < token_pool.size(); ++i) {
-            double w = std::max(1e-6, (double)token_pool[i].second);
-            auto it = used.find(token_pool[i].first);
-            if (it != used.end()) {
-                w *= std::pow(repetition_penalty, std::min(5, it->second));
-            }
-            w = std::pow(w, 1.0/temperature);
-            probs[i] = w; sum += w;
-        }
-        if (sum <= 0.0) return "";
-        for (auto& p : probs) p /= sum;
-        double r = (double)rand() / RAND_MAX;
-        double acc = 0.0;
-        for (size_t i = 0; i < probs.size(); ++i) { acc += probs[i]; if (r <= acc) return token_pool[i].first; }
-        return token_pool.back().first;
+    // Sampler over the whole pool, penalized by how often a token was used
+    std::unordered_map<std::string,int> used;
+    auto use = [&](const std::string& t){
+        int uses = ++used[t];
+        sampler_.set_penalty(t, std::pow(repetition_penalty, std::min(5, uses)));
     };
+    sampler_.reset(token_pool, temperature, 1.0f);
     
     // Compose sentence 8-20 tokens
-    std::unordered_map<std::string,int> used;
     int len = 8 + (rand() % 13);
     std::vector<std::string> words; words.reserve(len);
     
     // Seed with a query token if present
     if (!query_tokens.empty()) {
         words.push_back(query_tokens.front());
-        used[words.back()]++;
+        use(words.back());
     }
     while ((int)words.size() < len) {
-        std::string t = sample_token(used);
+        std::string t = sampler_.token(sampler_.sample(rng_));
         if (t.empty()) break;
         // Avoid doubling connectors
         if (!words.empty()) {
@@ -196,7 +333,7 @@ std::string AnswerSynthesizer::generate(
             }
         }
         words.push_back(t);
-        used[t]++;
+        use(t);
     }
     
     // Basic cleanup and capitalization
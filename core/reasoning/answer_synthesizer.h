@@ -12,7 +12,11 @@
 #ifndef MELVIN_ANSWER_SYNTHESIZER_H
 #define MELVIN_ANSWER_SYNTHESIZER_H
 
+#include <cstdint>
+#include <deque>
+#include <random>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
 #include "semantic_scorer.h"
@@ -21,6 +25,89 @@
 namespace melvin {
 namespace reasoning {
 
+/**
+ * @brief Recently emitted tokens with a count per token
+ */
+class TokenWindow {
+public:
+    explicit TokenWindow(size_t capacity) : capacity_(capacity) {}
+    
+    // Appends a token; the one pushed out of the window (if any) goes to evicted
+    void push(const std::string& token, std::string* evicted = nullptr);
+    int count(const std::string& token) const;
+    
+private:
+    size_t capacity_;
+    std::deque<std::string> tokens_;
+    std::unordered_map<std::string, int> counts_;
+};
+
+/**
+ * @brief Weighted token sampling with top-p and repetition penalties
+ * 
+ * The top-p nucleus is found with a partial sort and drawn from with a
+ * Walker alias table, so a draw is O(1) expected. Penalties only touch the
+ * penalized token: draws are rejected in proportion to how far a
+ * candidate's weight has dropped since the table was built, and the table
+ * is rebuilt once the candidates have lost a quarter of their mass or any
+ * weight went up. Buffers are reused across resets.
+ */
+class TokenSampler {
+public:
+    static constexpr size_t NONE = SIZE_MAX;
+    
+    /**
+     * @brief Start sampling from a new pool
+     * 
+     * Weight of a token is (max(1e-6, score) * penalty)^(1 / temperature);
+     * penalties start at 1. top_p >= 1 samples from the whole pool.
+     */
+    void reset(
+        const std::vector<std::pair<std::string, float>>& pool,
+        float temperature,
+        float top_p
+    );
+    
+    /**
+     * @brief Set the penalty factor of every pool entry for a token
+     * 
+     * Tokens not in the pool are ignored.
+     */
+    void set_penalty(const std::string& token, double factor);
+    
+    // Pool index of a draw, NONE if the pool is empty
+    size_t sample(std::mt19937& rng);
+    
+    const std::string& token(size_t index) const { return tokens_[index]; }
+    size_t size() const { return tokens_.size(); }
+    
+private:
+    static constexpr double REBUILD_MASS = 0.75;
+    
+    double exponent_ = 1.0;                    // 1 / temperature
+    double top_p_ = 1.0;
+    
+    std::vector<std::string> tokens_;
+    std::vector<double> base_;                 // max(1e-6, score)
+    std::vector<double> weight_;               // Current, with penalty and temperature
+    std::unordered_map<std::string_view, size_t> first_;  // Token → first pool index
+    std::vector<size_t> next_same_;            // Next pool index with the same token
+    
+    // Nucleus at the last build and its alias table
+    std::vector<size_t> order_;
+    std::vector<size_t> candidates_;
+    std::vector<size_t> candidate_pos_;        // Pool index → candidate, NONE if not one
+    std::vector<double> built_;                // Candidate weights at build time
+    std::vector<double> alias_prob_;
+    std::vector<uint32_t> alias_;
+    std::vector<uint32_t> small_, large_;
+    double built_mass_ = 0.0;
+    double mass_ = 0.0;                        // Current weight of the candidates
+    bool dirty_ = true;
+    
+    void build();
+};
+
 /**
  * @brief Answer synthesizer
  * 
@@ -107,6 +194,9 @@ private:
     std::string capitalize_first(const std::string& str);
     
     bool is_query_node(int node_id, const std::vector<int>& query_node_ids);
+    
+    TokenSampler sampler_;
+    std::mt19937 rng_;
 };
 
 } // namespace reasoning
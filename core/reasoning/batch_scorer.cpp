@@ -0,0 +1,197 @@
+/**
+ * @file batch_scorer.cpp
+ * @brief Implementation of batched similarity scoring
+ */
+
+#include "batch_scorer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// SSE is baseline on x86-64 and NEON on aarch64, so no extra flags are needed
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MELVIN_BATCH_SSE 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MELVIN_BATCH_NEON 1
+#endif
+
+namespace melvin {
+namespace reasoning {
+
+namespace {
+
+#if defined(MELVIN_BATCH_SSE)
+inline float hsum(__m128 v) {
+    __m128 shuf = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+}
+#endif
+
+// Four rows against one vector: each query lane is loaded once per block
+void dot4(const float* r0, const float* r1, const float* r2, const float* r3,
+          const float* q, size_t n, float* out) {
+    size_t i = 0;
+#if defined(MELVIN_BATCH_SSE)
+    __m128 a0 = _mm_setzero_ps(), a1 = _mm_setzero_ps();
+    __m128 a2 = _mm_setzero_ps(), a3 = _mm_setzero_ps();
+    for (; i + 4 <= n; i += 4) {
+        __m128 qv = _mm_loadu_ps(q + i);
+        a0 = _mm_add_ps(a0, _mm_mul_ps(_mm_loadu_ps(r0 + i), qv));
+        a1 = _mm_add_ps(a1, _mm_mul_ps(_mm_loadu_ps(r1 + i), qv));
+        a2 = _mm_add_ps(a2, _mm_mul_ps(_mm_loadu_ps(r2 + i), qv));
+        a3 = _mm_add_ps(a3, _mm_mul_ps(_mm_loadu_ps(r3 + i), qv));
+    }
+    out[0] = hsum(a0); out[1] = hsum(a1); out[2] = hsum(a2); out[3] = hsum(a3);
+#elif defined(MELVIN_BATCH_NEON)
+    float32x4_t a0 = vdupq_n_f32(0.0f), a1 = vdupq_n_f32(0.0f);
+    float32x4_t a2 = vdupq_n_f32(0.0f), a3 = vdupq_n_f32(0.0f);
+    for (; i + 4 <= n; i += 4) {
+        float32x4_t qv = vld1q_f32(q + i);
+        a0 = vfmaq_f32(a0, vld1q_f32(r0 + i), qv);
+        a1 = vfmaq_f32(a1, vld1q_f32(r1 + i), qv);
+        a2 = vfmaq_f32(a2, vld1q_f32(r2 + i), qv);
+        a3 = vfmaq_f32(a3, vld1q_f32(r3 + i), qv);
+    }
+    out[0] = vaddvq_f32(a0); out[1] = vaddvq_f32(a1); out[2] = vaddvq_f32(a2); out[3] = vaddvq_f32(a3);
+#else
+    out[0] = out[1] = out[2] = out[3] = 0.0f;
+#endif
+    for (; i < n; ++i) {
+        out[0] += r0[i] * q[i];
+        out[1] += r1[i] * q[i];
+        out[2] += r2[i] * q[i];
+        out[3] += r3[i] * q[i];
+    }
+}
+
+} // namespace
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+float BatchScorer::dot(const float* a, const float* b, size_t n) {
+    size_t i = 0;
+    float sum = 0.0f;
+#if defined(MELVIN_BATCH_SSE)
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    sum = hsum(_mm_add_ps(acc0, acc1));
+#elif defined(MELVIN_BATCH_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f), acc1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vfmaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vfmaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    sum = vaddvq_f32(vaddq_f32(acc0, acc1));
+#endif
+    for (; i < n; ++i) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void BatchScorer::accumulate(float* dst, const float* src, size_t n) {
+    size_t i = 0;
+#if defined(MELVIN_BATCH_SSE)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(dst + i, _mm_add_ps(_mm_loadu_ps(dst + i), _mm_loadu_ps(src + i)));
+    }
+#elif defined(MELVIN_BATCH_NEON)
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(dst + i, vaddq_f32(vld1q_f32(dst + i), vld1q_f32(src + i)));
+    }
+#endif
+    for (; i < n; ++i) {
+        dst[i] += src[i];
+    }
+}
+
+// ============================================================================
+// Gather / score
+// ============================================================================
+
+void BatchScorer::reset(const std::vector<float>& query) {
+    dim_ = query.size();
+    query_ = query;
+    query_norm_ = std::sqrt(dot(query_.data(), query_.data(), dim_));
+    matrix_.clear();
+    norms_.clear();
+    ids_.clear();
+}
+
+size_t BatchScorer::add(int id, const std::vector<float>& embedding) {
+    size_t row = ids_.size();
+    matrix_.resize((row + 1) * dim_, 0.0f);
+
+    float* dst = matrix_.data() + row * dim_;
+    size_t n = std::min(dim_, embedding.size());
+    if (n > 0) {
+        std::memcpy(dst, embedding.data(), n * sizeof(float));
+    }
+
+    ids_.push_back(id);
+    norms_.push_back(std::sqrt(dot(dst, dst, dim_)));
+    return row;
+}
+
+void BatchScorer::dot_all(std::vector<float>& out) const {
+    size_t n = ids_.size();
+    out.resize(n);
+
+    const float* q = query_.data();
+    size_t r = 0;
+    for (; r + 4 <= n; r += 4) {
+        dot4(row(r), row(r + 1), row(r + 2), row(r + 3), q, dim_, out.data() + r);
+    }
+    for (; r < n; ++r) {
+        out[r] = dot(row(r), q, dim_);
+    }
+}
+
+void BatchScorer::cosine_all(std::vector<float>& out) const {
+    dot_all(out);
+    for (size_t r = 0; r < out.size(); ++r) {
+        float denom = norms_[r] * query_norm_;
+        out[r] = (denom > 1e-6f) ? out[r] / denom : 0.0f;
+    }
+}
+
+void BatchScorer::top_k(const float* scores, size_t n, size_t k, std::vector<BatchHit>& out) {
+    out.clear();
+    k = std::min(k, n);
+    if (k == 0) {
+        return;
+    }
+
+    // "Better" ordering: higher score, then lower row; the heap keeps the
+    // worst of the current k at the front so each candidate is one compare
+    auto better = [](const BatchHit& a, const BatchHit& b) {
+        return a.score > b.score || (a.score == b.score && a.row < b.row);
+    };
+
+    out.reserve(k);
+    for (size_t i = 0; i < n; ++i) {
+        BatchHit hit{i, scores[i]};
+        if (out.size() < k) {
+            out.push_back(hit);
+            std::push_heap(out.begin(), out.end(), better);
+        } else if (better(hit, out.front())) {
+            std::pop_heap(out.begin(), out.end(), better);
+            out.back() = hit;
+            std::push_heap(out.begin(), out.end(), better);
+        }
+    }
+
+    std::sort_heap(out.begin(), out.end(), better);
+}
+
+} // namespace reasoning
+} // namespace melvin
@@ -0,0 +1,91 @@
+/**
+ * @file batch_scorer.h
+ * @brief Batched similarity scoring over a contiguous embedding block
+ *
+ * Scoring candidates one unordered_map lookup and one scalar loop at a time
+ * leaves most of the cost in pointer chasing. BatchScorer instead:
+ * - Gathers candidate embeddings once into a row-major [n × dim] block
+ * - Scores every row against the query with one vectorized mat-vec pass
+ * - Selects top-k with a bounded min-heap (O(n log k), no full sort)
+ *
+ * Buffers are kept between calls, so a scorer reused across hops or queries
+ * stops allocating after warm-up.
+ */
+
+#ifndef MELVIN_BATCH_SCORER_H
+#define MELVIN_BATCH_SCORER_H
+
+#include <cstddef>
+#include <vector>
+
+namespace melvin {
+namespace reasoning {
+
+/**
+ * @brief Row index and score of a top-k candidate
+ */
+struct BatchHit {
+    size_t row;
+    float score;
+};
+
+class BatchScorer {
+public:
+    BatchScorer() = default;
+
+    /**
+     * @brief Set the query vector and drop previously gathered rows
+     *
+     * The embedding dimension is taken from the query.
+     */
+    void reset(const std::vector<float>& query);
+
+    /**
+     * @brief Gather one candidate embedding as the next row
+     *
+     * Embeddings of a different length are truncated / zero-padded to the
+     * query dimension (the overlap is scored, as the scalar paths did).
+     * @return Row index of the candidate
+     */
+    size_t add(int id, const std::vector<float>& embedding);
+
+    size_t size() const { return ids_.size(); }
+    size_t dim() const { return dim_; }
+    int id(size_t row) const { return ids_[row]; }
+    const float* row(size_t row) const { return matrix_.data() + row * dim_; }
+
+    /**
+     * @brief out[i] = query · row_i
+     */
+    void dot_all(std::vector<float>& out) const;
+
+    /**
+     * @brief out[i] = cos(query, row_i); 0 for zero-norm rows or query
+     */
+    void cosine_all(std::vector<float>& out) const;
+
+    /**
+     * @brief Best k of scores[0..n) by a bounded heap, highest first
+     *
+     * Ties are broken by lower index so results are deterministic.
+     */
+    static void top_k(const float* scores, size_t n, size_t k, std::vector<BatchHit>& out);
+
+    // Vector kernels shared with callers that aggregate embeddings
+    static float dot(const float* a, const float* b, size_t n);
+    static void accumulate(float* dst, const float* src, size_t n);
+
+private:
+    size_t dim_ = 0;
+    std::vector<float> query_;
+    float query_norm_ = 0.0f;
+
+    std::vector<float> matrix_;                 // Row-major, size() × dim_
+    std::vector<float> norms_;                  // L2 norm per row
+    std::vector<int> ids_;                      // Caller id per row
+};
+
+} // namespace reasoning
+} // namespace melvin
+
+#endif // MELVIN_BATCH_SCORER_H
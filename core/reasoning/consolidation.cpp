@@ -1,6 +1,11 @@
 #include "consolidation.h"
 #include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <thread>
 #include <unordered_set>
+#include <utility>
 #include <iostream>
 
 namespace melvin {
@@ -13,6 +18,225 @@ struct PairHash {
     }
 };
 
+namespace {
+
+constexpr size_t SKETCH_BITS = 128;  // Hyperplanes per SimHash sketch
+constexpr size_t MAX_PAIRS_PER_BATCH = 1 << 20;  // Verified together, in parallel
+constexpr uint32_t NO_NODE = UINT32_MAX;
+constexpr float PRIORITY_EPSILON = 0.01f;  // Keeps every experience sampleable
+
+// Runs fn(begin, end) over [0, n) split across hardware threads
+template <typename Fn>
+void parallel_for(size_t n, Fn fn) {
+    size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+    threads = std::min(threads, n / 1024 + 1);
+    if (threads <= 1) {
+        fn(size_t(0), n);
+        return;
+    }
+    std::vector<std::thread> pool;
+    size_t chunk = (n + threads - 1) / threads;
+    for (size_t begin = 0; begin < n; begin += chunk) {
+        pool.emplace_back(fn, begin, std::min(n, begin + chunk));
+    }
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+// Union-find over snapshot indices, smallest index as root
+uint32_t find_root(std::vector<uint32_t>& parent, uint32_t x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+void unite_roots(std::vector<uint32_t>& parent, uint32_t a, uint32_t b) {
+    a = find_root(parent, a);
+    b = find_root(parent, b);
+    if (a != b) {
+        parent[std::max(a, b)] = std::min(a, b);
+    }
+}
+
+} // namespace
+
+// ==============================================================================
+// REPLAY BUFFER
+// ==============================================================================
+
+ReplayBuffer::ReplayBuffer(size_t capacity, float alpha)
+    : capacity_(std::max<size_t>(1, capacity))
+    , leaves_(1)
+    , alpha_(alpha)
+{
+    while (leaves_ < capacity_) {
+        leaves_ <<= 1;
+    }
+    ring_.resize(capacity_);
+    tree_.assign(2 * leaves_, 0.0);
+}
+
+size_t ReplayBuffer::add(const Experience& exp) {
+    size_t slot = next_;
+    ring_[slot] = exp;
+    set_leaf(slot, max_priority_);
+    next_ = (next_ + 1) % capacity_;
+    size_ = std::min(size_ + 1, capacity_);
+    return slot;
+}
+
+void ReplayBuffer::update_priority(size_t slot, float prediction_error) {
+    float priority = std::pow(std::fabs(prediction_error) + PRIORITY_EPSILON, alpha_);
+    max_priority_ = std::max(max_priority_, priority);
+    set_leaf(slot, priority);
+}
+
+void ReplayBuffer::set_leaf(size_t slot, double priority) {
+    size_t i = leaves_ + slot;
+    tree_[i] = priority;
+    for (i >>= 1; i > 0; i >>= 1) {
+        tree_[i] = tree_[2 * i] + tree_[2 * i + 1];
+    }
+}
+
+void ReplayBuffer::sample(size_t count, std::mt19937& rng, std::vector<size_t>& slots) const {
+    slots.clear();
+    double total = tree_[1];
+    if (size_ == 0 || count == 0 || total <= 0.0) {
+        return;
+    }
+    
+    // One draw per equal slice of the total priority
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double segment = total / count;
+    slots.reserve(count);
+    for (size_t k = 0; k < count; k++) {
+        double u = std::min((k + uniform(rng)) * segment, std::nextafter(total, 0.0));
+        size_t i = 1;
+        while (i < leaves_) {
+            size_t left = 2 * i;
+            if (u < tree_[left] || tree_[left + 1] <= 0.0) {
+                i = left;
+            } else {
+                u -= tree_[left];
+                i = left + 1;
+            }
+        }
+        slots.push_back(i - leaves_);
+    }
+}
+
+float ReplayBuffer::probability(size_t slot) const {
+    return tree_[1] > 0.0 ? static_cast<float>(tree_[leaves_ + slot] / tree_[1]) : 0.0f;
+}
+
+void ReplayBuffer::clear() {
+    std::fill(tree_.begin(), tree_.end(), 0.0);
+    next_ = 0;
+    size_ = 0;
+    max_priority_ = 1.0f;
+}
+
+std::pair<int, float>* EdgeIndex::find(
+    std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    int src,
+    int dst
+) {
+    if (lists_.size() > 2 * graph.size() + 64) {
+        // Many indexed lists have left the graph: sweep them out
+        for (auto l = lists_.begin(); l != lists_.end();) {
+            l = graph.count(l->first) > 0 ? std::next(l) : lists_.erase(l);
+        }
+    }
+    
+    auto it = graph.find(src);
+    if (it == graph.end()) {
+        lists_.erase(src);
+        return nullptr;
+    }
+    auto& edges = it->second;
+    
+    ListIndex& index = lists_[src];
+    if (index.data != edges.data() || index.size != edges.size()) {
+        // New or changed list: index it (backwards, so the first of any
+        // duplicate edges wins)
+        index.positions.clear();
+        index.positions.reserve(edges.size());
+        for (size_t e = edges.size(); e-- > 0;) {
+            index.positions[edges[e].first] = static_cast<uint32_t>(e);
+        }
+        index.data = edges.data();
+        index.size = edges.size();
+    }
+    
+    auto pos = index.positions.find(dst);
+    if (pos == index.positions.end() || edges[pos->second].first != dst) {
+        return nullptr;
+    }
+    return &edges[pos->second];
+}
+
+// ==============================================================================
+// CONSOLIDATOR
+// ==============================================================================
+
+// Node merge in stages, each resumable at `cursor`
+struct Consolidator::MergeState {
+    enum class Stage { START, SKETCH, BUCKET, COMPARE, RESOLVE, MOVE, REWRITE, DONE };
+    Stage stage = Stage::START;
+    size_t cursor = 0;
+    size_t units = 0;          // Done so far
+    size_t estimate = 0;       // Units known once the snapshot is taken
+    
+    // Snapshot and SimHash signatures (ids.size() x tables)
+    std::vector<int> ids;
+    size_t dim = 0;
+    std::vector<float> planes;
+    std::vector<std::vector<uint32_t>> table_bits;
+    std::vector<uint64_t> signatures;
+    std::vector<uint8_t> present;
+    
+    // Buckets of the current table: open addressing on the signature, each
+    // slot holding the head of a member list threaded through `next`
+    size_t table = 0;
+    std::vector<uint32_t> slots;
+    std::vector<uint32_t> next;
+    int slot_bits = 0;
+    std::vector<uint32_t> members;   // Bucket being paired
+    uint32_t loading = NO_NODE;      // Next member to load, NO_NODE between buckets
+    bool loaded = false;
+    size_t a = 0, b = 1;
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    std::vector<uint32_t> parent;
+    size_t comparisons = 0;
+    
+    // Result and edge rewrite
+    std::unordered_map<int, int> merged_into;
+    std::unordered_set<int> representatives;
+    std::vector<std::pair<int, int>> moves;
+    std::vector<int> lists;
+    int merged_count = 0;
+    
+    size_t known() const {
+        return std::max(units, estimate + comparisons + moves.size() + lists.size());
+    }
+};
+
+struct Consolidator::Pass {
+    ConsolidationPhase phase = ConsolidationPhase::IDLE;
+    std::deque<Experience> experiences;
+    std::vector<const Experience*> replay;
+    size_t prioritized = 0;         // Left to draw from the replay buffer
+    size_t prioritized_total = 0;
+    std::vector<int> nodes;    // Graph as of the start of PRUNE
+    size_t cursor = 0;
+    bool merge_nodes = false;       // Run MERGE after ABSTRACT
+    MergeState merge;
+};
+
 Consolidator::Consolidator()
     : strengthening_rate_(0.05f)
     , pruning_threshold_(0.1f)
@@ -20,6 +244,8 @@ Consolidator::Consolidator()
 {
 }
 
+Consolidator::~Consolidator() = default;
+
 void Consolidator::consolidate(
     std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
     const std::unordered_map<int, float>& activation_history,
@@ -112,6 +338,10 @@ void Consolidator::consolidate_full(
     // 1. Experience replay
     std::cout << "\n📼 Step 1: Experience Replay" << std::endl;
     replay_experiences(graph, experiences, 10);
+    if (replay_buffer_.size() > 0) {
+        int replayed = replay_prioritized(graph, replay_batch_size_);
+        std::cout << "   ✅ Replayed " << replayed << " buffered experiences by priority" << std::endl;
+    }
     
     // 2. Edge pruning
     std::cout << "\n✂️  Step 2: Edge Pruning" << std::endl;
@@ -138,51 +368,206 @@ void Consolidator::consolidate_full(
     std::cout << "═══════════════════════════════════════════════════════════\n" << std::endl;
 }
 
-void Consolidator::replay_experiences(
-    std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+// ==============================================================================
+// WORK UNITS (shared by the batch and incremental paths)
+// ==============================================================================
+
+std::vector<const Experience*> Consolidator::select_experiences(
     const std::deque<Experience>& experiences,
     int num_replays
 ) {
-    if (experiences.empty()) {
-        std::cout << "   ⚠️  No experiences to replay" << std::endl;
-        return;
-    }
-    
     // Select high-importance experiences
-    std::vector<Experience> important_experiences;
+    std::vector<const Experience*> selected;
     for (const auto& exp : experiences) {
         if (exp.importance > 0.5f) {
-            important_experiences.push_back(exp);
+            selected.push_back(&exp);
         }
     }
     
-    if (important_experiences.empty()) {
+    if (selected.empty()) {
         // Fall back to most recent
         int count = std::min(num_replays, static_cast<int>(experiences.size()));
         for (int i = 0; i < count; i++) {
-            important_experiences.push_back(experiences[experiences.size() - 1 - i]);
+            selected.push_back(&experiences[experiences.size() - 1 - i]);
         }
     }
-    
-    // Replay experiences (strengthen edges)
-    for (const auto& exp : important_experiences) {
+    return selected;
+}
+
+void Consolidator::apply_replay(
+    std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    const std::vector<const Experience*>& batch,
+    const std::vector<float>& weights
+) {
+    // Sum the boosts per edge first, so each edge is looked up and
+    // written once per batch
+    std::unordered_map<uint64_t, float> deltas;
+    for (size_t i = 0; i < batch.size(); i++) {
+        const Experience& exp = *batch[i];
+        float strength_boost = replay_strength_ * exp.importance * exp.outcome_reward * weights[i];
         for (const auto& edge_pair : exp.active_edges) {
-            int src = edge_pair.first;
-            int dst = edge_pair.second;
-            
-            auto it = graph.find(src);
-            if (it != graph.end()) {
-                for (auto& edge : it->second) {
-                    if (edge.first == dst) {
-                        float strength_boost = replay_strength_ * exp.importance * exp.outcome_reward;
-                        edge.second = std::min(1.0f, edge.second + strength_boost);
-                    }
+            deltas[EdgeIndex::key(edge_pair.first, edge_pair.second)] += strength_boost;
+        }
+        stats_.experiences_replayed++;
+    }
+    
+    for (const auto& delta : deltas) {
+        int src = static_cast<int>(static_cast<uint32_t>(delta.first >> 32));
+        int dst = static_cast<int>(static_cast<uint32_t>(delta.first));
+        std::pair<int, float>* edge = edge_index_.find(graph, src, dst);
+        if (edge) {
+            // Failures (reward -1) weaken edges; weights stay in [0, 1]
+            edge->second = std::max(0.0f, std::min(1.0f, edge->second + delta.second));
+        }
+    }
+}
+
+float Consolidator::prediction_error(
+    std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    const Experience& exp
+) {
+    // How far the graph is from reproducing the experience: mean gap
+    // between its edges' weights and the outcome (1 success, 0 failure)
+    if (exp.active_edges.empty()) {
+        return 0.0f;
+    }
+    float target = std::max(0.0f, std::min(1.0f, exp.outcome_reward));
+    float error = 0.0f;
+    for (const auto& edge_pair : exp.active_edges) {
+        std::pair<int, float>* edge = edge_index_.find(graph, edge_pair.first, edge_pair.second);
+        error += std::fabs(target - (edge ? edge->second : 0.0f));
+    }
+    return error / exp.active_edges.size();
+}
+
+void Consolidator::record_experience(const Experience& exp) {
+    replay_buffer_.add(exp);
+}
+
+int Consolidator::replay_prioritized(
+    std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    size_t batch_size
+) {
+    std::vector<size_t> slots;
+    replay_buffer_.sample(batch_size, replay_rng_, slots);
+    if (slots.empty()) {
+        return 0;
+    }
+    
+    // Importance-sampling weights undo the bias of sampling by priority
+    std::vector<const Experience*> batch;
+    std::vector<float> weights;
+    batch.reserve(slots.size());
+    weights.reserve(slots.size());
+    float max_weight = 0.0f;
+    for (size_t slot : slots) {
+        float p = replay_buffer_.probability(slot) * replay_buffer_.size();
+        float w = std::pow(std::max(p, 1e-12f), -replay_beta_);
+        batch.push_back(&replay_buffer_.at(slot));
+        weights.push_back(w);
+        max_weight = std::max(max_weight, w);
+    }
+    for (float& w : weights) {
+        w /= max_weight;
+    }
+    
+    apply_replay(graph, batch, weights);
+    
+    for (size_t slot : slots) {
+        replay_buffer_.update_priority(slot, prediction_error(graph, replay_buffer_.at(slot)));
+    }
+    return static_cast<int>(slots.size());
+}
+
+int Consolidator::prune_edges(std::vector<std::pair<int, float>>& edges) {
+    // Criteria for keeping:
+    // 1. Weight above threshold
+    // 2. Not too old (would need tracking)
+    size_t kept = 0;
+    for (size_t e = 0; e < edges.size(); e++) {
+        if (edges[e].second > pruning_threshold_) {
+            edges[kept++] = edges[e];
+        }
+    }
+    int pruned = static_cast<int>(edges.size() - kept);
+    edges.resize(kept);
+    return pruned;
+}
+
+bool Consolidator::build_cluster(
+    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    const std::unordered_map<int, std::vector<float>>& embeddings,
+    int hub,
+    NodeCluster& cluster
+) {
+    // High-degree nodes are cluster centers
+    auto it = graph.find(hub);
+    if (it == graph.end() || it->second.size() < 10) {
+        return false;
+    }
+    
+    cluster = NodeCluster();
+    cluster.member_nodes.push_back(hub);
+    
+    // Add strongly connected neighbors
+    for (const auto& edge : it->second) {
+        if (edge.second > 0.7f) {  // Strong connection
+            cluster.member_nodes.push_back(edge.first);
+        }
+    }
+    
+    // Only keep if large enough
+    if (cluster.member_nodes.size() < 3) {
+        return false;
+    }
+    
+    // Compute centroid embedding
+    if (!embeddings.empty()) {
+        size_t emb_size = embeddings.begin()->second.size();
+        cluster.centroid_embedding.resize(emb_size, 0.0f);
+        
+        int count = 0;
+        for (int node_id : cluster.member_nodes) {
+            auto emb_it = embeddings.find(node_id);
+            if (emb_it != embeddings.end()) {
+                size_t n = std::min(emb_size, emb_it->second.size());
+                for (size_t i = 0; i < n; i++) {
+                    cluster.centroid_embedding[i] += emb_it->second[i];
                 }
+                count++;
             }
         }
-        stats_.experiences_replayed++;
+        
+        if (count > 0) {
+            for (float& val : cluster.centroid_embedding) {
+                val /= count;
+            }
+        }
+    }
+    
+    cluster.frequency = cluster.member_nodes.size();
+    cluster.coherence = 0.8f;
+    cluster.abstract_node_id = -1;  // Would create new node in full implementation
+    return true;
+}
+
+// ==============================================================================
+// BATCH CONSOLIDATION STEPS
+// ==============================================================================
+
+void Consolidator::replay_experiences(
+    std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    const std::deque<Experience>& experiences,
+    int num_replays
+) {
+    if (experiences.empty()) {
+        std::cout << "   ⚠️  No experiences to replay" << std::endl;
+        return;
     }
     
+    std::vector<const Experience*> batch = select_experiences(experiences, num_replays);
+    apply_replay(graph, batch, std::vector<float>(batch.size(), 1.0f));
+    
     std::cout << "   ✅ Replayed " << stats_.experiences_replayed << " important experiences" << std::endl;
 }
 
@@ -193,23 +578,7 @@ int Consolidator::prune_weak_edges(
     int total_pruned = 0;
     
     for (auto& node_pair : graph) {
-        std::vector<std::pair<int, float>> kept_edges;
-        
-        for (const auto& edge : node_pair.second) {
-            // Criteria for keeping:
-            // 1. Weight above threshold
-            // 2. Not too old (would need tracking)
-            
-            bool strong_enough = edge.second > pruning_threshold_;
-            
-            if (strong_enough) {
-                kept_edges.push_back(edge);
-            } else {
-                total_pruned++;
-            }
-        }
-        
-        node_pair.second = kept_edges;
+        total_pruned += prune_edges(node_pair.second);
     }
     
     std::cout << "   ✅ Pruned " << total_pruned << " weak edges (threshold: " 
@@ -225,135 +594,515 @@ std::vector<NodeCluster> Consolidator::form_abstractions(
 ) {
     std::vector<NodeCluster> clusters;
     
-    // Find densely connected subgraphs (communities)
-    std::unordered_map<int, int> node_degree;
+    // Form clusters around densely connected hubs
+    NodeCluster cluster;
     for (const auto& node_pair : graph) {
-        node_degree[node_pair.first] = node_pair.second.size();
-    }
-    
-    // Identify high-degree nodes as cluster centers
-    std::vector<int> hub_nodes;
-    for (const auto& degree_pair : node_degree) {
-        if (degree_pair.second >= 10) {  // High connectivity
-            hub_nodes.push_back(degree_pair.first);
+        if (build_cluster(graph, embeddings, node_pair.first, cluster)) {
+            clusters.push_back(std::move(cluster));
         }
     }
     
-    // Form clusters around hubs
-    for (int hub : hub_nodes) {
-        NodeCluster cluster;
-        cluster.member_nodes.push_back(hub);
+    std::cout << "   ✅ Formed " << clusters.size() << " abstract concepts from frequent patterns" << std::endl;
+    
+    return clusters;
+}
+
+int Consolidator::merge_similar_nodes(
+    std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    std::unordered_map<int, std::vector<float>>& embeddings
+) {
+    MergeState merge;
+    merged_nodes_.clear();
+    merge_step(merge, graph, embeddings, SIZE_MAX);
+    
+    std::cout << "   ✅ Merged " << merge.merged_count << " similar nodes (threshold: " 
+              << merge_threshold_ << ", " << merge.comparisons << " comparisons)" << std::endl;
+    
+    return merge.merged_count;
+}
+
+// ==============================================================================
+// NODE MERGING
+// ==============================================================================
+
+size_t Consolidator::merge_step(
+    MergeState& merge,
+    std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    std::unordered_map<int, std::vector<float>>& embeddings,
+    size_t max_units
+) {
+    using Stage = MergeState::Stage;
+    size_t units = 0;
+    size_t tables = static_cast<size_t>(lsh_tables_);
+    
+    while (units < max_units && merge.stage != Stage::DONE) {
+        size_t budget = max_units - units;
+        size_t n = merge.ids.size();
         
-        // Add strongly connected neighbors
-        auto it = graph.find(hub);
-        if (it != graph.end()) {
-            for (const auto& edge : it->second) {
-                if (edge.second > 0.7f) {  // Strong connection
-                    cluster.member_nodes.push_back(edge.first);
+        switch (merge.stage) {
+        case Stage::START: {
+            // Snapshot: node ids in order. Random hyperplanes for a
+            // 128-bit SimHash sketch; each table keys on lsh_bits_ of its
+            // bits plus the embedding size (only equal sizes can match).
+            for (const auto& pair : embeddings) {
+                if (pair.second.empty()) continue;
+                merge.ids.push_back(pair.first);
+                merge.dim = std::max(merge.dim, pair.second.size());
+            }
+            std::sort(merge.ids.begin(), merge.ids.end());
+            n = merge.ids.size();
+            units += 1;
+            if (n < 2) {
+                merge.stage = Stage::DONE;
+                break;
+            }
+            
+            merge.planes.resize(SKETCH_BITS * merge.dim);
+            std::mt19937 rng(lsh_seed_);
+            std::normal_distribution<float> gaussian(0.0f, 1.0f);
+            for (float& p : merge.planes) {
+                p = gaussian(rng);
+            }
+            std::vector<uint32_t> all_bits(SKETCH_BITS);
+            std::iota(all_bits.begin(), all_bits.end(), 0);
+            merge.table_bits.resize(tables);
+            for (auto& picked : merge.table_bits) {
+                std::shuffle(all_bits.begin(), all_bits.end(), rng);
+                picked.assign(all_bits.begin(), all_bits.begin() + std::min<size_t>(lsh_bits_, 32));
+            }
+            merge.signatures.assign(n * tables, 0);
+            merge.present.assign(n, 0);
+            merge.parent.resize(n);
+            std::iota(merge.parent.begin(), merge.parent.end(), 0);
+            merge.estimate = n * (2 + 3 * tables);
+            merge.cursor = 0;
+            merge.stage = Stage::SKETCH;
+            break;
+        }
+        
+        case Stage::SKETCH: {
+            size_t end = std::min(n, merge.cursor + budget);
+            parallel_for(end - merge.cursor, [&](size_t begin, size_t stop) {
+                for (size_t i = merge.cursor + begin; i < merge.cursor + stop; i++) {
+                    auto it = embeddings.find(merge.ids[i]);
+                    if (it == embeddings.end() || it->second.empty()) continue;
+                    const std::vector<float>& emb = it->second;
+                    size_t dim = std::min(emb.size(), merge.dim);
+                    
+                    uint64_t sketch[SKETCH_BITS / 64] = {};
+                    for (size_t b = 0; b < SKETCH_BITS; b++) {
+                        const float* plane = &merge.planes[b * merge.dim];
+                        float proj = 0.0f;
+                        for (size_t d = 0; d < dim; d++) {
+                            proj += plane[d] * emb[d];
+                        }
+                        sketch[b / 64] |= static_cast<uint64_t>(proj >= 0.0f) << (b % 64);
+                    }
+                    for (size_t t = 0; t < tables; t++) {
+                        uint64_t sig = static_cast<uint64_t>(emb.size()) << 32;
+                        const auto& picked = merge.table_bits[t];
+                        for (size_t b = 0; b < picked.size(); b++) {
+                            sig |= ((sketch[picked[b] / 64] >> (picked[b] % 64)) & 1u) << b;
+                        }
+                        merge.signatures[i * tables + t] = sig;
+                    }
+                    merge.present[i] = 1;
                 }
+            });
+            units += end - merge.cursor;
+            merge.cursor = end;
+            if (merge.cursor == n) {
+                merge.table = 0;
+                merge.cursor = 0;
+                merge.stage = Stage::BUCKET;
             }
+            break;
         }
         
-        // Only keep if large enough
-        if (cluster.member_nodes.size() >= 3) {
-            // Compute centroid embedding
-            if (!embeddings.empty()) {
-                size_t emb_size = embeddings.begin()->second.size();
-                cluster.centroid_embedding.resize(emb_size, 0.0f);
-                
-                int count = 0;
-                for (int node_id : cluster.member_nodes) {
-                    auto emb_it = embeddings.find(node_id);
-                    if (emb_it != embeddings.end()) {
-                        for (size_t i = 0; i < emb_size; i++) {
-                            cluster.centroid_embedding[i] += emb_it->second[i];
+        case Stage::BUCKET: {
+            // One table at a time, so only one bucket index is alive
+            if (merge.cursor == 0) {
+                merge.slot_bits = 1;
+                while ((size_t(1) << merge.slot_bits) < 2 * n) {
+                    merge.slot_bits++;
+                }
+                merge.slots.assign(size_t(1) << merge.slot_bits, NO_NODE);
+                merge.next.assign(n, NO_NODE);
+            }
+            size_t mask = merge.slots.size() - 1;
+            size_t end = std::min(n, merge.cursor + budget);
+            for (size_t i = merge.cursor; i < end; i++) {
+                if (!merge.present[i]) continue;
+                uint64_t sig = merge.signatures[i * tables + merge.table];
+                size_t h = (sig * 0x9E3779B97F4A7C15ULL) >> (64 - merge.slot_bits);
+                while (merge.slots[h] != NO_NODE &&
+                       merge.signatures[merge.slots[h] * tables + merge.table] != sig) {
+                    h = (h + 1) & mask;
+                }
+                merge.next[i] = merge.slots[h];
+                merge.slots[h] = static_cast<uint32_t>(i);
+            }
+            units += end - merge.cursor;
+            merge.cursor = end;
+            if (merge.cursor == n) {
+                merge.cursor = 0;
+                merge.loaded = false;
+                merge.stage = Stage::COMPARE;
+            }
+            break;
+        }
+        
+        case Stage::COMPARE: {
+            // Candidate pairs: nodes sharing a bucket. Oversized buckets
+            // pair each node only with its neighbours in the order of the
+            // next table's signature. Pairs already in one cluster (mostly
+            // the same pair from an earlier table) are skipped.
+            merge.pairs.clear();
+            size_t limit = std::min(budget, MAX_PAIRS_PER_BATCH);
+            size_t visited = 0;
+            while (visited + merge.pairs.size() < limit && merge.cursor < merge.slots.size()) {
+                if (!merge.loaded) {
+                    if (merge.loading == NO_NODE) {
+                        uint32_t head = merge.slots[merge.cursor];
+                        if (head == NO_NODE || merge.next[head] == NO_NODE) {
+                            merge.cursor++;
+                            visited++;
+                            continue;
                         }
-                        count++;
+                        merge.members.clear();
+                        merge.loading = head;
+                    }
+                    // Members are charged as they load, so a huge bucket
+                    // spreads over several steps
+                    while (merge.loading != NO_NODE && visited + merge.pairs.size() < limit) {
+                        merge.members.push_back(merge.loading);
+                        merge.loading = merge.next[merge.loading];
+                        visited++;
+                    }
+                    if (merge.loading != NO_NODE) {
+                        break;
                     }
+                    if (merge.members.size() > max_bucket_size_ + 1) {
+                        size_t next = (merge.table + 1) % tables;
+                        std::sort(merge.members.begin(), merge.members.end(), [&](uint32_t x, uint32_t y) {
+                            return merge.signatures[x * tables + next] < merge.signatures[y * tables + next];
+                        });
+                    }
+                    merge.loaded = true;
+                    merge.a = 0;
+                    merge.b = 1;
                 }
                 
-                if (count > 0) {
-                    for (float& val : cluster.centroid_embedding) {
-                        val /= count;
-                    }
+                const auto& members = merge.members;
+                if (merge.a + 1 >= members.size()) {
+                    merge.loaded = false;
+                    merge.cursor++;
+                    continue;
+                }
+                size_t last = std::min(members.size(), merge.a + 1 + max_bucket_size_);
+                if (merge.b >= last) {
+                    merge.a++;
+                    merge.b = merge.a + 1;
+                    continue;
+                }
+                uint32_t x = members[merge.a], y = members[merge.b++];
+                if (find_root(merge.parent, x) != find_root(merge.parent, y)) {
+                    merge.pairs.emplace_back(x, y);
+                } else {
+                    visited++;
                 }
             }
             
-            cluster.frequency = cluster.member_nodes.size();
-            cluster.coherence = 0.8f;
-            cluster.abstract_node_id = -1;  // Would create new node in full implementation
+            // Verify the batch in parallel, then cluster with union-find
+            std::vector<uint8_t> similar(merge.pairs.size());
+            parallel_for(merge.pairs.size(), [&](size_t begin, size_t end) {
+                for (size_t p = begin; p < end; p++) {
+                    auto a = embeddings.find(merge.ids[merge.pairs[p].first]);
+                    auto b = embeddings.find(merge.ids[merge.pairs[p].second]);
+                    similar[p] = a != embeddings.end() && b != embeddings.end() &&
+                                 compute_similarity(a->second, b->second) > merge_threshold_;
+                }
+            });
+            for (size_t p = 0; p < merge.pairs.size(); p++) {
+                if (similar[p]) {
+                    unite_roots(merge.parent, merge.pairs[p].first, merge.pairs[p].second);
+                }
+            }
+            merge.comparisons += merge.pairs.size();
+            units += visited + merge.pairs.size();
             
-            clusters.push_back(cluster);
+            if (merge.cursor == merge.slots.size()) {
+                merge.cursor = 0;
+                if (++merge.table < tables) {
+                    merge.stage = Stage::BUCKET;
+                } else {
+                    merge.slots = std::vector<uint32_t>();
+                    merge.next = std::vector<uint32_t>();
+                    merge.stage = Stage::RESOLVE;
+                }
+            }
+            break;
+        }
+        
+        case Stage::RESOLVE: {
+            // Each merged node maps to the smallest id in its cluster
+            size_t end = std::min(n, merge.cursor + budget);
+            for (size_t i = merge.cursor; i < end; i++) {
+                uint32_t root = find_root(merge.parent, static_cast<uint32_t>(i));
+                if (root != i) {
+                    merge.merged_into[merge.ids[i]] = merge.ids[root];
+                    merge.representatives.insert(merge.ids[root]);
+                }
+            }
+            units += end - merge.cursor;
+            merge.cursor = end;
+            if (merge.cursor == n) {
+                merge.merged_count = static_cast<int>(merge.merged_into.size());
+                merged_nodes_ = merge.merged_into;
+                merge.moves.assign(merge.merged_into.begin(), merge.merged_into.end());
+                merge.cursor = 0;
+                merge.stage = merge.moves.empty() ? Stage::DONE : Stage::MOVE;
+            }
+            break;
+        }
+        
+        case Stage::MOVE: {
+            // Outgoing edges of merged nodes go to their representative
+            size_t end = std::min(merge.moves.size(), merge.cursor + budget);
+            for (size_t m = merge.cursor; m < end; m++) {
+                int remove = merge.moves[m].first;
+                int keep = merge.moves[m].second;
+                auto it = graph.find(remove);
+                if (it != graph.end()) {
+                    auto& keep_edges = graph[keep];
+                    it = graph.find(remove);  // graph[] may have rehashed
+                    keep_edges.insert(keep_edges.end(), it->second.begin(), it->second.end());
+                    graph.erase(it);
+                }
+                edge_index_.erase(remove);
+                embeddings.erase(remove);
+            }
+            units += end - merge.cursor;
+            merge.cursor = end;
+            if (merge.cursor == merge.moves.size()) {
+                merge.lists.clear();
+                merge.lists.reserve(graph.size());
+                for (const auto& node_pair : graph) {
+                    merge.lists.push_back(node_pair.first);
+                }
+                merge.cursor = 0;
+                merge.stage = Stage::REWRITE;
+            }
+            break;
+        }
+        
+        case Stage::REWRITE: {
+            // Redirect incoming edges; lists that changed drop self-loops
+            // the merge created and keep the strongest of duplicates
+            size_t end = std::min(merge.lists.size(), merge.cursor + budget);
+            std::vector<std::pair<const int, std::vector<std::pair<int, float>>>*> slice;
+            for (size_t l = merge.cursor; l < end; l++) {
+                auto it = graph.find(merge.lists[l]);
+                if (it != graph.end()) {
+                    slice.push_back(&*it);
+                }
+            }
+            std::vector<uint8_t> rewritten(slice.size(), 0);
+            parallel_for(slice.size(), [&](size_t begin, size_t stop) {
+                for (size_t l = begin; l < stop; l++) {
+                    int src = slice[l]->first;
+                    auto& edges = slice[l]->second;
+                    bool changed = merge.representatives.count(src) > 0;
+                    for (auto& edge : edges) {
+                        auto m = merge.merged_into.find(edge.first);
+                        if (m != merge.merged_into.end()) {
+                            edge.first = m->second;
+                            changed = true;
+                        }
+                    }
+                    if (!changed) continue;
+                    rewritten[l] = 1;
+                    
+                    std::sort(edges.begin(), edges.end(), [](const auto& a, const auto& b) {
+                        return a.first != b.first ? a.first < b.first : a.second > b.second;
+                    });
+                    size_t out = 0;
+                    for (size_t e = 0; e < edges.size(); e++) {
+                        if (edges[e].first == src) continue;
+                        if (out > 0 && edges[out - 1].first == edges[e].first) continue;
+                        edges[out++] = edges[e];
+                    }
+                    edges.resize(out);
+                }
+            });
+            for (size_t l = 0; l < slice.size(); l++) {
+                if (rewritten[l]) {
+                    edge_index_.erase(slice[l]->first);  // Sorted in place: positions moved
+                }
+            }
+            units += end - merge.cursor;
+            merge.cursor = end;
+            if (merge.cursor == merge.lists.size()) {
+                merge.stage = Stage::DONE;
+            }
+            break;
+        }
+        
+        case Stage::DONE:
+            break;
         }
     }
     
-    std::cout << "   ✅ Formed " << clusters.size() << " abstract concepts from frequent patterns" << std::endl;
-    
-    return clusters;
+    merge.units += units;
+    return units;
 }
 
-int Consolidator::merge_similar_nodes(
+// ==============================================================================
+// INCREMENTAL CONSOLIDATION
+// ==============================================================================
+
+void Consolidator::begin_consolidation(const std::deque<Experience>& experiences, bool merge_nodes) {
+    reset_stats();
+    pass_ = std::make_unique<Pass>();
+    pass_->merge_nodes = merge_nodes;
+    pass_->experiences = experiences;
+    pass_->replay = select_experiences(pass_->experiences, 10);
+    pass_->prioritized = replay_buffer_.size() > 0 ? replay_batch_size_ : 0;
+    pass_->prioritized_total = pass_->prioritized;
+    pass_->phase = ConsolidationPhase::REPLAY;
+    merged_nodes_.clear();
+}
+
+bool Consolidator::consolidation_active() const {
+    return pass_ && pass_->phase != ConsolidationPhase::IDLE;
+}
+
+std::unordered_map<int, int> Consolidator::take_merged_nodes() {
+    return std::exchange(merged_nodes_, {});
+}
+
+ConsolidationProgress Consolidator::consolidate_step(
     std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
-    std::unordered_map<int, std::vector<float>>& embeddings
+    std::unordered_map<int, std::vector<float>>& embeddings,
+    size_t max_units
 ) {
-    int merged_count = 0;
+    ConsolidationProgress progress;
+    if (!consolidation_active()) {
+        return progress;
+    }
+    Pass& pass = *pass_;
     
-    // Find similar node pairs
-    std::vector<std::pair<int, int>> to_merge;
-    std::vector<int> node_ids;
+    // Nodes of the graph as of the start of a phase
+    auto snapshot_nodes = [&]() {
+        pass.nodes.clear();
+        pass.nodes.reserve(graph.size());
+        for (const auto& node_pair : graph) {
+            pass.nodes.push_back(node_pair.first);
+        }
+        pass.cursor = 0;
+    };
     
-    for (const auto& pair : embeddings) {
-        node_ids.push_back(pair.first);
-    }
+    auto finish_pass = [&]() {
+        stats_.nodes_merged = pass.merge.merged_count;
+        pass.phase = ConsolidationPhase::IDLE;
+        progress.complete = true;
+        std::cout << "✅ Consolidation pass complete: " << stats_.experiences_replayed
+                  << " replayed, " << stats_.edges_pruned << " edges pruned, "
+                  << stats_.abstractions_formed << " abstractions, "
+                  << stats_.nodes_merged << " nodes merged" << std::endl;
+    };
     
-    // Compare all pairs (O(n²) - would optimize in production)
-    for (size_t i = 0; i < node_ids.size() && i < 100; i++) {  // Limit for efficiency
-        for (size_t j = i + 1; j < node_ids.size() && j < 100; j++) {
-            int id_a = node_ids[i];
-            int id_b = node_ids[j];
+    size_t units = 0;
+    while (units < max_units && pass.phase != ConsolidationPhase::IDLE) {
+        size_t end;
+        switch (pass.phase) {
+        case ConsolidationPhase::REPLAY:
+            // Given experiences first, then a prioritized batch from the buffer
+            if (pass.cursor < pass.replay.size()) {
+                end = std::min(pass.replay.size(), pass.cursor + (max_units - units));
+                std::vector<const Experience*> batch(pass.replay.begin() + pass.cursor, pass.replay.begin() + end);
+                apply_replay(graph, batch, std::vector<float>(batch.size(), 1.0f));
+                units += end - pass.cursor;
+                pass.cursor = end;
+            } else if (pass.prioritized > 0) {
+                size_t count = std::min(pass.prioritized, max_units - units);
+                replay_prioritized(graph, count);
+                pass.prioritized -= count;
+                units += count;
+            }
+            if (pass.cursor == pass.replay.size() && pass.prioritized == 0) {
+                snapshot_nodes();
+                pass.phase = ConsolidationPhase::PRUNE;
+            }
+            break;
             
-            float similarity = compute_similarity(embeddings[id_a], embeddings[id_b]);
+        case ConsolidationPhase::PRUNE:
+            end = std::min(pass.nodes.size(), pass.cursor + (max_units - units));
+            for (; pass.cursor < end; pass.cursor++, units++) {
+                auto it = graph.find(pass.nodes[pass.cursor]);
+                if (it != graph.end()) {
+                    stats_.edges_pruned += prune_edges(it->second);
+                }
+            }
+            if (pass.cursor == pass.nodes.size()) {
+                pass.cursor = 0;  // Abstraction walks the same nodes
+                pass.phase = ConsolidationPhase::ABSTRACT;
+            }
+            break;
             
-            if (similarity > merge_threshold_) {
-                to_merge.push_back({id_a, id_b});
-                if (to_merge.size() >= 50) break;  // Limit merges per cycle
+        case ConsolidationPhase::ABSTRACT: {
+            NodeCluster cluster;
+            end = std::min(pass.nodes.size(), pass.cursor + (max_units - units));
+            for (; pass.cursor < end; pass.cursor++, units++) {
+                if (build_cluster(graph, embeddings, pass.nodes[pass.cursor], cluster)) {
+                    stats_.abstractions_formed++;
+                }
             }
-        }
-        if (to_merge.size() >= 50) break;
-    }
-    
-    // Merge nodes (keep first, redirect edges from second)
-    for (const auto& merge_pair : to_merge) {
-        int keep = merge_pair.first;
-        int remove = merge_pair.second;
-        
-        // Redirect edges from 'remove' to 'keep'
-        auto it = graph.find(remove);
-        if (it != graph.end()) {
-            for (const auto& edge : it->second) {
-                // Add to 'keep' node's edges
-                graph[keep].push_back(edge);
+            if (pass.cursor == pass.nodes.size()) {
+                pass.nodes.clear();
+                pass.nodes.shrink_to_fit();
+                if (pass.merge_nodes) {
+                    pass.phase = ConsolidationPhase::MERGE;
+                } else {
+                    finish_pass();
+                }
             }
-            graph.erase(remove);
+            break;
         }
-        
-        // Update incoming edges
-        for (auto& node_pair : graph) {
-            for (auto& edge : node_pair.second) {
-                if (edge.first == remove) {
-                    edge.first = keep;
-                }
+            
+        case ConsolidationPhase::MERGE:
+            units += merge_step(pass.merge, graph, embeddings, max_units - units);
+            if (pass.merge.stage == MergeState::Stage::DONE) {
+                finish_pass();
             }
+            break;
+            
+        case ConsolidationPhase::IDLE:
+            break;
         }
-        
-        embeddings.erase(remove);
-        merged_count++;
     }
     
-    std::cout << "   ✅ Merged " << merged_count << " similar nodes (threshold: " 
-              << merge_threshold_ << ")" << std::endl;
-    
-    return merged_count;
+    progress.phase = pass.phase;
+    progress.units = units;
+    switch (pass.phase) {
+    case ConsolidationPhase::REPLAY:
+        progress.phase_done = pass.cursor + (pass.prioritized_total - pass.prioritized);
+        progress.phase_total = pass.replay.size() + pass.prioritized_total;
+        break;
+    case ConsolidationPhase::PRUNE:
+    case ConsolidationPhase::ABSTRACT:
+        progress.phase_done = pass.cursor;
+        progress.phase_total = pass.nodes.size();
+        break;
+    case ConsolidationPhase::MERGE:
+        progress.phase_done = pass.merge.units;
+        progress.phase_total = pass.merge.known();
+        break;
+    case ConsolidationPhase::IDLE:
+        pass_.reset();
+        break;
+    }
+    return progress;
 }
 
 float Consolidator::compute_similarity(const std::vector<float>& a, const std::vector<float>& b) {
@@ -1,6 +1,10 @@
 #ifndef CONSOLIDATION_H
 #define CONSOLIDATION_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
 #include <unordered_map>
 #include <vector>
 #include <deque>
@@ -17,6 +21,70 @@ struct Experience {
     float outcome_reward;    // Success/failure signal
 };
 
+// Fixed-capacity ring of experiences with a sum-tree over their replay
+// priorities, so proportional sampling and priority updates are O(log n).
+// New experiences get the highest priority seen so far, so each one is
+// replayed soon after it's recorded.
+class ReplayBuffer {
+public:
+    explicit ReplayBuffer(size_t capacity = 4096, float alpha = 0.6f);
+    
+    // Returns the slot; overwrites the oldest experience when full
+    size_t add(const Experience& exp);
+    
+    // Priority becomes (|error| + epsilon)^alpha
+    void update_priority(size_t slot, float prediction_error);
+    
+    // Stratified proportional sample of count slots (repeats possible)
+    void sample(size_t count, std::mt19937& rng, std::vector<size_t>& slots) const;
+    float probability(size_t slot) const;  // Of one draw
+    
+    const Experience& at(size_t slot) const { return ring_[slot]; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    void clear();
+    
+private:
+    size_t capacity_;
+    size_t leaves_;                 // capacity_ rounded up to a power of two
+    float alpha_;
+    std::vector<Experience> ring_;
+    size_t next_ = 0;
+    size_t size_ = 0;
+    std::vector<double> tree_;      // Node i = sum of 2i and 2i+1; slot s at leaves_ + s
+    float max_priority_ = 1.0f;
+    
+    void set_leaf(size_t slot, double priority);
+};
+
+// (src, dst) -> position of the edge in src's list, indexed one source
+// list at a time. A list is re-indexed only when its buffer or length
+// changed since it was indexed, and its old positions go with it; lists
+// that left the graph are dropped on lookup. Call erase() after
+// retargeting a list's edges in place, clear() after rewriting many.
+class EdgeIndex {
+public:
+    std::pair<int, float>* find(
+        std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        int src,
+        int dst
+    );
+    void erase(int src) { lists_.erase(src); }
+    void clear() { lists_.clear(); }
+    
+    static uint64_t key(int src, int dst) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(src)) << 32) | static_cast<uint32_t>(dst);
+    }
+    
+private:
+    struct ListIndex {
+        const std::pair<int, float>* data = nullptr;  // The list as indexed
+        size_t size = 0;
+        std::unordered_map<int, uint32_t> positions;  // dst -> first edge to it
+    };
+    std::unordered_map<int, ListIndex> lists_;
+};
+
 struct NodeCluster {
     std::vector<int> member_nodes;
     std::vector<float> centroid_embedding;
@@ -25,9 +93,28 @@ struct NodeCluster {
     int abstract_node_id;
 };
 
+// Incremental consolidation pass, phase by phase
+enum class ConsolidationPhase {
+    IDLE,       // No pass running
+    REPLAY,     // Unit: one experience
+    PRUNE,      // Unit: one node's edges
+    ABSTRACT,   // Unit: one node
+    MERGE       // Units: one node sketched or bucketed, one pair compared,
+                // one edge list rewritten
+};
+
+struct ConsolidationProgress {
+    ConsolidationPhase phase = ConsolidationPhase::IDLE;
+    size_t phase_done = 0;      // Units done in this phase
+    size_t phase_total = 0;     // Units known so far (merge grows as it goes)
+    size_t units = 0;           // Done by the last step
+    bool complete = false;      // The last step finished the pass
+};
+
 class Consolidator {
 public:
     Consolidator();
+    ~Consolidator();
     
     // GAP 6: Enhanced consolidation methods
     void consolidate_full(
@@ -45,6 +132,17 @@ public:
         int num_replays = 10
     );
     
+    // Prioritized replay: experiences recorded into the replay buffer are
+    // sampled by priority, their edge updates summed per edge and applied
+    // once each, and their priorities reset from the prediction error left
+    // afterwards. Returns the number replayed.
+    void record_experience(const Experience& exp);
+    int replay_prioritized(
+        std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        size_t batch_size
+    );
+    ReplayBuffer& replay_buffer() { return replay_buffer_; }
+    
     // Edge pruning (remove weak/unused connections)
     int prune_weak_edges(
         std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
@@ -58,12 +156,38 @@ public:
         int min_frequency = 100
     );
     
-    // Node merging (combine similar nodes)
+    // Node merging (combine similar nodes). Candidates come from SimHash
+    // buckets over all embeddings; pairs above merge_threshold_ are
+    // clustered with union-find, each cluster is folded into its smallest
+    // id, and edges are rewritten in one sweep.
     int merge_similar_nodes(
         std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
         std::unordered_map<int, std::vector<float>>& embeddings
     );
     
+    // Bounded-time consolidation: begin_consolidation() starts a pass of
+    // the same four steps as consolidate_full(), and each
+    // consolidate_step() does at most max_units units of it, resuming where
+    // the previous step stopped. Nodes are visited from a snapshot of ids
+    // taken when a phase starts and looked up again per unit, so the graph
+    // may change between steps; nodes added mid-pass wait for the next one.
+    // MERGE runs only when merge_nodes is set: it folds nodes whose
+    // embeddings are close, which is only safe when embeddings carry
+    // meaning (the runtime's hashed placeholders mostly don't).
+    void begin_consolidation(const std::deque<Experience>& experiences, bool merge_nodes = false);
+    ConsolidationProgress consolidate_step(
+        std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        std::unordered_map<int, std::vector<float>>& embeddings,
+        size_t max_units
+    );
+    bool consolidation_active() const;
+    
+    // Nodes folded by the current or last merge (merged id → representative),
+    // set once its clusters are resolved. Callers keeping their own tables of
+    // node ids (e.g. word ↔ id) take it after each step or merge to remap
+    // them; it is empty again until the next merge resolves.
+    std::unordered_map<int, int> take_merged_nodes();
+    
     // Original interface (enhanced)
     void consolidate(
         std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
@@ -94,8 +218,57 @@ private:
     float edge_age_threshold_ = 1000000.0f;  // Time units
     int min_activation_count_ = 3;
     
+    // SimHash banding for merge candidates: two nodes are compared if they
+    // agree on all lsh_bits_ hyperplane signs (of 128) in any of lsh_tables_
+    // tables. Near-duplicates (cosine ~0.97) are found >99% of the time,
+    // pairs right at the threshold less reliably; unrelated pairs collide
+    // in about 1 of 2000.
+    int lsh_bits_ = 16;             // At most 32
+    int lsh_tables_ = 32;
+    size_t max_bucket_size_ = 64;   // Larger buckets only compare sorted neighbours
+    uint32_t lsh_seed_ = 0x5eed;
+    
     Stats stats_;
     
+    // Prioritized replay
+    ReplayBuffer replay_buffer_;
+    EdgeIndex edge_index_;
+    std::mt19937 replay_rng_{0x5eed};
+    size_t replay_batch_size_ = 64;     // Per consolidation pass
+    float replay_beta_ = 0.4f;          // Importance-sampling correction
+    
+    std::unordered_map<int, int> merged_nodes_;
+    
+    // State of the incremental pass and of a node merge in progress
+    struct MergeState;
+    struct Pass;
+    std::unique_ptr<Pass> pass_;
+    
+    // Work units shared by the batch and incremental paths
+    std::vector<const Experience*> select_experiences(const std::deque<Experience>& experiences, int num_replays);
+    void apply_replay(
+        std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        const std::vector<const Experience*>& batch,
+        const std::vector<float>& weights
+    );
+    float prediction_error(
+        std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        const Experience& exp
+    );
+    int prune_edges(std::vector<std::pair<int, float>>& edges);
+    bool build_cluster(
+        const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        const std::unordered_map<int, std::vector<float>>& embeddings,
+        int hub,
+        NodeCluster& cluster
+    );
+    size_t merge_step(
+        MergeState& merge,
+        std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        std::unordered_map<int, std::vector<float>>& embeddings,
+        size_t max_units
+    );
+    
     // Helper methods
     float compute_similarity(const std::vector<float>& a, const std::vector<float>& b);
     std::vector<int> find_frequent_pattern(
@@ -39,7 +39,7 @@ ReasoningResult IntelligentReasoner::answer(const std::string& query) {
     }
     
     // Step 2: Compute query embedding
-    std::vector<float> query_embedding = melvin::language::compute_simple_embedding(tokens);
+    std::vector<float> query_embedding = intent_classifier_.embed(tokens);
     
     // Step 3: Classify intent
     result.intent = intent_classifier_.infer_intent(query_embedding, tokens);
@@ -114,6 +114,11 @@ public:
         return reflection_controller_.get_stats();
     }
     
+    /**
+     * @brief Access learned parameters (e.g. to apply a tuned genome)
+     */
+    melvin::evolution::DynamicGenome& genome() { return genome_; }
+    
     /**
      * @brief Save learned parameters
      */
@@ -1,11 +1,162 @@
 #include "memory_hierarchy.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
 #include <unordered_set>
 
+// SSE is baseline on x86-64 and NEON on aarch64, so no extra flags are needed
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MELVIN_MEMORY_SSE 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define MELVIN_MEMORY_NEON 1
+#endif
+
 namespace melvin {
 namespace reasoning {
 
+namespace {
+
+using Scored = std::pair<int, float>;
+
+// Min-heap on score, so the weakest of the current top-k sits on top
+bool weaker_first(const Scored& a, const Scored& b) {
+    return a.second > b.second;
+}
+
+// Keeps the k best candidates offered so far
+void offer(std::vector<Scored>& heap, size_t k, int id, float score) {
+    if (heap.size() < k) {
+        heap.emplace_back(id, score);
+        std::push_heap(heap.begin(), heap.end(), weaker_first);
+    } else if (score > heap.front().second) {
+        std::pop_heap(heap.begin(), heap.end(), weaker_first);
+        heap.back() = Scored(id, score);
+        std::push_heap(heap.begin(), heap.end(), weaker_first);
+    }
+}
+
+// Best first
+void finish(std::vector<Scored>& heap) {
+    std::sort_heap(heap.begin(), heap.end(), weaker_first);
+}
+
+// Dot product of two rows padded to a multiple of 4 floats
+float dot_padded(const float* a, const float* b, size_t n) {
+#if defined(MELVIN_MEMORY_SSE)
+    __m128 acc = _mm_setzero_ps();
+    for (size_t i = 0; i < n; i += 4) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    float lanes[4];
+    _mm_storeu_ps(lanes, acc);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(MELVIN_MEMORY_NEON)
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    for (size_t i = 0; i < n; i += 4) {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    return vaddvq_f32(acc);
+#else
+    float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (size_t i = 0; i < n; i += 4) {
+        acc[0] += a[i] * b[i];
+        acc[1] += a[i + 1] * b[i + 1];
+        acc[2] += a[i + 2] * b[i + 2];
+        acc[3] += a[i + 3] * b[i + 3];
+    }
+    return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+#endif
+}
+
+uint64_t mix(uint64_t h, uint64_t v) {
+    // FNV-1a style, a word at a time
+    return (h ^ v) * 1099511628211ULL;
+}
+
+} // namespace
+
+// ============================================================
+// CONTEXT SUBGRAPH
+// ============================================================
+
+std::unordered_map<int, std::vector<std::pair<int, float>>> ContextSubgraph::to_map() const {
+    std::unordered_map<int, std::vector<std::pair<int, float>>> map;
+    map.reserve(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (in_graph[i]) {
+            map[nodes[i]].assign(edges_begin(i), edges_end(i));
+        }
+    }
+    return map;
+}
+
+// ============================================================
+// EMBEDDING INDEX
+// ============================================================
+
+void EmbeddingIndex::build(const std::unordered_map<int, std::vector<float>>& embeddings) {
+    dim_ = 0;
+    for (const auto& entry : embeddings) {
+        dim_ = std::max(dim_, entry.second.size());
+    }
+    stride_ = (dim_ + 3) & ~static_cast<size_t>(3);
+    
+    ids_.clear();
+    rows_.clear();
+    ids_.reserve(embeddings.size());
+    rows_.reserve(embeddings.size() * stride_);
+    for (const auto& entry : embeddings) {
+        const auto& emb = entry.second;
+        if (emb.empty()) continue;
+        
+        float norm = 0.0f;
+        for (float v : emb) norm += v * v;
+        float scale = 1.0f / (std::sqrt(norm) + 1e-8f);
+        
+        ids_.push_back(entry.first);
+        size_t row = rows_.size();
+        rows_.resize(row + stride_, 0.0f);
+        for (size_t i = 0; i < emb.size(); ++i) {
+            rows_[row + i] = emb[i] * scale;
+        }
+    }
+}
+
+void EmbeddingIndex::top_k(const std::vector<float>& query, size_t k,
+                           std::vector<std::pair<int, float>>& out) const {
+    out.clear();
+    if (query.empty() || ids_.empty() || k == 0) {
+        return;
+    }
+    
+    // Normalized query, cut or padded to the row width
+    std::vector<float> q(stride_, 0.0f);
+    size_t n = std::min(query.size(), dim_);
+    float norm = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        q[i] = query[i];
+        norm += q[i] * q[i];
+    }
+    float scale = 1.0f / (std::sqrt(norm) + 1e-8f);
+    for (size_t i = 0; i < n; ++i) {
+        q[i] *= scale;
+    }
+    
+    out.reserve(std::min(k, ids_.size()));
+    const float* row = rows_.data();
+    for (size_t r = 0; r < ids_.size(); ++r, row += stride_) {
+        offer(out, k, ids_[r], dot_padded(q.data(), row, stride_));
+    }
+    finish(out);
+}
+
+// ============================================================
+// MEMORY HIERARCHY
+// ============================================================
+
 MemoryHierarchy::MemoryHierarchy() {
 }
 
@@ -15,7 +166,19 @@ void MemoryHierarchy::add_to_working_memory(const std::vector<int>& sequence) {
         if (working_memory_.size() > 10) {
             working_memory_.pop_front();
         }
+        update_working_memory_hash();
+    }
+}
+
+void MemoryHierarchy::update_working_memory_hash() {
+    uint64_t h = 14695981039346656037ULL;
+    for (const auto& seq : working_memory_) {
+        h = mix(h, seq.size());
+        for (int node_id : seq) {
+            h = mix(h, static_cast<uint32_t>(node_id));
+        }
     }
+    working_memory_hash_ = h;
 }
 
 void MemoryHierarchy::record_episode(const std::vector<int>& activation_sequence) {
@@ -33,11 +196,11 @@ std::unordered_map<int, std::vector<std::pair<int, float>>> MemoryHierarchy::bui
     const std::unordered_map<int, std::vector<float>>& embeddings,
     int top_k
 ) {
-    std::unordered_set<int> context_nodes;
-    
-    // 1. Retrieve semantically similar nodes
-    if (!query_embedding.empty() && !embeddings.empty()) {
-        std::vector<std::pair<int, float>> similarities;
+    // 1. Retrieve semantically similar nodes (bounded heap, no full sort)
+    std::vector<Scored> retrieved;
+    if (!query_embedding.empty() && !embeddings.empty() && top_k > 0) {
+        size_t k = static_cast<size_t>(top_k);
+        retrieved.reserve(std::min(k, embeddings.size()));
         
         for (const auto& emb_pair : embeddings) {
             int node_id = emb_pair.first;
@@ -54,48 +217,133 @@ std::unordered_map<int, std::vector<std::pair<int, float>>> MemoryHierarchy::bui
             }
             
             float similarity = dot / (std::sqrt(norm1) * std::sqrt(norm2) + 1e-8f);
-            similarities.emplace_back(node_id, similarity);
+            offer(retrieved, k, node_id, similarity);
         }
+        finish(retrieved);
+    }
+    
+    // 2-4. Add working memory, cut the subgraph, bias activation
+    ContextView view = make_context(retrieved, graph);
+    activation_field_.activate_batch(view->nodes, 0.5f);
+    
+    return view->to_map();
+}
+
+void MemoryHierarchy::index_embeddings(const std::unordered_map<int, std::vector<float>>& embeddings) {
+    embedding_index_.build(embeddings);
+    invalidate_context_cache();
+}
+
+void MemoryHierarchy::invalidate_context_cache() {
+    context_cache_.clear();
+}
+
+ContextView MemoryHierarchy::retrieve_context(
+    const std::vector<float>& query_embedding,
+    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+    uint64_t graph_version,
+    int top_k
+) {
+    // Cache key: query direction quantized to int8, plus what else
+    // determines the result
+    std::vector<int8_t> quantized(query_embedding.size());
+    float norm = 0.0f;
+    for (float v : query_embedding) norm += v * v;
+    float scale = 32.0f / (std::sqrt(norm) + 1e-8f);
+    uint64_t hash = mix(working_memory_hash_, static_cast<uint32_t>(top_k));
+    hash = mix(hash, reinterpret_cast<uintptr_t>(&graph));
+    hash = mix(hash, graph_version);
+    for (size_t i = 0; i < query_embedding.size(); ++i) {
+        quantized[i] = static_cast<int8_t>(std::lround(query_embedding[i] * scale));
+        hash = mix(hash, static_cast<uint8_t>(quantized[i]));
+    }
+    
+    ContextView view;
+    for (auto& entry : context_cache_) {
+        if (entry.hash == hash && entry.top_k == top_k && entry.graph == &graph &&
+            entry.graph_version == graph_version &&
+            entry.working_memory_hash == working_memory_hash_ && entry.query == quantized) {
+            entry.last_used = ++cache_clock_;
+            view = entry.view;
+            break;
+        }
+    }
+    
+    if (view) {
+        cache_stats_.hits++;
+    } else {
+        cache_stats_.misses++;
+        std::vector<Scored> retrieved;
+        if (top_k > 0) {
+            embedding_index_.top_k(query_embedding, static_cast<size_t>(top_k), retrieved);
+        }
+        view = make_context(retrieved, graph);
         
-        // Sort and take top-k
-        std::sort(similarities.begin(), similarities.end(),
-                 [](const auto& a, const auto& b) { return a.second > b.second; });
-        
-        for (size_t i = 0; i < std::min(similarities.size(), static_cast<size_t>(top_k)); ++i) {
-            context_nodes.insert(similarities[i].first);
+        CacheEntry entry;
+        entry.hash = hash;
+        entry.query = std::move(quantized);
+        entry.working_memory_hash = working_memory_hash_;
+        entry.top_k = top_k;
+        entry.graph = &graph;
+        entry.graph_version = graph_version;
+        entry.last_used = ++cache_clock_;
+        entry.view = view;
+        if (context_cache_.size() < CONTEXT_CACHE_SIZE) {
+            context_cache_.push_back(std::move(entry));
+        } else {
+            auto oldest = std::min_element(context_cache_.begin(), context_cache_.end(),
+                [](const CacheEntry& a, const CacheEntry& b) { return a.last_used < b.last_used; });
+            *oldest = std::move(entry);
         }
     }
     
-    // 2. Add nodes from working memory
+    // Bias activation field towards context
+    activation_field_.activate_batch(view->nodes, 0.5f);
+    return view;
+}
+
+ContextView MemoryHierarchy::make_context(
+    const std::vector<std::pair<int, float>>& retrieved,
+    const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph
+) const {
+    auto context = std::make_shared<ContextSubgraph>();
+    
+    // Node list: retrieved best first, then working memory, no repeats
+    std::unordered_map<int, uint32_t> slot;
+    slot.reserve(retrieved.size() + working_memory_.size() * 8);
+    auto add = [&](int node_id) {
+        if (slot.emplace(node_id, static_cast<uint32_t>(context->nodes.size())).second) {
+            context->nodes.push_back(node_id);
+        }
+    };
+    for (const auto& r : retrieved) {
+        add(r.first);
+    }
     for (const auto& seq : working_memory_) {
         for (int node_id : seq) {
-            context_nodes.insert(node_id);
+            add(node_id);
         }
     }
     
-    // 3. Materialize subgraph
-    std::unordered_map<int, std::vector<std::pair<int, float>>> context_graph;
-    
-    for (int node_id : context_nodes) {
-        auto it = graph.find(node_id);
+    // CSR slice: edges that stay inside the context
+    size_t n = context->nodes.size();
+    context->in_graph.assign(n, 0);
+    context->offsets.resize(n + 1);
+    context->offsets[0] = 0;
+    for (size_t i = 0; i < n; ++i) {
+        auto it = graph.find(context->nodes[i]);
         if (it != graph.end()) {
-            // Filter edges to only include context nodes
-            std::vector<std::pair<int, float>> filtered_edges;
+            context->in_graph[i] = 1;
             for (const auto& edge : it->second) {
-                if (context_nodes.count(edge.first) > 0) {
-                    filtered_edges.push_back(edge);
+                if (slot.count(edge.first) > 0) {
+                    context->edges.push_back(edge);
                 }
             }
-            context_graph[node_id] = filtered_edges;
         }
+        context->offsets[i + 1] = static_cast<uint32_t>(context->edges.size());
     }
     
-    // 4. Bias activation field towards context
-    for (int node_id : context_nodes) {
-        activation_field_.activate(node_id, 0.5f);
-    }
-    
-    return context_graph;
+    return context;
 }
 
 } // namespace reasoning
@@ -2,15 +2,62 @@
 #define MEMORY_HIERARCHY_H
 
 #include "spreading_activation.h"
+#include <cstdint>
 #include <deque>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
 namespace melvin {
 namespace reasoning {
 
+// Context subgraph in CSR form: the edges of nodes[i] that stay inside the
+// context are edges[offsets[i] .. offsets[i+1]).
+struct ContextSubgraph {
+    std::vector<int> nodes;                    // Retrieved (best first), then working memory
+    std::vector<uint8_t> in_graph;             // Per node: has an adjacency entry in the graph
+    std::vector<uint32_t> offsets;             // nodes.size() + 1
+    std::vector<std::pair<int, float>> edges;
+    
+    size_t size() const { return nodes.size(); }
+    const std::pair<int, float>* edges_begin(size_t i) const { return edges.data() + offsets[i]; }
+    const std::pair<int, float>* edges_end(size_t i) const { return edges.data() + offsets[i + 1]; }
+    
+    // Adjacency-map form (nodes without a graph entry are left out)
+    std::unordered_map<int, std::vector<std::pair<int, float>>> to_map() const;
+};
+
+// Shared and immutable, so cached views are handed out without copying
+using ContextView = std::shared_ptr<const ContextSubgraph>;
+
+// Embeddings as one contiguous row-major matrix of unit vectors, for
+// cosine top-k without walking a hash map. Shorter embeddings are
+// zero-padded to the longest one.
+class EmbeddingIndex {
+public:
+    void build(const std::unordered_map<int, std::vector<float>>& embeddings);
+    
+    size_t size() const { return ids_.size(); }
+    size_t dim() const { return dim_; }
+    
+    // The k most cosine-similar nodes, best first
+    void top_k(const std::vector<float>& query, size_t k,
+               std::vector<std::pair<int, float>>& out) const;
+    
+private:
+    size_t dim_ = 0;
+    size_t stride_ = 0;            // dim_ rounded up to 4 floats
+    std::vector<int> ids_;
+    std::vector<float> rows_;      // size() x stride_
+};
+
 class MemoryHierarchy {
 public:
+    struct CacheStats {
+        size_t hits = 0;
+        size_t misses = 0;
+    };
+    
     MemoryHierarchy();
     
     // Working memory (recent activations)
@@ -21,7 +68,7 @@ public:
     void record_episode(const std::vector<int>& activation_sequence);
     const std::deque<std::vector<int>>& get_episodes() const { return episodic_traces_; }
     
-    // Context subgraph building
+    // Context subgraph building (copies the result; see retrieve_context)
     std::unordered_map<int, std::vector<std::pair<int, float>>> build_context_subgraph(
         const std::vector<float>& query_embedding,
         const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
@@ -29,6 +76,22 @@ public:
         int top_k = 20
     );
     
+    // Indexed retrieval: top-k over index_embeddings() plus working memory,
+    // cut from `graph` as a CSR view. Views are cached by the query quantized
+    // to 1/32 steps, the working memory, top_k, the graph and graph_version;
+    // callers bump graph_version on every change to the graph's edges or
+    // weights. Biases the activation field towards the context like
+    // build_context_subgraph, cached or not.
+    void index_embeddings(const std::unordered_map<int, std::vector<float>>& embeddings);
+    ContextView retrieve_context(
+        const std::vector<float>& query_embedding,
+        const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph,
+        uint64_t graph_version,
+        int top_k = 20
+    );
+    void invalidate_context_cache();
+    CacheStats cache_stats() const { return cache_stats_; }
+    
     // Activation field accessor
     ActivationField& activation_field() { return activation_field_; }
     const ActivationField& activation_field() const { return activation_field_; }
@@ -37,6 +100,30 @@ private:
     std::deque<std::vector<int>> working_memory_;    // Last 10 sequences
     std::deque<std::vector<int>> episodic_traces_;   // Last 100 episodes
     ActivationField activation_field_;
+    
+    // Context cache: small, scanned linearly, least recently used evicted
+    static constexpr size_t CONTEXT_CACHE_SIZE = 16;
+    struct CacheEntry {
+        uint64_t hash = 0;
+        std::vector<int8_t> query;
+        uint64_t working_memory_hash = 0;
+        int top_k = 0;
+        const void* graph = nullptr;
+        uint64_t graph_version = 0;
+        uint64_t last_used = 0;
+        ContextView view;
+    };
+    EmbeddingIndex embedding_index_;
+    std::vector<CacheEntry> context_cache_;
+    uint64_t cache_clock_ = 0;
+    uint64_t working_memory_hash_ = 0;
+    CacheStats cache_stats_;
+    
+    void update_working_memory_hash();
+    
+    // Retrieved nodes + working memory, cut from graph
+    ContextView make_context(const std::vector<std::pair<int, float>>& retrieved,
+                             const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph) const;
 };
 
 } // namespace reasoning
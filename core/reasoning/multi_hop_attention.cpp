@@ -1,4 +1,5 @@
 #include "multi_hop_attention.h"
+#include "batch_scorer.h"
 #include <cmath>
 #include <algorithm>
 #include <unordered_set>
@@ -19,10 +20,8 @@ float MultiHopAttention::compute_attention(
     const std::vector<float>& value
 ) {
     // Simplified attention: dot product
-    float score = 0.0f;
-    for (size_t i = 0; i < std::min({query.size(), key.size(), value.size()}); ++i) {
-        score += query[i] * key[i];
-    }
+    size_t n = std::min({query.size(), key.size(), value.size()});
+    float score = BatchScorer::dot(query.data(), key.data(), n);
     return score / std::sqrt(static_cast<float>(head_dim_));
 }
 
@@ -39,6 +38,12 @@ std::vector<MultiHopAttention::QueryResult> MultiHopAttention::query(
     
     std::vector<float> current_query = query_embedding;
     
+    // Per-hop scratch, reused so later hops don't allocate
+    BatchScorer batch;
+    std::vector<float> activations;
+    std::vector<float> scores;
+    std::vector<BatchHit> best;
+    
     for (int hop = 0; hop < max_hops; ++hop) {
         // Get active frontier
         auto active_nodes = activation_field.get_active_nodes(frontier_threshold);
@@ -47,13 +52,11 @@ std::vector<MultiHopAttention::QueryResult> MultiHopAttention::query(
             break;
         }
         
-        // Find best node based on attention
-        int best_node = -1;
-        float best_attention = -1.0f;
-        
+        // Gather unvisited frontier nodes and score them in one batch
+        batch.reset(current_query);
+        activations.clear();
         for (const auto& active_pair : active_nodes) {
             int node_id = active_pair.first;
-            float activation = active_pair.second;
             
             if (visited.count(node_id) > 0) {
                 continue;
@@ -64,18 +67,26 @@ std::vector<MultiHopAttention::QueryResult> MultiHopAttention::query(
                 continue;
             }
             
-            float attention = compute_attention(current_query, emb_it->second, emb_it->second);
-            attention *= activation;  // Weight by activation
-            
-            if (attention > best_attention) {
-                best_attention = attention;
-                best_node = node_id;
-            }
+            batch.add(node_id, emb_it->second);
+            activations.push_back(active_pair.second);
+        }
+        
+        if (batch.size() == 0) {
+            break;
+        }
+        
+        batch.dot_all(scores);
+        float scale = 1.0f / std::sqrt(static_cast<float>(head_dim_));
+        for (size_t row = 0; row < scores.size(); ++row) {
+            scores[row] *= scale * activations[row];  // Weight by activation
         }
         
-        if (best_node == -1) {
+        BatchScorer::top_k(scores.data(), scores.size(), 1, best);
+        if (best[0].score <= -1.0f) {
             break;
         }
+        int best_node = batch.id(best[0].row);
+        float best_attention = best[0].score;
         
         // Add to path
         QueryResult result;
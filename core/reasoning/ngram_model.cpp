@@ -0,0 +1,321 @@
+#include "ngram_model.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+namespace melvin {
+namespace reasoning {
+
+namespace {
+
+constexpr uint32_t NGRAM_FILE_MAGIC = 0x4D4E474D;  // "MNGM"
+constexpr uint32_t NGRAM_FILE_VERSION = 1;
+
+inline uint64_t mix64(uint64_t x) {
+    // splitmix64 finalizer
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+template <typename T>
+void write_pod(std::ofstream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_pod(std::ifstream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return static_cast<bool>(in);
+}
+
+} // namespace
+
+// ============================================================================
+// Table
+// ============================================================================
+
+long NGramModel::Table::find(uint64_t key) const {
+    if (slots.empty()) {
+        return -1;
+    }
+    size_t mask = slots.size() - 1;
+    for (size_t i = key & mask;; i = (i + 1) & mask) {
+        uint32_t index = slots[i];
+        if (index == EMPTY) return -1;
+        if (contexts[index].key == key) return index;
+    }
+}
+
+NGramModel::Context& NGramModel::Table::insert(uint64_t key) {
+    // Keep load factor under 0.7 (capacity is always a power of two)
+    if ((contexts.size() + 1) * 10 > slots.size() * 7) {
+        rehash(std::max<size_t>(64, slots.size() * 2));
+    }
+
+    size_t mask = slots.size() - 1;
+    size_t i = key & mask;
+    while (slots[i] != EMPTY) {
+        i = (i + 1) & mask;
+    }
+    slots[i] = static_cast<uint32_t>(contexts.size());
+    contexts.push_back({key, 0, {}});
+    return contexts.back();
+}
+
+void NGramModel::Table::rehash(size_t capacity) {
+    slots.assign(capacity, EMPTY);
+    size_t mask = capacity - 1;
+    for (size_t index = 0; index < contexts.size(); ++index) {
+        size_t i = contexts[index].key & mask;
+        while (slots[i] != EMPTY) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = static_cast<uint32_t>(index);
+    }
+}
+
+// ============================================================================
+// NGramModel
+// ============================================================================
+
+NGramModel::NGramModel() : NGramModel(Config()) {
+}
+
+NGramModel::NGramModel(const Config& config) : config_(config) {
+    config_.max_order = std::max(1, std::min(config_.max_order, MAX_ORDER));
+    config_.max_successors = std::max<uint32_t>(1, config_.max_successors);
+    tables_.resize(config_.max_order);
+    if (config_.admit_threshold > 1) {
+        sketch_.assign(static_cast<size_t>(config_.sketch_width) * config_.sketch_depth, 0);
+    }
+}
+
+uint64_t NGramModel::context_key(const int* nodes, int order) {
+    uint64_t h = mix64(static_cast<uint64_t>(order));
+    for (int i = 0; i < order; ++i) {
+        h = mix64(h ^ static_cast<uint32_t>(nodes[i]));
+    }
+    return h;
+}
+
+uint32_t NGramModel::sketch_increment(uint64_t key) {
+    // Count-min: every row is incremented, the estimate is the minimum
+    uint32_t estimate = UINT32_MAX;
+    for (uint32_t row = 0; row < config_.sketch_depth; ++row) {
+        uint64_t h = mix64(key + row * 0x9e3779b97f4a7c15ULL);
+        uint32_t& cell = sketch_[row * static_cast<size_t>(config_.sketch_width) + (h % config_.sketch_width)];
+        if (cell < UINT32_MAX) ++cell;
+        estimate = std::min(estimate, cell);
+    }
+    return estimate;
+}
+
+void NGramModel::add_successor(Context& ctx, int next_node, uint32_t cap) {
+    ctx.total++;
+    auto& succ = ctx.successors;
+
+    size_t pos = 0;
+    while (pos < succ.size() && succ[pos].node_id != next_node) {
+        ++pos;
+    }
+
+    if (pos == succ.size()) {
+        if (succ.size() < cap) {
+            succ.push_back({next_node, 1});
+        } else {
+            // Space-Saving: the least frequent successor is replaced and its
+            // count inherited, which keeps the heavy hitters exact
+            pos = succ.size() - 1;
+            succ[pos].node_id = next_node;
+            succ[pos].count++;
+        }
+    } else {
+        succ[pos].count++;
+    }
+
+    // Restore descending order; the bumped entry only ever moves forward
+    while (pos > 0 && succ[pos - 1].count < succ[pos].count) {
+        std::swap(succ[pos - 1], succ[pos]);
+        --pos;
+    }
+}
+
+void NGramModel::record(const std::vector<int>& context, int next_node) {
+    int available = static_cast<int>(std::min<size_t>(context.size(), config_.max_order));
+    const int* end = context.data() + context.size();
+
+    for (int order = 1; order <= available; ++order) {
+        uint64_t key = context_key(end - order, order);
+        Table& table = tables_[order - 1];
+
+        long index = table.find(key);
+        if (index < 0) {
+            // Unigrams are always admitted; longer contexts wait for the sketch
+            if (order > 1 && config_.admit_threshold > 1 &&
+                sketch_increment(key) < config_.admit_threshold) {
+                continue;
+            }
+            add_successor(table.insert(key), next_node, config_.max_successors);
+        } else {
+            add_successor(table.contexts[index], next_node, config_.max_successors);
+        }
+    }
+}
+
+NGramMatch NGramModel::predict(const std::vector<int>& context, int top_k, int max_len) const {
+    NGramMatch match;
+    int longest = static_cast<int>(std::min<size_t>(context.size(), config_.max_order));
+    longest = std::min(longest, max_len);
+    const int* end = context.data() + context.size();
+
+    for (int order = longest; order >= 1; --order) {
+        const Table& table = tables_[order - 1];
+        long index = table.find(context_key(end - order, order));
+        if (index < 0 || table.contexts[index].successors.empty()) {
+            continue;
+        }
+
+        const Context& ctx = table.contexts[index];
+        size_t k = std::min<size_t>(ctx.successors.size(), static_cast<size_t>(std::max(top_k, 0)));
+        match.order = order;
+        match.total = ctx.total;
+        match.top.assign(ctx.successors.begin(), ctx.successors.begin() + k);
+        return match;
+    }
+
+    return match;
+}
+
+size_t NGramModel::prune(uint32_t min_total) {
+    size_t removed = 0;
+    for (Table& table : tables_) {
+        size_t before = table.contexts.size();
+        table.contexts.erase(
+            std::remove_if(table.contexts.begin(), table.contexts.end(),
+                           [min_total](const Context& ctx) { return ctx.total < min_total; }),
+            table.contexts.end());
+        removed += before - table.contexts.size();
+        if (table.contexts.size() != before) {
+            table.rehash(std::max<size_t>(64, table.slots.size()));
+        }
+    }
+    return removed;
+}
+
+size_t NGramModel::context_count() const {
+    size_t count = 0;
+    for (const Table& table : tables_) {
+        count += table.contexts.size();
+    }
+    return count;
+}
+
+size_t NGramModel::context_count(int order) const {
+    if (order < 1 || order > config_.max_order) return 0;
+    return tables_[order - 1].contexts.size();
+}
+
+size_t NGramModel::memory_bytes() const {
+    size_t bytes = sketch_.size() * sizeof(uint32_t);
+    for (const Table& table : tables_) {
+        bytes += table.slots.capacity() * sizeof(uint32_t);
+        bytes += table.contexts.capacity() * sizeof(Context);
+        for (const Context& ctx : table.contexts) {
+            bytes += ctx.successors.capacity() * sizeof(NGramSuccessor);
+        }
+    }
+    return bytes;
+}
+
+bool NGramModel::save(const std::string& filepath) const {
+    std::ofstream out(filepath, std::ios::binary);
+    if (!out) {
+        std::cerr << "❌ Cannot save n-gram model to " << filepath << std::endl;
+        return false;
+    }
+
+    write_pod(out, NGRAM_FILE_MAGIC);
+    write_pod(out, NGRAM_FILE_VERSION);
+    int32_t max_order = config_.max_order;
+    write_pod(out, max_order);
+
+    for (const Table& table : tables_) {
+        uint64_t context_count = table.contexts.size();
+        write_pod(out, context_count);
+        for (const Context& ctx : table.contexts) {
+            uint32_t succ_count = static_cast<uint32_t>(ctx.successors.size());
+            write_pod(out, ctx.key);
+            write_pod(out, ctx.total);
+            write_pod(out, succ_count);
+            out.write(reinterpret_cast<const char*>(ctx.successors.data()),
+                      succ_count * sizeof(NGramSuccessor));
+        }
+    }
+
+    return static_cast<bool>(out);
+}
+
+bool NGramModel::load(const std::string& filepath) {
+    std::ifstream in(filepath, std::ios::binary);
+    if (!in) {
+        return false;
+    }
+
+    uint32_t magic = 0, version = 0;
+    int32_t max_order = 0;
+    if (!read_pod(in, magic) || !read_pod(in, version) || !read_pod(in, max_order) ||
+        magic != NGRAM_FILE_MAGIC || version != NGRAM_FILE_VERSION ||
+        max_order < 1 || max_order > MAX_ORDER) {
+        std::cerr << "❌ Invalid n-gram model file " << filepath << std::endl;
+        return false;
+    }
+
+    std::vector<Table> tables(config_.max_order);
+    for (int order = 1; order <= max_order; ++order) {
+        uint64_t context_count = 0;
+        if (!read_pod(in, context_count)) return false;
+
+        for (uint64_t c = 0; c < context_count; ++c) {
+            Context ctx;
+            uint32_t succ_count = 0;
+            if (!read_pod(in, ctx.key) || !read_pod(in, ctx.total) || !read_pod(in, succ_count)) {
+                return false;
+            }
+            // Lists never outgrow the Space-Saving cap; a larger count is a
+            // corrupt file or another model's cap, not a size to allocate
+            if (succ_count > config_.max_successors) {
+                std::cerr << "❌ Invalid n-gram model file " << filepath << ": " << succ_count
+                          << " successors in one context (cap " << config_.max_successors << ")" << std::endl;
+                return false;
+            }
+            ctx.successors.resize(succ_count);
+            in.read(reinterpret_cast<char*>(ctx.successors.data()), succ_count * sizeof(NGramSuccessor));
+            if (!in) return false;
+
+            // Orders beyond this model's max_order are read and discarded
+            if (order <= config_.max_order) {
+                tables[order - 1].contexts.push_back(std::move(ctx));
+            }
+        }
+    }
+
+    for (Table& table : tables) {
+        size_t capacity = 64;
+        while (capacity * 7 < table.contexts.size() * 10) capacity *= 2;
+        table.rehash(capacity);
+    }
+    tables_ = std::move(tables);
+    return true;
+}
+
+void NGramModel::clear() {
+    tables_.assign(config_.max_order, Table());
+    std::fill(sketch_.begin(), sketch_.end(), 0);
+}
+
+} // namespace reasoning
+} // namespace melvin
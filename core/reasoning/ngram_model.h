@@ -0,0 +1,112 @@
+/**
+ * @file ngram_model.h
+ * @brief Compact hashed n-gram store for exact sequence recall
+ *
+ * Context (last n node ids) → successor counts, for every order 1..N:
+ * - One open-addressed table per order, keyed by a 64-bit packed context hash
+ * - Successors kept sorted by count, so top-k is a prefix read (no sort)
+ * - Successor lists are capped; overflow uses Space-Saving replacement
+ * - A count-min sketch gates admission of new high-order contexts so
+ *   one-off sequences don't grow the tables on long-running learners
+ */
+
+#ifndef MELVIN_NGRAM_MODEL_H
+#define MELVIN_NGRAM_MODEL_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace melvin {
+namespace reasoning {
+
+/**
+ * @brief Successor of a context with its observed count
+ */
+struct NGramSuccessor {
+    int32_t node_id;
+    uint32_t count;
+};
+
+/**
+ * @brief Result of a longest-match lookup
+ */
+struct NGramMatch {
+    int order = 0;                              // Context length that matched (0 = none)
+    uint32_t total = 0;                         // Total observations of the context
+    std::vector<NGramSuccessor> top;            // Up to top_k successors, most frequent first
+};
+
+class NGramModel {
+public:
+    struct Config {
+        int max_order = 3;                      // Longest context tracked (1..MAX_ORDER)
+        uint32_t max_successors = 32;           // Successor list cap per context
+        uint32_t admit_threshold = 1;           // Sketch count before an order>=2 context is stored
+        uint32_t sketch_width = 1 << 16;        // Count-min sketch columns
+        uint32_t sketch_depth = 4;              // Count-min sketch rows
+    };
+
+    static constexpr int MAX_ORDER = 8;
+
+    NGramModel();
+    explicit NGramModel(const Config& config);
+
+    /**
+     * @brief Record next_node after every suffix of context up to max_order
+     */
+    void record(const std::vector<int>& context, int next_node);
+
+    /**
+     * @brief Longest stored suffix of context (<= max_len) with its top-k successors
+     */
+    NGramMatch predict(const std::vector<int>& context, int top_k, int max_len = MAX_ORDER) const;
+
+    /**
+     * @brief Drop contexts observed fewer than min_total times; returns contexts removed
+     */
+    size_t prune(uint32_t min_total);
+
+    size_t context_count() const;
+    size_t context_count(int order) const;
+    size_t memory_bytes() const;
+    int max_order() const { return config_.max_order; }
+
+    bool save(const std::string& filepath) const;
+    // Fails, leaving the model unchanged, on a malformed file or a context
+    // with more successors than config.max_successors
+    bool load(const std::string& filepath);
+    void clear();
+
+private:
+    struct Context {
+        uint64_t key;
+        uint32_t total;
+        std::vector<NGramSuccessor> successors;  // Sorted by count, descending
+    };
+
+    // Open-addressed table for one order: slot → index into contexts (or EMPTY)
+    struct Table {
+        std::vector<uint32_t> slots;
+        std::vector<Context> contexts;
+
+        long find(uint64_t key) const;
+        Context& insert(uint64_t key);
+        void rehash(size_t capacity);
+    };
+
+    static constexpr uint32_t EMPTY = 0xFFFFFFFFu;
+
+    Config config_;
+    std::vector<Table> tables_;                 // tables_[order - 1]
+    std::vector<uint32_t> sketch_;              // depth × width counters
+
+    static uint64_t context_key(const int* nodes, int order);
+    static void add_successor(Context& ctx, int next_node, uint32_t cap);
+    uint32_t sketch_increment(uint64_t key);
+};
+
+} // namespace reasoning
+} // namespace melvin
+
+#endif // MELVIN_NGRAM_MODEL_H
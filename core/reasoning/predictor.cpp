@@ -2,12 +2,18 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
+#include <map>
 
 namespace melvin {
 namespace reasoning {
 
-Predictor::Predictor(int embedding_dim)
+Predictor::Predictor(int embedding_dim, int max_order)
     : embedding_dim_(embedding_dim)
+    , ngrams_([max_order] {
+          NGramModel::Config config;
+          config.max_order = max_order;
+          return config;
+      }())
 {
 }
 
@@ -44,70 +50,30 @@ std::vector<PredictionResult> Predictor::predict_exact_sequence(
     const std::vector<int>& context_nodes,
     int top_k
 ) {
-    // Try decreasing context lengths: 3, 2, 1
-    for (int context_len : {3, 2, 1}) {
-        if (context_nodes.size() < static_cast<size_t>(context_len)) {
-            continue;
-        }
-        
-        // Get last N nodes
-        auto start_it = context_nodes.end() - context_len;
-        std::vector<int> context(start_it, context_nodes.end());
-        
-        std::map<int, int> matches;
-        
-        // Check trigrams
-        if (context_len == 3 && context.size() == 3) {
-            auto key = std::make_tuple(context[0], context[1], context[2]);
-            auto it = trigram_counts_.find(key);
-            if (it != trigram_counts_.end() && !it->second.empty()) {
-                matches = it->second;
-            }
-        }
-        // Check bigrams
-        else if (context_len == 2 && context.size() == 2) {
-            auto key = std::make_pair(context[0], context[1]);
-            auto it = bigram_counts_.find(key);
-            if (it != bigram_counts_.end() && !it->second.empty()) {
-                matches = it->second;
-            }
-        }
-        // Check unigrams
-        else if (context_len == 1 && context.size() == 1) {
-            auto it = transition_counts_.find(context[0]);
-            if (it != transition_counts_.end() && !it->second.empty()) {
-                matches = it->second;
-            }
-        }
-        
-        if (!matches.empty()) {
-            // Convert to results
-            std::vector<PredictionResult> results;
-            int total = 0;
-            for (const auto& pair : matches) {
-                total += pair.second;
-            }
-            
-            // Sort by count
-            std::vector<std::pair<int, int>> sorted_matches(matches.begin(), matches.end());
-            std::sort(sorted_matches.begin(), sorted_matches.end(),
-                     [](const auto& a, const auto& b) { return a.second > b.second; });
-            
-            for (size_t i = 0; i < std::min(sorted_matches.size(), static_cast<size_t>(top_k)); ++i) {
-                PredictionResult result;
-                result.node_id = sorted_matches[i].first;
-                result.confidence = static_cast<float>(sorted_matches[i].second) / total;
-                result.score = result.confidence;
-                result.source = (context_len == 3) ? "exact_trigram" :
-                               (context_len == 2) ? "exact_bigram" : "exact_unigram";
-                results.push_back(result);
-            }
-            
-            return results;
-        }
+    // Longest stored suffix wins (trigram, then bigram, then unigram, ...);
+    // successors are already ranked, so this is a lookup plus a k-prefix copy
+    NGramMatch match = ngrams_.predict(context_nodes, top_k);
+    if (match.order == 0 || match.total == 0) {
+        return {};
     }
     
-    return {};
+    std::string source = (match.order == 3) ? "exact_trigram" :
+                         (match.order == 2) ? "exact_bigram" :
+                         (match.order == 1) ? "exact_unigram" :
+                         "exact_" + std::to_string(match.order) + "gram";
+    
+    std::vector<PredictionResult> results;
+    results.reserve(match.top.size());
+    for (const NGramSuccessor& succ : match.top) {
+        PredictionResult result;
+        result.node_id = succ.node_id;
+        result.confidence = static_cast<float>(succ.count) / match.total;
+        result.score = result.confidence;
+        result.source = source;
+        results.push_back(result);
+    }
+    
+    return results;
 }
 
 std::vector<PredictionResult> Predictor::predict_semantic(
@@ -172,19 +138,40 @@ std::vector<PredictionResult> Predictor::predict_semantic(
         }
     }
     
-    // Sort and return top-k
-    std::vector<std::pair<int, float>> sorted_candidates(candidates.begin(), candidates.end());
-    std::sort(sorted_candidates.begin(), sorted_candidates.end(),
-             [](const auto& a, const auto& b) { return a.second > b.second; });
+    if (candidates.empty()) {
+        return {};
+    }
+    
+    // Gather candidates once into a contiguous block and score them all
+    // against the context embedding in one pass
+    batch_.reset(get_context_embedding(context_nodes, embeddings));
+    batch_scores_.clear();
+    for (const auto& candidate : candidates) {
+        auto emb_it = embeddings.find(candidate.first);
+        batch_.add(candidate.first, emb_it != embeddings.end() ? emb_it->second : std::vector<float>());
+        batch_scores_.push_back(candidate.second);
+    }
+    
+    batch_.cosine_all(batch_similarity_);
+    for (size_t i = 0; i < batch_scores_.size(); ++i) {
+        // Semantic fit scales the graph score into [0.5, 1.0]; with no
+        // embeddings every candidate gets 0.5 and the ranking is unchanged
+        batch_scores_[i] *= 0.5f + 0.5f * std::max(0.0f, batch_similarity_[i]);
+    }
+    
+    // Bounded heap instead of sorting every candidate
+    BatchScorer::top_k(batch_scores_.data(), batch_scores_.size(),
+                       static_cast<size_t>(std::max(top_k, 0)), batch_hits_);
     
     std::vector<PredictionResult> results;
-    float max_score = sorted_candidates.empty() ? 1.0f : sorted_candidates[0].second;
+    results.reserve(batch_hits_.size());
+    float max_score = batch_hits_.empty() ? 1.0f : batch_hits_[0].score;
     
-    for (size_t i = 0; i < std::min(sorted_candidates.size(), static_cast<size_t>(top_k)); ++i) {
+    for (const BatchHit& hit : batch_hits_) {
         PredictionResult result;
-        result.node_id = sorted_candidates[i].first;
-        result.score = sorted_candidates[i].second;
-        result.confidence = max_score > 0 ? sorted_candidates[i].second / max_score : 0.0f;
+        result.node_id = batch_.id(hit.row);
+        result.score = hit.score;
+        result.confidence = max_score > 0 ? hit.score / max_score : 0.0f;
         result.source = "semantic";
         results.push_back(result);
     }
@@ -197,26 +184,7 @@ void Predictor::record_sequence(const std::vector<int>& context, int next_node)
         return;
     }
     
-    // Record unigram
-    if (context.size() >= 1) {
-        transition_counts_[context.back()][next_node]++;
-    }
-    
-    // Record bigram
-    if (context.size() >= 2) {
-        auto key = std::make_pair(context[context.size()-2], context[context.size()-1]);
-        bigram_counts_[key][next_node]++;
-    }
-    
-    // Record trigram
-    if (context.size() >= 3) {
-        auto key = std::make_tuple(
-            context[context.size()-3],
-            context[context.size()-2],
-            context[context.size()-1]
-        );
-        trigram_counts_[key][next_node]++;
-    }
+    ngrams_.record(context, next_node);
 }
 
 void Predictor::update_context_performance(const std::vector<int>& context, bool correct) {
@@ -274,16 +242,16 @@ std::vector<float> Predictor::get_context_embedding(
     for (int node_id : nodes) {
         auto it = embeddings.find(node_id);
         if (it != embeddings.end()) {
-            for (size_t i = 0; i < embedding_dim_ && i < it->second.size(); ++i) {
-                result[i] += it->second[i];
-            }
+            size_t n = std::min(result.size(), it->second.size());
+            BatchScorer::accumulate(result.data(), it->second.data(), n);
             count++;
         }
     }
     
     if (count > 0) {
+        float inv = 1.0f / count;
         for (float& val : result) {
-            val /= count;
+            val *= inv;
         }
     }
     
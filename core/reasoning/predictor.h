@@ -2,10 +2,11 @@
 #define PREDICTOR_H
 
 #include "spreading_activation.h"
+#include "ngram_model.h"
+#include "batch_scorer.h"
 #include <unordered_map>
 #include <vector>
 #include <string>
-#include <map>
 
 namespace melvin {
 namespace reasoning {
@@ -14,12 +15,12 @@ struct PredictionResult {
     int node_id;
     float confidence;
     float score;
-    std::string source;  // "exact_trigram", "exact_bigram", "exact_unigram", "semantic"
+    std::string source;  // "exact_trigram", "exact_bigram", "exact_unigram", "exact_<n>gram", "semantic"
 };
 
 class Predictor {
 public:
-    explicit Predictor(int embedding_dim = 128);
+    explicit Predictor(int embedding_dim = 128, int max_order = 3);
     
     // Prediction modes
     enum class Mode {
@@ -44,6 +45,12 @@ public:
     // Context performance tracking
     void update_context_performance(const std::vector<int>& context, bool correct);
     
+    // Exact sequence memory persistence / maintenance
+    bool save_sequences(const std::string& filepath) const { return ngrams_.save(filepath); }
+    bool load_sequences(const std::string& filepath) { return ngrams_.load(filepath); }
+    size_t prune_sequences(uint32_t min_count) { return ngrams_.prune(min_count); }
+    const NGramModel& sequences() const { return ngrams_; }
+    
 private:
     // Exact recall methods
     std::vector<PredictionResult> predict_exact_sequence(
@@ -69,10 +76,14 @@ private:
     
     int embedding_dim_;
     
-    // Exact sequence memory (n-grams)
-    std::map<int, std::map<int, int>> transition_counts_;  // node → {next: count}
-    std::map<std::pair<int,int>, std::map<int, int>> bigram_counts_;
-    std::map<std::tuple<int,int,int>, std::map<int, int>> trigram_counts_;
+    // Exact sequence memory (n-grams of every order up to max_order)
+    NGramModel ngrams_;
+    
+    // Semantic scoring scratch (reused across predictions)
+    BatchScorer batch_;
+    std::vector<float> batch_scores_;
+    std::vector<float> batch_similarity_;
+    std::vector<BatchHit> batch_hits_;
     
     // Adaptive context tracking
     std::unordered_map<int, int> optimal_context_lengths_;
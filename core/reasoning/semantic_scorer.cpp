@@ -4,6 +4,7 @@
  */
 
 #include "semantic_scorer.h"
+#include "batch_scorer.h"
 #include <algorithm>
 #include <cmath>
 
@@ -54,25 +55,35 @@ std::vector<ScoredNode> SemanticScorer::score_all(
     std::vector<ScoredNode> scored;
     scored.reserve(active_nodes.size());
     
+    // Gather embedded nodes into one block; semantic fit for all of them
+    // is then a single batched cosine pass
+    BatchScorer batch;
+    batch.reset(query_embedding);
     for (int node_id : active_nodes) {
-        ScoredNode snode;
-        snode.node_id = node_id;
-        
-        // Get activation
-        auto act_it = activations.find(node_id);
-        snode.activation = (act_it != activations.end()) ? act_it->second : 0.0f;
-        
-        // Get embedding
         auto emb_it = embeddings.find(node_id);
         if (emb_it == embeddings.end() || emb_it->second.empty()) {
             continue;  // Skip nodes without embeddings
         }
+        // Mismatched dimensions score 0, as in cosine_similarity()
+        batch.add(node_id, emb_it->second.size() == query_embedding.size()
+                               ? emb_it->second : std::vector<float>());
+    }
+    
+    std::vector<float> semantic_fit;
+    batch.cosine_all(semantic_fit);
+    
+    for (size_t row = 0; row < batch.size(); ++row) {
+        ScoredNode snode;
+        snode.node_id = batch.id(row);
         
-        // Compute semantic fit
-        snode.semantic_fit = compute_semantic_fit(emb_it->second, query_embedding);
+        // Get activation
+        auto act_it = activations.find(snode.node_id);
+        snode.activation = (act_it != activations.end()) ? act_it->second : 0.0f;
+        
+        snode.semantic_fit = semantic_fit[row];
         
         // Get path
-        auto path_it = paths_from_query.find(node_id);
+        auto path_it = paths_from_query.find(snode.node_id);
         if (path_it != paths_from_query.end()) {
             snode.best_path = path_it->second;
             snode.path_coherence = compute_path_coherence(snode.best_path, embeddings);
@@ -165,15 +176,9 @@ float SemanticScorer::cosine_similarity(
 ) const {
     if (a.size() != b.size() || a.empty()) return 0.0f;
     
-    float dot = 0.0f;
-    float norm_a = 0.0f;
-    float norm_b = 0.0f;
-    
-    for (size_t i = 0; i < a.size(); i++) {
-        dot += a[i] * b[i];
-        norm_a += a[i] * a[i];
-        norm_b += b[i] * b[i];
-    }
+    float dot = BatchScorer::dot(a.data(), b.data(), a.size());
+    float norm_a = BatchScorer::dot(a.data(), a.data(), a.size());
+    float norm_b = BatchScorer::dot(b.data(), b.data(), b.size());
     
     float denom = std::sqrt(norm_a) * std::sqrt(norm_b);
     return (denom > 1e-6f) ? (dot / denom) : 0.0f;
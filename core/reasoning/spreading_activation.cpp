@@ -40,6 +40,44 @@ void MetaLearner::adapt(float success, float surprise) {
     }
 }
 
+// Latency Histogram
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    size_t bucket = 0;
+    while (bucket + 1 < BUCKETS && (nanoseconds >> (bucket + 1)) != 0) {
+        bucket++;
+    }
+    counts_[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyHistogram::reset() {
+    for (auto& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t LatencyHistogram::count() const {
+    uint64_t total = 0;
+    for (const auto& count : counts_) {
+        total += count.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t LatencyHistogram::percentile(float p) const {
+    uint64_t total = count();
+    if (total == 0) return 0;
+    
+    uint64_t target = static_cast<uint64_t>(std::ceil(std::max(0.0f, std::min(1.0f, p)) * total));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += bucket(i);
+        if (seen >= std::max<uint64_t>(target, 1)) {
+            return uint64_t(1) << (i + 1);
+        }
+    }
+    return uint64_t(1) << BUCKETS;
+}
+
 ActivationField::ActivationField(float decay_rate, float spread_rate, float min_activation)
     : decay_rate_(decay_rate)
     , spread_rate_(spread_rate)
@@ -54,25 +92,64 @@ ActivationField::~ActivationField() {
     stop_background_loop();
 }
 
+template <typename Mutation>
+void ActivationField::publish(Mutation&& apply) {
+    // Caller holds activation_mutex_
+    int side = read_side_.load();
+    apply(published_[1 - side]);
+    read_side_.store(1 - side);
+    
+    // Readers that announced themselves on the current version may still be
+    // on the old side: flip the version, then wait for both counters to drain
+    auto start = std::chrono::steady_clock::now();
+    int version = version_.load();
+    while (readers_[1 - version].count.load() != 0) {
+        std::this_thread::yield();
+    }
+    version_.store(1 - version);
+    while (readers_[version].count.load() != 0) {
+        std::this_thread::yield();
+    }
+    publish_wait_histogram_.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+    
+    apply(published_[side]);
+}
+
 void ActivationField::activate(int node_id, float strength) {
     std::lock_guard<std::mutex> lock(activation_mutex_);
-    activations_[node_id] = std::max(activations_[node_id], strength);
+    float& activation = activations_[node_id];
+    activation = std::max(activation, strength);
+    float value = activation;
+    publish([&](std::unordered_map<int, float>& values) { values[node_id] = value; });
 }
 
-float ActivationField::get_activation(int node_id) const {
+void ActivationField::activate_batch(const std::vector<int>& node_ids, float strength) {
+    if (node_ids.empty()) return;
     std::lock_guard<std::mutex> lock(activation_mutex_);
-    auto it = activations_.find(node_id);
-    return (it != activations_.end()) ? it->second : 0.0f;
+    for (int node_id : node_ids) {
+        float& activation = activations_[node_id];
+        activation = std::max(activation, strength);
+    }
+    publish([&](std::unordered_map<int, float>& values) {
+        for (int node_id : node_ids) {
+            values[node_id] = activations_[node_id];
+        }
+    });
+}
+
+float ActivationField::get_activation(int node_id) const {
+    return read_published([&](const std::unordered_map<int, float>& values) {
+        auto it = values.find(node_id);
+        return (it != values.end()) ? it->second : 0.0f;
+    });
 }
 
 std::unordered_map<int, float> ActivationField::get_active_nodes(float threshold) const {
-    std::lock_guard<std::mutex> lock(activation_mutex_);
     std::unordered_map<int, float> result;
-    for (const auto& pair : activations_) {
-        if (pair.second >= threshold) {
-            result[pair.first] = pair.second;
-        }
-    }
+    for_each_active(threshold, [&](int node_id, float activation) {
+        result.emplace(node_id, activation);
+    });
     return result;
 }
 
@@ -117,6 +194,7 @@ void ActivationField::background_loop() {
 }
 
 void ActivationField::tick(const std::unordered_map<int, std::vector<std::pair<int, float>>>& graph) {
+    auto tick_start = std::chrono::steady_clock::now();
     std::lock_guard<std::mutex> lock(activation_mutex_);
     
     // Store graph reference for background loop
@@ -218,6 +296,12 @@ void ActivationField::tick(const std::unordered_map<int, std::vector<std::pair<i
     }
     
     current_time_ += (1000.0f / tick_rate_);
+    
+    // Readers switch to the new state in one step
+    publish([&](std::unordered_map<int, float>& values) { values = activations_; });
+    
+    tick_histogram_.record(static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - tick_start).count()));
 }
 
 // ==============================================================================
@@ -294,7 +378,10 @@ void ActivationField::inject_energy(int node_id, float strength, float salience,
     dynamics.last_activation_time = current_time_;
     
     // Also update legacy activation for compatibility
-    activations_[node_id] = std::max(activations_[node_id], energy_injection / 10.0f);
+    float& activation = activations_[node_id];
+    activation = std::max(activation, energy_injection / 10.0f);
+    float value = activation;
+    publish([&](std::unordered_map<int, float>& values) { values[node_id] = value; });
 }
 
 float ActivationField::get_energy(int node_id) const {
@@ -7,6 +7,7 @@
 #include <thread>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <deque>
 
 namespace melvin {
@@ -96,6 +97,25 @@ struct MetaLearner {
     void adapt(float success, float surprise);
 };
 
+// Latency histogram with power-of-two buckets: bucket i counts samples in
+// [2^i, 2^(i+1)) nanoseconds. Recording is a single relaxed increment.
+class LatencyHistogram {
+public:
+    static constexpr size_t BUCKETS = 40;
+    
+    void record(uint64_t nanoseconds);
+    void reset();
+    
+    uint64_t count() const;
+    uint64_t bucket(size_t i) const { return counts_[i].load(std::memory_order_relaxed); }
+    
+    // Upper edge (ns) of the bucket holding the p-th fraction of samples
+    uint64_t percentile(float p) const;
+    
+private:
+    std::atomic<uint64_t> counts_[BUCKETS] = {};
+};
+
 class ActivationField {
 public:
     ActivationField(float decay_rate = 0.9f, float spread_rate = 0.3f, float min_activation = 0.01f);
@@ -130,10 +150,32 @@ public:
     void decay_eligibility_traces(float decay_factor = 0.95f);
     
     // Original interface (enhanced)
+    // Readers see the last published state and never lock or wait for a tick
     void activate(int node_id, float strength = 1.0f);
+    void activate_batch(const std::vector<int>& node_ids, float strength = 1.0f);  // One publish
     float get_activation(int node_id) const;
     std::unordered_map<int, float> get_active_nodes(float threshold = 0.05f) const;
     
+    // Calls fn(node_id, activation) for every node at or above threshold,
+    // without building a map
+    template <typename F>
+    void for_each_active(float threshold, F&& fn) const {
+        read_published([&](const std::unordered_map<int, float>& values) {
+            for (const auto& pair : values) {
+                if (pair.second >= threshold) {
+                    fn(pair.first, pair.second);
+                }
+            }
+            return 0;
+        });
+    }
+    
+    // Timing: tick duration, reader latency (sampled 1 in 64 reads) and the
+    // time writers spend waiting for readers to leave the old copy
+    const LatencyHistogram& tick_histogram() const { return tick_histogram_; }
+    const LatencyHistogram& reader_histogram() const { return reader_histogram_; }
+    const LatencyHistogram& publish_wait_histogram() const { return publish_wait_histogram_; }
+    
     // Background spreading loop
     void start_background_loop();
     void stop_background_loop();
@@ -149,8 +191,52 @@ private:
     float compute_goal_similarity(int node_id, const std::vector<float>& goal_emb,
                                  const std::unordered_map<int, std::vector<float>>& embeddings);
     
-    mutable std::mutex activation_mutex_;
-    std::unordered_map<int, float> activations_;  // Legacy support
+    mutable std::mutex activation_mutex_;         // Writers only
+    std::unordered_map<int, float> activations_;  // Legacy support (writer's working copy)
+    
+    // Reader-visible activations, published with the left-right scheme:
+    // two copies, readers on one while writers update the other. A reader
+    // announces itself on the current version's counter, reads the side
+    // read_side_ points at and leaves - a fixed number of steps, no locks.
+    // A writer (holding activation_mutex_) updates the idle copy, points
+    // readers at it, waits until no reader can still be on the old copy,
+    // then brings that copy up to date too.
+    std::unordered_map<int, float> published_[2];
+    std::atomic<int> read_side_{0};
+    std::atomic<int> version_{0};
+    struct alignas(64) ReaderCount {
+        std::atomic<int64_t> count{0};
+    };
+    mutable ReaderCount readers_[2];
+    
+    LatencyHistogram tick_histogram_;
+    mutable LatencyHistogram reader_histogram_;
+    LatencyHistogram publish_wait_histogram_;
+    
+    template <typename Mutation>
+    void publish(Mutation&& apply);
+    
+    template <typename Read>
+    auto read_published(Read&& read) const {
+        using Clock = std::chrono::steady_clock;
+        static thread_local uint32_t sample_counter = 0;
+        bool sample = (++sample_counter & 63) == 0;
+        Clock::time_point start;
+        if (sample) {
+            start = Clock::now();
+        }
+        
+        int version = version_.load();
+        readers_[version].count.fetch_add(1);
+        auto result = read(published_[read_side_.load()]);
+        readers_[version].count.fetch_sub(1, std::memory_order_release);
+        
+        if (sample) {
+            reader_histogram_.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count()));
+        }
+        return result;
+    }
     std::unordered_map<int, EnergyDynamics> energy_map_;  // Enhanced energy system
     
     float decay_rate_;
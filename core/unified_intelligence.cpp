@@ -5,6 +5,7 @@
 
 #include "unified_intelligence.h"
 #include "reasoning/answer_synthesizer.h"
+#include <chrono>
 #include <queue>
 #include <set>
 #include <algorithm>
@@ -173,8 +174,23 @@ UnifiedResult UnifiedIntelligence::reason(const std::string& query) {
     
     result.mode = current_mode_;
     
-    // Save for learning
+    // Save for learning; the experience is the top results and the edges
+    // of the paths that reached them
     last_result_ = result;
+    last_experience_ = reasoning::Experience();
+    last_experience_.importance = result.confidence;
+    last_experience_.timestamp = static_cast<float>(std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+    last_experience_.outcome_reward = 0.0f;
+    for (size_t i = 0; i < std::min(size_t(5), ranked.size()); i++) {
+        last_experience_.activated_nodes.push_back(ranked[i].first);
+        auto path_it = paths.find(ranked[i].first);
+        if (path_it != paths.end()) {
+            for (size_t j = 1; j < path_it->second.size(); j++) {
+                last_experience_.active_edges.push_back({path_it->second[j - 1], path_it->second[j]});
+            }
+        }
+    }
     
     return result;
 }
@@ -210,6 +226,14 @@ void UnifiedIntelligence::learn(bool correct) {
         last_result_.coherence,
         correct
     );
+    
+    // 4. Keep the scored experience for prioritized replay
+    if (!last_experience_.active_edges.empty()) {
+        last_experience_.outcome_reward = correct ? 1.0f : -1.0f;
+        std::lock_guard<std::mutex> lock(graph_mutex_);
+        consolidator_.record_experience(last_experience_);
+        last_experience_.active_edges.clear();  // Scored once
+    }
 }
 
 void UnifiedIntelligence::save(const std::string& filepath) {
@@ -678,6 +702,37 @@ void UnifiedIntelligence::apply_hebbian_learning(
     }
 }
 
+void UnifiedIntelligence::begin_consolidation(bool merge_nodes) {
+    std::lock_guard<std::mutex> lock(graph_mutex_);
+    consolidator_.begin_consolidation({}, merge_nodes);  // No recorded experiences to replay yet
+}
+
+reasoning::ConsolidationProgress UnifiedIntelligence::consolidate_step(size_t max_units) {
+    std::lock_guard<std::mutex> lock(graph_mutex_);
+    auto progress = consolidator_.consolidate_step(graph_, embeddings_, max_units);
+    remap_merged_words(consolidator_.take_merged_nodes());
+    return progress;
+}
+
+void UnifiedIntelligence::remap_merged_words(const std::unordered_map<int, int>& merged_into) {
+    for (const auto& [merged, kept] : merged_into) {
+        auto it = id_to_word_.find(merged);
+        if (it == id_to_word_.end()) continue;
+        std::string word = std::move(it->second);
+        id_to_word_.erase(it);
+        
+        // The merged word now names the representative; the representative
+        // keeps its own word if it has one
+        word_to_id_[word] = kept;
+        id_to_word_.emplace(kept, std::move(word));
+    }
+}
+
+bool UnifiedIntelligence::consolidation_active() const {
+    std::lock_guard<std::mutex> lock(graph_mutex_);
+    return consolidator_.consolidation_active();
+}
+
 } // namespace intelligence
 } // namespace melvin
 
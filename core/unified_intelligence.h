@@ -25,6 +25,7 @@
 #include "core/language/intent_classifier.h"
 #include "core/metrics/reasoning_metrics.h"
 #include "core/metacognition/reflection_controller_dynamic.h"
+#include "core/reasoning/consolidation.h"
 
 namespace melvin {
 namespace intelligence {
@@ -147,6 +148,20 @@ public:
      */
     void apply_hebbian_learning(const std::unordered_map<int, float>& activations, float learning_rate = 0.01f);
     
+    /**
+     * @brief Background consolidation in bounded slices
+     * 
+     * begin_consolidation() starts a pass over the knowledge graph;
+     * each consolidate_step() runs at most max_units units of it under the
+     * graph lock, so reasoning can interleave between slices. Node
+     * merging is opt-in (merge_nodes): the runtime's hashed placeholder
+     * embeddings would fold unrelated words together. When it runs, words
+     * of merged nodes are remapped to the surviving node in the same step.
+     */
+    void begin_consolidation(bool merge_nodes = false);
+    reasoning::ConsolidationProgress consolidate_step(size_t max_units);
+    bool consolidation_active() const;
+    
     /**
      * @brief Get current system state
      */
@@ -182,6 +197,8 @@ private:
     
     // Thread safety for graph mutation
     mutable std::mutex graph_mutex_;
+    reasoning::Consolidator consolidator_;  // Guarded by graph_mutex_
+    reasoning::Experience last_experience_; // Recorded for replay once learn() scores it
     std::atomic<int> next_node_id_{0};
     
     // Current state
@@ -227,7 +244,10 @@ private:
     );
     
     void reflect_and_adapt();
-    
+
+    // Point the words of merged nodes at their representative; caller holds graph_mutex_
+    void remap_merged_words(const std::unordered_map<int, int>& merged_into);
+
     // Helpers
     std::vector<float> compute_embedding(const std::vector<std::string>& tokens);
     float cosine_similarity(const std::vector<float>& a, const std::vector<float>& b);
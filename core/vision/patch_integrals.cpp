@@ -0,0 +1,187 @@
+#include "patch_integrals.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace melvin {
+namespace vision {
+
+// ============================================================================
+// PatchIntegrals
+// ============================================================================
+
+void PatchIntegrals::set_lattice(int width, int height, const std::vector<int>& xs, const std::vector<int>& ys) {
+    col_at_.assign(static_cast<size_t>(width) + 1, -1);
+    num_cols_ = 0;
+    for (int x : xs) {
+        if (x >= 0 && x <= width && col_at_[x] < 0) {
+            col_at_[x] = static_cast<int>(num_cols_++);
+        }
+    }
+
+    row_at_.assign(static_cast<size_t>(height) + 1, -1);
+    size_t num_rows = 0;
+    for (int y : ys) {
+        if (y >= 0 && y <= height && row_at_[y] < 0) {
+            row_at_[y] = static_cast<int>(num_rows++);
+        }
+    }
+
+    table_.assign(num_rows * num_cols_ * LANES, 0);
+    column_sums_.assign(num_cols_ * LANES, 0);
+}
+
+void PatchIntegrals::set_parallel(ParallelFor parallel, size_t bands) {
+    parallel_ = std::move(parallel);
+    bands_ = std::max<size_t>(1, bands);
+}
+
+void PatchIntegrals::build(const uint8_t* bgr, size_t bgr_step, int width, int height,
+                           uint8_t* gray, size_t gray_step,
+                           const uint8_t* prev_gray, size_t prev_step,
+                           uint8_t* motion, size_t motion_step,
+                           const std::vector<int>& xs, const std::vector<int>& ys,
+                           int motion_threshold) {
+    set_lattice(width, height, xs, ys);
+
+    Source source{bgr, bgr_step, gray, gray_step, prev_gray, prev_step,
+                  motion, motion_step, width, motion_threshold};
+    size_t bands = std::min<size_t>(bands_, std::max(height, 1));
+    size_t cells = num_cols_ * LANES;
+    band_sums_.assign(bands * cells, 0);
+
+    auto band_rows = [&](size_t band, int& y_begin, int& y_end) {
+        y_begin = static_cast<int>(height * band / bands);
+        y_end = static_cast<int>(height * (band + 1) / bands);
+    };
+    auto run_band = [&](size_t band) {
+        int y_begin, y_end;
+        band_rows(band, y_begin, y_end);
+        accumulate_rows(source, y_begin, y_end, band_sums_.data() + band * cells);
+    };
+    if (bands > 1 && parallel_) {
+        parallel_(bands, run_band);
+    } else {
+        for (size_t band = 0; band < bands; ++band) {
+            run_band(band);
+        }
+    }
+
+    // Each band integrated from zero: add the totals of the bands above it
+    column_sums_.assign(cells, 0);
+    for (size_t band = 0; band < bands; ++band) {
+        int y_begin, y_end;
+        band_rows(band, y_begin, y_end);
+        for (int y = y_begin; band > 0 && y < y_end; ++y) {
+            if (row_at_[y] >= 0) {
+                uint32_t* row = table_.data() + static_cast<size_t>(row_at_[y]) * cells;
+                for (size_t k = 0; k < cells; ++k) {
+                    row[k] += column_sums_[k];
+                }
+            }
+        }
+        const uint32_t* totals = band_sums_.data() + band * cells;
+        for (size_t k = 0; k < cells; ++k) {
+            column_sums_[k] += totals[k];
+        }
+    }
+    if (row_at_[height] >= 0) {
+        std::copy(column_sums_.begin(), column_sums_.end(),
+                  table_.begin() + static_cast<size_t>(row_at_[height]) * cells);
+    }
+}
+
+void PatchIntegrals::accumulate_rows(const Source& source, int y_begin, int y_end, uint32_t* column_sums) {
+    const int width = source.width;
+    const size_t cells = num_cols_ * LANES;
+
+    for (int y = y_begin; y < y_end; ++y) {
+        // column_sums now holds the integral over rows [y_begin, y)
+        if (row_at_[y] >= 0) {
+            std::copy(column_sums, column_sums + cells,
+                      table_.begin() + static_cast<size_t>(row_at_[y]) * cells);
+        }
+
+        const uint8_t* src = source.bgr + y * source.bgr_step;
+        uint8_t* gray_row = source.gray + y * source.gray_step;
+        const uint8_t* prev_row = source.prev_gray ? source.prev_gray + y * source.prev_step : nullptr;
+        uint8_t* motion_row = source.prev_gray ? source.motion + y * source.motion_step : nullptr;
+        const int motion_threshold = source.motion_threshold;
+
+        // Running sums along the row, added into column_sums at every lattice
+        // column. Kept in registers: packing them into SIMD lanes per pixel
+        // costs more than the adds it saves.
+        uint32_t sum_b = 0, sum_g = 0, sum_r = 0;
+        uint32_t sq_b = 0, sq_g = 0, sq_r = 0;
+        uint32_t moving_count = 0;
+        auto flush = [&](int col) {
+            uint32_t* dst = column_sums + col * LANES;
+            dst[0] += sum_b;
+            dst[1] += sum_g;
+            dst[2] += sum_r;
+            dst[3] += sq_b;
+            dst[4] += sq_g;
+            dst[5] += sq_r;
+            dst[6] += moving_count;
+        };
+
+        for (int x = 0; x < width; ++x) {
+            if (col_at_[x] >= 0) {
+                flush(col_at_[x]);
+            }
+
+            uint32_t b = src[3 * x];
+            uint32_t g = src[3 * x + 1];
+            uint32_t r = src[3 * x + 2];
+
+            // Same fixed-point weights and rounding as cv::cvtColor(BGR2GRAY)
+            uint8_t luma = static_cast<uint8_t>((b * 1868 + g * 9617 + r * 4899 + (1 << 13)) >> 14);
+            gray_row[x] = luma;
+
+            uint32_t moving = 0;
+            if (prev_row) {
+                moving = std::abs(static_cast<int>(luma) - static_cast<int>(prev_row[x])) > motion_threshold;
+                motion_row[x] = moving ? 255 : 0;
+            }
+
+            sum_b += b;
+            sum_g += g;
+            sum_r += r;
+            sq_b += b * b;
+            sq_g += g * g;
+            sq_r += r * r;
+            moving_count += moving;
+        }
+        if (col_at_[width] >= 0) {
+            flush(col_at_[width]);
+        }
+    }
+}
+
+PatchIntegrals::Stats PatchIntegrals::patch(int x, int y, int w, int h) const {
+    const uint32_t* a = cell(x, y);
+    const uint32_t* b = cell(x + w, y);
+    const uint32_t* c = cell(x, y + h);
+    const uint32_t* d = cell(x + w, y + h);
+
+    uint32_t sum[LANES];
+    for (size_t k = 0; k < LANES; ++k) {
+        sum[k] = d[k] - b[k] - c[k] + a[k];  // Wraps back to the exact value
+    }
+
+    Stats stats;
+    double n = static_cast<double>(w) * h;
+    int64_t count = static_cast<int64_t>(w) * h;
+    for (int ch = 0; ch < 3; ++ch) {
+        int64_t s = sum[ch];
+        int64_t q = sum[3 + ch];
+        stats.mean[ch] = s / n;
+        // n·Σx² - (Σx)² is exact in integers, so no cancellation error
+        stats.stddev[ch] = std::sqrt(static_cast<double>(count * q - s * s)) / n;
+    }
+    stats.motion = static_cast<float>(sum[6] / n);
+    return stats;
+}
+
+} // namespace vision
+} // namespace melvin
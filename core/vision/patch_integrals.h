@@ -0,0 +1,102 @@
+#ifndef PATCH_INTEGRALS_H
+#define PATCH_INTEGRALS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace melvin {
+namespace vision {
+
+// ============================================================================
+// PatchIntegrals
+// ============================================================================
+
+// Summed-area table for per-patch colour statistics and motion.
+//
+// build() makes one pass over a BGR frame that converts it to grayscale,
+// thresholds the frame difference and accumulates the B/G/R values, their
+// squares and the motion bit. The integral is only stored at the patch
+// boundaries the caller asks for, so the table stays a few KB instead of
+// 28 bytes per pixel. Any patch whose corners lie on those boundaries then
+// costs four lookups for its mean, standard deviation and motion fraction.
+//
+// With set_parallel() the frame is split into horizontal bands that are
+// accumulated concurrently and then offset by the totals of the bands above.
+//
+// Lanes are summed modulo 2^32: differences are exact as long as the true
+// patch sum fits, which holds for patches up to 256x256 pixels.
+class PatchIntegrals {
+public:
+    // Runs job(0) .. job(count - 1), possibly concurrently, and returns when
+    // all of them have finished
+    using ParallelFor = std::function<void(size_t count, const std::function<void(size_t)>& job)>;
+
+    struct Stats {
+        double mean[3];    // B, G, R (as cv::mean)
+        double stddev[3];  // Population standard deviation (as cv::meanStdDev)
+        float motion;      // Fraction of moving pixels
+    };
+
+    // Split build() into up to `bands` row bands run through `parallel`
+    void set_parallel(ParallelFor parallel, size_t bands);
+
+    // bgr:       8-bit, 3-channel frame
+    // gray:      receives the frame in grayscale (cvtColor's BT.601 weights)
+    // prev_gray: previous grayscale frame of the same size, or nullptr
+    // motion:    receives the 0/255 mask |gray - prev_gray| > threshold
+    //            (only written when prev_gray is given)
+    // xs, ys:    patch edge coordinates in [0, width] / [0, height]
+    void build(const uint8_t* bgr, size_t bgr_step, int width, int height,
+               uint8_t* gray, size_t gray_step,
+               const uint8_t* prev_gray, size_t prev_step,
+               uint8_t* motion, size_t motion_step,
+               const std::vector<int>& xs, const std::vector<int>& ys,
+               int motion_threshold = 25);
+
+    // Statistics of the rect [x, x+w) x [y, y+h); its edges must be among
+    // the xs / ys given to build()
+    Stats patch(int x, int y, int w, int h) const;
+
+private:
+    static constexpr size_t LANES = 7;  // sum B, G, R, sum B², G², R², motion
+
+    std::vector<int> col_at_;       // x in [0, width] → lattice column, or -1
+    std::vector<int> row_at_;       // y in [0, height] → lattice row, or -1
+    size_t num_cols_ = 0;
+    std::vector<uint32_t> table_;   // lattice rows x lattice cols x LANES
+    std::vector<uint32_t> column_sums_;  // Totals of the bands above the current one
+    std::vector<uint32_t> band_sums_;    // Per band: running integral of its rows
+
+    ParallelFor parallel_;
+    size_t bands_ = 1;
+
+    struct Source {
+        const uint8_t* bgr;
+        size_t bgr_step;
+        uint8_t* gray;
+        size_t gray_step;
+        const uint8_t* prev_gray;
+        size_t prev_step;
+        uint8_t* motion;
+        size_t motion_step;
+        int width;
+        int motion_threshold;
+    };
+
+    void set_lattice(int width, int height, const std::vector<int>& xs, const std::vector<int>& ys);
+
+    // Integrates rows [y_begin, y_end) from zero into column_sums, storing
+    // the lattice rows it passes
+    void accumulate_rows(const Source& source, int y_begin, int y_end, uint32_t* column_sums);
+
+    const uint32_t* cell(int x, int y) const {
+        return table_.data() + (static_cast<size_t>(row_at_[y]) * num_cols_ + col_at_[x]) * LANES;
+    }
+};
+
+} // namespace vision
+} // namespace melvin
+
+#endif // PATCH_INTEGRALS_H
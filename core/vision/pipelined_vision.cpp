@@ -0,0 +1,278 @@
+#include "pipelined_vision.h"
+#include <algorithm>
+
+namespace melvin {
+namespace vision {
+
+namespace {
+
+constexpr size_t STAGE_THREADS = 4;
+
+// Stage 1 tile workers, counting the Stage 1 thread: 0 = cores left after the stage threads
+size_t tile_thread_count(size_t threads) {
+    if (threads == 0) {
+        size_t cores = std::thread::hardware_concurrency();
+        if (cores == 0) cores = 4;  // Fallback
+        // The Stage 1 thread tiles too, so it isn't counted twice
+        threads = cores > STAGE_THREADS ? cores - STAGE_THREADS + 1 : 1;
+    }
+    return threads;
+}
+
+double milliseconds(PipelinedVision::Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+// ============================================================================
+// Lifecycle
+// ============================================================================
+
+PipelinedVision::PipelinedVision() : PipelinedVision(Config()) {
+}
+
+PipelinedVision::PipelinedVision(const Config& config)
+    : config_(config)
+    , frames_(config.queue_capacity)
+    , patches_(config.queue_capacity)
+    , tokens_(config.queue_capacity)
+    , connected_(config.queue_capacity)
+    , tile_pool_(tile_thread_count(config.tile_threads))
+{
+    config_.tile_threads = tile_pool_.threads();
+    if (config_.tiles_per_frame == 0) {
+        config_.tiles_per_frame = config_.tile_threads > 1 ? 2 * config_.tile_threads : 1;
+    }
+    if (config_.tile_threads > 1 && config_.tiles_per_frame > 1) {
+        stage1_.set_parallel(
+            [this](size_t count, const std::function<void(size_t)>& job) { tile_pool_.run(count, job); },
+            config_.tiles_per_frame);
+    }
+
+    stage_threads_.emplace_back(&PipelinedVision::stage1_loop, this);
+    stage_threads_.emplace_back(&PipelinedVision::stage2_loop, this);
+    stage_threads_.emplace_back(&PipelinedVision::stage3_loop, this);
+    stage_threads_.emplace_back(&PipelinedVision::stage5_loop, this);
+}
+
+PipelinedVision::~PipelinedVision() {
+    stop();
+}
+
+void PipelinedVision::stop() {
+    if (stopped_) {
+        return;
+    }
+    stopped_ = true;
+
+    // Each stage drains its input, then closes the queue after it
+    frames_.close();
+    for (auto& thread : stage_threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+
+    tile_pool_.stop();
+}
+
+// ============================================================================
+// Frames In, Results Out
+// ============================================================================
+
+bool PipelinedVision::submit(const cv::Mat& frame) {
+    if (stopped_) {
+        return false;
+    }
+
+    InFlight<cv::Mat> job;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        job.frame_id = next_frame_id_++;
+    }
+    job.submitted = Clock::now();
+    job.data = frame.clone();
+
+    if (frames_.push(std::move(job))) {
+        record_drop(0);
+        return false;
+    }
+    return true;
+}
+
+bool PipelinedVision::poll(Result& result) {
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    if (!has_latest_) {
+        return false;
+    }
+    result = std::move(latest_);
+    has_latest_ = false;
+    return true;
+}
+
+void PipelinedVision::set_result_callback(std::function<void(const Result&)> callback) {
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    callback_ = std::move(callback);
+}
+
+// ============================================================================
+// Stages
+// ============================================================================
+
+void PipelinedVision::stage1_loop() {
+    InFlight<cv::Mat> job;
+    while (frames_.pop(job)) {
+        cv::Point2f focus;
+        {
+            std::lock_guard<std::mutex> lock(focus_mutex_);
+            focus = focus_point_;
+        }
+
+        auto start = Clock::now();
+        InFlight<Stage1_VisionInput::Output> out;
+        out.frame_id = job.frame_id;
+        out.submitted = job.submitted;
+        out.data = stage1_.process(job.data, focus);
+        record(0, start, Clock::now());
+
+        if (patches_.push(std::move(out))) {
+            record_drop(1);
+        }
+    }
+    patches_.close();
+}
+
+void PipelinedVision::stage2_loop() {
+    InFlight<Stage1_VisionInput::Output> job;
+    while (patches_.pop(job)) {
+        auto start = Clock::now();
+        InFlight<Stage2_Tokenize::Output> out;
+        out.frame_id = job.frame_id;
+        out.submitted = job.submitted;
+        out.data = stage2_.process(job.data);
+        record(1, start, Clock::now());
+
+        {
+            std::lock_guard<std::mutex> lock(focus_mutex_);
+            focus_point_ = out.data.focus_point;
+        }
+
+        if (tokens_.push(std::move(out))) {
+            record_drop(2);
+        }
+    }
+    tokens_.close();
+}
+
+void PipelinedVision::stage3_loop() {
+    InFlight<Stage2_Tokenize::Output> job;
+    while (tokens_.pop(job)) {
+        auto start = Clock::now();
+        InFlight<Connected> out;
+        out.frame_id = job.frame_id;
+        out.submitted = job.submitted;
+        out.data.focus_point = job.data.focus_point;
+        out.data.nodes_created = job.data.nodes_created;
+        out.data.nodes_reused = job.data.nodes_reused;
+        out.data.connected = stage3_.process(job.data);
+        record(2, start, Clock::now());
+
+        if (connected_.push(std::move(out))) {
+            record_drop(3);
+        }
+    }
+    connected_.close();
+}
+
+void PipelinedVision::stage5_loop() {
+    InFlight<Connected> job;
+    while (connected_.pop(job)) {
+        auto start = Clock::now();
+        Result result;
+        result.generalized = stage5_.process(job.data.connected);
+        auto end = Clock::now();
+        record(3, start, end);
+
+        result.frame_id = job.frame_id;
+        result.focus_point = job.data.focus_point;
+        result.nodes_created = job.data.nodes_created;
+        result.nodes_reused = job.data.nodes_reused;
+        result.edges = job.data.connected.edges.size();
+        result.objects = std::move(job.data.connected.objects);
+        result.latency_ms = milliseconds(end - job.submitted);
+
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            completed_++;
+            total_latency_ms_ += result.latency_ms;
+            max_latency_ms_ = std::max(max_latency_ms_, result.latency_ms);
+        }
+
+        std::function<void(const Result&)> callback;
+        {
+            std::lock_guard<std::mutex> lock(result_mutex_);
+            latest_ = result;
+            has_latest_ = true;
+            callback = callback_;
+        }
+        if (callback) {
+            callback(result);
+        }
+    }
+}
+
+// ============================================================================
+// Counters
+// ============================================================================
+
+void PipelinedVision::record(size_t stage, Clock::time_point start, Clock::time_point end) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    StageCounters& counters = counters_[stage];
+    if (counters.processed == 0) {
+        counters.first_start = start;
+    }
+    counters.last_end = end;
+    counters.processed++;
+
+    double ms = milliseconds(end - start);
+    counters.total_ms += ms;
+    counters.max_ms = std::max(counters.max_ms, ms);
+}
+
+void PipelinedVision::record_drop(size_t stage) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    counters_[stage].dropped++;
+}
+
+PipelinedVision::Stats PipelinedVision::get_stats() const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+
+    Stats stats;
+    stats.submitted = next_frame_id_;
+    stats.completed = completed_;
+    if (completed_ > 0) {
+        stats.mean_latency_ms = total_latency_ms_ / completed_;
+    }
+    stats.max_latency_ms = max_latency_ms_;
+
+    for (size_t i = 0; i < STAGE_THREADS; ++i) {
+        const StageCounters& counters = counters_[i];
+        StageStats& stage = stats.stages[i];
+        stage.processed = counters.processed;
+        stage.dropped = counters.dropped;
+        stage.max_ms = counters.max_ms;
+        if (counters.processed > 0) {
+            stage.mean_ms = counters.total_ms / counters.processed;
+            double wall_ms = milliseconds(counters.last_end - counters.first_start);
+            if (wall_ms > 0.0) {
+                stage.throughput_fps = counters.processed * 1000.0 / wall_ms;
+            }
+        }
+        stats.dropped += counters.dropped;
+    }
+    return stats;
+}
+
+} // namespace vision
+} // namespace melvin
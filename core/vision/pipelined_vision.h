@@ -0,0 +1,220 @@
+#ifndef PIPELINED_VISION_H
+#define PIPELINED_VISION_H
+
+#include "vision_pipeline.h"
+#include "../worker_pool.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace melvin {
+namespace vision {
+
+// ============================================================================
+// StageQueue
+// ============================================================================
+
+// Bounded hand-off between two pipeline stages. push() never blocks: when
+// the queue is full the oldest item is dropped, so a slow stage always
+// works on the freshest frame instead of a growing backlog.
+template <typename T>
+class StageQueue {
+public:
+    explicit StageQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+    // Returns true if an older item had to be dropped
+    bool push(T item) {
+        bool dropped = false;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (items_.size() >= capacity_) {
+                items_.pop_front();
+                dropped = true;
+            }
+            items_.push_back(std::move(item));
+        }
+        ready_.notify_one();
+        return dropped;
+    }
+
+    // Blocks until an item arrives; false once closed and drained
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [&] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        return true;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        ready_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    std::deque<T> items_;
+    bool closed_ = false;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+};
+
+// ============================================================================
+// PipelinedVision
+// ============================================================================
+
+// Runs Stage1 → Stage2 → Stage3 → Stage5 as a pipeline: each stage on its
+// own thread, so frame N+1 is tokenized while frame N is being connected
+// and generalized. Stage 1 additionally splits each frame into row tiles
+// on a worker pool (the calling stage thread works too).
+//
+// Frames flow in order; with every queue full, new frames push out the
+// oldest waiting one. Stage 1 focuses on the latest focus point Stage 2 has
+// published, which lags the sequential pipeline by the frames in flight.
+class PipelinedVision {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        size_t queue_capacity = 1;   // Frames waiting in front of each stage
+        size_t tile_threads = 0;     // Stage 1 tile workers, 0 = cores left after the stage threads
+        size_t tiles_per_frame = 0;  // Row bands per frame, 0 = 2 per tile thread
+    };
+
+    struct Result {
+        uint64_t frame_id = 0;
+        cv::Point2f focus_point;
+        int nodes_created = 0;
+        int nodes_reused = 0;
+        size_t edges = 0;
+        std::unordered_map<int, Object> objects;
+        Stage5_Generalize::Output generalized;
+        double latency_ms = 0.0;     // Submit → result
+    };
+
+    struct StageStats {
+        uint64_t processed = 0;
+        uint64_t dropped = 0;        // Pushed out of this stage's input queue
+        double mean_ms = 0.0;        // Time spent processing one frame
+        double max_ms = 0.0;
+        double throughput_fps = 0.0; // Frames processed per second of wall time
+    };
+
+    struct Stats {
+        uint64_t submitted = 0;
+        uint64_t completed = 0;
+        uint64_t dropped = 0;        // Over all queues
+        double mean_latency_ms = 0.0;
+        double max_latency_ms = 0.0;
+        StageStats stages[4];        // Stage 1, 2, 3, 5
+    };
+
+    PipelinedVision();
+    explicit PipelinedVision(const Config& config);
+    ~PipelinedVision();
+
+    PipelinedVision(const PipelinedVision&) = delete;
+    PipelinedVision& operator=(const PipelinedVision&) = delete;
+
+    // Never blocks; the frame is copied. Returns false if an older frame
+    // still waiting for Stage 1 had to be dropped to make room.
+    bool submit(const cv::Mat& frame);
+
+    // Latest finished frame; false if none finished since the last call
+    bool poll(Result& result);
+
+    // Called on the Stage 5 thread for every finished frame
+    void set_result_callback(std::function<void(const Result&)> callback);
+
+    // Finish the frames in flight and join all threads (also done by the
+    // destructor). Call from the thread that submits frames.
+    void stop();
+
+    Stats get_stats() const;
+    const Config& config() const { return config_; }
+
+private:
+    template <typename T>
+    struct InFlight {
+        uint64_t frame_id = 0;
+        Clock::time_point submitted;
+        T data;
+    };
+
+    // What Stage 5 needs to assemble a Result
+    struct Connected {
+        cv::Point2f focus_point;
+        int nodes_created;
+        int nodes_reused;
+        Stage3_Connect::Output connected;
+    };
+
+    struct StageCounters {
+        uint64_t processed = 0;
+        uint64_t dropped = 0;
+        double total_ms = 0.0;
+        double max_ms = 0.0;
+        Clock::time_point first_start;
+        Clock::time_point last_end;
+    };
+
+    Config config_;
+
+    Stage1_VisionInput stage1_;
+    Stage2_Tokenize stage2_;
+    Stage3_Connect stage3_;
+    Stage5_Generalize stage5_;
+
+    StageQueue<InFlight<cv::Mat>> frames_;
+    StageQueue<InFlight<Stage1_VisionInput::Output>> patches_;
+    StageQueue<InFlight<Stage2_Tokenize::Output>> tokens_;
+    StageQueue<InFlight<Connected>> connected_;
+    std::vector<std::thread> stage_threads_;
+    bool stopped_ = false;
+
+    // Stage 1 tile pool: each frame's tiles are one round
+    WorkerPool tile_pool_;
+
+    // Focus feedback from Stage 2 to Stage 1
+    mutable std::mutex focus_mutex_;
+    cv::Point2f focus_point_{-1.0f, -1.0f};
+
+    // Results and counters
+    mutable std::mutex result_mutex_;
+    Result latest_;
+    bool has_latest_ = false;
+    std::function<void(const Result&)> callback_;
+
+    mutable std::mutex stats_mutex_;
+    uint64_t next_frame_id_ = 0;
+    uint64_t completed_ = 0;
+    double total_latency_ms_ = 0.0;
+    double max_latency_ms_ = 0.0;
+    StageCounters counters_[4];
+
+    void stage1_loop();
+    void stage2_loop();
+    void stage3_loop();
+    void stage5_loop();
+
+    void record(size_t stage, Clock::time_point start, Clock::time_point end);
+    void record_drop(size_t stage);
+};
+
+} // namespace vision
+} // namespace melvin
+
+#endif // PIPELINED_VISION_H
@@ -1,8 +1,6 @@
 #include "vision_pipeline.h"
 #include <cmath>
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
 
 namespace melvin {
 namespace vision {
@@ -20,56 +18,19 @@ Stage1_VisionInput::Stage1_VisionInput()
 
 Stage1_VisionInput::Output Stage1_VisionInput::process(const cv::Mat& frame, const cv::Point2f& focus_point) {
     Output output;
-    
-    cv::Mat gray;
-    cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
-    
-    // Compute motion
-    if (!prev_frame_.empty()) {
-        cv::Mat diff;
-        cv::absdiff(gray, prev_frame_, diff);
-        cv::threshold(diff, output.motion_map, 25, 255, cv::THRESH_BINARY);
-    }
-    prev_frame_ = gray.clone();
+    CV_Assert(frame.type() == CV_8UC3);
     
     int height = frame.rows;
     int width = frame.cols;
     
-    // Coarse grid patches
-    for (int py = 0; py < height; py += patch_size_) {
-        for (int px = 0; px < width; px += patch_size_) {
-            if (py + patch_size_ > height || px + patch_size_ > width) {
-                continue;
-            }
-            
-            cv::Rect roi(px, py, patch_size_, patch_size_);
-            cv::Mat patch_img = frame(roi);
-            
-            Patch patch;
-            patch.x = px;
-            patch.y = py;
-            patch.width = patch_size_;
-            patch.height = patch_size_;
-            patch.avg_color = cv::mean(patch_img);
-            
-            // Motion
-            if (!output.motion_map.empty()) {
-                cv::Mat motion_patch = output.motion_map(roi);
-                patch.motion = cv::countNonZero(motion_patch) / float(patch_size_ * patch_size_);
-            } else {
-                patch.motion = 0.0f;
-            }
-            
-            // Saliency (color variance)
-            cv::Scalar mean, stddev;
-            cv::meanStdDev(patch_img, mean, stddev);
-            patch.saliency = (stddev[0] + stddev[1] + stddev[2]) / 3.0f;
-            
-            output.patches.push_back(patch);
+    // Patch layout: coarse grid everywhere, fine patches around focus
+    patch_rects_.clear();
+    for (int py = 0; py + patch_size_ <= height; py += patch_size_) {
+        for (int px = 0; px + patch_size_ <= width; px += patch_size_) {
+            patch_rects_.emplace_back(px, py, patch_size_, patch_size_);
         }
     }
     
-    // Fine patches around focus
     if (focus_point.x > 0 && focus_point.y > 0) {
         int fx = static_cast<int>(focus_point.x);
         int fy = static_cast<int>(focus_point.y);
@@ -79,37 +40,60 @@ Stage1_VisionInput::Output Stage1_VisionInput::process(const cv::Mat& frame, con
                 if (px < 0 || py < 0 || px + fine_patch_size_ > width || py + fine_patch_size_ > height) {
                     continue;
                 }
-                
-                cv::Rect roi(px, py, fine_patch_size_, fine_patch_size_);
-                cv::Mat patch_img = frame(roi);
-                
-                Patch patch;
-                patch.x = px;
-                patch.y = py;
-                patch.width = fine_patch_size_;
-                patch.height = fine_patch_size_;
-                patch.avg_color = cv::mean(patch_img);
-                
-                if (!output.motion_map.empty()) {
-                    cv::Mat motion_patch = output.motion_map(roi);
-                    patch.motion = cv::countNonZero(motion_patch) / float(fine_patch_size_ * fine_patch_size_);
-                } else {
-                    patch.motion = 0.0f;
-                }
-                
-                cv::Scalar mean, stddev;
-                cv::meanStdDev(patch_img, mean, stddev);
-                patch.saliency = (stddev[0] + stddev[1] + stddev[2]) / 3.0f;
-                
-                output.patches.push_back(patch);
+                patch_rects_.emplace_back(px, py, fine_patch_size_, fine_patch_size_);
             }
         }
     }
     
+    // Integrals are sampled on the patch edges
+    patch_xs_.clear();
+    patch_ys_.clear();
+    for (const auto& roi : patch_rects_) {
+        patch_xs_.push_back(roi.x);
+        patch_xs_.push_back(roi.x + roi.width);
+        patch_ys_.push_back(roi.y);
+        patch_ys_.push_back(roi.y + roi.height);
+    }
+    
+    // One pass over the frame: grayscale, motion mask and patch integrals
+    cv::Mat gray(height, width, CV_8UC1);
+    bool has_prev = !prev_frame_.empty() && prev_frame_.size() == frame.size();
+    if (has_prev) {
+        output.motion_map.create(height, width, CV_8UC1);
+    }
+    integrals_.build(frame.data, frame.step, width, height,
+                     gray.data, gray.step,
+                     has_prev ? prev_frame_.data : nullptr, prev_frame_.step,
+                     output.motion_map.data, output.motion_map.step,
+                     patch_xs_, patch_ys_);
+    prev_frame_ = gray;
+    
+    output.patches.reserve(patch_rects_.size());
+    for (const auto& roi : patch_rects_) {
+        PatchIntegrals::Stats stats = integrals_.patch(roi.x, roi.y, roi.width, roi.height);
+        
+        Patch patch;
+        patch.x = roi.x;
+        patch.y = roi.y;
+        patch.width = roi.width;
+        patch.height = roi.height;
+        patch.avg_color = cv::Scalar(stats.mean[0], stats.mean[1], stats.mean[2]);
+        patch.motion = has_prev ? stats.motion : 0.0f;
+        
+        // Saliency (color variance)
+        patch.saliency = (stats.stddev[0] + stats.stddev[1] + stats.stddev[2]) / 3.0f;
+        
+        output.patches.push_back(std::move(patch));
+    }
+    
     output.focus_point = focus_point;
     return output;
 }
 
+void Stage1_VisionInput::set_parallel(PatchIntegrals::ParallelFor parallel, size_t tiles) {
+    integrals_.set_parallel(std::move(parallel), tiles);
+}
+
 // ============================================================================
 // Stage2_Tokenize
 // ============================================================================
@@ -121,14 +105,17 @@ Stage2_Tokenize::Stage2_Tokenize()
     focus_history_ = std::deque<cv::Point2f>(20);
 }
 
-std::string Stage2_Tokenize::hash_patch(const Patch& patch) {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(0);
-    oss << patch.x / 10 << "_" << patch.y / 10 << "_"
-        << patch.avg_color[0] / 20 << "_"
-        << patch.avg_color[1] / 20 << "_"
-        << patch.avg_color[2] / 20;
-    return oss.str();
+uint64_t Stage2_Tokenize::patch_key(const Patch& patch) {
+    // Position in 10-pixel cells, colour in steps of 20 (rounded half to
+    // even, as "%.0f" formatting does), packed x:20 | y:20 | b:8 | g:8 | r:8
+    auto level = [](double channel) {
+        return static_cast<uint64_t>(std::nearbyint(channel / 20.0)) & 0xFF;
+    };
+    return (static_cast<uint64_t>(patch.x / 10) & 0xFFFFF) << 44 |
+           (static_cast<uint64_t>(patch.y / 10) & 0xFFFFF) << 24 |
+           level(patch.avg_color[0]) << 16 |
+           level(patch.avg_color[1]) << 8 |
+           level(patch.avg_color[2]);
 }
 
 std::vector<float> Stage2_Tokenize::create_embedding(const Patch& patch) {
@@ -151,9 +138,23 @@ std::vector<float> Stage2_Tokenize::create_embedding(const Patch& patch) {
     emb[7] = patch.motion;
     emb[8] = patch.saliency / 100.0f;
     
-    // Fill rest with derived features
+    // Fill rest with derived features sin(0.1·i + emb[i % 9]), expanded by
+    // the angle-addition identity: 9 sin/cos pairs per patch, not 119 sins
+    static const std::vector<std::pair<float, float>> phase = [] {
+        std::vector<std::pair<float, float>> table(128);
+        for (size_t i = 0; i < table.size(); ++i) {
+            table[i] = {std::sin(i * 0.1f), std::cos(i * 0.1f)};
+        }
+        return table;
+    }();
+    float base_sin[9], base_cos[9];
+    for (size_t k = 0; k < 9; ++k) {
+        base_sin[k] = std::sin(emb[k]);
+        base_cos[k] = std::cos(emb[k]);
+    }
     for (size_t i = 9; i < emb.size(); ++i) {
-        emb[i] = std::sin(i * 0.1f + emb[i % 9]) * 0.1f;
+        size_t k = i % 9;
+        emb[i] = (phase[i].first * base_cos[k] + phase[i].second * base_sin[k]) * 0.1f;
     }
     
     return emb;
@@ -192,25 +193,23 @@ Stage2_Tokenize::Output Stage2_Tokenize::process(const Stage1_VisionInput::Outpu
     output.nodes_reused = 0;
     
     // Create tokens from patches
+    output.tokens.reserve(input.patches.size());
     for (const auto& patch : input.patches) {
-        std::string hash = hash_patch(patch);
-        
         Token token;
         token.patch = patch;
         token.embedding = create_embedding(patch);
         
         // Deduplication
-        auto it = patch_to_node_.find(hash);
-        if (it != patch_to_node_.end()) {
-            token.node_id = it->second;
-            output.nodes_reused++;
-        } else {
-            token.node_id = next_node_id_++;
-            patch_to_node_[hash] = token.node_id;
+        auto [it, inserted] = patch_to_node_.try_emplace(patch_key(patch), next_node_id_);
+        token.node_id = it->second;
+        if (inserted) {
+            next_node_id_++;
             output.nodes_created++;
+        } else {
+            output.nodes_reused++;
         }
         
-        output.tokens.push_back(token);
+        output.tokens.push_back(std::move(token));
     }
     
     // Compute focus with temporal smoothing
@@ -1,7 +1,9 @@
 #ifndef VISION_PIPELINE_H
 #define VISION_PIPELINE_H
 
+#include "patch_integrals.h"
 #include <opencv2/opencv.hpp>
+#include <cstdint>
 #include <vector>
 #include <unordered_map>
 #include <deque>
@@ -55,11 +57,20 @@ public:
     
     Output process(const cv::Mat& frame, const cv::Point2f& focus_point);
     
+    // Process each frame as `tiles` row bands through `parallel`
+    void set_parallel(PatchIntegrals::ParallelFor parallel, size_t tiles);
+    
 private:
     int patch_size_;
     int fine_patch_size_;
     int focus_radius_;
     cv::Mat prev_frame_;
+    
+    // Per-frame scratch: patch layout and the integrals its stats come from
+    PatchIntegrals integrals_;
+    std::vector<cv::Rect> patch_rects_;
+    std::vector<int> patch_xs_;
+    std::vector<int> patch_ys_;
 };
 
 // Stage 2: Tokenize
@@ -77,12 +88,12 @@ public:
     Output process(const Stage1_VisionInput::Output& input);
     
 private:
-    std::unordered_map<std::string, int> patch_to_node_;
+    std::unordered_map<uint64_t, int> patch_to_node_;
     std::deque<cv::Point2f> focus_history_;
     int next_node_id_;
     float alpha_;  // Temporal smoothing
     
-    std::string hash_patch(const Patch& patch);
+    uint64_t patch_key(const Patch& patch);
     std::vector<float> create_embedding(const Patch& patch);
     cv::Point2f compute_focus(const std::vector<Patch>& patches);
 };
@@ -0,0 +1,81 @@
+#include "worker_pool.h"
+
+namespace melvin {
+
+WorkerPool::WorkerPool(size_t threads) {
+    for (size_t i = 1; i < threads; ++i) {
+        workers_.emplace_back(&WorkerPool::worker_loop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    stop();
+}
+
+void WorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_ready_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void WorkerPool::worker_loop() {
+    uint64_t seen_generation = 0;
+
+    while (true) {
+        std::shared_ptr<Round> round;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+            if (stop_) {
+                return;
+            }
+            seen_generation = generation_;
+            if (!round_) {
+                continue;  // Woke after the round finished
+            }
+            round = round_;
+            active_workers_++;
+        }
+
+        for (size_t i = round->next.fetch_add(1); i < round->count; i = round->next.fetch_add(1)) {
+            round->job(i);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            active_workers_--;
+        }
+        work_done_.notify_all();
+    }
+}
+
+void WorkerPool::run(size_t count, const std::function<void(size_t)>& job) {
+    auto round = std::make_shared<Round>();
+    round->job = job;
+    round->count = count;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        round_ = round;
+        generation_++;
+    }
+    work_ready_.notify_all();
+
+    // Caller pulls work too, then waits for workers that joined this round.
+    // Unpublishing under the same lock means no worker can join afterwards.
+    for (size_t i = round->next.fetch_add(1); i < count; i = round->next.fetch_add(1)) {
+        job(i);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [&] { return active_workers_ == 0; });
+    round_.reset();
+}
+
+} // namespace melvin
@@ -0,0 +1,64 @@
+#ifndef MELVIN_WORKER_POOL_H
+#define MELVIN_WORKER_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace melvin {
+
+/**
+ * Persistent worker pool for fork-join rounds
+ *
+ * run(count, job) calls job(i) for every i in [0, count) across the pool's
+ * workers and the calling thread, and returns once every call has finished.
+ * Workers stay parked between rounds, so a round costs a wakeup rather than
+ * a thread spawn. One round runs at a time; call run() from one thread.
+ */
+class WorkerPool {
+public:
+    // `threads` counts the caller, which works too, so threads - 1 are spawned
+    explicit WorkerPool(size_t threads);
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    size_t threads() const { return workers_.size() + 1; }
+
+    void run(size_t count, const std::function<void(size_t)>& job);
+
+    // Join the workers (also done by the destructor); later rounds run on
+    // the calling thread alone
+    void stop();
+
+private:
+    // One round: workers pull indices until `next` passes `count`. Owned
+    // per round so a worker waking after the round ended only sees an
+    // exhausted counter, never the next round's indices or a dead job.
+    struct Round {
+        std::function<void(size_t)> job;
+        size_t count = 0;
+        std::atomic<size_t> next{0};
+    };
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    std::shared_ptr<Round> round_;   // Published until the round completes
+    size_t active_workers_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+
+    void worker_loop();
+};
+
+} // namespace melvin
+
+#endif // MELVIN_WORKER_POOL_H
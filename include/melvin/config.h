@@ -22,8 +22,14 @@ constexpr uint16_t INITIAL_EDGE_WEIGHT = 100;  // Max is 65535
 
 // Pruning parameters
 constexpr float PRUNING_DECAY_RATE = 0.001f;
+constexpr float EDGE_DECAY_RATE = 0.95f;       // Edge weight kept per pruning round
 constexpr float PRUNING_THRESHOLD = 0.1f;
 
+// Tiered payload storage (cold node payloads spill to a segment file)
+constexpr bool ENABLE_TIERED_STORAGE = false;                // Opt-in: every payload stays in RAM otherwise
+constexpr size_t PAYLOAD_MEMORY_BUDGET = 256 * 1024 * 1024;  // Resident payload bytes
+constexpr uint64_t EVICTION_MIN_IDLE_MS = 5000;              // Recently touched nodes stay resident
+
 // Evolution parameters
 constexpr float MUTATION_RATE = 0.05f;
 constexpr size_t FITNESS_WINDOW_SIZE = 100;  // Cycles to track for fitness
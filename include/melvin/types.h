@@ -22,6 +22,38 @@ constexpr size_t MOTOR_PAYLOAD_SIZE = sizeof(float) * 8;  // position, velocity,
 // Maximum payload size for allocation
 constexpr size_t MAX_PAYLOAD_SIZE = VISION_PAYLOAD_SIZE;
 
+// Sensory modality of a node: tagged at intake, or inferred from its fixed payload size
+enum class Modality : uint8_t {
+    VISION = 0,
+    AUDIO = 1,
+    TEXT = 2,
+    MOTOR = 3,
+    OTHER = 4
+};
+
+constexpr size_t MODALITY_COUNT = 5;
+
+inline Modality modality_from_payload_size(size_t payload_size) {
+    switch (payload_size) {
+        case VISION_PAYLOAD_SIZE: return Modality::VISION;
+        case AUDIO_PAYLOAD_SIZE: return Modality::AUDIO;
+        case TEXT_PAYLOAD_SIZE: return Modality::TEXT;
+        case MOTOR_PAYLOAD_SIZE: return Modality::MOTOR;
+        default: return Modality::OTHER;
+    }
+}
+
+// Fixed payload size of a modality (0 for OTHER)
+constexpr size_t modality_payload_size(Modality modality) {
+    switch (modality) {
+        case Modality::VISION: return VISION_PAYLOAD_SIZE;
+        case Modality::AUDIO: return AUDIO_PAYLOAD_SIZE;
+        case Modality::TEXT: return TEXT_PAYLOAD_SIZE;
+        case Modality::MOTOR: return MOTOR_PAYLOAD_SIZE;
+        default: return 0;
+    }
+}
+
 // Node states
 enum class NodeState : uint8_t {
     INACTIVE = 0,
@@ -1,15 +1,22 @@
 #include "Weight.h"
+#include <algorithm>
 
 namespace melvin {
 
+uint16_t Weight::decay_factor_q16(float decay_rate) {
+    // 65535/65536 is the closest Q16 value below 1.0; rates >= 1 map there
+    float clamped = std::max<float>(0.0f, std::min<float>(1.0f, decay_rate));
+    return static_cast<uint16_t>(std::min<float>(clamped * 65536.0f, 65535.0f));
+}
+
 EdgeWeight Weight::update_by_coactivation(EdgeWeight current, EdgeWeight neighbor_activation) {
     // Simple update: average current weight with neighbor activation
-    float updated = (static_cast<float>(current) + static_cast<float>(neighbor_activation)) / 2.0f;
-    return static_cast<EdgeWeight>(std::min<float>(updated, 65535.0f));
+    return average(current, neighbor_activation);
 }
 
 EdgeWeight Weight::decay(EdgeWeight weight, float decay_rate) {
-    return static_cast<EdgeWeight>(static_cast<float>(weight) * decay_rate);
+    if (decay_rate >= 1.0f) return weight;
+    return decay_fixed(weight, decay_factor_q16(decay_rate));
 }
 
 EdgeWeight Weight::normalize(float weight) {
@@ -19,4 +26,3 @@ EdgeWeight Weight::normalize(float weight) {
 }
 
 } // namespace melvin
-
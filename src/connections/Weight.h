@@ -4,8 +4,39 @@
 
 namespace melvin {
 
+// Fixed-point edge weight math. EdgeWeight is a Q16 fraction where
+// 65535 == 1.0; hot paths stay in integers and convert to float once.
+// The packed-lane decay (scale_u16) lives in core/SimdKernels.h.
 class Weight {
 public:
+    static constexpr EdgeWeight MAX = 65535;
+    static constexpr float TO_FLOAT = 1.0f / 65535.0f;
+    
+    // EdgeWeight -> [0, 1] (multiply by reciprocal, no per-access divide)
+    static float to_float(EdgeWeight weight) { return static_cast<float>(weight) * TO_FLOAT; }
+    
+    // Sum of raw weights -> sum of normalized weights
+    static float sum_to_float(uint32_t weight_sum) { return static_cast<float>(weight_sum) * TO_FLOAT; }
+    
+    // min(a + b, MAX)
+    static EdgeWeight add_saturating(EdgeWeight a, EdgeWeight b) {
+        uint32_t sum = static_cast<uint32_t>(a) + b;
+        return static_cast<EdgeWeight>(sum > MAX ? MAX : sum);
+    }
+    
+    // floor((a + b) / 2)
+    static EdgeWeight average(EdgeWeight a, EdgeWeight b) {
+        return static_cast<EdgeWeight>((static_cast<uint32_t>(a) + b) >> 1);
+    }
+    
+    // Decay rate in [0, 1] -> Q16 multiplier for scale_u16 / decay_fixed
+    static uint16_t decay_factor_q16(float decay_rate);
+    
+    // (weight * factor_q16) >> 16
+    static EdgeWeight decay_fixed(EdgeWeight weight, uint16_t factor_q16) {
+        return static_cast<EdgeWeight>((static_cast<uint32_t>(weight) * factor_q16) >> 16);
+    }
+    
     // Update weight based on co-activation
     static EdgeWeight update_by_coactivation(EdgeWeight current, EdgeWeight neighbor_activation);
     
@@ -17,4 +48,3 @@ public:
 };
 
 } // namespace melvin
-
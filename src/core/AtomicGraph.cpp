@@ -1,10 +1,23 @@
 #include "AtomicGraph.h"
 #include "NodeAllocator.h"
+#include "SimdKernels.h"
+#include "../connections/Weight.h"
+#include <algorithm>
+#include <chrono>
 #include <cstring>
 #include <functional>
 
 namespace melvin {
 
+namespace {
+
+Time now_ms() {
+    return static_cast<Time>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
 AtomicGraph::AtomicGraph() = default;
 
 AtomicGraph::~AtomicGraph() = default;
@@ -12,30 +25,266 @@ AtomicGraph::~AtomicGraph() = default;
 bool AtomicGraph::add_node(std::unique_ptr<Node> node) {
     NodeID id = node->id();
     
+    {
+        std::unique_lock<std::shared_mutex> lock(nodes_mutex_);
+        
+        if (nodes_.find(id) != nodes_.end()) {
+            return false; // Already exists
+        }
+        
+        // Add to payload hash map for O(1) lookup
+        Node* node_ptr = node.get();
+        if (node_ptr && node_ptr->payload_size() > 0) {
+            uint64_t hash = hash_payload(node_ptr->payload(), node_ptr->payload_size());
+            payload_hash_to_node_[hash] = id;
+        }
+        
+        stats_.node_created(node_ptr->payload_size(), node_ptr->modality());
+        resident_payload_bytes_.fetch_add(node_ptr->payload_size(), std::memory_order_relaxed);
+        if (tiered_) node_ptr->touch(now_ms());
+        modality_index_.add(id, node_ptr->modality());
+        attach_to_column_locked(node_ptr);
+        nodes_[id] = std::move(node);
+    }
+    
+    if (tiered_ && resident_payload_bytes() > tiered_->config().memory_budget_bytes) {
+        evict_cold();
+    }
+    return true;
+}
+
+Node* AtomicGraph::get_node(NodeID id) {
+    {
+        std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+        auto it = nodes_.find(id);
+        if (it == nodes_.end()) {
+            return nullptr;
+        }
+        Node* node = it->second.get();
+        if (!tiered_) {
+            return node;
+        }
+        node->touch(now_ms());
+        if (!node->is_evicted()) {
+            return node;
+        }
+    }
+    return fault_in(id);
+}
+
+PinnedNode AtomicGraph::pin_node(NodeID id) {
+    {
+        std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+        auto it = nodes_.find(id);
+        if (it == nodes_.end()) {
+            return PinnedNode();
+        }
+        Node* node = it->second.get();
+        if (tiered_) {
+            node->touch(now_ms());
+        }
+        if (!node->is_evicted()) {
+            node->pin();  // Eviction needs the exclusive lock, so this can't race it
+            return PinnedNode(node);
+        }
+    }
+    return PinnedNode(fault_in(id, true));
+}
+
+Node* AtomicGraph::get_node_metadata(NodeID id) {
+    std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+    auto it = nodes_.find(id);
+    return it != nodes_.end() ? it->second.get() : nullptr;
+}
+
+Node* AtomicGraph::fault_in(NodeID id, bool pin) {
     std::unique_lock<std::shared_mutex> lock(nodes_mutex_);
+    auto it = nodes_.find(id);
+    if (it == nodes_.end()) {
+        return nullptr;
+    }
     
-    if (nodes_.find(id) != nodes_.end()) {
-        return false; // Already exists
+    Node* node = it->second.get();
+    if (node->is_evicted()) {
+        std::vector<uint8_t> buffer(node->payload_size());
+        if (!tiered_->load(id, buffer.data(), buffer.size())) {
+            return nullptr;  // Segment unreadable; don't hand out a payload-less node
+        }
+        node->restore_payload(buffer.data());
+        attach_to_column_locked(node);
+        resident_payload_bytes_.fetch_add(buffer.size(), std::memory_order_relaxed);
+        tiered_->record_fault(buffer.size());
     }
+    // Otherwise another thread faulted it in first
     
-    // Add to payload hash map for O(1) lookup
-    Node* node_ptr = node.get();
-    if (node_ptr && node_ptr->payload_size() > 0) {
-        uint64_t hash = hash_payload(node_ptr->payload(), node_ptr->payload_size());
-        payload_hash_to_node_[hash] = id;
+    if (pin) node->pin();
+    return node;
+}
+
+bool AtomicGraph::read_payload(NodeID id, std::vector<uint8_t>& out) const {
+    std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+    auto it = nodes_.find(id);
+    if (it == nodes_.end()) {
+        return false;
     }
     
-    nodes_[id] = std::move(node);
+    const Node* node = it->second.get();
+    out.resize(node->payload_size());
+    if (!node->is_evicted()) {
+        if (!out.empty()) std::memcpy(out.data(), node->payload(), out.size());
+        return true;
+    }
+    return tiered_ && tiered_->load(id, out.data(), out.size());
+}
+
+bool AtomicGraph::enable_tiered_storage(const TieredStorageConfig& config) {
+    auto storage = std::make_unique<TieredStorage>(config);
+    if (!storage->open()) {
+        return false;
+    }
+    std::unique_lock<std::shared_mutex> lock(nodes_mutex_);
+    tiered_ = std::move(storage);
+    Time now = now_ms();
+    for (auto& [_, node] : nodes_) {
+        node->touch(now);
+    }
     return true;
 }
 
-Node* AtomicGraph::get_node(NodeID id) {
+size_t AtomicGraph::enforce_memory_budget() {
+    if (!tiered_ || resident_payload_bytes() <= tiered_->config().memory_budget_bytes) {
+        return 0;
+    }
+    return evict_cold();
+}
+
+size_t AtomicGraph::evict_cold() {
+    // One evictor at a time; a thread that finds one running leaves the work to it
+    std::unique_lock<std::mutex> evicting(eviction_mutex_, std::try_to_lock);
+    if (!evicting.owns_lock()) {
+        return 0;
+    }
+    
+    const TieredStorageConfig& config = tiered_->config();
+    size_t low_water = static_cast<size_t>(config.memory_budget_bytes * config.low_water_ratio);
+    Time now = now_ms();
+    
+    struct Victim {
+        NodeID id;
+        Time last_access;
+        size_t offset;  // Into `copies`
+        size_t size;
+    };
+    std::vector<Victim> victims;
+    std::vector<uint8_t> copies;
+    
+    // 1. Pick the coldest payloads and copy them out under the shared lock
+    {
+        std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+        
+        // Coldness key: last access pushed forward by a credit per use, so a
+        // frequently used node outlives a one-off that was touched slightly later
+        std::vector<std::pair<Time, Node*>> candidates;
+        for (auto& [_, node] : nodes_) {
+            if (node->is_evicted() || node->payload_size() == 0 || node->is_pinned()) continue;
+            Time last = node->last_access();
+            if (now - std::min(now, last) < config.min_idle_ms) continue;
+            candidates.emplace_back(last + static_cast<Time>(node->frequency()) * config.frequency_credit_ms, node.get());
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        
+        size_t resident = resident_payload_bytes();
+        for (const auto& [_, node] : candidates) {
+            if (resident <= low_water) break;
+            size_t size = node->payload_size();
+            const uint8_t* payload = static_cast<const uint8_t*>(node->payload());
+            victims.push_back({node->id(), node->last_access(), copies.size(), size});
+            copies.insert(copies.end(), payload, payload + size);
+            resident -= std::min(resident, size);
+        }
+    }
+    
+    // 2. Write them to the segment with no graph lock held
+    size_t stored = 0;
+    while (stored < victims.size()) {
+        const Victim& victim = victims[stored];
+        if (!tiered_->store(victim.id, copies.data() + victim.offset, victim.size)) {
+            break;  // Disk full or unwritable: stay over budget rather than lose data
+        }
+        ++stored;
+    }
+    
+    // 3. Drop the payloads that nobody touched or pinned in the meantime
+    std::unique_lock<std::shared_mutex> lock(nodes_mutex_);
+    size_t evicted = 0;
+    for (size_t i = 0; i < stored; ++i) {
+        const Victim& victim = victims[i];
+        auto it = nodes_.find(victim.id);
+        if (it == nodes_.end()) {
+            tiered_->forget(victim.id);  // Removed while we were writing
+            continue;
+        }
+        Node* node = it->second.get();
+        if (node->is_evicted() || node->is_pinned() || node->last_access() != victim.last_access) {
+            continue;  // Warm again; the slot is reused if it goes cold later
+        }
+        detach_from_column_locked(node);
+        size_t bytes = node->evict_payload();
+        resident_payload_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+        tiered_->record_eviction(bytes);
+        ++evicted;
+    }
+    return evicted;
+}
+
+void AtomicGraph::attach_to_column_locked(Node* node) {
+    if (node->in_column() || node->is_evicted() || !node->payload()) {
+        return;
+    }
+    PayloadColumn* column = modality_index_.column(node->modality());
+    if (!column || column->stride() != node->payload_size()) {
+        return;  // Tag doesn't match the size: keep the node's own buffer
+    }
+    uint32_t slot = column->acquire(node->id());
+    node->move_payload_to_column(column->data(slot), slot);
+}
+
+void AtomicGraph::detach_from_column_locked(Node* node) {
+    if (node->in_column()) {
+        modality_index_.column(node->modality())->release(node->column_slot());
+    }
+}
+
+Modality AtomicGraph::get_modality(NodeID id) const {
     std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
-    auto it = nodes_.find(id);
-    if (it != nodes_.end()) {
-        return it->second.get();
+    Modality modality = Modality::OTHER;
+    modality_index_.lookup(id, modality);
+    return modality;
+}
+
+void AtomicGraph::partition_by_modality(const std::vector<NodeID>& ids,
+                                        std::array<std::vector<NodeID>, MODALITY_COUNT>& out) const {
+    std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+    modality_index_.partition(ids, out);
+}
+
+void AtomicGraph::select_modality(Modality modality, const NodeBitset& nodes, NodeBitset& out) const {
+    std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+    NodeBitset::intersect(nodes, modality_index_.nodes(modality), out);
+}
+
+void AtomicGraph::for_each_payload_run(Modality modality,
+                                       const std::function<void(const NodeID*, const uint8_t*, size_t)>& fn) const {
+    std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+    const PayloadColumn* column = modality_index_.column(modality);
+    if (column) {
+        column->for_each_run(fn);
     }
-    return nullptr;
+}
+
+TieredStorage::Stats AtomicGraph::eviction_stats() const {
+    return tiered_ ? tiered_->stats() : TieredStorage::Stats();
 }
 
 bool AtomicGraph::remove_node(NodeID id) {
@@ -43,30 +292,100 @@ bool AtomicGraph::remove_node(NodeID id) {
     std::unique_lock<std::shared_mutex> edge_lock(edges_mutex_);
     
     // Remove node
-    if (nodes_.erase(id) == 0) {
+    auto node_it = nodes_.find(id);
+    if (node_it == nodes_.end()) {
         return false;
     }
+    Node* removed = node_it->second.get();
+    stats_.node_deleted(removed->payload_size(), removed->modality());
+    modality_index_.remove(id, removed->modality());
+    detach_from_column_locked(removed);
+    if (removed->is_evicted()) {
+        tiered_->forget(id);
+    } else {
+        resident_payload_bytes_.fetch_sub(removed->payload_size(), std::memory_order_relaxed);
+    }
+    nodes_.erase(node_it);
     
     // Remove all edges involving this node
-    edges_.erase(id); // outgoing edges
-    for (auto& [source_id, targets] : edges_) {
-        targets.erase(id); // incoming edges
+    auto out_it = edges_.find(id); // outgoing edges
+    if (out_it != edges_.end()) {
+        for (EdgeWeight weight : out_it->second.weights()) {
+            stats_.edge_deleted(weight);
+        }
+        for (NodeID target : out_it->second.targets()) {
+            unlink_incoming_locked(id, target);
+        }
+        stats_.out_degree_changed(id, out_it->second.size(), 0);
+        edges_.erase(out_it);
     }
+    auto in_it = incoming_.find(id); // incoming edges
+    if (in_it != incoming_.end()) {
+        std::vector<NodeID> sources = std::move(in_it->second);
+        incoming_.erase(in_it);
+        for (NodeID source : sources) {
+            auto row_it = edges_.find(source);
+            if (row_it != edges_.end()) {
+                erase_edge_locked(source, row_it->second, id);
+            }
+        }
+    }
+    edges_changed();
     
     return true;
 }
 
 bool AtomicGraph::add_edge(NodeID source, NodeID target, EdgeWeight weight) {
     std::unique_lock<std::shared_mutex> lock(edges_mutex_);
-    edges_[source][target] = weight;
+    EdgeRow& row = edges_[source];
+    long slot = row.find(target);
+    if (slot >= 0) {
+        stats_.edge_weight_changed(row.weight_at(slot), weight);
+        row.weight_at(slot) = weight;
+    } else {
+        row.set(target, weight);
+        incoming_[target].push_back(source);
+        stats_.edge_created(weight);
+        stats_.out_degree_changed(source, row.size() - 1, row.size());
+    }
+    edges_changed();
     return true;
 }
 
+bool AtomicGraph::erase_edge_locked(NodeID source, EdgeRow& row, NodeID target) {
+    long slot = row.find(target);
+    if (slot < 0) {
+        return false;
+    }
+    stats_.edge_deleted(row.weight_at(slot));
+    row.erase(target);
+    unlink_incoming_locked(source, target);
+    stats_.out_degree_changed(source, row.size() + 1, row.size());
+    edges_changed();
+    return true;
+}
+
+void AtomicGraph::unlink_incoming_locked(NodeID source, NodeID target) {
+    auto it = incoming_.find(target);
+    if (it == incoming_.end()) {
+        return;
+    }
+    std::vector<NodeID>& sources = it->second;
+    auto pos = std::find(sources.begin(), sources.end(), source);
+    if (pos != sources.end()) {
+        *pos = sources.back();
+        sources.pop_back();
+    }
+    if (sources.empty()) {
+        incoming_.erase(it);
+    }
+}
+
 bool AtomicGraph::remove_edge(NodeID source, NodeID target) {
     std::unique_lock<std::shared_mutex> lock(edges_mutex_);
     auto source_it = edges_.find(source);
     if (source_it != edges_.end()) {
-        return source_it->second.erase(target) > 0;
+        return erase_edge_locked(source, source_it->second, target);
     }
     return false;
 }
@@ -75,9 +394,9 @@ EdgeWeight AtomicGraph::get_edge_weight(NodeID source, NodeID target) const {
     std::shared_lock<std::shared_mutex> lock(edges_mutex_);
     auto source_it = edges_.find(source);
     if (source_it != edges_.end()) {
-        auto target_it = source_it->second.find(target);
-        if (target_it != source_it->second.end()) {
-            return target_it->second;
+        long slot = source_it->second.find(target);
+        if (slot >= 0) {
+            return source_it->second.weight_at(slot);
         }
     }
     return 0;
@@ -87,7 +406,7 @@ bool AtomicGraph::has_edge(NodeID source, NodeID target) const {
     std::shared_lock<std::shared_mutex> lock(edges_mutex_);
     auto source_it = edges_.find(source);
     if (source_it != edges_.end()) {
-        return source_it->second.find(target) != source_it->second.end();
+        return source_it->second.contains(target);
     }
     return false;
 }
@@ -98,14 +417,12 @@ std::vector<NodeID> AtomicGraph::get_neighbors(NodeID node) const {
     
     auto source_it = edges_.find(node);
     if (source_it != edges_.end()) {
-        for (const auto& [target_id, _] : source_it->second) {
-            neighbors.push_back(target_id);
-        }
+        neighbors = source_it->second.targets();
     }
     
     // Also check for incoming edges
-    for (const auto& [source_id, targets] : edges_) {
-        if (targets.find(node) != targets.end()) {
+    for (const auto& [source_id, row] : edges_) {
+        if (row.contains(node)) {
             neighbors.push_back(source_id);
         }
     }
@@ -117,9 +434,9 @@ std::vector<Edge> AtomicGraph::get_all_edges() const {
     std::shared_lock<std::shared_mutex> lock(edges_mutex_);
     std::vector<Edge> result;
     
-    for (const auto& [source_id, targets] : edges_) {
-        for (const auto& [target_id, weight] : targets) {
-            result.emplace_back(source_id, target_id, weight);
+    for (const auto& [source_id, row] : edges_) {
+        for (size_t i = 0; i < row.size(); ++i) {
+            result.emplace_back(source_id, row.targets()[i], row.weights()[i]);
         }
     }
     
@@ -138,13 +455,57 @@ std::vector<NodeID> AtomicGraph::get_all_nodes() const {
     return result;
 }
 
+std::vector<std::pair<NodeID, EdgeWeight>> AtomicGraph::get_outgoing_edges(NodeID node) const {
+    std::shared_lock<std::shared_mutex> lock(edges_mutex_);
+    std::vector<std::pair<NodeID, EdgeWeight>> result;
+    
+    auto source_it = edges_.find(node);
+    if (source_it != edges_.end()) {
+        const EdgeRow& row = source_it->second;
+        result.reserve(row.size());
+        for (size_t i = 0; i < row.size(); ++i) {
+            result.emplace_back(row.targets()[i], row.weights()[i]);
+        }
+    }
+    
+    return result;
+}
+
+std::vector<std::pair<NodeID, EdgeWeight>> AtomicGraph::get_incoming_edges(NodeID node) const {
+    std::shared_lock<std::shared_mutex> lock(edges_mutex_);
+    std::vector<std::pair<NodeID, EdgeWeight>> result;
+    
+    auto in_it = incoming_.find(node);
+    if (in_it != incoming_.end()) {
+        result.reserve(in_it->second.size());
+        for (NodeID source : in_it->second) {
+            const EdgeRow& row = edges_.find(source)->second;
+            result.emplace_back(source, row.weight_at(row.find(node)));
+        }
+    }
+    
+    return result;
+}
+
+NodeID AtomicGraph::any_node() const {
+    std::shared_lock<std::shared_mutex> lock(nodes_mutex_);
+    return nodes_.empty() ? 0 : nodes_.begin()->first;
+}
+
 bool AtomicGraph::increment_edge_weight(NodeID source, NodeID target, EdgeWeight delta) {
     std::unique_lock<std::shared_mutex> lock(edges_mutex_);
-    auto& target_map = edges_[source];
-    auto it = target_map.find(target);
+    auto source_it = edges_.find(source);
+    if (source_it == edges_.end()) {
+        return false;
+    }
     
-    if (it != target_map.end()) {
-        it->second = std::min<EdgeWeight>(it->second + delta, 65535);
+    long slot = source_it->second.find(target);
+    if (slot >= 0) {
+        EdgeWeight& weight = source_it->second.weight_at(slot);
+        EdgeWeight updated = Weight::add_saturating(weight, delta);
+        stats_.edge_weight_changed(weight, updated);
+        weight = updated;
+        edges_changed();
         return true;
     }
     return false;
@@ -152,11 +513,18 @@ bool AtomicGraph::increment_edge_weight(NodeID source, NodeID target, EdgeWeight
 
 bool AtomicGraph::average_edge_weight(NodeID source, NodeID target, EdgeWeight other_weight) {
     std::unique_lock<std::shared_mutex> lock(edges_mutex_);
-    auto& target_map = edges_[source];
-    auto it = target_map.find(target);
+    auto source_it = edges_.find(source);
+    if (source_it == edges_.end()) {
+        return false;
+    }
     
-    if (it != target_map.end()) {
-        it->second = (it->second + other_weight) / 2;
+    long slot = source_it->second.find(target);
+    if (slot >= 0) {
+        EdgeWeight& weight = source_it->second.weight_at(slot);
+        EdgeWeight updated = Weight::average(weight, other_weight);
+        stats_.edge_weight_changed(weight, updated);
+        weight = updated;
+        edges_changed();
         return true;
     }
     return false;
@@ -166,17 +534,23 @@ void AtomicGraph::redirect_edge(NodeID old_target, NodeID new_target) {
     std::unique_lock<std::shared_mutex> lock(edges_mutex_);
     
     // Find all edges to old_target and redirect them
-    for (auto& [source_id, targets] : edges_) {
-        auto it = targets.find(old_target);
-        if (it != targets.end()) {
-            EdgeWeight weight = it->second;
-            targets.erase(it);
+    for (auto& [source_id, row] : edges_) {
+        long slot = row.find(old_target);
+        if (slot >= 0) {
+            EdgeWeight weight = row.weight_at(slot);
+            erase_edge_locked(source_id, row, old_target);
             
             // If new_target already has an edge, average the weights
-            if (targets.find(new_target) != targets.end()) {
-                targets[new_target] = (targets[new_target] + weight) / 2;
+            long existing = row.find(new_target);
+            if (existing >= 0) {
+                EdgeWeight updated = Weight::average(row.weight_at(existing), weight);
+                stats_.edge_weight_changed(row.weight_at(existing), updated);
+                row.weight_at(existing) = updated;
             } else {
-                targets[new_target] = weight;
+                row.set(new_target, weight);
+                incoming_[new_target].push_back(source_id);
+                stats_.edge_created(weight);
+                stats_.out_degree_changed(source_id, row.size() - 1, row.size());
             }
         }
     }
@@ -188,12 +562,32 @@ size_t AtomicGraph::node_count() const {
 }
 
 size_t AtomicGraph::edge_count() const {
-    std::shared_lock<std::shared_mutex> lock(edges_mutex_);
-    size_t count = 0;
-    for (const auto& [_, targets] : edges_) {
-        count += targets.size();
+    // Maintained on every mutation; no traversal or lock needed
+    return stats_.get_net_edges();
+}
+
+size_t AtomicGraph::decay_all_edges(float decay_rate) {
+    if (decay_rate >= 1.0f) {
+        return 0;
+    }
+    uint16_t factor = Weight::decay_factor_q16(decay_rate);
+    
+    // Each row's weights are contiguous, so the sweep is a series of packed
+    // uint16 multiplies rather than one hash lookup per edge
+    std::unique_lock<std::shared_mutex> lock(edges_mutex_);
+    size_t zeroed = 0;
+    std::array<size_t, GraphStatistics::WEIGHT_BUCKETS> histogram{};
+    for (auto& [_, row] : edges_) {
+        EdgeWeight* weights = row.weight_data();
+        simd::scale_u16(weights, factor, row.size());
+        zeroed += simd::count_zero_u16(weights, row.size());
+        for (size_t i = 0; i < row.size(); ++i) {
+            histogram[GraphStatistics::weight_bucket(weights[i])]++;
+        }
     }
-    return count;
+    stats_.set_weight_histogram(histogram);
+    edges_changed();
+    return zeroed;
 }
 
 void AtomicGraph::clear() {
@@ -201,6 +595,14 @@ void AtomicGraph::clear() {
     std::unique_lock<std::shared_mutex> edge_lock(edges_mutex_);
     nodes_.clear();
     edges_.clear();
+    incoming_.clear();
+    modality_index_.clear();
+    edges_changed();
+    stats_.reset();
+    resident_payload_bytes_.store(0, std::memory_order_relaxed);
+    if (tiered_) {
+        tiered_->reset();
+    }
 }
 
 uint64_t AtomicGraph::hash_payload(const void* payload, size_t size) const {
@@ -222,7 +624,14 @@ NodeID AtomicGraph::find_node_with_payload(const void* payload, size_t payload_s
         if (node_it != nodes_.end()) {
             const Node* node_ptr = node_it->second.get();
             if (node_ptr && node_ptr->payload_size() == payload_size) {
-                if (std::memcmp(node_ptr->payload(), payload, payload_size) == 0) {
+                if (node_ptr->is_evicted()) {
+                    // Compare against the cold copy without faulting it in
+                    std::vector<uint8_t> cold(payload_size);
+                    if (tiered_ && tiered_->load(node_ptr->id(), cold.data(), payload_size) &&
+                        std::memcmp(cold.data(), payload, payload_size) == 0) {
+                        return node_ptr->id();
+                    }
+                } else if (std::memcmp(node_ptr->payload(), payload, payload_size) == 0) {
                     return node_ptr->id();
                 }
             }
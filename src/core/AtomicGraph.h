@@ -2,12 +2,19 @@
 
 #include "../include/melvin/types.h"
 #include "Node.h"
+#include "EdgeRow.h"
+#include "GraphStatistics.h"
+#include "TieredStorage.h"
+#include "ModalityIndex.h"
+#include <array>
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <mutex>
 #include <shared_mutex>
 #include <vector>
 #include <memory>
+#include <atomic>
 
 namespace melvin {
 
@@ -17,10 +24,23 @@ public:
     ~AtomicGraph();
     
     // Node operations (thread-safe)
+    // get_node faults an evicted payload back in before returning. With
+    // tiered storage the payload can be evicted again once the call returns;
+    // read it through pin_node or read_payload instead.
     bool add_node(std::unique_ptr<Node> node);
     Node* get_node(NodeID id);
     bool remove_node(NodeID id);
     
+    // Like get_node, but the payload stays resident and in place until the
+    // returned handle is released. Empty if the node is absent or unreadable.
+    PinnedNode pin_node(NodeID id);
+    
+    // Node metadata (id, size, frequency) without touching or faulting; payload() may be null
+    Node* get_node_metadata(NodeID id);
+    
+    // Copy a payload without making it resident again (persistence, scans)
+    bool read_payload(NodeID id, std::vector<uint8_t>& out) const;
+    
     // Edge operations (thread-safe)
     bool add_edge(NodeID source, NodeID target, EdgeWeight weight);
     bool remove_edge(NodeID source, NodeID target);
@@ -32,6 +52,18 @@ public:
     std::vector<Edge> get_all_edges() const;
     std::vector<NodeID> get_all_nodes() const;
     
+    // Outgoing edges of one node - O(out-degree), no scan for incoming edges
+    std::vector<std::pair<NodeID, EdgeWeight>> get_outgoing_edges(NodeID node) const;
+    
+    // Incoming edges of one node as (source, weight) - O(in-degree) via the reverse index
+    std::vector<std::pair<NodeID, EdgeWeight>> get_incoming_edges(NodeID node) const;
+    
+    // Bumped by every edge or weight change; callers caching weights compare it
+    uint64_t edge_version() const { return edge_version_.load(std::memory_order_acquire); }
+    
+    // Any node in the graph (0 if empty) without copying the node list
+    NodeID any_node() const;
+    
     // Check if payload already exists (for deduplication) - O(1) hash lookup
     NodeID find_node_with_payload(const void* payload, size_t payload_size) const;
     
@@ -42,6 +74,10 @@ public:
     bool increment_edge_weight(NodeID source, NodeID target, EdgeWeight delta = 1);
     bool average_edge_weight(NodeID source, NodeID target, EdgeWeight other_weight);
     
+    // Multiply every edge weight by decay_rate in packed fixed-point batches.
+    // Returns the number of edges whose weight has reached zero.
+    size_t decay_all_edges(float decay_rate);
+    
     // Reconnect edges (used in leap node consolidation)
     void redirect_edge(NodeID old_target, NodeID new_target);
     
@@ -49,6 +85,37 @@ public:
     size_t node_count() const;
     size_t edge_count() const;
     
+    // Always-on mutation statistics (lock-free reads). Read-only: the graph
+    // is the only writer, and edge_count() is served from these counters.
+    const GraphStatistics& statistics() const { return stats_; }
+    
+    // Tiered storage: keep resident payload bytes under a budget by evicting
+    // cold nodes (by frequency and last access) to a segment file.
+    // Enable before other threads start using the graph.
+    bool enable_tiered_storage(const TieredStorageConfig& config = TieredStorageConfig());
+    bool tiered_storage_enabled() const { return tiered_ != nullptr; }
+    size_t enforce_memory_budget();
+    size_t resident_payload_bytes() const { return resident_payload_bytes_.load(std::memory_order_relaxed); }
+    TieredStorage::Stats eviction_stats() const;
+    
+    // Modality index: nodes are tagged at creation (Node::modality()) and
+    // indexed in one bitset per modality, so routing needs no node lookups
+    Modality get_modality(NodeID id) const;  // OTHER if absent
+    // Groups keep the order of ids (duplicates included); unknown ids are dropped
+    void partition_by_modality(const std::vector<NodeID>& ids,
+                               std::array<std::vector<NodeID>, MODALITY_COUNT>& out) const;
+    
+    // out = nodes & (all nodes of `modality`): the vectorized routing path,
+    // one word-wise AND per modality instead of a lookup per id
+    void select_modality(Modality modality, const NodeBitset& nodes, NodeBitset& out) const;
+    
+    // Resident payloads of a fixed-size modality live in one column:
+    // fn(ids, payloads, count) per run of contiguous slots, with
+    // modality_payload_size(modality) bytes per payload. Evicted payloads
+    // are skipped. Holds the node lock (shared) for the whole walk.
+    void for_each_payload_run(Modality modality,
+                              const std::function<void(const NodeID*, const uint8_t*, size_t)>& fn) const;
+    
     // Reset
     void clear();
     
@@ -57,12 +124,45 @@ private:
     mutable std::shared_mutex edges_mutex_;
     
     std::unordered_map<NodeID, std::unique_ptr<Node>> nodes_;
-    std::unordered_map<NodeID, std::unordered_map<NodeID, EdgeWeight>> edges_;
+    std::unordered_map<NodeID, EdgeRow> edges_;  // source -> outgoing row
+    std::unordered_map<NodeID, std::vector<NodeID>> incoming_;  // target -> sources, guarded by edges_mutex_
+    std::atomic<uint64_t> edge_version_{0};
     
     // Hash map for fast payload deduplication (hash -> node_id)
     mutable std::shared_mutex payload_hash_mutex_;
     std::unordered_map<uint64_t, NodeID> payload_hash_to_node_;
     
+    GraphStatistics stats_;
+    
+    // Guarded by nodes_mutex_
+    ModalityIndex modality_index_;
+    
+    std::unique_ptr<TieredStorage> tiered_;
+    std::atomic<size_t> resident_payload_bytes_{0};
+    
+    // Reload an evicted payload under the exclusive node lock (pinning the
+    // node before the lock is released if `pin`)
+    Node* fault_in(NodeID id, bool pin = false);
+    
+    // Move a resident fixed-size payload into its modality column (or give
+    // the slot back); caller holds nodes_mutex_ exclusively
+    void attach_to_column_locked(Node* node);
+    void detach_from_column_locked(Node* node);
+    
+    // Evict coldest unpinned payloads down to the low-water mark. Takes the
+    // node lock itself: victims are picked and copied under the shared lock,
+    // written to the segment unlocked, and dropped under the exclusive lock
+    // unless they were touched or pinned during the write.
+    size_t evict_cold();
+    std::mutex eviction_mutex_;
+    
+    // Remove one edge and record it; caller holds edges_mutex_ exclusively
+    bool erase_edge_locked(NodeID source, EdgeRow& row, NodeID target);
+    
+    // Reverse index upkeep; caller holds edges_mutex_ exclusively
+    void unlink_incoming_locked(NodeID source, NodeID target);
+    void edges_changed() { edge_version_.fetch_add(1, std::memory_order_release); }
+    
     // Helper to get edge key
     static uint64_t edge_key(NodeID source, NodeID target) {
         return (static_cast<uint64_t>(source) << 32) | target;
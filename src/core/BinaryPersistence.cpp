@@ -19,9 +19,10 @@ bool BinaryPersistence::save_to_files(const std::string& nodes_file, const std::
         std::vector<NodeID> all_nodes = graph_->get_all_nodes();
         nodes_count_ = all_nodes.size();
         
+        std::vector<uint8_t> payload;
         for (NodeID node_id : all_nodes) {
-            Node* node = graph_->get_node(node_id);
-            if (!node) continue;
+            Node* node = graph_->get_node_metadata(node_id);
+            if (!node || !graph_->read_payload(node_id, payload)) continue;
             
             NodeRecord record;
             record.id = node->id();
@@ -34,7 +35,7 @@ bool BinaryPersistence::save_to_files(const std::string& nodes_file, const std::
             
             // Write payload
             if (record.payload_size > 0) {
-                file.write(reinterpret_cast<const char*>(node->payload()), record.payload_size);
+                file.write(reinterpret_cast<const char*>(payload.data()), record.payload_size);
             }
         }
     }
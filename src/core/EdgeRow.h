@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../include/melvin/types.h"
+#include <unordered_map>
+#include <vector>
+
+namespace melvin {
+
+// Outgoing edges of one source node, stored as parallel arrays so the
+// uint16 weights are contiguous and can be swept in SIMD batches.
+// Small rows use a linear scan; a slot index is built once the row grows.
+class EdgeRow {
+public:
+    size_t size() const { return targets_.size(); }
+    bool empty() const { return targets_.empty(); }
+
+    const std::vector<NodeID>& targets() const { return targets_; }
+    const std::vector<EdgeWeight>& weights() const { return weights_; }
+    EdgeWeight* weight_data() { return weights_.data(); }
+
+    // Slot of target, or -1 if absent
+    long find(NodeID target) const {
+        if (!index_.empty()) {
+            auto it = index_.find(target);
+            return it != index_.end() ? static_cast<long>(it->second) : -1;
+        }
+        for (size_t i = 0; i < targets_.size(); ++i) {
+            if (targets_[i] == target) return static_cast<long>(i);
+        }
+        return -1;
+    }
+
+    bool contains(NodeID target) const { return find(target) >= 0; }
+
+    EdgeWeight weight_at(size_t slot) const { return weights_[slot]; }
+    EdgeWeight& weight_at(size_t slot) { return weights_[slot]; }
+
+    // Insert or overwrite; returns true if the edge is new
+    bool set(NodeID target, EdgeWeight weight) {
+        long slot = find(target);
+        if (slot >= 0) {
+            weights_[slot] = weight;
+            return false;
+        }
+        if (!index_.empty()) {
+            index_[target] = static_cast<uint32_t>(targets_.size());
+        }
+        targets_.push_back(target);
+        weights_.push_back(weight);
+        if (index_.empty() && targets_.size() > LINEAR_SCAN_LIMIT) {
+            build_index();
+        }
+        return true;
+    }
+
+    // Swap-with-last removal; returns false if absent
+    bool erase(NodeID target) {
+        long slot = find(target);
+        if (slot < 0) return false;
+
+        size_t last = targets_.size() - 1;
+        if (static_cast<size_t>(slot) != last) {
+            targets_[slot] = targets_[last];
+            weights_[slot] = weights_[last];
+            if (!index_.empty()) index_[targets_[slot]] = static_cast<uint32_t>(slot);
+        }
+        targets_.pop_back();
+        weights_.pop_back();
+        if (!index_.empty()) index_.erase(target);
+        return true;
+    }
+
+    void clear() {
+        targets_.clear();
+        weights_.clear();
+        index_.clear();
+    }
+
+private:
+    static constexpr size_t LINEAR_SCAN_LIMIT = 16;
+
+    std::vector<NodeID> targets_;
+    std::vector<EdgeWeight> weights_;
+    std::unordered_map<NodeID, uint32_t> index_;  // Empty while the row is small
+
+    void build_index() {
+        index_.reserve(targets_.size() * 2);
+        for (size_t i = 0; i < targets_.size(); ++i) {
+            index_[targets_[i]] = static_cast<uint32_t>(i);
+        }
+    }
+};
+
+} // namespace melvin
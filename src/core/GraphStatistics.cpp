@@ -1,59 +1,392 @@
 #include "GraphStatistics.h"
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 
 namespace melvin {
 
-GraphStatistics::GraphStatistics()
-    : total_nodes_created_(0), total_nodes_deleted_(0),
-      total_edges_created_(0), total_edges_deleted_(0) {
+namespace {
+
+const char* modality_name(size_t index) {
+    static const char* names[MODALITY_COUNT] = {"vision", "audio", "text", "motor", "other"};
+    return names[index];
+}
+
+constexpr uint64_t HUB_ID_MASK = (1ULL << 48) - 1;
+
+uint64_t pack_hub(NodeID node, size_t degree) {
+    uint64_t clamped = std::min<size_t>(degree, 65535);
+    return (clamped << 48) | (node & HUB_ID_MASK);
+}
+
+template <size_t N>
+void write_array(std::ostringstream& out, const std::array<size_t, N>& values) {
+    out << "[";
+    for (size_t i = 0; i < N; ++i) {
+        out << (i ? "," : "") << values[i];
+    }
+    out << "]";
+}
+
+} // namespace
+
+GraphStatistics::GraphStatistics() {
+    for (auto& slot : hubs_) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+}
+
+GraphStatistics::Shard& GraphStatistics::local_shard() {
+    // Each thread sticks to one shard, assigned round-robin on first use
+    static std::atomic<size_t> next_shard{0};
+    thread_local size_t shard_index = next_shard.fetch_add(1, std::memory_order_relaxed) % NUM_SHARDS;
+    return shards_[shard_index];
+}
+
+int64_t GraphStatistics::sum(std::atomic<int64_t> Shard::*field) const {
+    int64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += (shard.*field).load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+template <size_t N>
+std::array<size_t, N> GraphStatistics::sum_array(std::array<std::atomic<int64_t>, N> Shard::*field) const {
+    std::array<int64_t, N> totals{};
+    for (const Shard& shard : shards_) {
+        for (size_t i = 0; i < N; ++i) {
+            totals[i] += (shard.*field)[i].load(std::memory_order_relaxed);
+        }
+    }
+    std::array<size_t, N> result{};
+    for (size_t i = 0; i < N; ++i) {
+        result[i] = totals[i] > 0 ? static_cast<size_t>(totals[i]) : 0;
+    }
+    return result;
 }
 
 void GraphStatistics::node_created() {
-    total_nodes_created_.fetch_add(1, std::memory_order_relaxed);
+    local_shard().nodes_created.fetch_add(1, std::memory_order_relaxed);
 }
 
 void GraphStatistics::node_deleted() {
-    total_nodes_deleted_.fetch_add(1, std::memory_order_relaxed);
+    local_shard().nodes_deleted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GraphStatistics::node_created(size_t payload_size) {
+    node_created(payload_size, modality_from_payload_size(payload_size));
+}
+
+void GraphStatistics::node_deleted(size_t payload_size) {
+    node_deleted(payload_size, modality_from_payload_size(payload_size));
+}
+
+void GraphStatistics::node_created(size_t payload_size, Modality modality) {
+    Shard& shard = local_shard();
+    size_t index = static_cast<size_t>(modality);
+    shard.nodes_created.fetch_add(1, std::memory_order_relaxed);
+    shard.nodes_by_modality[index].fetch_add(1, std::memory_order_relaxed);
+    shard.payload_bytes[index].fetch_add(static_cast<int64_t>(payload_size), std::memory_order_relaxed);
+}
+
+void GraphStatistics::node_deleted(size_t payload_size, Modality modality) {
+    Shard& shard = local_shard();
+    size_t index = static_cast<size_t>(modality);
+    shard.nodes_deleted.fetch_add(1, std::memory_order_relaxed);
+    shard.nodes_by_modality[index].fetch_sub(1, std::memory_order_relaxed);
+    shard.payload_bytes[index].fetch_sub(static_cast<int64_t>(payload_size), std::memory_order_relaxed);
+}
+
+size_t GraphStatistics::get_total_nodes_created() const {
+    return static_cast<size_t>(sum(&Shard::nodes_created));
+}
+
+size_t GraphStatistics::get_total_nodes_deleted() const {
+    return static_cast<size_t>(sum(&Shard::nodes_deleted));
 }
 
 size_t GraphStatistics::get_net_nodes() const {
-    size_t created = total_nodes_created_.load();
-    size_t deleted = total_nodes_deleted_.load();
+    size_t created = get_total_nodes_created();
+    size_t deleted = get_total_nodes_deleted();
     return created > deleted ? created - deleted : 0;
 }
 
 void GraphStatistics::edge_created() {
-    total_edges_created_.fetch_add(1, std::memory_order_relaxed);
+    local_shard().edges_created.fetch_add(1, std::memory_order_relaxed);
 }
 
 void GraphStatistics::edge_deleted() {
-    total_edges_deleted_.fetch_add(1, std::memory_order_relaxed);
+    local_shard().edges_deleted.fetch_add(1, std::memory_order_relaxed);
+}
+
+void GraphStatistics::edge_created(EdgeWeight weight) {
+    Shard& shard = local_shard();
+    shard.edges_created.fetch_add(1, std::memory_order_relaxed);
+    shard.weight_buckets[weight_bucket(weight)].fetch_add(1, std::memory_order_relaxed);
+}
+
+void GraphStatistics::edge_deleted(EdgeWeight weight) {
+    Shard& shard = local_shard();
+    shard.edges_deleted.fetch_add(1, std::memory_order_relaxed);
+    shard.weight_buckets[weight_bucket(weight)].fetch_sub(1, std::memory_order_relaxed);
+}
+
+void GraphStatistics::edge_weight_changed(EdgeWeight old_weight, EdgeWeight new_weight) {
+    size_t old_bucket = weight_bucket(old_weight);
+    size_t new_bucket = weight_bucket(new_weight);
+    if (old_bucket == new_bucket) return;
+
+    Shard& shard = local_shard();
+    shard.weight_buckets[old_bucket].fetch_sub(1, std::memory_order_relaxed);
+    shard.weight_buckets[new_bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t GraphStatistics::get_total_edges_created() const {
+    return static_cast<size_t>(sum(&Shard::edges_created));
+}
+
+size_t GraphStatistics::get_total_edges_deleted() const {
+    return static_cast<size_t>(sum(&Shard::edges_deleted));
 }
 
 size_t GraphStatistics::get_net_edges() const {
-    size_t created = total_edges_created_.load();
-    size_t deleted = total_edges_deleted_.load();
+    size_t created = get_total_edges_created();
+    size_t deleted = get_total_edges_deleted();
     return created > deleted ? created - deleted : 0;
 }
 
+size_t GraphStatistics::degree_bucket(size_t degree) {
+    size_t bucket = 0;
+    while (degree > 0 && bucket < DEGREE_BUCKETS - 1) {
+        degree >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void GraphStatistics::out_degree_changed(NodeID node, size_t old_degree, size_t new_degree) {
+    // Bucket 0 is derived from the node count, so only non-empty rows are counted
+    size_t old_bucket = degree_bucket(old_degree);
+    size_t new_bucket = degree_bucket(new_degree);
+    if (old_bucket != new_bucket) {
+        Shard& shard = local_shard();
+        if (old_bucket > 0) shard.degree_buckets[old_bucket].fetch_sub(1, std::memory_order_relaxed);
+        if (new_bucket > 0) shard.degree_buckets[new_bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (new_degree >= HUB_MIN_DEGREE || old_degree >= HUB_MIN_DEGREE) {
+        update_hub(node, new_degree);
+    }
+}
+
+void GraphStatistics::update_hub(NodeID node, size_t degree) {
+    uint64_t packed = degree >= HUB_MIN_DEGREE ? pack_hub(node, degree) : 0;
+
+    // Already tracked: refresh in place (or drop it once below the threshold)
+    for (auto& slot : hubs_) {
+        uint64_t current = slot.load(std::memory_order_relaxed);
+        while (current != 0 && (current & HUB_ID_MASK) == (node & HUB_ID_MASK)) {
+            if (slot.compare_exchange_weak(current, packed, std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+    if (packed == 0) return;
+
+    // Otherwise displace the weakest hub; a lost race just skips this update
+    size_t weakest = 0;
+    uint64_t weakest_value = hubs_[0].load(std::memory_order_relaxed);
+    for (size_t i = 1; i < MAX_HUBS; ++i) {
+        uint64_t value = hubs_[i].load(std::memory_order_relaxed);
+        if ((value >> 48) < (weakest_value >> 48)) {
+            weakest = i;
+            weakest_value = value;
+        }
+    }
+    if ((weakest_value >> 48) < (packed >> 48)) {
+        hubs_[weakest].compare_exchange_strong(weakest_value, packed, std::memory_order_relaxed);
+    }
+}
+
+void GraphStatistics::set_weight_histogram(const std::array<size_t, WEIGHT_BUCKETS>& histogram) {
+    for (Shard& shard : shards_) {
+        for (auto& bucket : shard.weight_buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (size_t i = 0; i < WEIGHT_BUCKETS; ++i) {
+        shards_[0].weight_buckets[i].store(static_cast<int64_t>(histogram[i]), std::memory_order_relaxed);
+    }
+}
+
+size_t GraphStatistics::get_nodes(Modality modality) const {
+    return sum_array(&Shard::nodes_by_modality)[static_cast<size_t>(modality)];
+}
+
+size_t GraphStatistics::get_payload_bytes(Modality modality) const {
+    return sum_array(&Shard::payload_bytes)[static_cast<size_t>(modality)];
+}
+
+std::array<size_t, GraphStatistics::DEGREE_BUCKETS> GraphStatistics::get_degree_histogram() const {
+    std::array<size_t, DEGREE_BUCKETS> histogram = sum_array(&Shard::degree_buckets);
+    size_t with_edges = 0;
+    for (size_t i = 1; i < DEGREE_BUCKETS; ++i) {
+        with_edges += histogram[i];
+    }
+    size_t nodes = get_net_nodes();
+    histogram[0] = nodes > with_edges ? nodes - with_edges : 0;
+    return histogram;
+}
+
+std::array<size_t, GraphStatistics::WEIGHT_BUCKETS> GraphStatistics::get_weight_histogram() const {
+    return sum_array(&Shard::weight_buckets);
+}
+
+std::vector<GraphStatistics::Hub> GraphStatistics::get_hubs() const {
+    std::vector<Hub> hubs;
+    for (const auto& slot : hubs_) {
+        uint64_t value = slot.load(std::memory_order_relaxed);
+        if (value != 0) {
+            hubs.push_back({value & HUB_ID_MASK, static_cast<size_t>(value >> 48)});
+        }
+    }
+    std::sort(hubs.begin(), hubs.end(), [](const Hub& a, const Hub& b) {
+        return a.out_degree > b.out_degree;
+    });
+    return hubs;
+}
+
+GraphStatistics::Snapshot GraphStatistics::snapshot() const {
+    Snapshot snap;
+    snap.timestamp_ms = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    snap.nodes_created = get_total_nodes_created();
+    snap.nodes_deleted = get_total_nodes_deleted();
+    snap.edges_created = get_total_edges_created();
+    snap.edges_deleted = get_total_edges_deleted();
+    snap.net_nodes = get_net_nodes();
+    snap.net_edges = get_net_edges();
+    snap.nodes_by_modality = sum_array(&Shard::nodes_by_modality);
+    snap.payload_bytes_by_modality = sum_array(&Shard::payload_bytes);
+    snap.degree_histogram = get_degree_histogram();
+    snap.weight_histogram = get_weight_histogram();
+    snap.hubs = get_hubs();
+    return snap;
+}
+
+std::string GraphStatistics::Snapshot::to_json() const {
+    std::ostringstream out;
+    out << "{\"timestamp_ms\":" << timestamp_ms
+        << ",\"nodes\":" << net_nodes
+        << ",\"edges\":" << net_edges
+        << ",\"nodes_created\":" << nodes_created
+        << ",\"nodes_deleted\":" << nodes_deleted
+        << ",\"edges_created\":" << edges_created
+        << ",\"edges_deleted\":" << edges_deleted;
+
+    out << ",\"modalities\":{";
+    for (size_t i = 0; i < MODALITY_COUNT; ++i) {
+        out << (i ? "," : "") << "\"" << modality_name(i) << "\":{\"nodes\":"
+            << nodes_by_modality[i] << ",\"payload_bytes\":" << payload_bytes_by_modality[i] << "}";
+    }
+    out << "}";
+
+    out << ",\"degree_histogram\":";
+    write_array(out, degree_histogram);
+    out << ",\"weight_histogram\":";
+    write_array(out, weight_histogram);
+
+    out << ",\"hubs\":[";
+    for (size_t i = 0; i < hubs.size(); ++i) {
+        out << (i ? "," : "") << "{\"node\":" << hubs[i].node << ",\"out_degree\":" << hubs[i].out_degree << "}";
+    }
+    out << "]}";
+    return out.str();
+}
+
 void GraphStatistics::reset() {
-    total_nodes_created_ = 0;
-    total_nodes_deleted_ = 0;
-    total_edges_created_ = 0;
-    total_edges_deleted_ = 0;
+    for (Shard& shard : shards_) {
+        shard.nodes_created = 0;
+        shard.nodes_deleted = 0;
+        shard.edges_created = 0;
+        shard.edges_deleted = 0;
+        for (auto& v : shard.nodes_by_modality) v = 0;
+        for (auto& v : shard.payload_bytes) v = 0;
+        for (auto& v : shard.degree_buckets) v = 0;
+        for (auto& v : shard.weight_buckets) v = 0;
+    }
+    for (auto& slot : hubs_) {
+        slot = 0;
+    }
 }
 
 void GraphStatistics::print_stats() const {
-    size_t net_nodes = get_net_nodes();
-    size_t net_edges = get_net_edges();
-    
+    Snapshot snap = snapshot();
+
     std::cout << "=== Graph Statistics ===\n";
-    std::cout << "Nodes: " << net_nodes << " (created: " << total_nodes_created_.load() 
-              << ", deleted: " << total_nodes_deleted_.load() << ")\n";
-    std::cout << "Edges: " << net_edges << " (created: " << total_edges_created_.load() 
-              << ", deleted: " << total_edges_deleted_.load() << ")\n";
+    std::cout << "Nodes: " << snap.net_nodes << " (created: " << snap.nodes_created
+              << ", deleted: " << snap.nodes_deleted << ")\n";
+    std::cout << "Edges: " << snap.net_edges << " (created: " << snap.edges_created
+              << ", deleted: " << snap.edges_deleted << ")\n";
+    for (size_t i = 0; i < MODALITY_COUNT; ++i) {
+        if (snap.nodes_by_modality[i] > 0) {
+            std::cout << "  " << modality_name(i) << ": " << snap.nodes_by_modality[i]
+                      << " nodes, " << snap.payload_bytes_by_modality[i] << " payload bytes\n";
+        }
+    }
+    if (!snap.hubs.empty()) {
+        std::cout << "Top hub: node " << snap.hubs[0].node << " (out-degree "
+                  << snap.hubs[0].out_degree << ")\n";
+    }
     std::cout << "======================\n";
 }
 
-} // namespace melvin
+StatisticsExporter::StatisticsExporter(const GraphStatistics* stats, const std::string& path,
+                                       std::chrono::milliseconds interval)
+    : stats_(stats), path_(path), interval_(interval), running_(false) {
+}
+
+StatisticsExporter::~StatisticsExporter() {
+    stop();
+}
+
+void StatisticsExporter::start() {
+    if (running_.exchange(true)) {
+        return;
+    }
+    thread_ = std::thread(&StatisticsExporter::export_loop, this);
+}
+
+void StatisticsExporter::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
 
+bool StatisticsExporter::export_now() {
+    std::ofstream out(path_, std::ios::app);
+    if (!out) {
+        return false;
+    }
+    out << stats_->snapshot().to_json() << "\n";
+    return true;
+}
+
+void StatisticsExporter::export_loop() {
+    auto next = std::chrono::steady_clock::now() + interval_;
+    while (running_.load()) {
+        // Poll in short steps so stop() doesn't wait a full interval
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (std::chrono::steady_clock::now() >= next) {
+            export_now();
+            next += interval_;
+        }
+    }
+}
+
+} // namespace melvin
@@ -1,42 +1,142 @@
 #pragma once
 
 #include "../include/melvin/types.h"
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace melvin {
 
-// Tracks total nodes and edges across graph lifetime
+// Always-on graph statistics, updated by AtomicGraph on every mutation.
+// Writers bump relaxed atomics in a per-thread shard (no shared cache line
+// between intake threads); readers sum the shards without taking any lock,
+// so values are eventually consistent rather than a stop-the-world count.
 class GraphStatistics {
 public:
+    static constexpr size_t NUM_SHARDS = 16;
+    static constexpr size_t DEGREE_BUCKETS = 17;  // 0, 1, 2-3, 4-7, ..., >= 2^15
+    static constexpr size_t WEIGHT_BUCKETS = 16;  // EdgeWeight >> 12
+    static constexpr size_t MAX_HUBS = 8;
+    static constexpr size_t HUB_MIN_DEGREE = 32;  // Out-degree to be tracked as a hub
+
+    struct Hub {
+        NodeID node;
+        size_t out_degree;
+    };
+
+    // Point-in-time copy of every counter, for exporters and pruning policy
+    struct Snapshot {
+        uint64_t timestamp_ms = 0;
+        size_t nodes_created = 0;
+        size_t nodes_deleted = 0;
+        size_t edges_created = 0;
+        size_t edges_deleted = 0;
+        size_t net_nodes = 0;
+        size_t net_edges = 0;
+        std::array<size_t, MODALITY_COUNT> nodes_by_modality{};
+        std::array<size_t, MODALITY_COUNT> payload_bytes_by_modality{};
+        std::array<size_t, DEGREE_BUCKETS> degree_histogram{};
+        std::array<size_t, WEIGHT_BUCKETS> weight_histogram{};
+        std::vector<Hub> hubs;
+
+        std::string to_json() const;
+    };
+
     GraphStatistics();
-    
+
     // Node counting
     void node_created();
     void node_deleted();
-    size_t get_total_nodes_created() const { return total_nodes_created_.load(); }
-    size_t get_total_nodes_deleted() const { return total_nodes_deleted_.load(); }
+    void node_created(size_t payload_size);
+    void node_deleted(size_t payload_size);
+    void node_created(size_t payload_size, Modality modality);
+    void node_deleted(size_t payload_size, Modality modality);
+    size_t get_total_nodes_created() const;
+    size_t get_total_nodes_deleted() const;
     size_t get_net_nodes() const;
-    
+
     // Edge counting
     void edge_created();
     void edge_deleted();
-    size_t get_total_edges_created() const { return total_edges_created_.load(); }
-    size_t get_total_edges_deleted() const { return total_edges_deleted_.load(); }
+    void edge_created(EdgeWeight weight);
+    void edge_deleted(EdgeWeight weight);
+    void edge_weight_changed(EdgeWeight old_weight, EdgeWeight new_weight);
+    size_t get_total_edges_created() const;
+    size_t get_total_edges_deleted() const;
     size_t get_net_edges() const;
-    
+
+    // Structure tracking
+    void out_degree_changed(NodeID node, size_t old_degree, size_t new_degree);
+
+    // Replace the weight histogram after a bulk sweep (caller holds the edge lock)
+    void set_weight_histogram(const std::array<size_t, WEIGHT_BUCKETS>& histogram);
+
+    // Lock-free readers
+    size_t get_nodes(Modality modality) const;
+    size_t get_payload_bytes(Modality modality) const;
+    std::array<size_t, DEGREE_BUCKETS> get_degree_histogram() const;
+    std::array<size_t, WEIGHT_BUCKETS> get_weight_histogram() const;
+    std::vector<Hub> get_hubs() const;
+    Snapshot snapshot() const;
+
+    static size_t degree_bucket(size_t degree);
+    static size_t weight_bucket(EdgeWeight weight) { return weight >> 12; }
+
     // Reset counters
     void reset();
-    
+
     // Print statistics
     void print_stats() const;
-    
+
 private:
-    std::atomic<size_t> total_nodes_created_;
-    std::atomic<size_t> total_nodes_deleted_;
-    std::atomic<size_t> total_edges_created_;
-    std::atomic<size_t> total_edges_deleted_;
+    struct alignas(64) Shard {
+        std::atomic<int64_t> nodes_created{0};
+        std::atomic<int64_t> nodes_deleted{0};
+        std::atomic<int64_t> edges_created{0};
+        std::atomic<int64_t> edges_deleted{0};
+        std::array<std::atomic<int64_t>, MODALITY_COUNT> nodes_by_modality{};
+        std::array<std::atomic<int64_t>, MODALITY_COUNT> payload_bytes{};
+        std::array<std::atomic<int64_t>, DEGREE_BUCKETS> degree_buckets{};
+        std::array<std::atomic<int64_t>, WEIGHT_BUCKETS> weight_buckets{};
+    };
+
+    std::array<Shard, NUM_SHARDS> shards_;
+
+    // Best-effort top hubs: (min(degree, 65535) << 48) | node id, updated by CAS
+    std::array<std::atomic<uint64_t>, MAX_HUBS> hubs_{};
+
+    Shard& local_shard();
+    int64_t sum(std::atomic<int64_t> Shard::*field) const;
+    template <size_t N>
+    std::array<size_t, N> sum_array(std::array<std::atomic<int64_t>, N> Shard::*field) const;
+    void update_hub(NodeID node, size_t degree);
 };
 
-} // namespace melvin
+// Periodically writes GraphStatistics snapshots as JSON lines
+class StatisticsExporter {
+public:
+    StatisticsExporter(const GraphStatistics* stats, const std::string& path,
+                       std::chrono::milliseconds interval = std::chrono::seconds(10));
+    ~StatisticsExporter();
+
+    void start();
+    void stop();
 
+    // Append one snapshot immediately
+    bool export_now();
+
+private:
+    const GraphStatistics* stats_;
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    std::atomic<bool> running_;
+    std::thread thread_;
+
+    void export_loop();
+};
+
+} // namespace melvin
@@ -0,0 +1,119 @@
+#include "ModalityIndex.h"
+#include <algorithm>
+
+namespace melvin {
+
+void NodeBitset::intersect(const NodeBitset& a, const NodeBitset& b, NodeBitset& out) {
+    size_t n = std::min(a.words_.size(), b.words_.size());
+    out.words_.resize(n);
+    const uint64_t* x = a.words_.data();
+    const uint64_t* y = b.words_.data();
+    uint64_t* dst = out.words_.data();
+    for (size_t i = 0; i < n; ++i) {
+        dst[i] = x[i] & y[i];  // Auto-vectorized
+    }
+}
+
+uint32_t PayloadColumn::acquire(NodeID id) {
+    uint32_t slot;
+    if (!free_slots_.empty()) {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slot_ids_.size());
+        if (slot % CHUNK_SLOTS == 0) {
+            chunks_.emplace_back(new uint8_t[CHUNK_SLOTS * stride_]);
+        }
+        slot_ids_.push_back(0);
+    }
+    slot_ids_[slot] = id;
+    ++occupied_;
+    return slot;
+}
+
+void PayloadColumn::release(uint32_t slot) {
+    if (slot >= slot_ids_.size() || slot_ids_[slot] == 0) return;
+    slot_ids_[slot] = 0;
+    free_slots_.push_back(slot);
+    --occupied_;
+}
+
+void PayloadColumn::clear() {
+    chunks_.clear();
+    slot_ids_.clear();
+    free_slots_.clear();
+    occupied_ = 0;
+}
+
+ModalityIndex::ModalityIndex() {
+    for (size_t m = 0; m < MODALITY_COUNT; ++m) {
+        columns_[m] = PayloadColumn(modality_payload_size(static_cast<Modality>(m)));
+    }
+}
+
+void ModalityIndex::add(NodeID id, Modality modality) {
+    if (id < MAX_DENSE_ID) {
+        bitsets_[static_cast<size_t>(modality)].set(id);
+    } else {
+        sparse_[id] = modality;
+    }
+}
+
+void ModalityIndex::remove(NodeID id, Modality modality) {
+    if (id < MAX_DENSE_ID) {
+        bitsets_[static_cast<size_t>(modality)].reset(id);
+    } else {
+        sparse_.erase(id);
+    }
+}
+
+bool ModalityIndex::lookup(NodeID id, Modality& modality) const {
+    if (id >= MAX_DENSE_ID) {
+        auto it = sparse_.find(id);
+        if (it == sparse_.end()) return false;
+        modality = it->second;
+        return true;
+    }
+    for (size_t m = 0; m < MODALITY_COUNT; ++m) {
+        if (bitsets_[m].test(id)) {
+            modality = static_cast<Modality>(m);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ModalityIndex::partition(const std::vector<NodeID>& ids,
+                              std::array<std::vector<NodeID>, MODALITY_COUNT>& out) const {
+    for (auto& group : out) {
+        group.clear();
+    }
+    for (NodeID id : ids) {
+        Modality modality;
+        if (lookup(id, modality)) {
+            out[static_cast<size_t>(modality)].push_back(id);
+        }
+    }
+}
+
+PayloadColumn* ModalityIndex::column(Modality modality) {
+    PayloadColumn& column = columns_[static_cast<size_t>(modality)];
+    return column.stride() > 0 ? &column : nullptr;
+}
+
+const PayloadColumn* ModalityIndex::column(Modality modality) const {
+    const PayloadColumn& column = columns_[static_cast<size_t>(modality)];
+    return column.stride() > 0 ? &column : nullptr;
+}
+
+void ModalityIndex::clear() {
+    for (auto& bitset : bitsets_) {
+        bitset.clear();
+    }
+    sparse_.clear();
+    for (auto& column : columns_) {
+        column.clear();
+    }
+}
+
+} // namespace melvin
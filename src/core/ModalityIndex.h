@@ -0,0 +1,144 @@
+#pragma once
+
+#include "../include/melvin/types.h"
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace melvin {
+
+// Set of node IDs as a dense bitset: bit i is node i. Node IDs are handed out
+// in ascending order from 1, so the words stay densely used.
+class NodeBitset {
+public:
+    void set(NodeID id) {
+        size_t word = id >> 6;
+        if (word >= words_.size()) words_.resize(word + 1, 0);
+        words_[word] |= uint64_t(1) << (id & 63);
+    }
+
+    void reset(NodeID id) {
+        size_t word = id >> 6;
+        if (word < words_.size()) words_[word] &= ~(uint64_t(1) << (id & 63));
+    }
+
+    bool test(NodeID id) const {
+        size_t word = id >> 6;
+        return word < words_.size() && (words_[word] >> (id & 63)) & 1;
+    }
+
+    void clear() { words_.clear(); }
+
+    size_t word_count() const { return words_.size(); }
+    const uint64_t* words() const { return words_.data(); }
+
+    // out = a & b, one word-wise AND over the shorter of the two. This is
+    // the vectorized way to route a batch: build it as a bitset and
+    // intersect it with a modality's nodes (AtomicGraph::select_modality)
+    static void intersect(const NodeBitset& a, const NodeBitset& b, NodeBitset& out);
+
+    // fn(id) for every set bit, in ascending order
+    template <typename F>
+    void for_each(F&& fn) const {
+        for (size_t w = 0; w < words_.size(); ++w) {
+            uint64_t bits = words_[w];
+            while (bits) {
+                fn(static_cast<NodeID>((w << 6) | __builtin_ctzll(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+private:
+    std::vector<uint64_t> words_;
+};
+
+// Fixed-stride payload storage for one modality. Slots live in chunks of
+// CHUNK_SLOTS so a slot's address never moves while nodes point into it;
+// within a chunk the payloads are contiguous for batch processing.
+class PayloadColumn {
+public:
+    static constexpr size_t CHUNK_SLOTS = 256;
+
+    explicit PayloadColumn(size_t stride = 0) : stride_(stride) {}
+
+    size_t stride() const { return stride_; }
+    size_t size() const { return occupied_; }
+
+    // Reserve a slot for node `id` (reusing released slots first)
+    uint32_t acquire(NodeID id);
+    void release(uint32_t slot);
+
+    uint8_t* data(uint32_t slot) {
+        return chunks_[slot / CHUNK_SLOTS].get() + (slot % CHUNK_SLOTS) * stride_;
+    }
+
+    // fn(ids, payloads, count) for every run of occupied neighbouring slots;
+    // payloads holds count * stride() bytes
+    template <typename F>
+    void for_each_run(F&& fn) const {
+        size_t slots = slot_ids_.size();
+        size_t begin = 0;
+        while (begin < slots) {
+            if (slot_ids_[begin] == 0) {
+                ++begin;
+                continue;
+            }
+            size_t chunk_end = (begin / CHUNK_SLOTS + 1) * CHUNK_SLOTS;
+            size_t end = begin + 1;
+            while (end < slots && end < chunk_end && slot_ids_[end] != 0) ++end;
+            fn(slot_ids_.data() + begin,
+               chunks_[begin / CHUNK_SLOTS].get() + (begin % CHUNK_SLOTS) * stride_,
+               end - begin);
+            begin = end;
+        }
+    }
+
+    void clear();
+
+private:
+    size_t stride_;
+    std::vector<std::unique_ptr<uint8_t[]>> chunks_;
+    std::vector<NodeID> slot_ids_;      // Owner of each slot, 0 if free
+    std::vector<uint32_t> free_slots_;
+    size_t occupied_ = 0;
+};
+
+// Per-modality node index for AtomicGraph: one bitset of node IDs per
+// modality, plus a payload column for each modality with a fixed payload
+// size. Not synchronized; the graph guards it with its node lock.
+class ModalityIndex {
+public:
+    // IDs at or above this are kept in a hash map instead of the bitsets
+    static constexpr NodeID MAX_DENSE_ID = NodeID(1) << 24;
+
+    ModalityIndex();
+
+    void add(NodeID id, Modality modality);
+    void remove(NodeID id, Modality modality);
+
+    // False if the node isn't indexed
+    bool lookup(NodeID id, Modality& modality) const;
+
+    const NodeBitset& nodes(Modality modality) const { return bitsets_[static_cast<size_t>(modality)]; }
+
+    // Split ids by modality, dropping unknown ones. Each group keeps the
+    // order of ids, duplicates included. One lookup() per id; batches that
+    // don't need their order kept route faster through NodeBitset::intersect.
+    void partition(const std::vector<NodeID>& ids,
+                   std::array<std::vector<NodeID>, MODALITY_COUNT>& out) const;
+
+    // Column for modality, or nullptr if it has no fixed payload size
+    PayloadColumn* column(Modality modality);
+    const PayloadColumn* column(Modality modality) const;
+
+    void clear();
+
+private:
+    std::array<NodeBitset, MODALITY_COUNT> bitsets_;
+    std::unordered_map<NodeID, Modality> sparse_;
+    std::array<PayloadColumn, MODALITY_COUNT> columns_;
+};
+
+} // namespace melvin
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
+#include <atomic>
 
 namespace melvin {
 
@@ -14,8 +15,12 @@ class AtomicGraph;
 // Layout: id (8B) + payload (variable)
 class Node {
 public:
-    Node(NodeID id, const void* payload, size_t payload_size) 
-        : id_(id), payload_size_(payload_size) {
+    // Modality inferred from the payload size
+    Node(NodeID id, const void* payload, size_t payload_size)
+        : Node(id, payload, payload_size, modality_from_payload_size(payload_size)) {}
+    
+    Node(NodeID id, const void* payload, size_t payload_size, Modality modality)
+        : id_(id), payload_size_(payload_size), modality_(modality) {
         if (payload && payload_size > 0) {
             payload_ = new uint8_t[payload_size];
             memcpy(payload_, payload, payload_size);
@@ -25,7 +30,7 @@ public:
     }
     
     ~Node() {
-        if (payload_) {
+        if (payload_ && !in_column()) {
             delete[] payload_;
         }
     }
@@ -35,12 +40,17 @@ public:
     Node& operator=(const Node&) = delete;
     
     Node(Node&& other) noexcept 
-        : id_(other.id_), payload_(other.payload_), payload_size_(other.payload_size_) {
+        : id_(other.id_), payload_(other.payload_), payload_size_(other.payload_size_),
+          frequency_(other.frequency_), first_seen_(other.first_seen_),
+          last_access_(other.last_access_.load(std::memory_order_relaxed)),
+          modality_(other.modality_), column_slot_(other.column_slot_) {
         other.payload_ = nullptr;
         other.payload_size_ = 0;
+        other.column_slot_ = NO_COLUMN_SLOT;
     }
     
     NodeID id() const { return id_; }
+    Modality modality() const { return modality_; }
     
     const void* payload() const { return payload_; }
     void* payload() { return payload_; }
@@ -56,12 +66,96 @@ public:
     
     void increment_frequency() { ++frequency_; }
     
+    // Access tracking for cold-node eviction (written under shared locks)
+    void touch(Time now) { last_access_.store(now, std::memory_order_relaxed); }
+    Time last_access() const { return last_access_.load(std::memory_order_relaxed); }
+    
+    // Readers holding a PinnedNode; the graph never evicts a pinned payload.
+    // Pin only under the graph's node lock (shared is enough).
+    void pin() { pins_.fetch_add(1, std::memory_order_relaxed); }
+    void unpin() { pins_.fetch_sub(1, std::memory_order_release); }
+    bool is_pinned() const { return pins_.load(std::memory_order_acquire) != 0; }
+    
+    // Tiered storage: an evicted node keeps its size but drops the payload buffer
+    bool is_evicted() const { return payload_ == nullptr && payload_size_ > 0; }
+    
+    // A payload held in a column slot is only dropped here; the owner of the
+    // column releases the slot
+    size_t evict_payload() {
+        if (!payload_) return 0;
+        if (!in_column()) delete[] payload_;
+        payload_ = nullptr;
+        column_slot_ = NO_COLUMN_SLOT;
+        return payload_size_;
+    }
+    
+    void restore_payload(const uint8_t* data) {
+        if (payload_ || payload_size_ == 0) return;
+        payload_ = new uint8_t[payload_size_];
+        memcpy(payload_, data, payload_size_);
+    }
+    
+    // Payload column storage (see PayloadColumn): the buffer is a slot owned
+    // by the graph's column for this node's modality
+    static constexpr uint32_t NO_COLUMN_SLOT = UINT32_MAX;
+    bool in_column() const { return column_slot_ != NO_COLUMN_SLOT; }
+    uint32_t column_slot() const { return column_slot_; }
+    
+    // Copy the resident payload into `slot_data` and use it from now on
+    void move_payload_to_column(uint8_t* slot_data, uint32_t slot) {
+        if (!payload_) return;
+        memcpy(slot_data, payload_, payload_size_);
+        if (!in_column()) delete[] payload_;
+        payload_ = slot_data;
+        column_slot_ = slot;
+    }
+    
 private:
     NodeID id_;
     uint8_t* payload_;
     size_t payload_size_;
     uint32_t frequency_ = 1;
     Time first_seen_ = 0;
+    std::atomic<Time> last_access_{0};
+    std::atomic<uint32_t> pins_{0};
+    Modality modality_;
+    uint32_t column_slot_ = NO_COLUMN_SLOT;
+};
+
+// Keeps a node's payload resident and in place while held (see
+// AtomicGraph::pin_node). Release it as soon as the payload has been read:
+// a pinned node can't be evicted, so long-lived pins defeat the budget.
+// A pin doesn't keep the node itself alive across remove_node() or clear().
+class PinnedNode {
+public:
+    PinnedNode() = default;
+    explicit PinnedNode(Node* node) : node_(node) {}
+    ~PinnedNode() { reset(); }
+    
+    PinnedNode(const PinnedNode&) = delete;
+    PinnedNode& operator=(const PinnedNode&) = delete;
+    
+    PinnedNode(PinnedNode&& other) noexcept : node_(other.node_) { other.node_ = nullptr; }
+    PinnedNode& operator=(PinnedNode&& other) noexcept {
+        if (this != &other) {
+            reset();
+            node_ = other.node_;
+            other.node_ = nullptr;
+        }
+        return *this;
+    }
+    
+    void reset() {
+        if (node_) node_->unpin();
+        node_ = nullptr;
+    }
+    
+    Node* get() const { return node_; }
+    Node* operator->() const { return node_; }
+    explicit operator bool() const { return node_ != nullptr; }
+    
+private:
+    Node* node_ = nullptr;
 };
 
 } // namespace melvin
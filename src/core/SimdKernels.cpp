@@ -0,0 +1,126 @@
+#include "SimdKernels.h"
+
+#if defined(MELVIN_SIMD_SSE2)
+#include <emmintrin.h>
+#elif defined(MELVIN_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace melvin {
+namespace simd {
+
+uint64_t sad_u8(const uint8_t* a, const uint8_t* b, size_t n) {
+    uint64_t total = 0;
+    size_t i = 0;
+
+#if defined(MELVIN_SIMD_SSE2)
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        acc = _mm_add_epi64(acc, _mm_sad_epu8(va, vb));  // Two 64-bit partial sums
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    total = lanes[0] + lanes[1];
+#elif defined(MELVIN_SIMD_NEON)
+    uint32x4_t acc = vdupq_n_u32(0);
+    size_t since_flush = 0;
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t diff = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        acc = vpadalq_u16(acc, vpaddlq_u8(diff));
+        // Each lane grows by at most 1020 per step; flush well before 2^32
+        if (++since_flush == (1u << 20)) {
+            total += vaddvq_u32(acc);
+            acc = vdupq_n_u32(0);
+            since_flush = 0;
+        }
+    }
+    total += vaddvq_u32(acc);
+#endif
+
+    for (; i < n; ++i) {
+        total += (a[i] > b[i]) ? (a[i] - b[i]) : (b[i] - a[i]);
+    }
+
+    return total;
+}
+
+uint64_t sum_squares_s16(const int16_t* samples, size_t n) {
+    uint64_t total = 0;
+    size_t i = 0;
+
+#if defined(MELVIN_SIMD_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = _mm_setzero_si128();
+    for (; i + 8 <= n; i += 8) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + i));
+        // Pair sums are <= 2^31, so read them as unsigned before widening
+        __m128i sq = _mm_madd_epi16(x, x);
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(sq, zero));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(sq, zero));
+    }
+    alignas(16) uint64_t lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    total = lanes[0] + lanes[1];
+#elif defined(MELVIN_SIMD_NEON)
+    int64x2_t acc = vdupq_n_s64(0);
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t x = vld1q_s16(samples + i);
+        acc = vpadalq_s32(acc, vmull_s16(vget_low_s16(x), vget_low_s16(x)));
+        acc = vpadalq_s32(acc, vmull_s16(vget_high_s16(x), vget_high_s16(x)));
+    }
+    total = static_cast<uint64_t>(vaddvq_s64(acc));
+#endif
+
+    for (; i < n; ++i) {
+        int32_t s = samples[i];
+        total += static_cast<uint64_t>(s * s);
+    }
+
+    return total;
+}
+
+uint64_t sad_u8_2d(const uint8_t* a, const uint8_t* b,
+                   size_t row_bytes, size_t rows, size_t stride) {
+    uint64_t total = 0;
+    for (size_t r = 0; r < rows; ++r) {
+        total += sad_u8(a + r * stride, b + r * stride, row_bytes);
+    }
+    return total;
+}
+
+void scale_u16(uint16_t* w, uint16_t factor_q16, size_t n) {
+    size_t i = 0;
+
+#if defined(MELVIN_SIMD_SSE2)
+    const __m128i vf = _mm_set1_epi16(static_cast<short>(factor_q16));
+    for (; i + 8 <= n; i += 8) {
+        __m128i* p = reinterpret_cast<__m128i*>(w + i);
+        _mm_storeu_si128(p, _mm_mulhi_epu16(_mm_loadu_si128(p), vf));
+    }
+#elif defined(MELVIN_SIMD_NEON)
+    const uint16x4_t vf = vdup_n_u16(factor_q16);
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t x = vld1q_u16(w + i);
+        uint16x4_t lo = vshrn_n_u32(vmull_u16(vget_low_u16(x), vf), 16);
+        uint16x4_t hi = vshrn_n_u32(vmull_u16(vget_high_u16(x), vf), 16);
+        vst1q_u16(w + i, vcombine_u16(lo, hi));
+    }
+#endif
+
+    for (; i < n; ++i) {
+        w[i] = static_cast<uint16_t>((static_cast<uint32_t>(w[i]) * factor_q16) >> 16);
+    }
+}
+
+size_t count_zero_u16(const uint16_t* w, size_t n) {
+    size_t zeros = 0;
+    for (size_t i = 0; i < n; ++i) {
+        zeros += (w[i] == 0);
+    }
+    return zeros;
+}
+
+} // namespace simd
+} // namespace melvin
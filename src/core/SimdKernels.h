@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+// Pick the widest integer SIMD path the target guarantees without extra flags
+// (SSE2 is baseline on x86-64, NEON is baseline on aarch64 / Jetson).
+// The NEON path uses AArch64 across-vector adds, so 32-bit ARM stays scalar.
+#if defined(__SSE2__) || defined(_M_X64)
+#define MELVIN_SIMD_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define MELVIN_SIMD_NEON 1
+#endif
+
+namespace melvin {
+namespace simd {
+
+// Sum of absolute differences between two byte buffers (psadbw / vabd)
+uint64_t sad_u8(const uint8_t* a, const uint8_t* b, size_t n);
+
+// Sum of squares of int16 samples, exact in 64 bits (pmaddwd / vmlal)
+uint64_t sum_squares_s16(const int16_t* samples, size_t n);
+
+// Strided 2D SAD: `rows` rows of `row_bytes` bytes, `stride` bytes apart
+uint64_t sad_u8_2d(const uint8_t* a, const uint8_t* b,
+                   size_t row_bytes, size_t rows, size_t stride);
+
+// Packed uint16 fixed-point lanes (edge weights, 65535 == 1.0)
+
+// w[i] = (w[i] * factor_q16) >> 16, factor_q16 in [0, 65535] (decay)
+void scale_u16(uint16_t* w, uint16_t factor_q16, size_t n);
+
+// Number of zero lanes
+size_t count_zero_u16(const uint16_t* w, size_t n);
+
+} // namespace simd
+} // namespace melvin
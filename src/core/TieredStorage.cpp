@@ -0,0 +1,104 @@
+#include "TieredStorage.h"
+
+namespace melvin {
+
+TieredStorage::TieredStorage(const TieredStorageConfig& config)
+    : config_(config), file_(nullptr), end_offset_(0),
+      evictions_(0), faults_(0), bytes_evicted_(0), bytes_faulted_(0) {
+}
+
+TieredStorage::~TieredStorage() {
+    if (file_) {
+        std::fclose(file_);
+    }
+}
+
+bool TieredStorage::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_) {
+        return true;
+    }
+    file_ = std::fopen(config_.segment_path.c_str(), "w+b");
+    end_offset_ = 0;
+    slots_.clear();
+    return file_ != nullptr;
+}
+
+bool TieredStorage::store(NodeID id, const void* payload, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return false;
+    }
+
+    auto it = slots_.find(id);
+    if (it != slots_.end() && it->second.size == size) {
+        return true;  // Already on disk from an earlier eviction
+    }
+
+    if (std::fseek(file_, static_cast<long>(end_offset_), SEEK_SET) != 0 ||
+        std::fwrite(payload, 1, size, file_) != size) {
+        return false;
+    }
+
+    slots_[id] = {end_offset_, size};
+    end_offset_ += size;
+    return true;
+}
+
+bool TieredStorage::load(NodeID id, void* dst, size_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_) {
+        return false;
+    }
+
+    auto it = slots_.find(id);
+    if (it == slots_.end() || it->second.size != size) {
+        return false;
+    }
+
+    std::fflush(file_);
+    if (std::fseek(file_, static_cast<long>(it->second.offset), SEEK_SET) != 0) {
+        return false;
+    }
+    return std::fread(dst, 1, size, file_) == size;
+}
+
+void TieredStorage::forget(NodeID id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.erase(id);
+}
+
+bool TieredStorage::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    slots_.clear();
+    end_offset_ = 0;
+    if (!file_) {
+        return false;
+    }
+    file_ = std::freopen(config_.segment_path.c_str(), "w+b", file_);
+    return file_ != nullptr;
+}
+
+void TieredStorage::record_eviction(size_t bytes) {
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+    bytes_evicted_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void TieredStorage::record_fault(size_t bytes) {
+    faults_.fetch_add(1, std::memory_order_relaxed);
+    bytes_faulted_.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+TieredStorage::Stats TieredStorage::stats() const {
+    Stats s;
+    s.evictions = evictions_.load(std::memory_order_relaxed);
+    s.faults = faults_.load(std::memory_order_relaxed);
+    s.bytes_evicted = bytes_evicted_.load(std::memory_order_relaxed);
+    s.bytes_faulted = bytes_faulted_.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    s.segment_bytes = end_offset_;
+    return s;
+}
+
+} // namespace melvin
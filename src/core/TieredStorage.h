@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../include/melvin/types.h"
+#include "../include/melvin/config.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace melvin {
+
+struct TieredStorageConfig {
+    std::string segment_path = "data/payload_segment.bin";
+    size_t memory_budget_bytes = PAYLOAD_MEMORY_BUDGET;  // Resident payload bytes
+    float low_water_ratio = 0.9f;                       // Evict down to this fraction of budget
+    Time min_idle_ms = EVICTION_MIN_IDLE_MS;            // Never evict nodes touched more recently
+    Time frequency_credit_ms = 1000;                    // Each use keeps a node warm this much longer
+};
+
+// Cold tier for node payloads: an append-only segment file plus an index of
+// where each evicted payload lives. Payloads are immutable once created, so a
+// node that is evicted, faulted back and evicted again reuses its old slot.
+class TieredStorage {
+public:
+    struct Stats {
+        size_t evictions = 0;
+        size_t faults = 0;
+        size_t bytes_evicted = 0;
+        size_t bytes_faulted = 0;
+        size_t segment_bytes = 0;
+    };
+
+    explicit TieredStorage(const TieredStorageConfig& config);
+    ~TieredStorage();
+
+    // Truncates any previous segment; payloads are only valid for this process
+    bool open();
+    bool is_open() const { return file_ != nullptr; }
+
+    const TieredStorageConfig& config() const { return config_; }
+
+    // Write a payload to the segment (or reuse its slot); false on I/O error
+    bool store(NodeID id, const void* payload, size_t size);
+
+    // Read an evicted payload back; false if unknown or on I/O error
+    bool load(NodeID id, void* dst, size_t size);
+
+    // Forget a node's slot (space is reclaimed only by a new segment)
+    void forget(NodeID id);
+
+    // Forget every slot and truncate the segment (the graph was cleared)
+    bool reset();
+
+    void record_eviction(size_t bytes);
+    void record_fault(size_t bytes);
+    Stats stats() const;
+
+private:
+    struct Slot {
+        uint64_t offset;
+        size_t size;
+    };
+
+    TieredStorageConfig config_;
+    std::FILE* file_;
+    uint64_t end_offset_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<NodeID, Slot> slots_;
+
+    std::atomic<size_t> evictions_;
+    std::atomic<size_t> faults_;
+    std::atomic<size_t> bytes_evicted_;
+    std::atomic<size_t> bytes_faulted_;
+};
+
+} // namespace melvin
@@ -1,6 +1,7 @@
 #include "LeapConnections.h"
 #include "../include/melvin/types.h"
 #include "../include/melvin/config.h"
+#include "../connections/Weight.h"
 #include <algorithm>
 #include <set>
 #include <iterator>
@@ -45,7 +46,7 @@ bool LeapConnections::create_leap_connection(NodeID n1, NodeID n2, float thresho
     }
     
     // Create bidirectional connection with averaged weight
-    EdgeWeight weight = static_cast<EdgeWeight>(avg_weight * 65535.0f);
+    EdgeWeight weight = Weight::normalize(avg_weight);
     graph_->add_edge(n1, n2, weight);
     graph_->add_edge(n2, n1, weight);
     
@@ -79,7 +80,7 @@ float LeapConnections::avg_weight_to_target(NodeID n1, NodeID n2, NodeID target)
     EdgeWeight w2 = graph_->get_edge_weight(n2, target);
     
     // Normalize to [0, 1] and average
-    float avg = ((w1 / 65535.0f) + (w2 / 65535.0f)) / 2.0f;
+    float avg = Weight::to_float(Weight::average(w1, w2));
     return avg;
 }
 
@@ -1,5 +1,6 @@
 #include "LeapNodes.h"
 #include "../include/melvin/types.h"
+#include "../connections/Weight.h"
 #include <algorithm>
 #include <numeric>
 
@@ -74,8 +75,9 @@ float LeapNodes::triangle_weight_sum(NodeID n1, NodeID n2, NodeID n3) const {
     EdgeWeight w31 = graph_->get_edge_weight(n3, n1);
     EdgeWeight w32 = graph_->get_edge_weight(n3, n2);
     
-    // Normalize to [0, 1] range before summing
-    float sum = (w12 + w13 + w23 + w21 + w31 + w32) / 65535.0f;
+    // Sum in integers, normalize to [0, 1] units once
+    uint32_t raw = static_cast<uint32_t>(w12) + w13 + w23 + w21 + w31 + w32;
+    float sum = Weight::sum_to_float(raw);
     return sum;
 }
 
@@ -1,27 +1,36 @@
 #include "AdaptiveFilter.h"
+#include "../core/SimdKernels.h"
 #include <cmath>
 #include <cstring>
 #include <algorithm>
 
 namespace melvin {
 
-AdaptiveFilter::AdaptiveFilter() {
-    last_frame_.resize(768);  // VISION_PAYLOAD_SIZE
+AdaptiveFilter::AdaptiveFilter(size_t frame_width, size_t frame_height, size_t channels)
+    : frame_width_(frame_width),
+      frame_height_(frame_height),
+      channels_(channels),
+      frame_bytes_(frame_width * frame_height * channels),
+      row_bytes_(frame_width * channels),
+      has_last_frame_(false) {
+    frame_sad_budget_ = static_cast<uint64_t>(MOTION_THRESHOLD * 255.0f * frame_bytes_);
+    size_t block_bytes = std::min(frame_width_, BLOCK_SIZE) * std::min(frame_height_, BLOCK_SIZE) * channels_;
+    block_sad_budget_ = static_cast<uint64_t>(BLOCK_MOTION_THRESHOLD * 255.0f * block_bytes);
+    
+    last_frame_.resize(frame_bytes_);
     last_audio_.resize(320);  // AUDIO_PAYLOAD_SIZE / 2
 }
 
 bool AdaptiveFilter::should_capture_vision(const uint8_t* new_frame, size_t frame_size) {
-    if (!new_frame || frame_size < 768) return false;
+    if (!new_frame || frame_size < frame_bytes_) return false;
     
     // Check if significant motion
-    if (last_frame_.empty()) {
+    if (!has_last_frame_) {
         update_frame(new_frame);
         return true;  // First frame always capture
     }
     
-    float difference = calculate_frame_difference(new_frame, last_frame_.data());
-    
-    if (difference > MOTION_THRESHOLD) {
+    if (detect_motion(new_frame)) {
         update_frame(new_frame);
         return true;
     }
@@ -46,7 +55,8 @@ bool AdaptiveFilter::should_capture_audio(const int16_t* new_audio, size_t audio
 }
 
 void AdaptiveFilter::update_frame(const uint8_t* frame) {
-    std::memcpy(last_frame_.data(), frame, 768);
+    std::memcpy(last_frame_.data(), frame, frame_bytes_);
+    has_last_frame_ = true;
 }
 
 void AdaptiveFilter::update_audio(const int16_t* audio, size_t size) {
@@ -54,28 +64,50 @@ void AdaptiveFilter::update_audio(const int16_t* audio, size_t size) {
     std::memcpy(last_audio_.data(), audio, copy_size * sizeof(int16_t));
 }
 
-float AdaptiveFilter::calculate_frame_difference(const uint8_t* frame1, const uint8_t* frame2) const {
-    float total_diff = 0.0f;
-    size_t pixels = 16 * 16;
+bool AdaptiveFilter::detect_motion(const uint8_t* frame) const {
+    const uint8_t* last = last_frame_.data();
+    
+    // Level 1: coarse pass over every COARSE_ROW_STEP-th row of a large
+    // frame. The sampled SAD is a lower bound on the exact one, so a frame
+    // that is over budget on the sampled rows alone is accepted here; an
+    // extrapolated estimate could accept frames the exact pass rejects.
+    // Frames under COARSE_MIN_BYTES go straight to the exact pass.
+    if (frame_bytes_ >= COARSE_MIN_BYTES) {
+        uint64_t sampled = 0;
+        for (size_t row = 0; row < frame_height_; row += COARSE_ROW_STEP) {
+            sampled += simd::sad_u8(frame + row * row_bytes_, last + row * row_bytes_, row_bytes_);
+            if (sampled > frame_sad_budget_) {
+                return true;
+            }
+        }
+    }
     
-    for (size_t i = 0; i < pixels * 3; ++i) {
-        int diff = abs((int)frame1[i] - (int)frame2[i]);
-        total_diff += (float)diff / 255.0f;
+    // Level 2: exact pass block by block. Exit as soon as one block shows
+    // localized motion or the frame-wide SAD budget is exceeded.
+    uint64_t total = 0;
+    for (size_t by = 0; by < frame_height_; by += BLOCK_SIZE) {
+        size_t rows = std::min(BLOCK_SIZE, frame_height_ - by);
+        for (size_t bx = 0; bx < frame_width_; bx += BLOCK_SIZE) {
+            size_t cols = std::min(BLOCK_SIZE, frame_width_ - bx);
+            size_t offset = by * row_bytes_ + bx * channels_;
+            uint64_t block_sad = simd::sad_u8_2d(frame + offset, last + offset,
+                                                 cols * channels_, rows, row_bytes_);
+            total += block_sad;
+            if (block_sad > block_sad_budget_ || total > frame_sad_budget_) {
+                return true;
+            }
+        }
     }
     
-    return total_diff / (pixels * 3);  // Average difference per pixel
+    return false;
 }
 
 float AdaptiveFilter::calculate_audio_energy(const int16_t* audio, size_t size) const {
-    float energy = 0.0f;
-    
-    for (size_t i = 0; i < size && i < 320; ++i) {
-        float sample = (float)audio[i] / 32768.0f;
-        energy += sample * sample;
-    }
+    if (size == 0) return 0.0f;
     
-    return energy / size;  // RMS energy
+    // Integer sum of squares, normalized once instead of per sample
+    uint64_t sum_sq = simd::sum_squares_s16(audio, size);
+    return static_cast<float>(static_cast<double>(sum_sq) / (32768.0 * 32768.0) / size);  // RMS energy
 }
 
 } // namespace melvin
-
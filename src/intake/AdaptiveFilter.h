@@ -10,7 +10,8 @@ namespace melvin {
 // Filters input to only capture significant changes
 class AdaptiveFilter {
 public:
-    AdaptiveFilter();
+    // Frame geometry defaults to the 16x16 RGB vision payload
+    AdaptiveFilter(size_t frame_width = 16, size_t frame_height = 16, size_t channels = 3);
     
     // Check if vision frame should be captured (significant change?)
     bool should_capture_vision(const uint8_t* new_frame, size_t frame_size);
@@ -22,16 +23,36 @@ public:
     void update_frame(const uint8_t* frame);
     void update_audio(const int16_t* audio, size_t size);
     
+    size_t frame_bytes() const { return frame_bytes_; }
+    
+    // Frame-wide SAD a frame must exceed to count as motion
+    uint64_t frame_sad_budget() const { return frame_sad_budget_; }
+    
 private:
+    size_t frame_width_;
+    size_t frame_height_;
+    size_t channels_;
+    size_t frame_bytes_;
+    size_t row_bytes_;
+    bool has_last_frame_;
+    
+    // SAD budgets derived from the float thresholds (integer compare in the hot path)
+    uint64_t frame_sad_budget_;
+    uint64_t block_sad_budget_;
+    
     std::vector<uint8_t> last_frame_;
     std::vector<int16_t> last_audio_;
     
-    float calculate_frame_difference(const uint8_t* frame1, const uint8_t* frame2) const;
+    // Multi-resolution change test against the last captured frame
+    bool detect_motion(const uint8_t* frame) const;
     float calculate_audio_energy(const int16_t* audio, size_t size) const;
     
     static constexpr float MOTION_THRESHOLD = 0.001f;  // Very low threshold to capture all motion
+    static constexpr float BLOCK_MOTION_THRESHOLD = 0.05f;  // Localized motion inside one block
     static constexpr float AUDIO_THRESHOLD = 0.001f;  // Very low threshold to capture all audio
+    static constexpr size_t BLOCK_SIZE = 16;  // Block edge in pixels
+    static constexpr size_t COARSE_ROW_STEP = 4;  // Coarse pass samples every 4th row
+    static constexpr size_t COARSE_MIN_BYTES = 64 * 1024;  // Smaller frames skip the coarse pass
 };
 
 } // namespace melvin
-
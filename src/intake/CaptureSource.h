@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../include/melvin/types.h"
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+
+namespace melvin {
+
+// One timestamped sensor sample: a 16x16 RGB frame or a 20ms audio chunk
+struct CaptureEvent {
+    Modality modality = Modality::OTHER;
+    uint64_t timestamp_us = 0;   // Capture time (trace time when replaying)
+    uint64_t arrival_us = 0;     // Set by MultimodalIntake when queued
+    uint32_t size = 0;
+    std::array<uint8_t, MAX_PAYLOAD_SIZE> payload;
+
+    void set_payload(const void* data, size_t bytes) {
+        size = static_cast<uint32_t>(bytes < payload.size() ? bytes : payload.size());
+        std::memcpy(payload.data(), data, size);
+    }
+};
+
+// Producer of capture events (camera + microphone, a recorded trace, ...).
+// Events are handed to the sink on the source's own threads, at most one
+// thread per modality. The sink returns false when the event's queue is
+// full; live sources drop the event, replay sources may retry.
+class CaptureSource {
+public:
+    using Sink = std::function<bool(const CaptureEvent&)>;
+
+    virtual ~CaptureSource() = default;
+
+    virtual bool start(Sink sink) = 0;
+    virtual void stop() = 0;
+
+    // True once a finite source (trace) has delivered its last event
+    virtual bool finished() const { return false; }
+};
+
+// Bounded lock-free single-producer / single-consumer ring. The consumer
+// side may move between threads as long as only one drains at a time.
+template <typename T>
+class CaptureQueue {
+public:
+    explicit CaptureQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity + 1) size <<= 1;
+        mask_ = size - 1;
+        slots_.reset(new T[size]);
+    }
+
+    bool push(const T& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t next = (tail + 1) & mask_;
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;  // Full
+        }
+        slots_[tail] = item;
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;  // Empty
+        }
+        item = slots_[head];
+        head_.store((head + 1) & mask_, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+} // namespace melvin
@@ -0,0 +1,167 @@
+#include "CaptureTrace.h"
+#include <chrono>
+#include <iostream>
+
+namespace melvin {
+
+namespace {
+
+constexpr char TRACE_MAGIC[4] = {'M', 'C', 'T', 'R'};
+constexpr uint64_t LOOP_GAP_US = 33000;  // One frame period between replay loops
+
+template <typename T>
+void write_value(std::ofstream& file, T value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+bool read_value(std::ifstream& file, T& value) {
+    file.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return file.gcount() == static_cast<std::streamsize>(sizeof(T));
+}
+
+} // namespace
+
+bool CaptureTraceWriter::open(const std::string& path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    file_.open(path, std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        return false;
+    }
+    file_.write(TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    write_value<uint32_t>(file_, VERSION);
+    events_written_ = 0;
+    return file_.good();
+}
+
+void CaptureTraceWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_.is_open()) {
+        file_.close();
+    }
+}
+
+void CaptureTraceWriter::write(const CaptureEvent& event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!file_.is_open()) {
+        return;
+    }
+    write_value<uint8_t>(file_, static_cast<uint8_t>(event.modality));
+    write_value<uint32_t>(file_, event.size);
+    write_value<uint64_t>(file_, event.timestamp_us);
+    file_.write(reinterpret_cast<const char*>(event.payload.data()), event.size);
+    events_written_++;
+}
+
+CaptureTraceSource::CaptureTraceSource(const std::string& path, Speed speed, size_t loops)
+    : path_(path), speed_(speed), loops_(loops > 0 ? loops : 1) {
+}
+
+CaptureTraceSource::~CaptureTraceSource() {
+    stop();
+}
+
+bool CaptureTraceSource::load() {
+    std::ifstream file(path_, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    file.read(magic, sizeof(magic));
+    if (file.gcount() != sizeof(magic) || std::memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0 ||
+        !read_value(file, version) || version != CaptureTraceWriter::VERSION) {
+        std::cerr << "Not a capture trace: " << path_ << "\n";
+        return false;
+    }
+
+    events_.clear();
+    while (true) {
+        uint8_t modality;
+        uint32_t size;
+        uint64_t timestamp_us;
+        if (!read_value(file, modality)) {
+            break;  // Clean end of trace
+        }
+        CaptureEvent event;
+        if (!read_value(file, size) || !read_value(file, timestamp_us) ||
+            modality >= MODALITY_COUNT || size > event.payload.size()) {
+            std::cerr << "Truncated or corrupt capture trace: " << path_ << "\n";
+            return false;
+        }
+        file.read(reinterpret_cast<char*>(event.payload.data()), size);
+        if (file.gcount() != static_cast<std::streamsize>(size)) {
+            std::cerr << "Truncated or corrupt capture trace: " << path_ << "\n";
+            return false;
+        }
+        event.modality = static_cast<Modality>(modality);
+        event.size = size;
+        event.timestamp_us = timestamp_us;
+        events_.push_back(event);
+    }
+
+    loaded_ = true;
+    return true;
+}
+
+bool CaptureTraceSource::start(Sink sink) {
+    if (running_.load() || (!loaded_ && !load())) {
+        return false;
+    }
+    sink_ = std::move(sink);
+    finished_.store(false);
+    running_.store(true);
+    thread_ = std::thread(&CaptureTraceSource::replay_loop, this);
+    return true;
+}
+
+void CaptureTraceSource::stop() {
+    running_.store(false);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void CaptureTraceSource::replay_loop() {
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    uint64_t loop_offset_us = 0;
+
+    for (size_t loop = 0; loop < loops_ && running_.load(); ++loop) {
+        uint64_t first_us = events_.empty() ? 0 : events_.front().timestamp_us;
+        uint64_t last_us = first_us;
+
+        for (const CaptureEvent& recorded : events_) {
+            if (!running_.load()) {
+                break;
+            }
+            CaptureEvent event = recorded;
+            event.timestamp_us = loop_offset_us + (recorded.timestamp_us - first_us);
+            last_us = recorded.timestamp_us;
+
+            if (speed_ == Speed::REAL_TIME) {
+                std::this_thread::sleep_until(start + std::chrono::microseconds(event.timestamp_us));
+                if (!sink_(event)) {
+                    events_dropped_++;  // Same as a live source falling behind
+                    continue;
+                }
+            } else {
+                bool accepted = sink_(event);
+                while (!accepted && running_.load()) {
+                    std::this_thread::yield();  // Lossless: wait for the intake
+                    accepted = sink_(event);
+                }
+                if (!accepted) {
+                    break;
+                }
+            }
+            events_replayed_++;
+        }
+        loop_offset_us += (last_us - first_us) + LOOP_GAP_US;
+    }
+
+    finished_.store(true);
+}
+
+} // namespace melvin
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CaptureSource.h"
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace melvin {
+
+// Capture trace file: a header ("MCTR", uint32 version) followed by one
+// record per event: uint8 modality, uint32 payload size, uint64 capture
+// timestamp (us), payload bytes. Little-endian, as written by the host.
+
+// Appends events to a trace file (thread-safe)
+class CaptureTraceWriter {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    bool open(const std::string& path);
+    void close();
+    bool is_open() const { return file_.is_open(); }
+
+    void write(const CaptureEvent& event);
+    size_t events_written() const { return events_written_; }
+
+private:
+    std::ofstream file_;
+    std::mutex mutex_;
+    size_t events_written_ = 0;
+};
+
+// Replays a trace file as a capture source, on one thread
+class CaptureTraceSource : public CaptureSource {
+public:
+    enum class Speed {
+        REAL_TIME,  // Keep the recorded spacing between events
+        MAX_SPEED   // As fast as the intake accepts them, nothing dropped
+    };
+
+    explicit CaptureTraceSource(const std::string& path, Speed speed = Speed::REAL_TIME, size_t loops = 1);
+    ~CaptureTraceSource() override;
+
+    // Reads the whole trace up front; false if missing or malformed
+    bool load();
+    size_t event_count() const { return events_.size(); }
+
+    bool start(Sink sink) override;
+    void stop() override;
+    bool finished() const override { return finished_.load(); }
+
+    size_t events_replayed() const { return events_replayed_.load(); }
+    size_t events_dropped() const { return events_dropped_.load(); }
+
+private:
+    std::string path_;
+    Speed speed_;
+    size_t loops_;
+    std::vector<CaptureEvent> events_;
+    bool loaded_ = false;
+
+    Sink sink_;
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> finished_{false};
+    std::atomic<size_t> events_replayed_{0};
+    std::atomic<size_t> events_dropped_{0};
+
+    void replay_loop();
+};
+
+} // namespace melvin
@@ -1,6 +1,8 @@
 #pragma once
 #include "../include/melvin/types.h"
 #include <atomic>
+#include <functional>
+#include <mutex>
 #include <thread>
 #include <vector>
 #include <memory>
@@ -28,6 +30,10 @@ public:
     // Check if capture is active
     bool is_active() const { return active_.load(); }
     
+    // Called on the capture threads with every new frame / chunk (set before start)
+    void set_vision_callback(std::function<void(const uint8_t*, size_t)> callback) { vision_callback_ = std::move(callback); }
+    void set_audio_callback(std::function<void(const int16_t*, size_t)> callback) { audio_callback_ = std::move(callback); }
+    
 private:
     std::atomic<bool> active_;
     std::thread camera_thread_;
@@ -39,6 +45,9 @@ private:
     std::mutex vision_mutex_;
     std::mutex audio_mutex_;
     
+    std::function<void(const uint8_t*, size_t)> vision_callback_;
+    std::function<void(const int16_t*, size_t)> audio_callback_;
+    
 #ifdef __APPLE__
     void* impl_;  // Pointer to HardwareCaptureImpl (hidden to avoid Objective-C in header)
 #endif
@@ -181,9 +181,12 @@ bool HardwareCapture::get_latest_audio_chunk(int16_t* buffer, size_t buffer_size
 }
 
 void HardwareCapture::capture_camera() {
+    std::vector<uint8_t> frame_copy(VISION_PAYLOAD_SIZE);
+    
     while (active_.load()) {
         {
             std::lock_guard<std::mutex> lock(vision_mutex_);
+            bool got_real_frame = false;
             
 #ifdef __APPLE__
             // Try to get frame from real hardware
@@ -194,23 +197,34 @@ void HardwareCapture::capture_camera() {
                     if (frame) {
                         // Got real frame!
                         std::memcpy(latest_vision_.data(), frame, VISION_PAYLOAD_SIZE);
-                        continue; // Skip simulated data
+                        got_real_frame = true;
                     }
                 }
             }
 #endif
             
-            // Fallback: Generate simulated moving pattern
-            static size_t frame = 0;
-            frame++;
-            for (size_t y = 0; y < 16; ++y) {
-                for (size_t x = 0; x < 16; ++x) {
-                    size_t idx = (y * 16 + x) * 3;
-                    latest_vision_[idx + 0] = ((x + frame) % 100) + 50; // R
-                    latest_vision_[idx + 1] = ((y + frame) % 100) + 50; // G
-                    latest_vision_[idx + 2] = ((x + y + frame) % 100) + 50; // B
+            if (!got_real_frame) {
+                // Fallback: Generate simulated moving pattern
+                static size_t frame = 0;
+                frame++;
+                for (size_t y = 0; y < 16; ++y) {
+                    for (size_t x = 0; x < 16; ++x) {
+                        size_t idx = (y * 16 + x) * 3;
+                        latest_vision_[idx + 0] = ((x + frame) % 100) + 50; // R
+                        latest_vision_[idx + 1] = ((y + frame) % 100) + 50; // G
+                        latest_vision_[idx + 2] = ((x + y + frame) % 100) + 50; // B
+                    }
                 }
             }
+            
+            if (vision_callback_) {
+                std::memcpy(frame_copy.data(), latest_vision_.data(), VISION_PAYLOAD_SIZE);
+            }
+        }
+        
+        // Push the new frame outside the lock
+        if (vision_callback_) {
+            vision_callback_(frame_copy.data(), frame_copy.size());
         }
         
         std::this_thread::sleep_for(std::chrono::milliseconds(33)); // ~30fps
@@ -218,9 +232,12 @@ void HardwareCapture::capture_camera() {
 }
 
 void HardwareCapture::capture_audio() {
+    std::vector<int16_t> chunk_copy(AUDIO_PAYLOAD_SIZE / 2);
+    
     while (active_.load()) {
         {
             std::lock_guard<std::mutex> lock(audio_mutex_);
+            bool got_real_audio = false;
             
 #ifdef __APPLE__
             // Try to get audio from real hardware
@@ -231,21 +248,32 @@ void HardwareCapture::capture_audio() {
                     if (audio) {
                         // Got real audio!
                         std::memcpy(latest_audio_.data(), audio, AUDIO_PAYLOAD_SIZE / 2 * sizeof(int16_t));
-                        continue; // Skip simulated data
+                        got_real_audio = true;
                     }
                 }
             }
 #endif
             
-            // Fallback: Generate simulated sine wave
-            static size_t sample = 0;
-            for (size_t i = 0; i < AUDIO_PAYLOAD_SIZE / 2; ++i) {
-                double phase = (sample + i) * 0.01;
-                latest_audio_[i] = static_cast<int16_t>(sin(phase) * 10000);
-                sample++;
+            if (!got_real_audio) {
+                // Fallback: Generate simulated sine wave
+                static size_t sample = 0;
+                for (size_t i = 0; i < AUDIO_PAYLOAD_SIZE / 2; ++i) {
+                    double phase = (sample + i) * 0.01;
+                    latest_audio_[i] = static_cast<int16_t>(sin(phase) * 10000);
+                    sample++;
+                }
+            }
+            
+            if (audio_callback_) {
+                std::memcpy(chunk_copy.data(), latest_audio_.data(), AUDIO_PAYLOAD_SIZE);
             }
         }
         
+        // Push the new chunk outside the lock
+        if (audio_callback_) {
+            audio_callback_(chunk_copy.data(), chunk_copy.size());
+        }
+        
         std::this_thread::sleep_for(std::chrono::milliseconds(20)); // 20ms chunks
     }
 }
@@ -0,0 +1,39 @@
+#include "HardwareCaptureSource.h"
+
+namespace melvin {
+
+HardwareCaptureSource::HardwareCaptureSource() : hardware_(std::make_unique<HardwareCapture>()) {
+}
+
+HardwareCaptureSource::~HardwareCaptureSource() {
+    stop();
+}
+
+bool HardwareCaptureSource::start(Sink sink) {
+    sink_ = std::move(sink);
+    start_time_ = std::chrono::steady_clock::now();
+    hardware_->set_vision_callback([this](const uint8_t* frame, size_t bytes) {
+        push(Modality::VISION, frame, bytes);
+    });
+    hardware_->set_audio_callback([this](const int16_t* samples, size_t count) {
+        push(Modality::AUDIO, samples, count * sizeof(int16_t));
+    });
+    return hardware_->start();
+}
+
+void HardwareCaptureSource::stop() {
+    hardware_->stop();
+}
+
+void HardwareCaptureSource::push(Modality modality, const void* data, size_t bytes) {
+    CaptureEvent event;
+    event.modality = modality;
+    event.timestamp_us = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time_).count());
+    event.set_payload(data, bytes);
+    if (!sink_(event)) {
+        events_dropped_++;
+    }
+}
+
+} // namespace melvin
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CaptureSource.h"
+#include "HardwareCapture.h"
+#include <chrono>
+
+namespace melvin {
+
+// Camera + microphone as a capture source: every frame / chunk the
+// capture threads produce is pushed as it arrives. Events the intake
+// can't take right away are dropped (a live source can't wait).
+class HardwareCaptureSource : public CaptureSource {
+public:
+    HardwareCaptureSource();
+    ~HardwareCaptureSource() override;
+
+    bool start(Sink sink) override;
+    void stop() override;
+
+    size_t events_dropped() const { return events_dropped_.load(); }
+
+private:
+    std::unique_ptr<HardwareCapture> hardware_;
+    Sink sink_;
+    std::chrono::steady_clock::time_point start_time_;
+    std::atomic<size_t> events_dropped_{0};
+
+    void push(Modality modality, const void* data, size_t bytes);
+};
+
+} // namespace melvin
@@ -33,7 +33,7 @@ void IntakeManager::shutdown_all() {
 
 NodeID IntakeManager::create_vision_node(const uint8_t* pixel_data) {
     NodeID id = allocate_next_id();
-    auto node = std::make_unique<Node>(id, pixel_data, VISION_PAYLOAD_SIZE);
+    auto node = std::make_unique<Node>(id, pixel_data, VISION_PAYLOAD_SIZE, Modality::VISION);
     
     if (graph_->add_node(std::move(node))) {
         latest_node_id_ = id;
@@ -45,7 +45,7 @@ NodeID IntakeManager::create_vision_node(const uint8_t* pixel_data) {
 
 NodeID IntakeManager::create_audio_node(const int16_t* audio_data) {
     NodeID id = allocate_next_id();
-    auto node = std::make_unique<Node>(id, audio_data, AUDIO_PAYLOAD_SIZE);
+    auto node = std::make_unique<Node>(id, audio_data, AUDIO_PAYLOAD_SIZE, Modality::AUDIO);
     
     if (graph_->add_node(std::move(node))) {
         latest_node_id_ = id;
@@ -57,7 +57,7 @@ NodeID IntakeManager::create_audio_node(const int16_t* audio_data) {
 
 NodeID IntakeManager::create_text_node(char c) {
     NodeID id = allocate_next_id();
-    auto node = std::make_unique<Node>(id, &c, TEXT_PAYLOAD_SIZE);
+    auto node = std::make_unique<Node>(id, &c, TEXT_PAYLOAD_SIZE, Modality::TEXT);
     
     if (graph_->add_node(std::move(node))) {
         latest_node_id_ = id;
@@ -78,7 +78,7 @@ NodeID IntakeManager::create_motor_node(uint16_t motor_id, const float* motor_da
     payload.motor_id = motor_id;
     std::memcpy(payload.data, motor_data, sizeof(float) * 7);
     
-    auto node = std::make_unique<Node>(id, &payload, sizeof(MotorPayload));
+    auto node = std::make_unique<Node>(id, &payload, sizeof(MotorPayload), Modality::MOTOR);
     
     if (graph_->add_node(std::move(node))) {
         latest_node_id_ = id;
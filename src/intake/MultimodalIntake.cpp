@@ -6,27 +6,66 @@
 
 namespace melvin {
 
+namespace {
+
+// Queue index of a modality, or -1 if the intake doesn't take it
+int queue_of(Modality modality) {
+    switch (modality) {
+        case Modality::VISION: return 0;
+        case Modality::AUDIO: return 1;
+        default: return -1;
+    }
+}
+
+} // namespace
+
 MultimodalIntake::MultimodalIntake(IntakeManager* intake, AtomicGraph* graph)
-    : intake_(intake), graph_(graph), running_(false) {
-    hardware_ = std::make_unique<HardwareCapture>();
+    : MultimodalIntake(intake, graph, Config()) {
+}
+
+MultimodalIntake::MultimodalIntake(IntakeManager* intake, AtomicGraph* graph, const Config& config)
+    : intake_(intake), graph_(graph), config_(config), running_(false) {
     filter_ = std::make_unique<AdaptiveFilter>();
+    for (size_t q = 0; q < QUEUES; ++q) {
+        queues_[q] = std::make_unique<CaptureQueue<CaptureEvent>>(config_.queue_capacity);
+        scheduled_[q].store(false);
+    }
 }
 
 MultimodalIntake::~MultimodalIntake() {
     stop();
 }
 
-void MultimodalIntake::start() {
+void MultimodalIntake::set_source(std::unique_ptr<CaptureSource> source) {
     if (running_.load()) {
         return;
     }
+    source_ = std::move(source);
+}
+
+bool MultimodalIntake::start() {
+    if (running_.load()) {
+        return true;
+    }
+    if (!source_) {
+        std::cerr << "MultimodalIntake: no capture source set\n";
+        return false;
+    }
     
-    std::cout << "Starting multimodal hardware intake (camera + microphone)...\n";
+    std::cout << "Starting multimodal intake (" << config_.workers << " workers)...\n";
     
-    hardware_->start();
+    start_time_ = Clock::now();
     running_.store(true);
+    size_t workers = config_.workers > 0 ? config_.workers : 1;
+    for (size_t i = 0; i < workers; ++i) {
+        workers_.emplace_back(&MultimodalIntake::worker_loop, this);
+    }
     
-    intake_thread_ = std::thread(&MultimodalIntake::continuous_intake_loop, this);
+    if (!source_->start([this](const CaptureEvent& event) { return enqueue(event); })) {
+        stop();
+        return false;
+    }
+    return true;
 }
 
 void MultimodalIntake::stop() {
@@ -34,63 +73,177 @@ void MultimodalIntake::stop() {
         return;
     }
     
-    running_.store(false);
-    hardware_->stop();
+    // Source first, so nothing is pushed after the workers are gone
+    source_->stop();
     
-    if (intake_thread_.joinable()) {
-        intake_thread_.join();
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        running_.store(false);
     }
+    ready_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+    
+    // Events still queued are discarded
+    CaptureEvent event;
+    for (size_t q = 0; q < QUEUES; ++q) {
+        while (queues_[q]->pop(event)) {
+            pending_--;
+        }
+        scheduled_[q].store(false);
+    }
+    ready_.clear();
+    stop_recording();
+}
+
+bool MultimodalIntake::start_recording(const std::string& path) {
+    if (!recorder_.open(path)) {
+        return false;
+    }
+    recording_.store(true);
+    return true;
+}
+
+void MultimodalIntake::stop_recording() {
+    recording_.store(false);
+    recorder_.close();
+}
+
+void MultimodalIntake::wait_until_drained() {
+    while (running_.load() && !(source_->finished() && pending_.load() == 0)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+uint64_t MultimodalIntake::now_us() const {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - start_time_).count());
 }
 
-void MultimodalIntake::continuous_intake_loop() {
-    uint64_t frame_count = 0;
-    uint64_t audio_count = 0;
+bool MultimodalIntake::enqueue(const CaptureEvent& event) {
+    int queue = queue_of(event.modality);
+    if (queue < 0 || !running_.load()) {
+        return true;  // Not ours: consumed and ignored
+    }
     
-    while (running_.load()) {
-        // Capture and process vision (only every 3rd attempt to reduce load)
-        if (frame_count % 3 == 0) {
-            process_vision_frame();
-        }
-        frame_count++;
-        
-        // Capture and process audio (only every 3rd attempt to reduce load)
-        if (audio_count % 3 == 0) {
-            process_audio_chunk();
+    if (recording_.load()) {
+        recorder_.write(event);  // Everything captured, even if dropped below
+    }
+    
+    CaptureEvent queued = event;
+    queued.arrival_us = now_us();
+    pending_++;
+    if (!queues_[queue]->push(queued)) {
+        pending_--;
+        dropped_++;
+        return false;
+    }
+    captured_++;
+    
+    // Only the push that finds the queue idle has to wake a worker
+    if (!scheduled_[queue].exchange(true)) {
+        schedule(queue);
+    }
+    return true;
+}
+
+void MultimodalIntake::schedule(size_t queue) {
+    {
+        std::lock_guard<std::mutex> lock(ready_mutex_);
+        ready_.push_back(queue);
+    }
+    ready_cv_.notify_one();
+}
+
+void MultimodalIntake::worker_loop() {
+    while (true) {
+        size_t queue;
+        {
+            std::unique_lock<std::mutex> lock(ready_mutex_);
+            ready_cv_.wait(lock, [this] { return !running_.load() || !ready_.empty(); });
+            if (!running_.load()) {
+                return;
+            }
+            queue = ready_.front();
+            ready_.pop_front();
         }
-        audio_count++;
-        
-        // Throttle to reasonable rate
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));  // Slower to prevent overload
-        
-        // Print progress less often
-        if ((frame_count + audio_count) % 100 == 0) {
-            std::cout << "Captured " << frame_count << " vision frames, " 
-                      << audio_count << " audio chunks\n";
+    
+        drain(queue);
+    
+        // A push may have landed after the last pop but before the flag was
+        // cleared; whoever sets the flag again reschedules
+        scheduled_[queue].store(false);
+        if (!queues_[queue]->empty() && !scheduled_[queue].exchange(true)) {
+            schedule(queue);
         }
     }
 }
 
-void MultimodalIntake::process_vision_frame() {
-    uint8_t buffer[VISION_PAYLOAD_SIZE];
+void MultimodalIntake::drain(size_t queue) {
+    CaptureEvent event;
+    while (running_.load() && queues_[queue]->pop(event)) {
+        process_event(event);
     
-    if (hardware_->get_latest_vision_frame(buffer, VISION_PAYLOAD_SIZE)) {
-        // Only capture if significant change (adaptive filtering)
-        if (filter_->should_capture_vision(buffer, VISION_PAYLOAD_SIZE)) {
-            intake_->create_vision_node(buffer);
+        uint64_t latency = now_us() - event.arrival_us;
+        total_latency_us_ += latency;
+        uint64_t max = max_latency_us_.load(std::memory_order_relaxed);
+        while (latency > max && !max_latency_us_.compare_exchange_weak(max, latency)) {
         }
+        processed_++;
+        pending_--;
     }
 }
 
-void MultimodalIntake::process_audio_chunk() {
+void MultimodalIntake::process_event(const CaptureEvent& event) {
+    if (event.modality == Modality::VISION) {
+        process_vision_frame(event);
+    } else {
+        process_audio_chunk(event);
+    }
+}
+
+void MultimodalIntake::process_vision_frame(const CaptureEvent& event) {
+    if (event.size != VISION_PAYLOAD_SIZE) {
+        return;
+    }
+    // Only capture if significant change (adaptive filtering)
+    if (filter_->should_capture_vision(event.payload.data(), VISION_PAYLOAD_SIZE)) {
+        if (intake_->create_vision_node(event.payload.data())) {
+            nodes_created_++;
+        }
+    }
+}
+
+void MultimodalIntake::process_audio_chunk(const CaptureEvent& event) {
+    if (event.size != AUDIO_PAYLOAD_SIZE) {
+        return;
+    }
     int16_t buffer[AUDIO_PAYLOAD_SIZE / 2];
+    std::memcpy(buffer, event.payload.data(), AUDIO_PAYLOAD_SIZE);
     
-    if (hardware_->get_latest_audio_chunk(buffer, AUDIO_PAYLOAD_SIZE / 2)) {
-        // Only capture if significant energy (adaptive filtering)
-        if (filter_->should_capture_audio(buffer, AUDIO_PAYLOAD_SIZE / 2)) {
-            intake_->create_audio_node(buffer);
+    // Only capture if significant energy (adaptive filtering)
+    if (filter_->should_capture_audio(buffer, AUDIO_PAYLOAD_SIZE / 2)) {
+        if (intake_->create_audio_node(buffer)) {
+            nodes_created_++;
         }
     }
 }
 
-} // namespace melvin
+MultimodalIntake::Stats MultimodalIntake::get_stats() const {
+    Stats stats;
+    stats.captured = captured_.load();
+    stats.dropped = dropped_.load();
+    stats.processed = processed_.load();
+    stats.nodes_created = nodes_created_.load();
+    if (stats.processed > 0) {
+        stats.mean_latency_ms = total_latency_us_.load() / 1000.0 / stats.processed;
+    }
+    stats.max_latency_ms = max_latency_us_.load() / 1000.0;
+    return stats;
+}
 
+} // namespace melvin
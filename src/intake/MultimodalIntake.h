@@ -1,22 +1,52 @@
 #pragma once
 
 #include "IntakeManager.h"
-#include "HardwareCapture.h"
 #include "AdaptiveFilter.h"
+#include "CaptureSource.h"
+#include "CaptureTrace.h"
 #include "../core/AtomicGraph.h"
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace melvin {
 
-// Continuously intakes vision and audio from hardware, feeding both into Melvin
+// Event-driven intake of vision and audio into Melvin. The capture source
+// pushes each event into a lock-free queue for its modality as soon as it
+// arrives; a worker pool drains the queues, runs the adaptive filter and
+// creates nodes. A modality's queue is drained by one worker at a time, so
+// its events are filtered and turned into nodes in capture order.
 class MultimodalIntake {
 public:
+    struct Config {
+        size_t workers = 2;           // Threads draining the queues
+        size_t queue_capacity = 64;   // Events buffered per modality
+    };
+    
+    struct Stats {
+        size_t captured = 0;          // Accepted into a queue
+        size_t dropped = 0;           // Queue was full
+        size_t processed = 0;
+        size_t nodes_created = 0;     // Passed the adaptive filter
+        double mean_latency_ms = 0.0; // Queued → processed
+        double max_latency_ms = 0.0;
+    };
+    
     MultimodalIntake(IntakeManager* intake, AtomicGraph* graph);
+    MultimodalIntake(IntakeManager* intake, AtomicGraph* graph, const Config& config);
     ~MultimodalIntake();
     
-    // Start continuous intake from hardware
-    void start();
+    // Where events come from (HardwareCaptureSource, CaptureTraceSource, ...).
+    // Set before start().
+    void set_source(std::unique_ptr<CaptureSource> source);
+    CaptureSource* source() const { return source_.get(); }
+    
+    // Start intake from the source; false without a source or if it fails
+    bool start();
     
     // Stop intake
     void stop();
@@ -24,18 +54,58 @@ public:
     // Check if running
     bool is_running() const { return running_.load(); }
     
+    // Record every captured event (before filtering) as a replayable trace
+    bool start_recording(const std::string& path);
+    void stop_recording();
+    
+    // Block until a finite source has finished and every event is processed
+    void wait_until_drained();
+    
+    Stats get_stats() const;
+
 private:
+    using Clock = std::chrono::steady_clock;
+    
     IntakeManager* intake_;
     AtomicGraph* graph_;
-    std::unique_ptr<HardwareCapture> hardware_;
+    Config config_;
+    std::unique_ptr<CaptureSource> source_;
     std::unique_ptr<AdaptiveFilter> filter_;
-    std::thread intake_thread_;
     std::atomic<bool> running_;
+    Clock::time_point start_time_;
     
-    void continuous_intake_loop();
-    void process_vision_frame();
-    void process_audio_chunk();
+    // One queue per modality (vision, audio). scheduled_ is set while the
+    // modality is in ready_ or being drained, so it's drained by one worker.
+    static constexpr size_t QUEUES = 2;
+    std::unique_ptr<CaptureQueue<CaptureEvent>> queues_[QUEUES];
+    std::atomic<bool> scheduled_[QUEUES];
+    std::deque<size_t> ready_;
+    std::mutex ready_mutex_;
+    std::condition_variable ready_cv_;
+    std::vector<std::thread> workers_;
+    
+    CaptureTraceWriter recorder_;
+    std::atomic<bool> recording_{false};
+    
+    std::atomic<size_t> pending_{0};      // Queued but not yet processed
+    std::atomic<size_t> captured_{0};
+    std::atomic<size_t> dropped_{0};
+    std::atomic<size_t> processed_{0};
+    std::atomic<size_t> nodes_created_{0};
+    std::atomic<uint64_t> total_latency_us_{0};
+    std::atomic<uint64_t> max_latency_us_{0};
+    
+    uint64_t now_us() const;
+    
+    // Sink handed to the source (runs on the source's threads)
+    bool enqueue(const CaptureEvent& event);
+    void schedule(size_t queue);
+    
+    void worker_loop();
+    void drain(size_t queue);
+    void process_event(const CaptureEvent& event);
+    void process_vision_frame(const CaptureEvent& event);
+    void process_audio_chunk(const CaptureEvent& event);
 };
 
 } // namespace melvin
-
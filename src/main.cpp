@@ -5,6 +5,7 @@
 #include "intake/IntakeManager.h"
 #include "intake/DatasetLoader.h"
 #include "intake/MultimodalIntake.h"
+#include "intake/HardwareCaptureSource.h"
 #include "connections/ExactConnector.h"
 #include "generalization/LeapNodes.h"
 #include "generalization/LeapConnections.h"
@@ -46,8 +47,14 @@ int main() {
     // Initialize core graph
     auto graph = std::make_unique<AtomicGraph>();
     
-    // Initialize statistics tracking
-    auto stats = std::make_unique<GraphStatistics>();
+    // Optionally bound resident payload memory; cold payloads spill to a segment file
+    if (ENABLE_TIERED_STORAGE && !graph->enable_tiered_storage()) {
+        std::cout << "[Storage] Tiered storage unavailable, keeping all payloads in RAM\n";
+    }
+    
+    // Statistics are maintained by the graph itself; export snapshots periodically
+    const GraphStatistics* stats = &graph->statistics();
+    auto stats_exporter = std::make_unique<StatisticsExporter>(stats, "logs/graph_stats.jsonl");
     
     // Initialize parallel task queue (4 worker threads)
     auto task_queue = std::make_unique<TaskQueue>(4);
@@ -100,6 +107,7 @@ int main() {
     
     // Initialize multimodal hardware intake
     auto multimodal_intake = std::make_unique<MultimodalIntake>(intake_manager.get(), graph.get());
+    multimodal_intake->set_source(std::make_unique<HardwareCaptureSource>());
     
     // Initialize visualizer for camera/audio display
     auto visualizer = std::make_unique<Visualizer>();
@@ -157,13 +165,7 @@ int main() {
     std::cout << "Total nodes in graph: " << graph->node_count() << "\n";
     std::cout << "Total edges in graph: " << graph->edge_count() << "\n";
     
-    // Update statistics with loaded nodes
-    for (size_t i = 0; i < graph->node_count(); ++i) {
-        stats->node_created();
-    }
-    for (size_t i = 0; i < graph->edge_count(); ++i) {
-        stats->edge_created();
-    }
+    stats_exporter->start();
     
     tracer.trace("Starting main loop");
     std::cout << "\nRunning perception-action-reasoning loop...\n\n";
@@ -256,7 +258,7 @@ int main() {
             
             // Find recent vision node
             for (int i = std::min(50, (int)all_nodes.size() - 1); i >= 0; --i) {
-                Node* node = graph->get_node(all_nodes[i]);
+                PinnedNode node = graph->pin_node(all_nodes[i]);
                 if (node && node->payload_size() == VISION_PAYLOAD_SIZE) {
                     GraphStats gstats;
                     gstats.nodes = graph->node_count();
@@ -282,7 +284,7 @@ int main() {
             
             // Find recent audio node
             for (int i = std::min(50, (int)all_nodes.size() - 1); i >= 0; --i) {
-                Node* node = graph->get_node(all_nodes[i]);
+                PinnedNode node = graph->pin_node(all_nodes[i]);
                 if (node && node->payload_size() == AUDIO_PAYLOAD_SIZE) {
                     display_manager->update_audio_waveform(
                         (const int16_t*)node->payload(), 
@@ -301,7 +303,7 @@ int main() {
             // Find and show recent vision node
             bool found_vision = false;
             for (int i = std::min(50, (int)all_nodes.size() - 1); i >= 0; --i) {
-                Node* node = graph->get_node(all_nodes[i]);
+                PinnedNode node = graph->pin_node(all_nodes[i]);
                 if (node && node->payload_size() == VISION_PAYLOAD_SIZE) {
                     visualizer->show_camera_frame((const uint8_t*)node->payload(), node->payload_size());
                     found_vision = true;
@@ -315,7 +317,7 @@ int main() {
             // Find and show recent audio node
             bool found_audio = false;
             for (int i = std::min(50, (int)all_nodes.size() - 1); i >= 0; --i) {
-                Node* node = graph->get_node(all_nodes[i]);
+                PinnedNode node = graph->pin_node(all_nodes[i]);
                 if (node && node->payload_size() == AUDIO_PAYLOAD_SIZE) {
                     visualizer->show_audio_waveform((const int16_t*)node->payload(), node->payload_size() / 2);
                     found_audio = true;
@@ -353,8 +355,9 @@ int main() {
             evolution_engine->update(coherence, accuracy, efficiency);
         }
         
-        // 8. PRUNING: Remove low-score nodes and edges
+        // 8. PRUNING: Decay every edge, then remove low-score nodes and edges
         if (cycle % 500 == 0) {
+            graph->decay_all_edges(EDGE_DECAY_RATE);
             size_t pruned_nodes = pruning_engine->prune_nodes();
             size_t pruned_edges = pruning_engine->prune_edges();
             
@@ -381,9 +384,16 @@ int main() {
 #endif
     
     // Print final statistics
+    stats_exporter->stop();
+    stats_exporter->export_now();
     std::cout << "\n";
     stats->print_stats();
     
+    TieredStorage::Stats eviction = graph->eviction_stats();
+    std::cout << "Payload memory: " << graph->resident_payload_bytes() << " bytes resident, "
+              << eviction.evictions << " evictions, " << eviction.faults << " faults, "
+              << eviction.segment_bytes << " bytes on disk\n";
+    
     // Save graph to binary files
     std::cout << "\nSaving graph to binary files...\n";
     bool saved = persistence->save_to_files("data/nodes.bin", "data/edges.bin");
@@ -63,7 +63,7 @@ std::vector<NodeID> MotorController::extract_motor_nodes(const std::vector<NodeI
     std::vector<NodeID> motor_nodes;
     
     for (NodeID node_id : active_nodes) {
-        Node* node = graph_->get_node(node_id);
+        Node* node = graph_->get_node_metadata(node_id);  // Size only; payload may stay on disk
         if (node && node->payload_size() >= sizeof(MotorNodeData)) {
             motor_nodes.push_back(node_id);
         }
@@ -73,12 +73,12 @@ std::vector<NodeID> MotorController::extract_motor_nodes(const std::vector<NodeI
 }
 
 MotorNodeData MotorController::node_to_command(NodeID node) {
-    Node* node_ptr = graph_->get_node(node);
+    PinnedNode node_ptr = graph_->pin_node(node);
     if (!node_ptr) {
         return MotorNodeData{};
     }
     
-    MotorNodeData data = MotorNode::parse_motor_node_data(node_ptr);
+    MotorNodeData data = MotorNode::parse_motor_node_data(node_ptr.get());
     // TODO: Adjust command based on current state
     
     return data;
@@ -18,7 +18,7 @@ void AudioOutput::output(const std::vector<NodeID>& audio_nodes, AtomicGraph* gr
     
     // TODO: Implement actual audio playback
     for (NodeID node_id : audio_nodes) {
-        Node* node = graph->get_node(node_id);
+        PinnedNode node = graph->pin_node(node_id);
         if (node && node->payload_size() == AUDIO_PAYLOAD_SIZE) {
             // Process audio buffer
             const int16_t* audio_data = static_cast<const int16_t*>(node->payload());
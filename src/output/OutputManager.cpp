@@ -1,5 +1,4 @@
 #include "OutputManager.h"
-#include "../core/Node.h"
 #include "../include/melvin/types.h"
 #include "../include/melvin/config.h"
 #include <iostream>
@@ -37,27 +36,14 @@ void OutputManager::categorize_nodes(const std::vector<NodeID>& active,
                                       std::vector<NodeID>& vision,
                                       std::vector<NodeID>& motor,
                                       std::vector<NodeID>& text) {
-    audio.clear();
-    vision.clear();
-    motor.clear();
-    text.clear();
+    // One shared lock and a bitset pass instead of a node lookup per id
+    std::array<std::vector<NodeID>, MODALITY_COUNT> groups;
+    graph_->partition_by_modality(active, groups);
     
-    for (NodeID node_id : active) {
-        Node* node = graph_->get_node(node_id);
-        if (!node) continue;
-        
-        size_t payload_size = node->payload_size();
-        
-        if (payload_size == AUDIO_PAYLOAD_SIZE) {
-            audio.push_back(node_id);
-        } else if (payload_size == VISION_PAYLOAD_SIZE) {
-            vision.push_back(node_id);
-        } else if (payload_size >= sizeof(melvin::MotorNodeData)) {
-            motor.push_back(node_id);
-        } else if (payload_size == TEXT_PAYLOAD_SIZE) {
-            text.push_back(node_id);
-        }
-    }
+    audio = std::move(groups[static_cast<size_t>(Modality::AUDIO)]);
+    vision = std::move(groups[static_cast<size_t>(Modality::VISION)]);
+    motor = std::move(groups[static_cast<size_t>(Modality::MOTOR)]);
+    text = std::move(groups[static_cast<size_t>(Modality::TEXT)]);
 }
 
 } // namespace melvin
@@ -21,7 +21,7 @@ void VisualAttention::update_attention(const std::vector<NodeID>& vision_nodes,
     size_t count = 0;
     
     for (NodeID node_id : vision_nodes) {
-        Node* node = graph->get_node(node_id);
+        Node* node = graph->get_node_metadata(node_id);  // Size only; payload may stay on disk
         if (node && node->payload_size() == VISION_PAYLOAD_SIZE) {
             // Extract position from metadata if available
             // For now, just increment
@@ -1,6 +1,7 @@
 #include "PruningEngine.h"
 #include "../core/Node.h"
 #include "../include/melvin/types.h"
+#include "../connections/Weight.h"
 
 namespace melvin {
 
@@ -48,11 +49,11 @@ float PruningEngine::calculate_node_score(NodeID node) const {
 float PruningEngine::calculate_edge_score(NodeID source, NodeID target) const {
     // Simplified: use edge weight as score
     EdgeWeight weight = graph_->get_edge_weight(source, target);
-    return static_cast<float>(weight) / 65535.0f;
+    return Weight::to_float(weight);
 }
 
 Time PruningEngine::get_node_age(NodeID node) const {
-    Node* node_ptr = graph_->get_node(node);
+    Node* node_ptr = graph_->get_node_metadata(node);  // Metadata only; don't fault the payload in
     if (!node_ptr) {
         return 0;
     }
@@ -64,7 +65,7 @@ Time PruningEngine::get_node_age(NodeID node) const {
 }
 
 uint32_t PruningEngine::get_node_frequency(NodeID node) const {
-    Node* node_ptr = graph_->get_node(node);
+    Node* node_ptr = graph_->get_node_metadata(node);
     if (!node_ptr) {
         return 0;
     }
@@ -1,5 +1,6 @@
 #include "ActivationField.h"
 #include "../include/melvin/types.h"
+#include "../connections/Weight.h"
 #include <cmath>
 #include <numeric>
 #include <algorithm>
@@ -37,7 +38,7 @@ void ActivationField::update_energies(float decay_rate) {
             auto neighbor_it = new_energies.find(neighbor_id);
             if (neighbor_it != new_energies.end()) {
                 EdgeWeight weight = graph_->get_edge_weight(node_id, neighbor_id);
-                float weight_normalized = static_cast<float>(weight) / 65535.0f;
+                float weight_normalized = Weight::to_float(weight);
                 neighbor_activation += weight_normalized * neighbor_it->second;
             }
         }
@@ -71,7 +72,7 @@ void ActivationField::excite_neighbors(const std::vector<NodeID>& active_nodes)
                 // Neighbor not already active, add excitation
                 float current_energy = get_energy(neighbor);
                 EdgeWeight weight = graph_->get_edge_weight(active_node, neighbor);
-                float excitation = static_cast<float>(weight) / 65535.0f;
+                float excitation = Weight::to_float(weight);
                 set_energy(neighbor, current_energy + excitation);
             }
         }
@@ -1,5 +1,6 @@
 #include "CoherenceCalculator.h"
 #include "../include/melvin/types.h"
+#include "../connections/Weight.h"
 #include <unordered_set>
 #include <unordered_map>
 #include <algorithm>
@@ -36,7 +37,7 @@ float CoherenceCalculator::avg_internal_weight(const std::vector<NodeID>& active
         for (NodeID neighbor : neighbors) {
             if (active_set.find(neighbor) != active_set.end()) {
                 EdgeWeight weight = graph_->get_edge_weight(node, neighbor);
-                sum += static_cast<float>(weight) / 65535.0f;
+                sum += Weight::to_float(weight);
                 count++;
             }
         }
@@ -60,7 +61,7 @@ float CoherenceCalculator::avg_external_weight(const std::vector<NodeID>& active
         for (NodeID neighbor : neighbors) {
             if (active_set.find(neighbor) == active_set.end()) {
                 EdgeWeight weight = graph_->get_edge_weight(node, neighbor);
-                sum += static_cast<float>(weight) / 65535.0f;
+                sum += Weight::to_float(weight);
                 count++;
             }
         }
@@ -79,7 +80,7 @@ float CoherenceCalculator::get_external_relevance(NodeID node, const std::vector
     for (NodeID neighbor : neighbors) {
         if (active_set.find(neighbor) != active_set.end()) {
             EdgeWeight weight = graph_->get_edge_weight(node, neighbor);
-            avg_weight += static_cast<float>(weight) / 65535.0f;
+            avg_weight += Weight::to_float(weight);
             count++;
         }
     }
@@ -1,6 +1,6 @@
 #include "TraversalEngine.h"
 #include "../include/melvin/types.h"
-#include <unordered_set>
+#include "../connections/Weight.h"
 #include <algorithm>
 
 namespace melvin {
@@ -11,65 +11,151 @@ TraversalEngine::TraversalEngine(AtomicGraph* graph, ActivationField* field, Coh
 
 NodeID TraversalEngine::select_next_node(const std::vector<NodeID>& active_nodes) {
     if (active_nodes.empty()) {
-        // No active nodes, return first node in graph
-        std::vector<NodeID> all_nodes = graph_->get_all_nodes();
-        if (!all_nodes.empty()) {
-            return all_nodes[0];
-        }
-        return 0;
+        // No active nodes, return any node in graph
+        return graph_->any_node();
     }
     
-    // Find candidate nodes (neighbors of active nodes that aren't already active)
-    std::unordered_set<NodeID> active_set(active_nodes.begin(), active_nodes.end());
-    std::unordered_set<NodeID> candidates;
-    
-    for (NodeID active : active_nodes) {
-        std::vector<NodeID> neighbors = graph_->get_neighbors(active);
-        for (NodeID neighbor : neighbors) {
-            if (active_set.find(neighbor) == active_set.end()) {
-                candidates.insert(neighbor);
+    // Sync frontier with the caller's active set. Growth is incremental;
+    // a node leaving the active set or a weight change invalidates
+    // accumulated scores.
+    bool dropped = active_nodes.size() < active_set_.size() ||
+                   graph_->edge_version() != edge_version_;
+    if (!dropped) {
+        std::unordered_set<NodeID> incoming(active_nodes.begin(), active_nodes.end());
+        for (NodeID node : active_set_) {
+            if (incoming.find(node) == incoming.end()) {
+                dropped = true;
+                break;
             }
         }
     }
     
-    // Select candidate with highest score
-    NodeID best_node = 0;
-    float best_score = -1.0f;
-    
-    for (NodeID candidate : candidates) {
-        float score = calculate_node_score(candidate, active_nodes);
-        if (score > best_score) {
-            best_score = score;
-            best_node = candidate;
+    if (dropped) {
+        begin_traversal(active_nodes);
+    } else {
+        for (NodeID node : active_nodes) {
+            activate(node);
         }
     }
     
-    return best_node;
+    return peek_best();
 }
 
-float TraversalEngine::calculate_node_score(NodeID candidate, const std::vector<NodeID>& active_nodes) {
-    // Combine coherence, edge strength, and external relevance
-    float coherence = coherence_->calculate_coherence(active_nodes);
-    float external_relevance = coherence_->get_external_relevance(candidate, active_nodes);
+void TraversalEngine::begin_traversal(const std::vector<NodeID>& seeds) {
+    active_set_.clear();
+    candidates_.clear();
+    frontier_ = std::priority_queue<FrontierEntry>();
+    edge_version_ = graph_->edge_version();  // Read first: later changes force another rebuild
+    
+    for (NodeID node : seeds) {
+        activate(node);
+    }
+}
+
+void TraversalEngine::refresh_if_edges_changed() {
+    if (graph_->edge_version() != edge_version_) {
+        begin_traversal(std::vector<NodeID>(active_set_.begin(), active_set_.end()));
+    }
+}
+
+void TraversalEngine::activate(NodeID node) {
+    if (!active_set_.insert(node).second) {
+        return;  // Already active
+    }
+    candidates_.erase(node);
+    size_t active_count = active_set_.size();
+    
+    // Only the new node's edges change any candidate's score. A neighbor
+    // counts once per edge direction for relevance, which always reads the
+    // candidate -> node weight (0 if that edge doesn't exist).
+    std::vector<std::pair<NodeID, EdgeWeight>> incoming = graph_->get_incoming_edges(node);
+    std::unordered_map<NodeID, EdgeWeight> back_weight(incoming.begin(), incoming.end());
     
-    // Calculate average edge strength to active nodes
-    float avg_edge_strength = 0.0f;
-    size_t count = 0;
+    auto support = [&](NodeID candidate, float strength, EdgeWeight relevance) {
+        if (active_set_.find(candidate) != active_set_.end()) {
+            return;
+        }
+        CandidateStats& stats = candidates_[candidate];
+        stats.strength_sum += strength;
+        stats.relevance_sum += Weight::to_float(relevance);
+        stats.relevance_count++;
+        stats.version++;
+        frontier_.push({frontier_score(stats, active_count), candidate, stats.version,
+                        static_cast<uint32_t>(active_count)});
+    };
     
-    for (NodeID active : active_nodes) {
-        EdgeWeight weight = graph_->get_edge_weight(active, candidate);
-        avg_edge_strength += static_cast<float>(weight) / 65535.0f;
-        count++;
+    for (const auto& [neighbor, weight] : graph_->get_outgoing_edges(node)) {
+        auto back = back_weight.find(neighbor);
+        support(neighbor, Weight::to_float(weight), back != back_weight.end() ? back->second : 0);
+    }
+    for (const auto& [neighbor, weight] : incoming) {
+        support(neighbor, 0.0f, weight);
     }
     
-    if (count > 0) {
-        avg_edge_strength /= count;
+    if (frontier_.size() > 4 * candidates_.size() + 64) {
+        compact_frontier();
     }
+}
+
+std::vector<NodeID> TraversalEngine::expand(size_t beam_width) {
+    refresh_if_edges_changed();
     
-    // Weighted combination
-    float score = coherence * 0.4f + avg_edge_strength * 0.3f + external_relevance * 0.3f;
+    // Pop the whole beam before activating so members don't rescore each other
+    std::vector<NodeID> beam;
+    beam.reserve(beam_width);
     
-    return score;
+    while (beam.size() < beam_width && settle_top()) {
+        NodeID node = frontier_.top().node;
+        frontier_.pop();
+        candidates_.erase(node);
+        beam.push_back(node);
+    }
+    
+    for (NodeID node : beam) {
+        activate(node);
+    }
+    
+    return beam;
+}
+
+NodeID TraversalEngine::peek_best() {
+    refresh_if_edges_changed();
+    return settle_top() ? frontier_.top().node : 0;
+}
+
+float TraversalEngine::frontier_score(const CandidateStats& stats, size_t active_count) const {
+    float strength = active_count > 0 ? stats.strength_sum / active_count : 0.0f;
+    float relevance = stats.relevance_count > 0 ? stats.relevance_sum / stats.relevance_count : 0.0f;
+    return strength * 0.3f + relevance * 0.3f;
+}
+
+bool TraversalEngine::settle_top() {
+    uint32_t active_count = static_cast<uint32_t>(active_set_.size());
+    while (!frontier_.empty()) {
+        FrontierEntry top = frontier_.top();
+        auto it = candidates_.find(top.node);
+        if (it == candidates_.end() || it->second.version != top.version) {
+            frontier_.pop();  // Superseded by a newer entry or already activated
+            continue;
+        }
+        if (top.active_count == active_count) {
+            return true;
+        }
+        frontier_.pop();  // Scored for a smaller active set: rescore
+        frontier_.push({frontier_score(it->second, active_count), top.node, top.version, active_count});
+    }
+    return false;
+}
+
+void TraversalEngine::compact_frontier() {
+    std::vector<FrontierEntry> live;
+    live.reserve(candidates_.size());
+    size_t active_count = active_set_.size();
+    for (const auto& [node, stats] : candidates_) {
+        live.push_back({frontier_score(stats, active_count), node, stats.version,
+                        static_cast<uint32_t>(active_count)});
+    }
+    frontier_ = std::priority_queue<FrontierEntry>(std::less<FrontierEntry>(), std::move(live));
 }
 
 bool TraversalEngine::should_continue_reasoning(const std::vector<NodeID>& active_nodes) {
@@ -110,5 +196,25 @@ std::vector<NodeID> TraversalEngine::reason(const std::vector<NodeID>& initial_n
     return active;
 }
 
-} // namespace melvin
+std::vector<NodeID> TraversalEngine::reason_beam(const std::vector<NodeID>& initial_nodes,
+                                                 size_t beam_width,
+                                                 size_t max_iterations) {
+    begin_traversal(initial_nodes);
+    std::vector<NodeID> path = initial_nodes;
+    
+    for (size_t i = 0; i < max_iterations; ++i) {
+        std::vector<NodeID> beam = expand(beam_width);
+        if (beam.empty()) {
+            break;  // Frontier exhausted
+        }
+        
+        for (NodeID node : beam) {
+            field_->set_energy(node, 1.0f);
+            path.push_back(node);
+        }
+    }
+    
+    return path;
+}
 
+} // namespace melvin
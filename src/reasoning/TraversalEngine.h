@@ -5,17 +5,43 @@
 #include "CoherenceCalculator.h"
 #include "../include/melvin/config.h"
 #include <vector>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace melvin {
 
 // Decides next activation by combining coherence, edge strength, and external relevance
+//
+// The engine is stateful: it keeps a max-heap frontier of inactive neighbors
+// (through edges in either direction) keyed by an incrementally maintained
+// score. Activating a node only touches that node's own edges, so a step
+// costs O(degree log frontier) instead of rescoring every candidate against
+// every active node. Accumulated weights are rebuilt from the active set
+// when the graph's edge version changes.
 class TraversalEngine {
 public:
     TraversalEngine(AtomicGraph* graph, ActivationField* field, CoherenceCalculator* coherence);
     
     // Get next node to activate based on current active nodes
+    // (syncs the frontier with active_nodes, rebuilding only if nodes were dropped)
     NodeID select_next_node(const std::vector<NodeID>& active_nodes);
     
+    // Reset the frontier around a seed set
+    void begin_traversal(const std::vector<NodeID>& seeds);
+    
+    // Activate a node and push its neighbors onto the frontier
+    void activate(NodeID node);
+    
+    // Beam-style expansion: pop and activate the top-B frontier nodes
+    std::vector<NodeID> expand(size_t beam_width = 1);
+    
+    // Highest-scoring frontier node without activating it (0 if none)
+    NodeID peek_best();
+    
+    size_t frontier_size() const { return candidates_.size(); }
+    const std::unordered_set<NodeID>& active_set() const { return active_set_; }
+    
     // Decide if we should continue reasoning
     bool should_continue_reasoning(const std::vector<NodeID>& active_nodes);
     
@@ -23,14 +49,58 @@ public:
     std::vector<NodeID> reason(const std::vector<NodeID>& initial_nodes, 
                                size_t max_iterations = MAX_REASONING_ITERATIONS);
     
+    // Run beam search over the frontier from the seeds
+    std::vector<NodeID> reason_beam(const std::vector<NodeID>& initial_nodes,
+                                    size_t beam_width,
+                                    size_t max_iterations = MAX_REASONING_ITERATIONS);
+    
 private:
     AtomicGraph* graph_;
     ActivationField* field_;
     CoherenceCalculator* coherence_;
     
-    // Calculate score for potential next node
-    float calculate_node_score(NodeID candidate, const std::vector<NodeID>& active_nodes);
+    // Accumulated support from the active set for one inactive candidate
+    struct CandidateStats {
+        float strength_sum = 0.0f;   // Σ w(active -> candidate), normalized to [0,1] per edge
+        float relevance_sum = 0.0f;  // Σ w(candidate -> active) over relevance_count links
+        uint32_t relevance_count = 0;  // Active neighbors, once per edge direction
+        uint32_t version = 0;        // Bumped on every update; stale heap entries are skipped
+    };
+    
+    struct FrontierEntry {
+        float score;
+        NodeID node;
+        uint32_t version;
+        uint32_t active_count;       // |active| the score was computed with
+        
+        bool operator<(const FrontierEntry& other) const {
+            if (score != other.score) return score < other.score;
+            return node > other.node;  // Deterministic tie-break: lower ID first
+        }
+    };
+    
+    std::unordered_set<NodeID> active_set_;
+    std::unordered_map<NodeID, CandidateStats> candidates_;
+    std::priority_queue<FrontierEntry> frontier_;
+    uint64_t edge_version_ = 0;  // Graph edge version the stats were accumulated at
+    
+    // 0.3 * mean edge strength from the active set (Σ / |active|)
+    //   + 0.3 * external relevance (CoherenceCalculator::get_external_relevance).
+    // The 0.4 * coherence term is the same for every candidate, so it is
+    // dropped without changing the ranking.
+    float frontier_score(const CandidateStats& stats, size_t active_count) const;
+    
+    // Drop stale heap entries at the top and rescore entries computed for a
+    // smaller active set. Those keys can only be too high (the strength term
+    // shrinks as |active| grows), so once the top is current it is the best.
+    // Returns false if the frontier is empty.
+    bool settle_top();
+    
+    // Rebuild from the active set if edge weights changed since they were read
+    void refresh_if_edges_changed();
+    
+    // Rebuild the heap once stale entries dominate it
+    void compact_frontier();
 };
 
 } // namespace melvin
-
@@ -0,0 +1,98 @@
+/**
+ * @file test_adaptive_filter.cpp
+ * @brief Tests for AdaptiveFilter motion gating
+ *
+ * A frame counts as motion when its SAD against the last captured frame
+ * exceeds the frame budget, or one block exceeds its own budget. Covers
+ * frames exactly at and one past the frame budget, on the default 16x16
+ * payload and on a 640x480 frame whose change sits on the coarse pass's
+ * sampled rows, plus localized motion in a single block.
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "src/intake/AdaptiveFilter.h"
+
+using namespace melvin;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  PASS  " : "  FAIL  ") << what << "\n";
+    if (!condition) failures++;
+}
+
+// Adds `sad` to the frame one unit per byte, cycling over every row_step-th row
+std::vector<uint8_t> perturb(const std::vector<uint8_t>& frame, size_t row_bytes, size_t row_step, uint64_t sad) {
+    std::vector<uint8_t> changed = frame;
+    size_t rows = frame.size() / row_bytes;
+    while (sad > 0) {
+        for (size_t row = 0; row < rows && sad > 0; row += row_step) {
+            for (size_t i = 0; i < row_bytes && sad > 0; ++i, --sad) {
+                changed[row * row_bytes + i]++;
+            }
+        }
+    }
+    return changed;
+}
+
+// Fresh filter primed with `base`, then asked about `frame`
+bool captures(size_t width, size_t height, const std::vector<uint8_t>& base, const std::vector<uint8_t>& frame) {
+    AdaptiveFilter filter(width, height, 3);
+    filter.should_capture_vision(base.data(), base.size());
+    return filter.should_capture_vision(frame.data(), frame.size());
+}
+
+void check_budget_boundary(size_t width, size_t height, size_t row_step, const std::string& label) {
+    AdaptiveFilter filter(width, height, 3);
+    uint64_t budget = filter.frame_sad_budget();
+    size_t row_bytes = width * 3;
+    std::vector<uint8_t> base(filter.frame_bytes(), 100);
+
+    check(!captures(width, height, base, base), label + ": unchanged frame skipped");
+    check(!captures(width, height, base, perturb(base, row_bytes, row_step, budget)),
+          label + ": SAD at budget (" + std::to_string(budget) + ") skipped");
+    check(captures(width, height, base, perturb(base, row_bytes, row_step, budget + 1)),
+          label + ": SAD one past budget captured");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Adaptive filter tests\n";
+
+    // 1. Default 16x16 payload: the exact pass decides alone
+    check_budget_boundary(16, 16, 1, "16x16");
+
+    // 2. Large frame, change only on rows the coarse pass samples
+    check_budget_boundary(640, 480, 4, "640x480 sampled rows");
+
+    // 3. Large frame, change only on rows the coarse pass skips
+    check_budget_boundary(640, 480, 2, "640x480 alternate rows");
+
+    // 4. Localized motion: one block well past its budget, frame total under
+    {
+        AdaptiveFilter filter(640, 480, 3);
+        std::vector<uint8_t> base(filter.frame_bytes(), 100);
+        std::vector<uint8_t> frame = base;
+        size_t row_bytes = 640 * 3;
+        uint64_t sad = 0;
+        for (size_t y = 0; y < 16; ++y) {
+            for (size_t x = 0; x < 16 * 3; ++x) {
+                frame[(32 + y) * row_bytes + 96 + x] = 200;
+                sad += 100;
+            }
+        }
+        check(sad < filter.frame_sad_budget(), "localized change is under the frame budget");
+        check(captures(640, 480, base, frame), "localized motion in one block captured");
+    }
+
+    std::cout << "\n" << (failures == 0 ? "All adaptive filter tests passed"
+                                        : "Adaptive filter tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+/**
+ * @file test_audio_persistence.cpp
+ * @brief Round-trip tests for AudioGraphLayer binary persistence
+ *
+ * Covers full snapshots, incremental delta saves, torn journal tails (and
+ * deltas saved after loading one), corrupt files, and load time for a
+ * larger graph.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "core/audio/audio_graph_layer.h"
+
+using namespace melvin::audio;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  PASS  " : "  FAIL  ") << what << "\n";
+    if (!condition) failures++;
+}
+
+std::vector<float> make_mel(int seed) {
+    std::vector<float> mel(80);
+    for (size_t i = 0; i < mel.size(); ++i) {
+        mel[i] = std::sin(0.1f * static_cast<float>(i + 1) * static_cast<float>(seed));
+    }
+    return mel;
+}
+
+void teach(AudioGraphLayer& layer, int first, int count) {
+    for (int i = first; i < first + count; ++i) {
+        std::string word = "word" + std::to_string(i);
+        std::vector<float> embedding(16, 0.01f * i);
+        std::vector<uint64_t> concepts = {static_cast<uint64_t>(i), static_cast<uint64_t>(i + 1)};
+        layer.learn_from_speech_input(word, embedding, make_mel(i), concepts);
+        layer.learn_from_speech_output(word, make_mel(i + 7), concepts);
+        layer.learn_phoneme_pattern(word, make_mel(i + 3), concepts);
+    }
+}
+
+// Compares two layers through the public query API
+bool same_graph(AudioGraphLayer& a, AudioGraphLayer& b, int concepts) {
+    auto sa = a.get_stats();
+    auto sb = b.get_stats();
+    if (sa.total_audio_nodes != sb.total_audio_nodes ||
+        sa.total_phoneme_patterns != sb.total_phoneme_patterns ||
+        sa.total_associations != sb.total_associations ||
+        sa.inputs_processed != sb.inputs_processed ||
+        sa.outputs_processed != sb.outputs_processed ||
+        std::fabs(sa.average_confidence - sb.average_confidence) > 1e-6f) {
+        return false;
+    }
+    for (int c = 0; c <= concepts; ++c) {
+        auto audio_a = a.get_audio_for_concept(c);
+        auto audio_b = b.get_audio_for_concept(c);
+        if (audio_a != audio_b) return false;
+        for (uint64_t id : audio_a) {
+            if (a.get_concepts_for_audio(id) != b.get_concepts_for_audio(id)) return false;
+            if (a.get_association_strength(id, c) != b.get_association_strength(id, c)) return false;
+        }
+        if (a.generate_audio_from_concepts({static_cast<uint64_t>(c)}, 0.0f) !=
+            b.generate_audio_from_concepts({static_cast<uint64_t>(c)}, 0.0f)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main() {
+    std::string dir = "/tmp/melvin_audio_persistence_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+    std::string path = dir + "/audio_graph.bin";
+
+    std::cout << "AudioGraphLayer persistence\n\n";
+
+    // 1. Full snapshot round trip
+    AudioGraphLayer original;
+    teach(original, 0, 50);
+    check(original.save_to_file(path), "snapshot saved");
+    {
+        AudioGraphLayer loaded;
+        check(loaded.load_from_file(path), "snapshot loaded");
+        check(same_graph(original, loaded, 51), "snapshot round trip matches");
+    }
+
+    // 2. Incremental saves replay on top of the snapshot
+    teach(original, 40, 30);   // Updates existing nodes and adds new ones
+    check(original.save_incremental(path), "first delta appended");
+    teach(original, 70, 5);
+    check(original.save_incremental(path), "second delta appended");
+    check(std::filesystem::exists(path + ".delta"), "delta journal exists");
+    {
+        AudioGraphLayer loaded;
+        check(loaded.load_from_file(path), "snapshot + deltas loaded");
+        check(same_graph(original, loaded, 76), "incremental round trip matches");
+
+        // Loaded layer continues the same journal
+        teach(loaded, 76, 3);
+        teach(original, 76, 3);
+        check(loaded.save_incremental(path), "delta appended after reload");
+        AudioGraphLayer reloaded;
+        check(reloaded.load_from_file(path), "reloaded");
+        check(same_graph(original, reloaded, 80), "journal continued after reload");
+    }
+
+    // 3. A torn trailing record is ignored
+    {
+        std::ofstream journal(path + ".delta", std::ios::binary | std::ios::app);
+        const char garbage[] = "\x44\x44\x41\x4d\x01\x00\x00\x00partial";
+        journal.write(garbage, sizeof(garbage) - 1);
+    }
+    {
+        AudioGraphLayer loaded;
+        check(loaded.load_from_file(path), "load with torn journal tail");
+        check(same_graph(original, loaded, 80), "torn tail ignored");
+
+        // Deltas saved after that load must replay past the old tear
+        teach(loaded, 80, 20);
+        teach(original, 80, 20);
+        check(loaded.save_incremental(path), "delta appended after torn tail");
+        AudioGraphLayer reloaded;
+        check(reloaded.load_from_file(path), "reloaded after torn tail");
+        check(same_graph(original, reloaded, 100), "delta after torn tail replayed");
+    }
+
+    // 4. A full save folds the journal in
+    check(original.save_to_file(path), "compacting snapshot saved");
+    check(!std::filesystem::exists(path + ".delta"), "journal removed after snapshot");
+    {
+        AudioGraphLayer loaded;
+        check(loaded.load_from_file(path), "compacted snapshot loaded");
+        check(same_graph(original, loaded, 100), "compacted round trip matches");
+    }
+
+    // 5. Corrupt files are rejected and leave state untouched
+    {
+        std::string bad = dir + "/corrupt.bin";
+        std::filesystem::copy_file(path, bad);
+        std::filesystem::resize_file(bad, std::filesystem::file_size(bad) / 2);
+        AudioGraphLayer loaded;
+        teach(loaded, 0, 3);
+        auto before = loaded.get_stats();
+        check(!loaded.load_from_file(bad), "truncated file rejected");
+        check(loaded.get_stats().total_audio_nodes == before.total_audio_nodes, "state untouched on failure");
+
+        std::ofstream junk(dir + "/junk.bin", std::ios::binary);
+        junk << "not an audio graph";
+        junk.close();
+        check(!loaded.load_from_file(dir + "/junk.bin"), "foreign file rejected");
+    }
+
+    // 6. Load time for a larger graph
+    {
+        AudioGraphLayer big;
+        teach(big, 0, 5000);
+        std::string big_path = dir + "/big.bin";
+        big.save_to_file(big_path);
+
+        AudioGraphLayer loaded;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = loaded.load_from_file(big_path);
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        check(ok && loaded.get_stats().total_audio_nodes == big.get_stats().total_audio_nodes,
+              "5000-word graph loaded in " + std::to_string(ms) + " ms (" +
+              std::to_string(std::filesystem::file_size(big_path) / 1024) + " KB)");
+    }
+
+    std::filesystem::remove_all(dir);
+
+    std::cout << "\n" << (failures == 0 ? "All persistence tests passed" : "Persistence tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file test_consolidation.cpp
+ * @brief Tests for node merging and replay in consolidation passes
+ *
+ * Covers the merge map the Consolidator hands out (batch and incremental),
+ * word lookups on UnifiedIntelligence after a merging pass has folded two
+ * concepts (the merged word must resolve to the surviving node), the
+ * default live pass leaving words with the runtime's hashed embeddings
+ * apart, edge weights staying in [0, 1] under replayed successes and
+ * failures, EdgeIndex lookups on lists that change between lookups, and
+ * incremental steps staying within their budget on one oversized bucket.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/reasoning/consolidation.h"
+#include "core/unified_intelligence.h"
+
+using namespace melvin::reasoning;
+using namespace melvin::intelligence;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  PASS  " : "  FAIL  ") << what << "\n";
+    if (!condition) failures++;
+}
+
+struct KnowledgeBase {
+    std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
+    std::unordered_map<int, std::vector<float>> embeddings;
+    std::unordered_map<std::string, int> word_to_id;
+    std::unordered_map<int, std::string> id_to_word;
+};
+
+// Unrelated random concepts, plus "automobile" as a near-copy of "car"
+KnowledgeBase make_knowledge_base() {
+    static const char* words[] = {
+        "car", "tree", "river", "music", "stone", "cloud", "bread", "light", "engine", "garden"
+    };
+    KnowledgeBase kb;
+    std::mt19937 rng(11);
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+
+    int id = 0;
+    for (const char* word : words) {
+        std::vector<float> embedding(64);
+        for (float& x : embedding) x = gauss(rng);
+        kb.embeddings[id] = embedding;
+        kb.word_to_id[word] = id;
+        kb.id_to_word[id] = word;
+        id++;
+    }
+    std::vector<float> near_car = kb.embeddings[0];
+    for (float& x : near_car) x += 0.01f * gauss(rng);
+    kb.embeddings[id] = near_car;
+    kb.word_to_id["automobile"] = id;
+    kb.id_to_word[id] = "automobile";
+
+    for (const auto& [node, _] : kb.embeddings) {
+        int next = (node + 1) % static_cast<int>(kb.embeddings.size());
+        kb.graph[node].push_back({next, 0.5f});
+    }
+    return kb;
+}
+
+// Words embedded the way the runtime does it (UnifiedIntelligence and
+// melvin_jetson's loader): sin(hash + i) placeholders, nearly all pairwise
+// cosines close to +-1
+KnowledgeBase make_runtime_knowledge_base() {
+    static const char* words[] = {
+        "car", "tree", "river", "music", "stone", "cloud", "bread", "light", "engine", "garden",
+        "dog", "cat", "house", "water", "fire", "book", "phone", "chair", "table", "window",
+        "road", "rain", "sun", "moon", "star"
+    };
+    KnowledgeBase kb;
+    int id = 0;
+    for (const char* word : words) {
+        size_t hash = std::hash<std::string>{}(word);
+        std::vector<float> embedding(128);
+        for (size_t i = 0; i < embedding.size(); i++) {
+            embedding[i] = std::sin(static_cast<float>(hash + i) * 0.01f);
+        }
+        kb.embeddings[id] = embedding;
+        kb.word_to_id[word] = id;
+        kb.id_to_word[id] = word;
+        kb.graph[id].push_back({(id + 1) % 25, 0.5f});
+        id++;
+    }
+    return kb;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Consolidation merge tests\n";
+
+    // 1. Batch merge reports merged ids
+    {
+        KnowledgeBase kb = make_knowledge_base();
+        int automobile = kb.word_to_id["automobile"];
+        Consolidator consolidator;
+        consolidator.merge_similar_nodes(kb.graph, kb.embeddings);
+        auto merged = consolidator.take_merged_nodes();
+        check(merged.size() == 1 && merged.count(automobile) && merged[automobile] == 0,
+              "batch merge folds automobile into car");
+        check(!kb.graph.count(automobile) && !kb.embeddings.count(automobile), "merged node erased");
+        check(consolidator.take_merged_nodes().empty(), "merge map handed out once");
+    }
+
+    // 2. Incremental pass hands out the same map
+    {
+        KnowledgeBase kb = make_knowledge_base();
+        int automobile = kb.word_to_id["automobile"];
+        Consolidator consolidator;
+        consolidator.begin_consolidation({}, true);
+        std::unordered_map<int, int> merged;
+        while (consolidator.consolidation_active()) {
+            consolidator.consolidate_step(kb.graph, kb.embeddings, 3);
+            for (const auto& entry : consolidator.take_merged_nodes()) merged.insert(entry);
+        }
+        check(merged.size() == 1 && merged.count(automobile) && merged[automobile] == 0,
+              "incremental pass folds automobile into car");
+    }
+
+    // 3. Word lookups after a merging pass resolve to nodes that still exist
+    {
+        KnowledgeBase kb = make_knowledge_base();
+        UnifiedIntelligence intelligence;
+        intelligence.initialize(kb.graph, kb.embeddings, kb.word_to_id, kb.id_to_word);
+
+        intelligence.begin_consolidation(true);
+        while (intelligence.consolidation_active()) {
+            intelligence.consolidate_step(5);
+        }
+
+        int car = intelligence.add_concept("car", kb.embeddings[0]);
+        int automobile = intelligence.add_concept("automobile", kb.embeddings[0]);
+        check(car == 0 && automobile == car, "merged concept looks up the surviving node");
+
+        int fresh = intelligence.add_concept("bicycle", std::vector<float>(64, 0.1f));
+        check(fresh != car && fresh != kb.word_to_id["automobile"], "new concepts get unused ids");
+
+        UnifiedResult result = intelligence.reason("what is an automobile");
+        check(!result.answer.empty(), "reasoning over the merged word answers");
+    }
+
+    // 4. The live pass over the runtime's hashed embeddings merges nothing
+    {
+        KnowledgeBase kb = make_runtime_knowledge_base();
+        UnifiedIntelligence intelligence;
+        intelligence.initialize(kb.graph, kb.embeddings, kb.word_to_id, kb.id_to_word);
+
+        intelligence.begin_consolidation();
+        while (intelligence.consolidation_active()) {
+            intelligence.consolidate_step(5);
+        }
+
+        std::unordered_map<int, std::string> owner;
+        bool distinct = true;
+        for (const auto& [word, id] : kb.word_to_id) {
+            int found = intelligence.add_concept(word, kb.embeddings[id]);
+            distinct = distinct && found == id && owner.emplace(found, word).second;
+        }
+        check(distinct, std::to_string(kb.word_to_id.size()) + " unrelated words keep their own nodes");
+    }
+
+    // 5. Replayed failures weaken edges without pushing them below zero
+    {
+        std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
+        graph[0] = {{1, 0.02f}, {2, 0.98f}};
+        Consolidator consolidator;
+        Experience failure{{0, 1}, {{0, 1}}, 1.0f, 0.0f, -1.0f};
+        Experience success{{0, 2}, {{0, 2}}, 1.0f, 0.0f, 1.0f};
+        for (int i = 0; i < 20; ++i) {
+            consolidator.record_experience(failure);
+            consolidator.record_experience(success);
+        }
+        for (int i = 0; i < 10; ++i) {
+            consolidator.replay_prioritized(graph, 16);
+        }
+        check(graph[0][0].second == 0.0f, "replayed failures floor the edge at 0");
+        check(graph[0][1].second == 1.0f, "replayed successes cap the edge at 1");
+    }
+
+    // 6. EdgeIndex follows lists that grow, shrink or leave the graph
+    {
+        std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
+        graph[0] = {{1, 0.1f}, {2, 0.2f}, {1, 0.3f}};
+        EdgeIndex index;
+        std::pair<int, float>* edge = index.find(graph, 0, 1);
+        check(edge && edge->second == 0.1f, "first of duplicate edges wins");
+        check(!index.find(graph, 0, 7), "missing edge not found");
+
+        for (int dst = 3; dst < 200; ++dst) graph[0].push_back({dst, 0.5f});
+        edge = index.find(graph, 0, 150);
+        check(edge && edge == &graph[0][150], "edge appended after indexing is found");
+
+        graph[0].erase(graph[0].begin(), graph[0].begin() + 3);
+        edge = index.find(graph, 0, 3);
+        check(edge && edge == &graph[0][0] && !index.find(graph, 0, 2), "shrunk list re-indexed");
+
+        graph.erase(0);
+        check(!index.find(graph, 0, 3), "list that left the graph not found");
+        graph[0] = {{9, 0.9f}};
+        edge = index.find(graph, 0, 9);
+        check(edge && edge->second == 0.9f && !index.find(graph, 0, 3), "list that came back indexed afresh");
+    }
+
+    // 7. A bucket larger than the step budget is loaded over several steps
+    {
+        std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
+        std::unordered_map<int, std::vector<float>> embeddings;
+        for (int id = 0; id < 500; ++id) {
+            embeddings[id] = std::vector<float>(16, 1.0f);  // One bucket in every table
+            graph[id].push_back({(id + 1) % 500, 0.5f});
+        }
+        Consolidator consolidator;
+        consolidator.begin_consolidation({}, true);
+        size_t most = 0;
+        int merged = 0;
+        while (consolidator.consolidation_active()) {
+            ConsolidationProgress progress = consolidator.consolidate_step(graph, embeddings, 100);
+            most = std::max(most, progress.units);
+            merged += static_cast<int>(consolidator.take_merged_nodes().size());
+        }
+        check(most <= 100, "no step exceeds its budget (largest " + std::to_string(most) + " units)");
+        check(merged == 499 && graph.size() == 1, "identical nodes merged into one");
+    }
+
+    std::cout << "\n" << (failures == 0 ? "All consolidation merge tests passed"
+                                        : "Consolidation merge tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
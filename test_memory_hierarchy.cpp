@@ -0,0 +1,147 @@
+/**
+ * @file test_memory_hierarchy.cpp
+ * @brief Tests for indexed, cached context retrieval in MemoryHierarchy
+ *
+ * Covers a cached view matching one built from scratch (and the
+ * adjacency-map path), a cache miss once the graph version is bumped
+ * after an in-place edit, and the indexed top-k matching a brute-force
+ * cosine ranking on embeddings whose width isn't a multiple of four.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "core/reasoning/memory_hierarchy.h"
+
+using namespace melvin::reasoning;
+
+namespace {
+
+constexpr size_t DIM = 10;
+
+using Graph = std::unordered_map<int, std::vector<std::pair<int, float>>>;
+using Embeddings = std::unordered_map<int, std::vector<float>>;
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  PASS  " : "  FAIL  ") << what << "\n";
+    if (!condition) failures++;
+}
+
+bool same_view(const ContextSubgraph& a, const ContextSubgraph& b) {
+    return a.nodes == b.nodes && a.in_graph == b.in_graph &&
+           a.offsets == b.offsets && a.edges == b.edges;
+}
+
+std::vector<float> random_vector(std::mt19937& rng) {
+    std::normal_distribution<float> dist(0.0f, 1.0f);
+    std::vector<float> v(DIM);
+    for (float& x : v) x = dist(rng);
+    return v;
+}
+
+// Ids of the k most cosine-similar embeddings, best first
+std::vector<int> brute_force_top_k(const std::vector<float>& query, const Embeddings& embeddings, size_t k) {
+    std::vector<std::pair<float, int>> scored;
+    for (const auto& [id, emb] : embeddings) {
+        float dot = 0.0f, nq = 0.0f, ne = 0.0f;
+        for (size_t i = 0; i < DIM; ++i) {
+            dot += query[i] * emb[i];
+            nq += query[i] * query[i];
+            ne += emb[i] * emb[i];
+        }
+        scored.emplace_back(dot / (std::sqrt(nq) * std::sqrt(ne)), id);
+    }
+    std::sort(scored.begin(), scored.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<int> ids;
+    for (size_t i = 0; i < std::min(k, scored.size()); ++i) {
+        ids.push_back(scored[i].second);
+    }
+    return ids;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Memory hierarchy tests\n";
+
+    std::mt19937 rng(7);
+    Embeddings embeddings;
+    Graph graph;
+    std::uniform_int_distribution<int> pick(0, 199);
+    for (int id = 0; id < 200; ++id) {
+        embeddings[id] = random_vector(rng);
+        for (int e = 0; e < 6; ++e) {
+            graph[id].emplace_back(pick(rng), 0.1f * static_cast<float>(e + 1));
+        }
+    }
+    std::vector<float> query = random_vector(rng);
+    const std::vector<int> working = {3, 17, 42};
+
+    MemoryHierarchy memory;
+    memory.index_embeddings(embeddings);
+    memory.add_to_working_memory(working);
+
+    // 1. A cached view equals a fresh build
+    {
+        ContextView first = memory.retrieve_context(query, graph, 1, 20);
+        ContextView second = memory.retrieve_context(query, graph, 1, 20);
+        check(first == second && memory.cache_stats().hits == 1 && memory.cache_stats().misses == 1,
+              "same query and version: served from the cache");
+
+        MemoryHierarchy fresh;
+        fresh.index_embeddings(embeddings);
+        fresh.add_to_working_memory(working);
+        check(same_view(*second, *fresh.retrieve_context(query, graph, 1, 20)),
+              "cached view equals a fresh build");
+
+        MemoryHierarchy unindexed;
+        unindexed.add_to_working_memory(working);
+        check(second->to_map() == unindexed.build_context_subgraph(query, graph, embeddings, 20),
+              "view matches build_context_subgraph");
+    }
+
+    // 2. An in-place edit under a new version misses and is seen
+    {
+        ContextView before = memory.retrieve_context(query, graph, 1, 20);
+        int node = before->nodes.front();
+        int target = before->nodes.back();
+        graph[node].emplace_back(target, 0.9f);
+
+        size_t misses = memory.cache_stats().misses;
+        ContextView after = memory.retrieve_context(query, graph, 2, 20);
+        check(memory.cache_stats().misses == misses + 1, "new graph version: cache miss");
+
+        MemoryHierarchy fresh;
+        fresh.index_embeddings(embeddings);
+        fresh.add_to_working_memory(working);
+        check(same_view(*after, *fresh.retrieve_context(query, graph, 2, 20)) &&
+              after->edges.size() == before->edges.size() + 1,
+              "view after the edit equals a fresh build");
+    }
+
+    // 3. Indexed top-k matches a brute-force cosine ranking
+    {
+        MemoryHierarchy retrieval;
+        retrieval.index_embeddings(embeddings);
+        bool matches = true;
+        for (int trial = 0; trial < 20; ++trial) {
+            std::vector<float> q = random_vector(rng);
+            for (int k : {1, 5, 20}) {
+                ContextView view = retrieval.retrieve_context(q, graph, 1, k);
+                matches = matches && view->nodes == brute_force_top_k(q, embeddings, static_cast<size_t>(k));
+            }
+        }
+        check(matches, "top-k equals brute-force cosine (k = 1, 5, 20)");
+    }
+
+    std::cout << "\n" << (failures == 0 ? "All memory hierarchy tests passed"
+                                        : "Memory hierarchy tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_pipelined_vision.cpp
+ * @brief Tests for PipelinedVision and its Stage 1 tile pool
+ *
+ * Every frame runs one tile round on the pool, so thousands of small frames
+ * give thousands of back-to-back rounds. Covers frames run in lockstep
+ * (results must match the sequential stages exactly), a burst of frames
+ * submitted without waiting, and pools of different sizes.
+ */
+
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "core/vision/vision_pipeline.h"
+#include "core/vision/pipelined_vision.h"
+
+using namespace melvin::vision;
+
+namespace {
+
+constexpr int WIDTH = 160;
+constexpr int HEIGHT = 120;
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  PASS  " : "  FAIL  ") << what << "\n";
+    if (!condition) failures++;
+}
+
+std::vector<cv::Mat> make_frames(int count) {
+    std::vector<cv::Mat> frames;
+    cv::RNG rng(7);
+    for (int i = 0; i < count; ++i) {
+        cv::Mat frame(HEIGHT, WIDTH, CV_8UC3, cv::Scalar(90, 120, 150));
+        cv::rectangle(frame, cv::Rect((3 * i) % (WIDTH - 40), 30, 40, 40), cv::Scalar(0, 0, 220), cv::FILLED);
+        cv::rectangle(frame, cv::Rect(100, (2 * i) % (HEIGHT - 50), 30, 50), cv::Scalar(200, 40, 40), cv::FILLED);
+        cv::Mat noise(frame.size(), CV_8UC3);
+        rng.fill(noise, cv::RNG::UNIFORM, 0, 12);
+        frame += noise;
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+struct Summary {
+    int nodes_created = 0;
+    int nodes_reused = 0;
+    size_t edges = 0;
+
+    bool operator==(const Summary& other) const {
+        return nodes_created == other.nodes_created && nodes_reused == other.nodes_reused &&
+               edges == other.edges;
+    }
+};
+
+std::vector<Summary> run_sequential(const std::vector<cv::Mat>& frames) {
+    Stage1_VisionInput stage1;
+    Stage2_Tokenize stage2;
+    Stage3_Connect stage3;
+    Stage5_Generalize stage5;
+    cv::Point2f focus(-1, -1);
+
+    std::vector<Summary> summaries;
+    for (const cv::Mat& frame : frames) {
+        auto tokenized = stage2.process(stage1.process(frame, focus));
+        focus = tokenized.focus_point;
+        auto connected = stage3.process(tokenized);
+        stage5.process(connected);
+        summaries.push_back({tokenized.nodes_created, tokenized.nodes_reused, connected.edges.size()});
+    }
+    return summaries;
+}
+
+// Submits each frame once the previous one has come out of Stage 5
+std::vector<Summary> run_lockstep(const std::vector<cv::Mat>& frames, const PipelinedVision::Config& config) {
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::vector<Summary> summaries;
+
+    PipelinedVision pipeline(config);
+    pipeline.set_result_callback([&](const PipelinedVision::Result& result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        summaries.push_back({result.nodes_created, result.nodes_reused, result.edges});
+        finished.notify_all();
+    });
+
+    for (size_t i = 0; i < frames.size(); ++i) {
+        pipeline.submit(frames[i]);
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [&] { return summaries.size() > i; });
+    }
+    pipeline.stop();
+    return summaries;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Pipelined vision tests\n";
+
+    std::vector<cv::Mat> frames = make_frames(2000);
+    std::vector<Summary> expected = run_sequential(frames);
+
+    // 1. Lockstep: one tile round per frame, each right after the last
+    {
+        PipelinedVision::Config config;
+        config.tile_threads = 4;
+        config.tiles_per_frame = 8;
+        check(run_lockstep(frames, config) == expected,
+              std::to_string(frames.size()) + " lockstep frames match sequential stages");
+    }
+
+    // 2. More tile threads than tiles: most workers wake to a finished round
+    {
+        PipelinedVision::Config config;
+        config.tile_threads = 16;
+        config.tiles_per_frame = 2;
+        std::vector<cv::Mat> head(frames.begin(), frames.begin() + 500);
+        std::vector<Summary> head_expected(expected.begin(), expected.begin() + 500);
+        check(run_lockstep(head, config) == head_expected, "oversubscribed tile pool matches");
+    }
+
+    // 3. Burst: frames submitted back to back, stale ones dropped
+    {
+        PipelinedVision::Config config;
+        config.tile_threads = 4;
+        PipelinedVision pipeline(config);
+        for (const cv::Mat& frame : frames) {
+            pipeline.submit(frame);
+        }
+        pipeline.stop();
+        PipelinedVision::Stats stats = pipeline.get_stats();
+        check(stats.submitted == frames.size() && stats.completed + stats.dropped == stats.submitted,
+              "burst: every frame completed or dropped (" + std::to_string(stats.completed) +
+              " completed, " + std::to_string(stats.dropped) + " dropped)");
+        check(stats.stages[0].processed >= stats.completed, "Stage 1 ran a tile round per frame");
+    }
+
+    std::cout << "\n" << (failures == 0 ? "All pipelined vision tests passed"
+                                        : "Pipelined vision tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
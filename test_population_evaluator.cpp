@@ -0,0 +1,127 @@
+/**
+ * @file test_population_evaluator.cpp
+ * @brief Tests for parallel population evaluation and evolution
+ *
+ * Covers thousands of back-to-back worker-pool rounds (including empty and
+ * single-genome rounds, where idle workers wake after the round is over),
+ * scores that don't depend on the thread count, the results cache, and
+ * PopulationEvolution driving the evaluator across generations.
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/cognitive_field/population_evaluator.h"
+#include "core/cognitive_field/population_evolution.h"
+
+using namespace melvin;
+using namespace melvin::cognitive_field;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  PASS  " : "  FAIL  ") << what << "\n";
+    if (!condition) failures++;
+}
+
+// Depends only on the genome and the trial RNG, so scores are reproducible
+float trial(const evolution::Genome& genome, size_t trial_index, std::mt19937& rng) {
+    (void)trial_index;
+    float base = static_cast<float>(PopulationEvaluator::genome_hash(genome) % 1000) / 1000.0f;
+    std::uniform_real_distribution<float> noise(0.0f, 1.0f);
+    return 0.5f * base + 0.5f * noise(rng);
+}
+
+std::vector<evolution::Genome> make_population(size_t size) {
+    std::vector<evolution::Genome> population(size);
+    for (size_t i = 1; i < population.size(); ++i) {
+        population[i].mutate();
+    }
+    return population;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "Population evaluator tests\n";
+
+    PopulationEvaluator::Config config;
+    config.cache_capacity = 0;      // Every round runs every genome
+    config.trials_per_genome = 4;
+
+    PopulationEvaluator::Config serial_config = config;
+    serial_config.num_threads = 1;
+    PopulationEvaluator serial(serial_config);
+
+    // 1. Back-to-back rounds of varying size on a shared pool
+    {
+        config.num_threads = 16;
+        PopulationEvaluator parallel(config);
+        std::vector<evolution::Genome> population = make_population(12);
+        std::vector<float> expected = serial.evaluate(population, trial);
+
+        size_t mismatched_rounds = 0;
+        const size_t rounds = 10000;
+        for (size_t round = 0; round < rounds; ++round) {
+            // Sizes 0..3 leave most workers without work; they wake late
+            size_t size = round % 5 == 4 ? population.size() : round % 4;
+            std::vector<evolution::Genome> slice(population.begin(), population.begin() + size);
+            std::vector<float> fitness = parallel.evaluate(slice, trial);
+            if (!std::equal(fitness.begin(), fitness.end(), expected.begin())) {
+                mismatched_rounds++;
+            }
+        }
+        check(mismatched_rounds == 0, std::to_string(rounds) + " back-to-back rounds match serial scores");
+        check(parallel.get_stats().rounds == rounds, "every round counted");
+    }
+
+    // 2. Pools are reusable after destruction of an earlier one
+    {
+        std::vector<evolution::Genome> population = make_population(6);
+        std::vector<float> expected = serial.evaluate(population, trial);
+        bool all_equal = true;
+        for (int i = 0; i < 50; ++i) {
+            config.num_threads = 2 + i % 6;
+            PopulationEvaluator pool(config);
+            all_equal = all_equal && pool.evaluate(population, trial) == expected;
+        }
+        check(all_equal, "scores independent of thread count");
+    }
+
+    // 3. Cache: an unchanged population costs no trials
+    {
+        PopulationEvaluator::Config cached_config;
+        cached_config.num_threads = 4;
+        PopulationEvaluator cached(cached_config);
+        std::vector<evolution::Genome> population = make_population(8);
+        std::vector<float> first = cached.evaluate(population, trial);
+        size_t trials_before = cached.get_stats().trials_run;
+        std::vector<float> second = cached.evaluate(population, trial);
+        check(first == second && cached.get_stats().trials_run == trials_before,
+              "second evaluation served from cache");
+    }
+
+    // 4. Evolution drives the evaluator once per generation
+    {
+        PopulationEvolution evolution(8, 10);
+        evolution.set_trial_function(trial);
+        evolution.initialize_population();
+        for (int generation = 0; generation < 20; ++generation) {
+            evolution.evolve();
+        }
+        std::vector<float> scores = evolution.get_all_fitness_scores();
+        bool in_range = std::all_of(scores.begin(), scores.end(),
+                                    [](float s) { return s >= 0.0f && s <= 1.0f; });
+        check(in_range && scores.size() == 8, "evolved population scored in [0, 1]");
+        check(evolution.get_evaluator().get_stats().rounds == 20, "one evaluation round per generation");
+    }
+
+    std::cout << "\n" << (failures == 0 ? "All population evaluator tests passed"
+                                        : "Population evaluator tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file test_simd_kernels.cpp
+ * @brief Tests for the packed uint16 edge weight kernels
+ *
+ * Covers scale_u16 and count_zero_u16 against a scalar reference on
+ * lengths that aren't a multiple of the vector width and on unaligned
+ * starts, weights pinned at 0 and 65535 under factors 0, 1, 32768 and
+ * 65535, and AtomicGraph::decay_all_edges matching Weight::decay per edge.
+ */
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "src/core/AtomicGraph.h"
+#include "src/core/SimdKernels.h"
+#include "src/connections/Weight.h"
+
+using namespace melvin;
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  PASS  " : "  FAIL  ") << what << "\n";
+    if (!condition) failures++;
+}
+
+std::vector<uint16_t> scale_reference(std::vector<uint16_t> w, uint16_t factor) {
+    for (uint16_t& x : w) {
+        x = static_cast<uint16_t>((static_cast<uint32_t>(x) * factor) >> 16);
+    }
+    return w;
+}
+
+size_t zero_reference(const std::vector<uint16_t>& w) {
+    size_t zeros = 0;
+    for (uint16_t x : w) zeros += x == 0;
+    return zeros;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "SIMD kernel tests\n";
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> lane(0, 65535);
+    const size_t lengths[] = {0, 1, 7, 8, 9, 15, 16, 17, 31, 1000};
+    const uint16_t factors[] = {0, 1, 32768, 65535};
+
+    // 1. scale_u16 matches the scalar reference on odd lengths and offsets
+    {
+        bool same = true;
+        for (size_t n : lengths) {
+            for (size_t offset : {0, 1, 3}) {
+                std::vector<uint16_t> buffer(n + offset);
+                for (uint16_t& x : buffer) x = static_cast<uint16_t>(lane(rng));
+                std::vector<uint16_t> lanes(buffer.begin() + offset, buffer.end());
+                uint16_t factor = static_cast<uint16_t>(lane(rng));
+                simd::scale_u16(buffer.data() + offset, factor, n);
+                same = same && std::vector<uint16_t>(buffer.begin() + offset, buffer.end()) ==
+                                   scale_reference(lanes, factor);
+            }
+        }
+        check(same, "scale_u16 equals (w * f) >> 16 on every length and offset");
+    }
+
+    // 2. Saturation: weights at 0 and 65535 under extreme factors
+    {
+        bool same = true;
+        for (size_t n : lengths) {
+            for (uint16_t factor : factors) {
+                std::vector<uint16_t> w(n);
+                for (size_t i = 0; i < n; ++i) w[i] = (i % 3 == 0) ? 0 : 65535;
+                std::vector<uint16_t> want = scale_reference(w, factor);
+                simd::scale_u16(w.data(), factor, n);
+                same = same && w == want;
+            }
+        }
+        check(same, "weights 0 and 65535 under factors 0, 1, 32768, 65535");
+
+        std::vector<uint16_t> full(17, 65535);
+        simd::scale_u16(full.data(), 65535, full.size());
+        check(full == std::vector<uint16_t>(17, 65534), "65535 * 65535 >> 16 is 65534, no wraparound");
+
+        std::vector<uint16_t> cleared(17, 65535);
+        simd::scale_u16(cleared.data(), 0, cleared.size());
+        check(cleared == std::vector<uint16_t>(17, 0), "factor 0 clears every lane, tail included");
+    }
+
+    // 3. count_zero_u16 matches the scalar count, tail included
+    {
+        bool same = true;
+        for (size_t n : lengths) {
+            std::vector<uint16_t> w(n);
+            for (uint16_t& x : w) x = static_cast<uint16_t>(lane(rng) % 4 == 0 ? 0 : lane(rng) | 1);
+            if (n > 0) w.back() = 0;
+            same = same && simd::count_zero_u16(w.data(), n) == zero_reference(w);
+        }
+        check(same, "count_zero_u16 equals the scalar count on every length");
+    }
+
+    // 4. decay_all_edges decays each edge like Weight::decay
+    {
+        AtomicGraph graph;
+        std::vector<std::vector<EdgeWeight>> weights(20);
+        for (NodeID source = 1; source <= 20; ++source) {
+            graph.add_node(std::make_unique<Node>(source, nullptr, 0, Modality::OTHER));
+            // 1..20 targets per row, so most rows have a scalar tail
+            for (NodeID target = 1; target <= source; ++target) {
+                EdgeWeight w = (target % 5 == 0) ? 1 : (target % 7 == 0) ? 65535 : static_cast<EdgeWeight>(lane(rng));
+                graph.add_edge(source, target, w);
+                weights[source - 1].push_back(w);
+            }
+        }
+
+        const float rate = 0.5f;
+        size_t zeros = graph.decay_all_edges(rate);
+        bool same = true;
+        size_t want_zeros = 0;
+        for (NodeID source = 1; source <= 20; ++source) {
+            for (NodeID target = 1; target <= source; ++target) {
+                EdgeWeight want = Weight::decay(weights[source - 1][target - 1], rate);
+                same = same && graph.get_edge_weight(source, target) == want;
+                want_zeros += want == 0;
+            }
+        }
+        check(same, "every edge weight equals Weight::decay");
+        check(zeros == want_zeros && zeros > 0, "returns the number of edges decayed to zero");
+        check(graph.decay_all_edges(1.0f) == 0, "rate 1 leaves the weights alone");
+    }
+
+    std::cout << "\n" << (failures == 0 ? "All SIMD kernel tests passed"
+                                        : "SIMD kernel tests FAILED")
+              << "\n";
+    return failures == 0 ? 0 : 1;
+}
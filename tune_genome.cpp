@@ -0,0 +1,401 @@
+/**
+ * @file tune_genome.cpp
+ * @brief Offline genome tuning harness
+ *
+ * Replays a recorded query trace against IntelligentReasoner for many
+ * candidate genomes and reports the Pareto front of latency vs answer
+ * quality, instead of tuning live against whatever traffic arrives.
+ *
+ * Search: successive halving. All candidates run on a short prefix of the
+ * trace; the best 1/eta (by Pareto rank, then quality) advance to a prefix
+ * eta times longer, until the survivors run the full trace. Candidates are
+ * evaluated in parallel, each on its own reasoner instance.
+ *
+ * Trace format (TSV, '#' comments):
+ *   query<TAB>expected_concept[,expected_concept...]
+ * Quality is the fraction of expected concepts among the top-10 scored
+ * nodes (answer confidence when a line lists none).
+ *
+ * Usage:
+ *   tune_genome --nodes data/nodes.tsv --edges data/edges.tsv --trace q.tsv
+ *               [--candidates 27] [--eta 3] [--threads N] [--seed S]
+ *               [--gene name:lo:hi ...] [--out logs/tuning]
+ *
+ * Latency is wall time per answer(); use --threads 1 for uncontended numbers.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include "core/reasoning/intelligent_reasoner.h"
+#include "core/language/intent_classifier.h"
+#include "storage/graph_loader.h"
+
+using namespace melvin;
+
+namespace {
+
+struct GeneRange {
+    std::string name;
+    float lo;
+    float hi;
+};
+
+struct TraceQuery {
+    std::string query;
+    std::vector<std::string> expected;
+};
+
+struct KnowledgeBase {
+    std::unordered_map<int, std::vector<std::pair<int, float>>> graph;
+    std::unordered_map<int, std::vector<float>> embeddings;
+    std::unordered_map<std::string, int> word_to_id;
+    std::unordered_map<int, std::string> id_to_word;
+};
+
+struct Candidate {
+    std::vector<float> genes;
+    size_t budget = 0;          // Queries replayed in the latest evaluation
+    float quality = 0.0f;
+    float mean_latency_ms = 0.0f;
+    float p95_latency_ms = 0.0f;
+};
+
+// Scoring/traversal genes that drive answer quality and latency
+const std::vector<GeneRange> DEFAULT_RANGES = {
+    {"activation_weight", 0.1f, 0.8f},
+    {"semantic_bias_weight", 0.1f, 0.8f},
+    {"coherence_weight", 0.0f, 0.5f},
+    {"temperature", 0.3f, 2.0f},
+    {"semantic_threshold", 0.1f, 0.6f},
+    {"hop_decay", 0.7f, 0.95f},
+    {"activation_threshold", 0.05f, 0.3f},
+    {"spreading_factor", 0.5f, 0.95f},
+};
+
+bool ends_with(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+bool load_knowledge(const std::string& nodes_path, const std::string& edges_path, KnowledgeBase& kb) {
+    storage::GraphLoader loader;
+    std::unordered_map<int, float> priors;
+
+    bool ok = ends_with(nodes_path, ".bin")
+        ? loader.LoadNodesBIN(nodes_path, kb.id_to_word, kb.word_to_id, priors)
+        : loader.LoadNodesTSV(nodes_path, kb.id_to_word, kb.word_to_id, priors);
+    ok = ok && (ends_with(edges_path, ".bin")
+        ? loader.LoadEdgesBIN(edges_path, kb.graph)
+        : loader.LoadEdgesTSV(edges_path, kb.graph));
+    if (!ok) return false;
+
+    for (const auto& [id, label] : kb.id_to_word) {
+        kb.embeddings[id] = language::compute_simple_embedding(language::tokenize(label));
+    }
+    return true;
+}
+
+bool load_trace(const std::string& path, std::vector<TraceQuery>& trace) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        TraceQuery entry;
+        size_t tab = line.find('\t');
+        entry.query = line.substr(0, tab);
+        if (tab != std::string::npos) {
+            std::stringstream ss(line.substr(tab + 1));
+            std::string concept;
+            while (std::getline(ss, concept, ',')) {
+                if (!concept.empty()) entry.expected.push_back(concept);
+            }
+        }
+        trace.push_back(std::move(entry));
+    }
+    return !trace.empty();
+}
+
+bool parse_range(const std::string& spec, GeneRange& range) {
+    size_t a = spec.find(':');
+    size_t b = spec.find(':', a + 1);
+    if (a == std::string::npos || b == std::string::npos) return false;
+    range.name = spec.substr(0, a);
+    range.lo = std::stof(spec.substr(a + 1, b - a - 1));
+    range.hi = std::stof(spec.substr(b + 1));
+    return range.lo <= range.hi;
+}
+
+// Replay the first `budget` queries on a fresh reasoner with this genome
+void evaluate(Candidate& candidate, size_t budget,
+              const std::vector<GeneRange>& ranges,
+              const std::vector<TraceQuery>& trace,
+              const KnowledgeBase& kb) {
+    reasoning::IntelligentReasoner reasoner;
+    reasoner.initialize(kb.graph, kb.embeddings, kb.word_to_id, kb.id_to_word);
+    for (size_t g = 0; g < ranges.size(); ++g) {
+        reasoner.genome().set_gene(ranges[g].name, candidate.genes[g]);
+    }
+    reasoner.genome().reasoning_params().normalize_weights();
+
+    std::vector<float> latencies;
+    latencies.reserve(budget);
+    float quality_sum = 0.0f;
+
+    for (size_t q = 0; q < budget; ++q) {
+        const TraceQuery& entry = trace[q];
+
+        auto start = std::chrono::steady_clock::now();
+        reasoning::ReasoningResult result = reasoner.answer(entry.query);
+        auto end = std::chrono::steady_clock::now();
+        latencies.push_back(std::chrono::duration<float, std::milli>(end - start).count());
+
+        if (entry.expected.empty()) {
+            quality_sum += result.confidence;
+            continue;
+        }
+
+        std::unordered_set<std::string> top;
+        for (const auto& node : result.top_nodes) {
+            auto it = kb.id_to_word.find(node.node_id);
+            if (it != kb.id_to_word.end()) top.insert(it->second);
+        }
+        size_t hits = 0;
+        for (const auto& concept : entry.expected) {
+            hits += top.count(concept);
+        }
+        quality_sum += static_cast<float>(hits) / entry.expected.size();
+    }
+
+    candidate.budget = budget;
+    candidate.quality = quality_sum / budget;
+
+    float total = 0.0f;
+    for (float l : latencies) total += l;
+    candidate.mean_latency_ms = total / budget;
+
+    std::sort(latencies.begin(), latencies.end());
+    candidate.p95_latency_ms = latencies[std::min(latencies.size() - 1, latencies.size() * 95 / 100)];
+}
+
+void evaluate_all(std::vector<Candidate>& candidates, size_t budget, size_t threads,
+                  const std::vector<GeneRange>& ranges,
+                  const std::vector<TraceQuery>& trace,
+                  const KnowledgeBase& kb) {
+    std::atomic<size_t> next{0};
+    auto worker = [&] {
+        for (size_t i = next.fetch_add(1); i < candidates.size(); i = next.fetch_add(1)) {
+            evaluate(candidates[i], budget, ranges, trace, kb);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < std::min(threads, candidates.size()); ++t) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) thread.join();
+}
+
+// Maximize quality, minimize p95 latency
+bool dominates(const Candidate& a, const Candidate& b) {
+    return a.quality >= b.quality && a.p95_latency_ms <= b.p95_latency_ms &&
+           (a.quality > b.quality || a.p95_latency_ms < b.p95_latency_ms);
+}
+
+std::vector<int> pareto_ranks(const std::vector<Candidate>& candidates) {
+    std::vector<int> rank(candidates.size(), -1);
+    size_t assigned = 0;
+    for (int level = 0; assigned < candidates.size(); ++level) {
+        std::vector<size_t> front;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (rank[i] >= 0) continue;
+            bool dominated = false;
+            for (size_t j = 0; j < candidates.size() && !dominated; ++j) {
+                dominated = rank[j] < 0 && j != i &&
+                            dominates(candidates[j], candidates[i]);
+            }
+            if (!dominated) front.push_back(i);
+        }
+        for (size_t i : front) rank[i] = level;
+        assigned += front.size();
+    }
+    return rank;
+}
+
+void print_candidate(const Candidate& c, const std::vector<GeneRange>& ranges) {
+    std::cout << "  quality " << std::fixed << std::setprecision(3) << c.quality
+              << "  p95 " << std::setprecision(2) << c.p95_latency_ms << " ms"
+              << "  mean " << c.mean_latency_ms << " ms  |";
+    for (size_t g = 0; g < ranges.size(); ++g) {
+        std::cout << " " << ranges[g].name << "=" << std::setprecision(3) << c.genes[g];
+    }
+    std::cout << "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string nodes_path = "data/nodes.tsv";
+    std::string edges_path = "data/edges.tsv";
+    std::string trace_path;
+    std::string out_dir = "logs/tuning";
+    size_t num_candidates = 27;
+    size_t eta = 3;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t seed = 42;
+    std::vector<GeneRange> ranges;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto next = [&]() -> std::string { return (i + 1 < argc) ? argv[++i] : ""; };
+        if (arg == "--nodes") nodes_path = next();
+        else if (arg == "--edges") edges_path = next();
+        else if (arg == "--trace") trace_path = next();
+        else if (arg == "--out") out_dir = next();
+        else if (arg == "--candidates") num_candidates = std::max(1, std::stoi(next()));
+        else if (arg == "--eta") eta = std::max(2, std::stoi(next()));
+        else if (arg == "--threads") threads = std::max(1, std::stoi(next()));
+        else if (arg == "--seed") seed = static_cast<uint32_t>(std::stoul(next()));
+        else if (arg == "--gene") {
+            GeneRange range;
+            if (!parse_range(next(), range)) {
+                std::cerr << "❌ Bad --gene spec (expected name:lo:hi)\n";
+                return 1;
+            }
+            if (!evolution::DynamicGenome().has_gene(range.name)) {
+                std::cerr << "❌ Unknown gene: " << range.name << "\n";
+                return 1;
+            }
+            ranges.push_back(range);
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return 1;
+        }
+    }
+    if (ranges.empty()) ranges = DEFAULT_RANGES;
+
+    if (trace_path.empty()) {
+        std::cerr << "Usage: tune_genome --trace queries.tsv [--nodes F] [--edges F] "
+                     "[--candidates N] [--eta K] [--threads T] [--seed S] "
+                     "[--gene name:lo:hi ...] [--out DIR]\n";
+        return 1;
+    }
+
+    KnowledgeBase kb;
+    if (!load_knowledge(nodes_path, edges_path, kb)) {
+        std::cerr << "❌ Cannot load graph from " << nodes_path << " / " << edges_path << "\n";
+        return 1;
+    }
+    std::vector<TraceQuery> trace;
+    if (!load_trace(trace_path, trace)) {
+        std::cerr << "❌ Cannot load trace " << trace_path << "\n";
+        return 1;
+    }
+
+    std::cout << "🧬 Tuning " << ranges.size() << " genes over " << trace.size() << " queries ("
+              << kb.id_to_word.size() << " nodes, " << num_candidates << " candidates, "
+              << threads << " threads)\n";
+
+    // Candidate 0 is the current default genome, the rest are uniform samples
+    std::mt19937 rng(seed);
+    std::vector<Candidate> candidates(num_candidates);
+    {
+        evolution::DynamicGenome defaults;
+        for (size_t c = 0; c < num_candidates; ++c) {
+            for (const auto& range : ranges) {
+                std::uniform_real_distribution<float> dist(range.lo, range.hi);
+                candidates[c].genes.push_back(c == 0 ? defaults.get_gene(range.name) : dist(rng));
+            }
+        }
+    }
+
+    // Successive halving: the first rung's budget is sized so the last
+    // (at most eta) survivors reach the full trace together
+    size_t rungs = 0;
+    for (size_t n = num_candidates; n > eta; n = (n + eta - 1) / eta) rungs++;
+    size_t budget = trace.size();
+    for (size_t r = 0; r < rungs && budget > 1; ++r) budget = (budget + eta - 1) / eta;
+
+    while (true) {
+        evaluate_all(candidates, budget, threads, ranges, trace, kb);
+        std::cout << "📊 Rung: " << candidates.size() << " candidates x " << budget << " queries\n";
+
+        if (budget >= trace.size() && candidates.size() <= eta) break;
+        budget = std::min(trace.size(), budget * eta);
+        if (candidates.size() <= eta) continue;
+
+        std::vector<int> rank = pareto_ranks(candidates);
+        std::vector<size_t> order(candidates.size());
+        for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+        std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            if (rank[a] != rank[b]) return rank[a] < rank[b];
+            return candidates[a].quality > candidates[b].quality;
+        });
+
+        size_t keep = std::max<size_t>(1, (candidates.size() + eta - 1) / eta);
+        std::vector<Candidate> survivors;
+        for (size_t i = 0; i < keep; ++i) survivors.push_back(candidates[order[i]]);
+        candidates = std::move(survivors);
+    }
+
+    // Pareto front of the full-trace evaluations
+    std::vector<int> rank = pareto_ranks(candidates);
+    std::vector<Candidate> front;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (rank[i] == 0) front.push_back(candidates[i]);
+    }
+    std::sort(front.begin(), front.end(), [](const Candidate& a, const Candidate& b) {
+        return a.p95_latency_ms < b.p95_latency_ms;
+    });
+
+    std::cout << "\n✅ Pareto front (latency vs quality):\n";
+    std::filesystem::create_directories(out_dir);
+    std::ofstream summary(out_dir + "/pareto_front.tsv");
+    if (summary) {
+        summary << "index\tquality\tp95_ms\tmean_ms";
+        for (const auto& range : ranges) summary << "\t" << range.name;
+        summary << "\n";
+    }
+
+    for (size_t i = 0; i < front.size(); ++i) {
+        // Each point is saved as a deployable genome, and reported with the
+        // gene values that genome holds (weights normalized, as evaluated)
+        evolution::DynamicGenome genome;
+        for (size_t g = 0; g < ranges.size(); ++g) {
+            genome.set_gene(ranges[g].name, front[i].genes[g]);
+        }
+        genome.reasoning_params().normalize_weights();
+        genome.save(out_dir + "/front_" + std::to_string(i) + ".genome");
+
+        Candidate deployed = front[i];
+        for (size_t g = 0; g < ranges.size(); ++g) {
+            deployed.genes[g] = genome.get_gene(ranges[g].name);
+        }
+        print_candidate(deployed, ranges);
+
+        if (summary) {
+            summary << i << "\t" << deployed.quality << "\t" << deployed.p95_latency_ms
+                    << "\t" << deployed.mean_latency_ms;
+            for (float value : deployed.genes) summary << "\t" << value;
+            summary << "\n";
+        }
+    }
+
+    if (!summary) {
+        std::cerr << "⚠️  Could not write " << out_dir << "/pareto_front.tsv\n";
+    }
+    return 0;
+}